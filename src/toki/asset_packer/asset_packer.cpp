@@ -0,0 +1,48 @@
+#include <toki/core/core.h>
+#include <toki/runtime/runtime.h>
+
+// Packs files into an archive readable by PackFileSystem, entries are named by the paths given
+// on the command line.
+//
+// usage: asset_packer <output> [--compress] <files...>
+
+using namespace toki;
+
+static b8 is_option(StringView arg, StringView option) {
+	return arg.size() == option.size() && arg == option;
+}
+
+toki::i32 toki::toki_entrypoint(toki::Span<char*> args) {
+	if (args.size() < 3) {
+		toki::println("usage: asset_packer <output> [--compress] <files...>");
+		return 1;
+	}
+
+	PackWriteConfig config{};
+	DynamicArray<StringView> inputs;
+	for (u64 i = 2; i < args.size(); i++) {
+		if (is_option(args[i], "--compress")) {
+			config.compress = true;
+		} else {
+			inputs.push_back(args[i]);
+		}
+	}
+
+	if (!write_pack(args[1], inputs, config)) {
+		return 1;
+	}
+
+	PackFileSystem pack;
+	if (!pack.open(args[1])) {
+		return 1;
+	}
+
+	toki::println("Packed {} file(s) into {}", pack.entry_count(), args[1]);
+	for (u64 i = 0; i < inputs.size(); i++) {
+		const PackEntry* entry = pack.find(inputs[i]);
+		if (entry != nullptr) {
+			toki::println("  {} {} -> {} bytes", inputs[i], entry->size, entry->stored_size);
+		}
+	}
+	return 0;
+}
@@ -24,22 +24,28 @@ namespace toki {
 	#endif
 #endif
 
+// Vector types like __m128 carry attributes that are dropped when they are template arguments,
+// DISABLE_IGNORED_ATTRIBUTES silences the warning about it
 #if defined(__clang__)
-	#define PUSH_WARNING		 _Pragma("clang diagnostic push")
-	#define POP_WARNING			 _Pragma("clang diagnostic pop")
-	#define DISABLE_UNUSED_PARAM _Pragma("clang diagnostic ignored \"-Wunused-parameter\"")
+	#define PUSH_WARNING			   _Pragma("clang diagnostic push")
+	#define POP_WARNING				   _Pragma("clang diagnostic pop")
+	#define DISABLE_UNUSED_PARAM	   _Pragma("clang diagnostic ignored \"-Wunused-parameter\"")
+	#define DISABLE_IGNORED_ATTRIBUTES _Pragma("clang diagnostic ignored \"-Wignored-attributes\"")
 #elif defined(__GNUC__)
-	#define PUSH_WARNING		 _Pragma("GCC diagnostic push")
-	#define POP_WARNING			 _Pragma("GCC diagnostic pop")
-	#define DISABLE_UNUSED_PARAM _Pragma("GCC diagnostic ignored \"-Wunused-parameter\"")
+	#define PUSH_WARNING			   _Pragma("GCC diagnostic push")
+	#define POP_WARNING				   _Pragma("GCC diagnostic pop")
+	#define DISABLE_UNUSED_PARAM	   _Pragma("GCC diagnostic ignored \"-Wunused-parameter\"")
+	#define DISABLE_IGNORED_ATTRIBUTES _Pragma("GCC diagnostic ignored \"-Wignored-attributes\"")
 #elif defined(_MSC_VER)
-	#define PUSH_WARNING		 __pragma(warning(push))
-	#define POP_WARNING			 __pragma(warning(pop))
-	#define DISABLE_UNUSED_PARAM __pragma(warning(disable : 4100))
+	#define PUSH_WARNING			   __pragma(warning(push))
+	#define POP_WARNING				   __pragma(warning(pop))
+	#define DISABLE_UNUSED_PARAM	   __pragma(warning(disable : 4100))
+	#define DISABLE_IGNORED_ATTRIBUTES
 #else
 	#define PUSH_WARNING
 	#define POP_WARNING
 	#define DISABLE_UNUSED_PARAM
+	#define DISABLE_IGNORED_ATTRIBUTES
 #endif
 
 #if !defined(TK_DEBUG_BREAK)
@@ -35,4 +35,6 @@ constexpr const u8 U8_MAX = static_cast<u8>(-1);
 constexpr const i8 I8_MAX = static_cast<i8>(static_cast<u8>(static_cast<u8>(1) << 7) - 1);
 constexpr const i8 I8_MIN = static_cast<i8>(static_cast<u8>(1) << 7);
 
+constexpr const f32 F32_MAX = 3.40282347e+38f;
+
 }  // namespace toki
@@ -114,7 +114,11 @@ public:
 		return m_size;
 	}
 
+	// Frees the current buffer first, its elements are not destroyed just like in the destructor
 	void move(DynamicArray&& other) {
+		if (m_data != nullptr) {
+			AllocatorType::free(m_data);
+		}
 		m_data			 = other.m_data;
 		m_size			 = other.m_size;
 		m_capacity		 = other.m_capacity;
@@ -1,11 +1,18 @@
 #pragma once
 
 //
+#include <toki/core/math/aabb.h>
+#include <toki/core/math/batch.h>
 #include <toki/core/math/extent.h>
+#include <toki/core/math/frustum.h>
 #include <toki/core/math/math.h>
 #include <toki/core/math/matrix4.h>
+#include <toki/core/math/quantize.h>
+#include <toki/core/math/quaternion.h>
+#include <toki/core/math/transcendental.h>
 #include <toki/core/math/vector2.h>
 #include <toki/core/math/vector3.h>
+#include <toki/core/math/vector4.h>
 
 #include <toki/core/math/matrix_functions.hpp>
 
@@ -38,6 +45,7 @@
 #include <toki/core/memory/allocator.h>
 #include <toki/core/memory/bump_allocator.h>
 #include <toki/core/memory/memory.h>
+#include <toki/core/memory/scratch.h>
 #include <toki/core/memory/unique_ptr.h>
 
 //
@@ -45,15 +53,31 @@
 #include <toki/core/string/converters.h>
 #include <toki/core/string/span.h>
 #include <toki/core/string/string_view.h>
+#include <toki/core/string/utf8.h>
 
 //
+#include <toki/core/utils/block_compression.h>
+#include <toki/core/utils/buffered_stream.h>
 #include <toki/core/utils/bytes.h>
 #include <toki/core/utils/file.h>
+#include <toki/core/utils/hash.h>
+#include <toki/core/utils/image.h>
+#include <toki/core/utils/line_index.h>
+#include <toki/core/utils/lz4.h>
+#include <toki/core/utils/mapped_file.h>
+#include <toki/core/utils/mesh_optimizer.h>
+#include <toki/core/utils/mesh_simplifier.h>
 #include <toki/core/utils/path.h>
+#include <toki/core/utils/shelf_packer.h>
+#include <toki/core/utils/sort.h>
 #include <toki/core/utils/utils.h>
 
 //
+#include <toki/core/platform/async_io.h>
+#include <toki/core/platform/file_watcher.h>
 #include <toki/core/platform/threads/atomic.h>
+#include <toki/core/platform/threads/cpu_topology.h>
 #include <toki/core/platform/threads/mutex.h>
 #include <toki/core/platform/threads/thread.h>
+#include <toki/core/platform/threads/triple_buffer.h>
 #include <toki/core/platform/window/window.h>
@@ -7,6 +7,10 @@ enum struct TokiError {
 	Unknown,
 
 	FileOpen,
+	FileMap,
+	FileWrite,
+
+	CorruptData,
 
 	MEMORY_ALLOCATION_FAILED,
 };
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <toki/core/common/defines.h>
+#include <toki/core/math/math.h>
+#include <toki/core/math/vector3.h>
+
+namespace toki {
+
+// Axis aligned bounding box, a default constructed box is empty and takes the bounds of the
+// first point or box merged into it
+struct Aabb {
+	Vector3 min{ F32_MAX };
+	Vector3 max{ -F32_MAX };
+
+	constexpr b8 is_empty() const {
+		return min.x > max.x || min.y > max.y || min.z > max.z;
+	}
+
+	constexpr void expand(const Vector3& point) {
+		min = Vector3(toki::min(min.x, point.x), toki::min(min.y, point.y), toki::min(min.z, point.z));
+		max = Vector3(toki::max(max.x, point.x), toki::max(max.y, point.y), toki::max(max.z, point.z));
+	}
+
+	constexpr void merge(const Aabb& other) {
+		if (other.is_empty()) {
+			return;
+		}
+		expand(other.min);
+		expand(other.max);
+	}
+
+	constexpr Vector3 center() const {
+		return (min + max) * 0.5f;
+	}
+
+	constexpr Vector3 extent() const {
+		return (max - min) * 0.5f;
+	}
+};
+
+}  // namespace toki
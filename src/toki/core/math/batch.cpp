@@ -0,0 +1,508 @@
+#include "toki/core/math/batch.h"
+
+#include <toki/core/common/assert.h>
+#include <toki/core/math/simd.h>
+
+namespace toki {
+
+static Vector3 transform_scalar(const f32* m, f32 x, f32 y, f32 z, f32 w) {
+	// Same order of additions as the 8 wide kernel so both give the same results
+	return Vector3(
+		(m[0] * x + m[4] * y) + (m[8] * z + m[12] * w),
+		(m[1] * x + m[5] * y) + (m[9] * z + m[13] * w),
+		(m[2] * x + m[6] * y) + (m[10] * z + m[14] * w));
+}
+
+static Vector3 normalize_scalar(f32 x, f32 y, f32 z) {
+	f32 length_squared = x * x + y * y + z * z;
+	if (!(length_squared > 0.0f)) {
+		return Vector3(x, y, z);
+	}
+	f32 inverse_length = 1.0f / static_cast<f32>(toki::sqrt(length_squared));
+	return Vector3(x * inverse_length, y * inverse_length, z * inverse_length);
+}
+
+// Elements [begin, count) one at a time, also the tail of the 8 wide loops
+static void transform_aos_scalar(const Vector3* in, const f32* m, f32 w, Vector3* out, u64 begin, u64 count) {
+	for (u64 i = begin; i < count; i++) {
+		out[i] = transform_scalar(m, in[i].x, in[i].y, in[i].z, w);
+	}
+}
+
+static void transform_soa_scalar(const Vector3Soa& in, const f32* m, f32 w, const Vector3Soa& out, u64 begin) {
+	for (u64 i = begin; i < in.count; i++) {
+		Vector3 v = transform_scalar(m, in.x[i], in.y[i], in.z[i], w);
+		out.x[i]  = v.x;
+		out.y[i]  = v.y;
+		out.z[i]  = v.z;
+	}
+}
+
+static void normalize_aos_scalar(const Vector3* in, Vector3* out, u64 begin, u64 count) {
+	for (u64 i = begin; i < count; i++) {
+		out[i] = normalize_scalar(in[i].x, in[i].y, in[i].z);
+	}
+}
+
+static void normalize_soa_scalar(const Vector3Soa& in, const Vector3Soa& out, u64 begin) {
+	for (u64 i = begin; i < in.count; i++) {
+		Vector3 v = normalize_scalar(in.x[i], in.y[i], in.z[i]);
+		out.x[i]  = v.x;
+		out.y[i]  = v.y;
+		out.z[i]  = v.z;
+	}
+}
+
+static void aabb_aos_scalar(const Vector3* points, u64 begin, u64 count, Aabb& aabb) {
+	for (u64 i = begin; i < count; i++) {
+		aabb.expand(points[i]);
+	}
+}
+
+static void aabb_soa_scalar(const Vector3Soa& points, u64 begin, Aabb& aabb) {
+	for (u64 i = begin; i < points.count; i++) {
+		aabb.expand(Vector3(points.x[i], points.y[i], points.z[i]));
+	}
+}
+
+#if defined(TK_MATH_X86)
+
+static b8 has_avx() {
+	static const b8 supported = __builtin_cpu_supports("avx");
+	return supported;
+}
+
+// 8 vectors are 6 groups of 4 floats, each 128 bit half is deinterleaved on its own so the lanes
+// end up as (0 1 2 3 | 4 5 6 7) in all three registers
+__attribute__((target("avx"))) static inline void load_aos8(const Vector3* vectors, __m256& x, __m256& y, __m256& z) {
+	const f32* f = &vectors->x;
+	__m256 m03	 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(f)), _mm_loadu_ps(f + 12), 1);
+	__m256 m14	 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(f + 4)), _mm_loadu_ps(f + 16), 1);
+	__m256 m25	 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(f + 8)), _mm_loadu_ps(f + 20), 1);
+
+	__m256 xy = _mm256_shuffle_ps(m14, m25, _MM_SHUFFLE(2, 1, 3, 2));
+	__m256 yz = _mm256_shuffle_ps(m03, m14, _MM_SHUFFLE(1, 0, 2, 1));
+	x		  = _mm256_shuffle_ps(m03, xy, _MM_SHUFFLE(2, 0, 3, 0));
+	y		  = _mm256_shuffle_ps(yz, xy, _MM_SHUFFLE(3, 1, 2, 0));
+	z		  = _mm256_shuffle_ps(yz, m25, _MM_SHUFFLE(3, 0, 3, 1));
+}
+
+__attribute__((target("avx"))) static inline void store_aos8(Vector3* vectors, __m256 x, __m256 y, __m256 z) {
+	__m256 xy = _mm256_shuffle_ps(x, y, _MM_SHUFFLE(2, 0, 2, 0));
+	__m256 yz = _mm256_shuffle_ps(y, z, _MM_SHUFFLE(3, 1, 3, 1));
+	__m256 zx = _mm256_shuffle_ps(z, x, _MM_SHUFFLE(3, 1, 2, 0));
+
+	__m256 m03 = _mm256_shuffle_ps(xy, zx, _MM_SHUFFLE(2, 0, 2, 0));
+	__m256 m14 = _mm256_shuffle_ps(yz, xy, _MM_SHUFFLE(3, 1, 2, 0));
+	__m256 m25 = _mm256_shuffle_ps(zx, yz, _MM_SHUFFLE(3, 1, 3, 1));
+
+	f32* f = &vectors->x;
+	_mm_storeu_ps(f, _mm256_castps256_ps128(m03));
+	_mm_storeu_ps(f + 4, _mm256_castps256_ps128(m14));
+	_mm_storeu_ps(f + 8, _mm256_castps256_ps128(m25));
+	_mm_storeu_ps(f + 12, _mm256_extractf128_ps(m03, 1));
+	_mm_storeu_ps(f + 16, _mm256_extractf128_ps(m14, 1));
+	_mm_storeu_ps(f + 20, _mm256_extractf128_ps(m25, 1));
+}
+
+// The upper three rows of the matrix with every element in all 8 lanes, the translation column is
+// already scaled by w
+struct BroadcastMatrix {
+	__m256 m[12];
+};
+
+__attribute__((target("avx"))) static inline BroadcastMatrix broadcast_matrix(const f32* m, f32 w) {
+	BroadcastMatrix broadcast;
+	for (u32 col = 0; col < 4; col++) {
+		for (u32 row = 0; row < 3; row++) {
+			f32 value				   = col == 3 ? m[col * 4 + row] * w : m[col * 4 + row];
+			broadcast.m[col * 3 + row] = _mm256_set1_ps(value);
+		}
+	}
+	return broadcast;
+}
+
+__attribute__((target("avx"))) static inline void transform8(
+	const BroadcastMatrix& b, __m256& x, __m256& y, __m256& z) {
+	__m256 ox = _mm256_add_ps(
+		_mm256_add_ps(_mm256_mul_ps(b.m[0], x), _mm256_mul_ps(b.m[3], y)),
+		_mm256_add_ps(_mm256_mul_ps(b.m[6], z), b.m[9]));
+	__m256 oy = _mm256_add_ps(
+		_mm256_add_ps(_mm256_mul_ps(b.m[1], x), _mm256_mul_ps(b.m[4], y)),
+		_mm256_add_ps(_mm256_mul_ps(b.m[7], z), b.m[10]));
+	__m256 oz = _mm256_add_ps(
+		_mm256_add_ps(_mm256_mul_ps(b.m[2], x), _mm256_mul_ps(b.m[5], y)),
+		_mm256_add_ps(_mm256_mul_ps(b.m[8], z), b.m[11]));
+	x = ox;
+	y = oy;
+	z = oz;
+}
+
+__attribute__((target("avx"))) static inline void normalize8(__m256& x, __m256& y, __m256& z) {
+	__m256 length_squared =
+		_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, x), _mm256_mul_ps(y, y)), _mm256_mul_ps(z, z));
+	__m256 inverse_length = _mm256_div_ps(_mm256_set1_ps(1.0f), _mm256_sqrt_ps(length_squared));
+	// Zero length lanes are left as they are instead of becoming NaN
+	__m256 non_zero = _mm256_cmp_ps(length_squared, _mm256_setzero_ps(), _CMP_GT_OQ);
+	x				= _mm256_blendv_ps(x, _mm256_mul_ps(x, inverse_length), non_zero);
+	y				= _mm256_blendv_ps(y, _mm256_mul_ps(y, inverse_length), non_zero);
+	z				= _mm256_blendv_ps(z, _mm256_mul_ps(z, inverse_length), non_zero);
+}
+
+__attribute__((target("avx"))) static u64 transform_aos_avx(
+	const Vector3* in, const f32* m, f32 w, Vector3* out, u64 count) {
+	BroadcastMatrix broadcast = broadcast_matrix(m, w);
+
+	u64 i = 0;
+	for (; i + 8 <= count; i += 8) {
+		__m256 x, y, z;
+		load_aos8(in + i, x, y, z);
+		transform8(broadcast, x, y, z);
+		store_aos8(out + i, x, y, z);
+	}
+	return i;
+}
+
+__attribute__((target("avx"))) static u64 transform_soa_avx(
+	const Vector3Soa& in, const f32* m, f32 w, const Vector3Soa& out) {
+	BroadcastMatrix broadcast = broadcast_matrix(m, w);
+
+	u64 i = 0;
+	for (; i + 8 <= in.count; i += 8) {
+		__m256 x = _mm256_loadu_ps(in.x + i);
+		__m256 y = _mm256_loadu_ps(in.y + i);
+		__m256 z = _mm256_loadu_ps(in.z + i);
+		transform8(broadcast, x, y, z);
+		_mm256_storeu_ps(out.x + i, x);
+		_mm256_storeu_ps(out.y + i, y);
+		_mm256_storeu_ps(out.z + i, z);
+	}
+	return i;
+}
+
+__attribute__((target("avx"))) static u64 normalize_aos_avx(const Vector3* in, Vector3* out, u64 count) {
+	u64 i = 0;
+	for (; i + 8 <= count; i += 8) {
+		__m256 x, y, z;
+		load_aos8(in + i, x, y, z);
+		normalize8(x, y, z);
+		store_aos8(out + i, x, y, z);
+	}
+	return i;
+}
+
+__attribute__((target("avx"))) static u64 normalize_soa_avx(const Vector3Soa& in, const Vector3Soa& out) {
+	u64 i = 0;
+	for (; i + 8 <= in.count; i += 8) {
+		__m256 x = _mm256_loadu_ps(in.x + i);
+		__m256 y = _mm256_loadu_ps(in.y + i);
+		__m256 z = _mm256_loadu_ps(in.z + i);
+		normalize8(x, y, z);
+		_mm256_storeu_ps(out.x + i, x);
+		_mm256_storeu_ps(out.y + i, y);
+		_mm256_storeu_ps(out.z + i, z);
+	}
+	return i;
+}
+
+__attribute__((target("avx"))) static inline f32 reduce_min8(__m256 v) {
+	__m128 r = _mm_min_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+	r		 = _mm_min_ps(r, _mm_movehl_ps(r, r));
+	r		 = _mm_min_ss(r, _mm_shuffle_ps(r, r, _MM_SHUFFLE(1, 1, 1, 1)));
+	return _mm_cvtss_f32(r);
+}
+
+__attribute__((target("avx"))) static inline f32 reduce_max8(__m256 v) {
+	__m128 r = _mm_max_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+	r		 = _mm_max_ps(r, _mm_movehl_ps(r, r));
+	r		 = _mm_max_ss(r, _mm_shuffle_ps(r, r, _MM_SHUFFLE(1, 1, 1, 1)));
+	return _mm_cvtss_f32(r);
+}
+
+// Bounds of the elements [0, returned count), the rest is left to the scalar loop
+__attribute__((target("avx"))) static u64 aabb_aos_avx(const Vector3* points, u64 count, Aabb& aabb) {
+	__m256 min_x = _mm256_set1_ps(F32_MAX), min_y = min_x, min_z = min_x;
+	__m256 max_x = _mm256_set1_ps(-F32_MAX), max_y = max_x, max_z = max_x;
+
+	u64 i = 0;
+	for (; i + 8 <= count; i += 8) {
+		__m256 x, y, z;
+		load_aos8(points + i, x, y, z);
+		min_x = _mm256_min_ps(min_x, x);
+		min_y = _mm256_min_ps(min_y, y);
+		min_z = _mm256_min_ps(min_z, z);
+		max_x = _mm256_max_ps(max_x, x);
+		max_y = _mm256_max_ps(max_y, y);
+		max_z = _mm256_max_ps(max_z, z);
+	}
+
+	if (i > 0) {
+		aabb.expand(Vector3(reduce_min8(min_x), reduce_min8(min_y), reduce_min8(min_z)));
+		aabb.expand(Vector3(reduce_max8(max_x), reduce_max8(max_y), reduce_max8(max_z)));
+	}
+	return i;
+}
+
+__attribute__((target("avx"))) static u64 aabb_soa_avx(const Vector3Soa& points, Aabb& aabb) {
+	__m256 min_x = _mm256_set1_ps(F32_MAX), min_y = min_x, min_z = min_x;
+	__m256 max_x = _mm256_set1_ps(-F32_MAX), max_y = max_x, max_z = max_x;
+
+	u64 i = 0;
+	for (; i + 8 <= points.count; i += 8) {
+		__m256 x = _mm256_loadu_ps(points.x + i);
+		__m256 y = _mm256_loadu_ps(points.y + i);
+		__m256 z = _mm256_loadu_ps(points.z + i);
+		min_x	 = _mm256_min_ps(min_x, x);
+		min_y	 = _mm256_min_ps(min_y, y);
+		min_z	 = _mm256_min_ps(min_z, z);
+		max_x	 = _mm256_max_ps(max_x, x);
+		max_y	 = _mm256_max_ps(max_y, y);
+		max_z	 = _mm256_max_ps(max_z, z);
+	}
+
+	if (i > 0) {
+		aabb.expand(Vector3(reduce_min8(min_x), reduce_min8(min_y), reduce_min8(min_z)));
+		aabb.expand(Vector3(reduce_max8(max_x), reduce_max8(max_y), reduce_max8(max_z)));
+	}
+	return i;
+}
+
+// 4x4 transpose within each 128 bit half, rows become columns for two groups of four at once
+__attribute__((target("avx"))) static inline void transpose_halves(__m256& r0, __m256& r1, __m256& r2, __m256& r3) {
+	__m256 t0 = _mm256_unpacklo_ps(r0, r1);
+	__m256 t1 = _mm256_unpacklo_ps(r2, r3);
+	__m256 t2 = _mm256_unpackhi_ps(r0, r1);
+	__m256 t3 = _mm256_unpackhi_ps(r2, r3);
+	r0		  = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(1, 0, 1, 0));
+	r1		  = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(3, 2, 3, 2));
+	r2		  = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(1, 0, 1, 0));
+	r3		  = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(3, 2, 3, 2));
+}
+
+// Quaternions 0-3 go to the low halves and 4-7 to the high ones, the same lane order load_aos8
+// gives for vectors
+__attribute__((target("avx"))) static inline void load_quaternions8(
+	const Quaternion* rotations, __m256& x, __m256& y, __m256& z, __m256& w) {
+	const f32* f = &rotations->x;
+	x			 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(f)), _mm_loadu_ps(f + 16), 1);
+	y			 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(f + 4)), _mm_loadu_ps(f + 20), 1);
+	z			 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(f + 8)), _mm_loadu_ps(f + 24), 1);
+	w			 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(f + 12)), _mm_loadu_ps(f + 28), 1);
+	transpose_halves(x, y, z, w);
+}
+
+// Writes column col of 8 matrices given its four rows, one matrix per lane
+__attribute__((target("avx"))) static inline void store_columns8(
+	Matrix4* matrices, u32 col, __m256 r0, __m256 r1, __m256 r2, __m256 r3) {
+	transpose_halves(r0, r1, r2, r3);
+	__m256 columns[4] = { r0, r1, r2, r3 };
+	for (u32 i = 0; i < 4; i++) {
+		_mm_storeu_ps(&matrices[i][col * 4], _mm256_castps256_ps128(columns[i]));
+		_mm_storeu_ps(&matrices[i + 4][col * 4], _mm256_extractf128_ps(columns[i], 1));
+	}
+}
+
+__attribute__((target("avx"))) static u64 compose_trs_avx(
+	const Vector3* translations, const Quaternion* rotations, const Vector3* scales, Matrix4* out, u64 count) {
+	const __m256 one  = _mm256_set1_ps(1.0f);
+	const __m256 two  = _mm256_set1_ps(2.0f);
+	const __m256 zero = _mm256_setzero_ps();
+
+	u64 i = 0;
+	for (; i + 8 <= count; i += 8) {
+		__m256 x, y, z, w;
+		load_quaternions8(rotations + i, x, y, z, w);
+		__m256 tx, ty, tz;
+		load_aos8(translations + i, tx, ty, tz);
+		__m256 sx, sy, sz;
+		load_aos8(scales + i, sx, sy, sz);
+
+		__m256 xx = _mm256_mul_ps(x, x);
+		__m256 yy = _mm256_mul_ps(y, y);
+		__m256 zz = _mm256_mul_ps(z, z);
+		__m256 xy = _mm256_mul_ps(x, y);
+		__m256 xz = _mm256_mul_ps(x, z);
+		__m256 yz = _mm256_mul_ps(y, z);
+		__m256 wx = _mm256_mul_ps(w, x);
+		__m256 wy = _mm256_mul_ps(w, y);
+		__m256 wz = _mm256_mul_ps(w, z);
+
+		// Same expressions as Quaternion::to_matrix, each column scaled by its axis
+		store_columns8(
+			out + i,
+			0,
+			_mm256_mul_ps(_mm256_sub_ps(one, _mm256_mul_ps(two, _mm256_add_ps(yy, zz))), sx),
+			_mm256_mul_ps(_mm256_mul_ps(two, _mm256_add_ps(xy, wz)), sx),
+			_mm256_mul_ps(_mm256_mul_ps(two, _mm256_sub_ps(xz, wy)), sx),
+			zero);
+		store_columns8(
+			out + i,
+			1,
+			_mm256_mul_ps(_mm256_mul_ps(two, _mm256_sub_ps(xy, wz)), sy),
+			_mm256_mul_ps(_mm256_sub_ps(one, _mm256_mul_ps(two, _mm256_add_ps(xx, zz))), sy),
+			_mm256_mul_ps(_mm256_mul_ps(two, _mm256_add_ps(yz, wx)), sy),
+			zero);
+		store_columns8(
+			out + i,
+			2,
+			_mm256_mul_ps(_mm256_mul_ps(two, _mm256_add_ps(xz, wy)), sz),
+			_mm256_mul_ps(_mm256_mul_ps(two, _mm256_sub_ps(yz, wx)), sz),
+			_mm256_mul_ps(_mm256_sub_ps(one, _mm256_mul_ps(two, _mm256_add_ps(xx, yy))), sz),
+			zero);
+		store_columns8(out + i, 3, tx, ty, tz, one);
+	}
+	return i;
+}
+
+// Two result columns per register like the AVX path of Matrix4, a lhs stride of zero reuses the
+// same matrix for every product
+__attribute__((target("avx"))) static void multiply_matrices_avx(
+	const Matrix4* lhs, u64 lhs_stride, const Matrix4* rhs, Matrix4* out, u64 count) {
+	for (u64 i = 0; i < count; i++) {
+		const f32* l = lhs[i * lhs_stride].data();
+		const f32* r = rhs[i].data();
+		f32* o		 = &out[i][0];
+
+		__m256 c0  = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(l));
+		__m256 c1  = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(l + 4));
+		__m256 c2  = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(l + 8));
+		__m256 c3  = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(l + 12));
+		__m256 r01 = _mm256_loadu_ps(r);
+		__m256 r23 = _mm256_loadu_ps(r + 8);
+
+		__m256 v01 = _mm256_mul_ps(c0, _mm256_shuffle_ps(r01, r01, _MM_SHUFFLE(0, 0, 0, 0)));
+		__m256 v23 = _mm256_mul_ps(c0, _mm256_shuffle_ps(r23, r23, _MM_SHUFFLE(0, 0, 0, 0)));
+		v01		   = _mm256_add_ps(v01, _mm256_mul_ps(c1, _mm256_shuffle_ps(r01, r01, _MM_SHUFFLE(1, 1, 1, 1))));
+		v23		   = _mm256_add_ps(v23, _mm256_mul_ps(c1, _mm256_shuffle_ps(r23, r23, _MM_SHUFFLE(1, 1, 1, 1))));
+		v01		   = _mm256_add_ps(v01, _mm256_mul_ps(c2, _mm256_shuffle_ps(r01, r01, _MM_SHUFFLE(2, 2, 2, 2))));
+		v23		   = _mm256_add_ps(v23, _mm256_mul_ps(c2, _mm256_shuffle_ps(r23, r23, _MM_SHUFFLE(2, 2, 2, 2))));
+		v01		   = _mm256_add_ps(v01, _mm256_mul_ps(c3, _mm256_shuffle_ps(r01, r01, _MM_SHUFFLE(3, 3, 3, 3))));
+		v23		   = _mm256_add_ps(v23, _mm256_mul_ps(c3, _mm256_shuffle_ps(r23, r23, _MM_SHUFFLE(3, 3, 3, 3))));
+		_mm256_storeu_ps(o, v01);
+		_mm256_storeu_ps(o + 8, v23);
+	}
+}
+
+#endif
+
+static void transform_aos(const Vector3* in, const Matrix4& matrix, f32 w, Vector3* out, u64 count) {
+	u64 done = 0;
+#if defined(TK_MATH_X86)
+	if (has_avx()) {
+		done = transform_aos_avx(in, matrix.data(), w, out, count);
+	}
+#endif
+	transform_aos_scalar(in, matrix.data(), w, out, done, count);
+}
+
+static void transform_soa(const Vector3Soa& in, const Matrix4& matrix, f32 w, const Vector3Soa& out) {
+	TK_ASSERT(in.count == out.count);
+	u64 done = 0;
+#if defined(TK_MATH_X86)
+	if (has_avx()) {
+		done = transform_soa_avx(in, matrix.data(), w, out);
+	}
+#endif
+	transform_soa_scalar(in, matrix.data(), w, out, done);
+}
+
+void transform_points(Span<Vector3> points, const Matrix4& matrix, Vector3* points_out) {
+	transform_aos(points.data(), matrix, 1.0f, points_out, points.size());
+}
+
+void transform_points(const Vector3Soa& points, const Matrix4& matrix, const Vector3Soa& points_out) {
+	transform_soa(points, matrix, 1.0f, points_out);
+}
+
+void transform_directions(Span<Vector3> directions, const Matrix4& matrix, Vector3* directions_out) {
+	transform_aos(directions.data(), matrix, 0.0f, directions_out, directions.size());
+}
+
+void transform_directions(const Vector3Soa& directions, const Matrix4& matrix, const Vector3Soa& directions_out) {
+	transform_soa(directions, matrix, 0.0f, directions_out);
+}
+
+void multiply_matrices(Span<Matrix4> lhs, Span<Matrix4> rhs, Matrix4* products_out) {
+	TK_ASSERT(lhs.size() == rhs.size());
+#if defined(TK_MATH_X86)
+	if (has_avx()) {
+		multiply_matrices_avx(lhs.data(), 1, rhs.data(), products_out, rhs.size());
+		return;
+	}
+#endif
+	for (u64 i = 0; i < rhs.size(); i++) {
+		products_out[i] = lhs[i] * rhs[i];
+	}
+}
+
+void multiply_matrices(const Matrix4& lhs, Span<Matrix4> rhs, Matrix4* products_out) {
+#if defined(TK_MATH_X86)
+	if (has_avx()) {
+		multiply_matrices_avx(&lhs, 0, rhs.data(), products_out, rhs.size());
+		return;
+	}
+#endif
+	for (u64 i = 0; i < rhs.size(); i++) {
+		products_out[i] = lhs * rhs[i];
+	}
+}
+
+void compose_trs(Span<Vector3> translations, Span<Quaternion> rotations, Span<Vector3> scales, Matrix4* matrices_out) {
+	TK_ASSERT(translations.size() == rotations.size() && rotations.size() == scales.size());
+	u64 done = 0;
+#if defined(TK_MATH_X86)
+	if (has_avx()) {
+		done = compose_trs_avx(translations.data(), rotations.data(), scales.data(), matrices_out, rotations.size());
+	}
+#endif
+	for (u64 i = done; i < rotations.size(); i++) {
+		matrices_out[i] = compose_trs(translations[i], rotations[i], scales[i]);
+	}
+}
+
+void normalize_many(Span<Vector3> vectors, Vector3* vectors_out) {
+	u64 done = 0;
+#if defined(TK_MATH_X86)
+	if (has_avx()) {
+		done = normalize_aos_avx(vectors.data(), vectors_out, vectors.size());
+	}
+#endif
+	normalize_aos_scalar(vectors.data(), vectors_out, done, vectors.size());
+}
+
+void normalize_many(const Vector3Soa& vectors, const Vector3Soa& vectors_out) {
+	TK_ASSERT(vectors.count == vectors_out.count);
+	u64 done = 0;
+#if defined(TK_MATH_X86)
+	if (has_avx()) {
+		done = normalize_soa_avx(vectors, vectors_out);
+	}
+#endif
+	normalize_soa_scalar(vectors, vectors_out, done);
+}
+
+Aabb compute_aabb(Span<Vector3> points) {
+	Aabb aabb;
+	u64 done = 0;
+#if defined(TK_MATH_X86)
+	if (has_avx()) {
+		done = aabb_aos_avx(points.data(), points.size(), aabb);
+	}
+#endif
+	aabb_aos_scalar(points.data(), done, points.size(), aabb);
+	return aabb;
+}
+
+Aabb compute_aabb(const Vector3Soa& points) {
+	Aabb aabb;
+	u64 done = 0;
+#if defined(TK_MATH_X86)
+	if (has_avx()) {
+		done = aabb_soa_avx(points, aabb);
+	}
+#endif
+	aabb_soa_scalar(points, done, aabb);
+	return aabb;
+}
+
+}  // namespace toki
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <toki/core/math/aabb.h>
+#include <toki/core/math/matrix4.h>
+#include <toki/core/math/quaternion.h>
+#include <toki/core/math/vector3.h>
+#include <toki/core/string/span.h>
+#include <toki/core/types.h>
+
+namespace toki {
+
+// Math over whole arrays at once, 8 elements at a time with AVX when the CPU supports it and one
+// at a time otherwise. Outputs hold as many elements as the input and may be the input itself.
+
+// Positions split into one array per component, the layout the 8 wide kernels work on directly
+struct Vector3Soa {
+	f32* x;
+	f32* y;
+	f32* z;
+	u64 count;
+};
+
+// Transforms with w = 1 without dividing by the resulting w, like Matrix4::transform_point
+void transform_points(Span<Vector3> points, const Matrix4& matrix, Vector3* points_out);
+void transform_points(const Vector3Soa& points, const Matrix4& matrix, const Vector3Soa& points_out);
+
+// Transforms with w = 0, normals need the inverse transpose of the matrix
+void transform_directions(Span<Vector3> directions, const Matrix4& matrix, Vector3* directions_out);
+void transform_directions(const Vector3Soa& directions, const Matrix4& matrix, const Vector3Soa& directions_out);
+
+// products_out[i] = lhs[i] * rhs[i], lhs and rhs have the same size
+void multiply_matrices(Span<Matrix4> lhs, Span<Matrix4> rhs, Matrix4* products_out);
+// products_out[i] = lhs * rhs[i], parent transform applied to its children
+void multiply_matrices(const Matrix4& lhs, Span<Matrix4> rhs, Matrix4* products_out);
+
+// matrices_out[i] = compose_trs(translations[i], rotations[i], scales[i]), all three have the same
+// size
+void compose_trs(Span<Vector3> translations, Span<Quaternion> rotations, Span<Vector3> scales, Matrix4* matrices_out);
+
+// Zero length vectors stay zero instead of becoming NaN
+void normalize_many(Span<Vector3> vectors, Vector3* vectors_out);
+void normalize_many(const Vector3Soa& vectors, const Vector3Soa& vectors_out);
+
+// Empty box for no points
+Aabb compute_aabb(Span<Vector3> points);
+Aabb compute_aabb(const Vector3Soa& points);
+
+}  // namespace toki
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <toki/core/math/aabb.h>
+#include <toki/core/math/math.h>
+#include <toki/core/math/matrix4.h>
+#include <toki/core/math/vector3.h>
+#include <toki/core/math/vector4.h>
+#include <toki/core/types.h>
+
+namespace toki {
+
+struct BoundingSphere {
+	Vector3 center;
+	f32 radius{};
+
+	// Sphere around the box, looser than the smallest enclosing sphere of the geometry but
+	// it does not need the vertices
+	static constexpr BoundingSphere from_aabb(const Aabb& box) {
+		return BoundingSphere{ box.center(), box.extent().length() };
+	}
+};
+
+enum struct FrustumTest : u8 {
+	OUTSIDE,
+	INTERSECTING,
+	INSIDE,
+};
+
+// The six clip planes of a view projection matrix, xyz of each plane is the normal pointing into
+// the frustum and w its distance so a point p is on the inner side when dot(xyz, p) + w >= 0.
+// Planes are normalized so the distances are in world units. Assumes the 0 to 1 clip depth of
+// Vulkan and toki::perspective.
+struct Frustum {
+	enum Plane : u32 {
+		PLANE_LEFT,
+		PLANE_RIGHT,
+		PLANE_BOTTOM,
+		PLANE_TOP,
+		PLANE_NEAR,
+		PLANE_FAR,
+		PLANE_COUNT,
+	};
+
+	Vector4 planes[PLANE_COUNT];
+
+	static constexpr Frustum from_matrix(const Matrix4& view_projection);
+
+	constexpr f32 distance(u32 plane, const Vector3& point) const {
+		const Vector4& p = planes[plane];
+		return p.x * point.x + p.y * point.y + p.z * point.z + p.w;
+	}
+
+	constexpr b8 contains(const Vector3& point) const;
+	constexpr b8 intersects(const BoundingSphere& sphere) const;
+	// Conservative, a box outside the frustum near one of its edges can still pass
+	constexpr b8 intersects(const Aabb& box) const;
+	// INSIDE when the box is on the inner side of every plane, hierarchies can then skip testing
+	// what is inside of it
+	constexpr FrustumTest classify(const Aabb& box) const;
+};
+
+constexpr Frustum Frustum::from_matrix(const Matrix4& view_projection) {
+	// Clip space is -w <= x, y <= w and 0 <= z <= w, each bound is a sum of two matrix rows
+	auto row = [&view_projection](u32 index) {
+		return Vector4(
+			view_projection[0 * 4 + index],
+			view_projection[1 * 4 + index],
+			view_projection[2 * 4 + index],
+			view_projection[3 * 4 + index]);
+	};
+
+	Vector4 x = row(0), y = row(1), z = row(2), w = row(3);
+
+	Frustum frustum{};
+	frustum.planes[PLANE_LEFT]	 = w + x;
+	frustum.planes[PLANE_RIGHT]	 = w - x;
+	frustum.planes[PLANE_BOTTOM] = w + y;
+	frustum.planes[PLANE_TOP]	 = w - y;
+	frustum.planes[PLANE_NEAR]	 = z;
+	frustum.planes[PLANE_FAR]	 = w - z;
+
+	for (u32 i = 0; i < PLANE_COUNT; i++) {
+		f32 length = static_cast<f32>(toki::sqrt(frustum.planes[i].xyz().length_squared()));
+		if (length > 0.0f) {
+			frustum.planes[i] = frustum.planes[i] * (1.0f / length);
+		}
+	}
+	return frustum;
+}
+
+constexpr b8 Frustum::contains(const Vector3& point) const {
+	for (u32 i = 0; i < PLANE_COUNT; i++) {
+		if (distance(i, point) < 0.0f) {
+			return false;
+		}
+	}
+	return true;
+}
+
+constexpr b8 Frustum::intersects(const BoundingSphere& sphere) const {
+	for (u32 i = 0; i < PLANE_COUNT; i++) {
+		if (distance(i, sphere.center) < -sphere.radius) {
+			return false;
+		}
+	}
+	return true;
+}
+
+constexpr b8 Frustum::intersects(const Aabb& box) const {
+	return classify(box) != FrustumTest::OUTSIDE;
+}
+
+constexpr FrustumTest Frustum::classify(const Aabb& box) const {
+	if (box.is_empty()) {
+		return FrustumTest::OUTSIDE;
+	}
+
+	// Distance of the center against the extent projected onto the plane normal
+	Vector3 center = box.center();
+	Vector3 extent = box.extent();
+
+	FrustumTest result = FrustumTest::INSIDE;
+	for (u32 i = 0; i < PLANE_COUNT; i++) {
+		const Vector4& p = planes[i];
+		f32 radius		 = toki::abs(p.x) * extent.x + toki::abs(p.y) * extent.y + toki::abs(p.z) * extent.z;
+		f32 d			 = distance(i, center);
+		if (d < -radius) {
+			return FrustumTest::OUTSIDE;
+		}
+		if (d < radius) {
+			result = FrustumTest::INTERSECTING;
+		}
+	}
+	return result;
+}
+
+}  // namespace toki
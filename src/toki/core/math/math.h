@@ -1,6 +1,7 @@
 #pragma once
 
 #include <toki/core/common/assert.h>
+#include <toki/core/common/type_traits.h>
 #include <toki/core/types.h>
 
 namespace toki {
@@ -24,14 +25,15 @@ constexpr T clamp(T value, T min_value, T max_value) {
 	return min(max(value, min_value), max_value);
 }
 
-template <typename T>
-constexpr T pow(T value, T exp) {
+// Integer exponents only, pow in transcendental.h takes real ones
+template <typename T, CIsIntegral E>
+constexpr T pow(T value, E exp) {
 	if (exp == 0) {
 		return 1;
 	}
 
 	T result = 1;
-	for (u32 i = 0; i < exp; ++i) {
+	for (E i = 0; i < exp; ++i) {
 		result *= value;
 	}
 
@@ -151,13 +153,6 @@ constexpr f64 tan(f64 x) {
 	return sin(x) / cos_value;
 }
 
-// x - Angle in radians
-constexpr f64 atan(f64 x) {
-	f64 sin_value = sin(x);
-	TK_ASSERT(sin_value != 0.0f);
-	return cos(x) / sin_value;
-}
-
 // x - Angle in radians
 constexpr f64 acos(f64 x) {
 	if (x > 1.0f)
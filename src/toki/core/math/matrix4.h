@@ -1,15 +1,161 @@
 #pragma once
 
 #include <toki/core/common/type_traits.h>
-#include <toki/core/containers/array.h>
+#include <toki/core/math/simd.h>
+#include <toki/core/math/transcendental.h>
 #include <toki/core/math/vector3.h>
+#include <toki/core/math/vector4.h>
 
 namespace toki {
 
-class Matrix4 {
+#if defined(TK_MATH_X86)
+
+namespace detail {
+
+// Columns of the matrices are loaded into one register each, the result column j is the sum of
+// the columns of lhs scaled by the elements of column j of rhs
+inline void matrix4_multiply(const f32* lhs, const f32* rhs, f32* out) {
+	#if defined(TK_MATH_AVX)
+	// Two result columns per register, the lhs columns are repeated in both halves
+	__m256 c0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(lhs));
+	__m256 c1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(lhs + 4));
+	__m256 c2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(lhs + 8));
+	__m256 c3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(lhs + 12));
+	for (u32 col = 0; col < 4; col += 2) {
+		__m256 r = _mm256_loadu_ps(rhs + col * 4);
+		__m256 v = _mm256_mul_ps(c0, _mm256_shuffle_ps(r, r, _MM_SHUFFLE(0, 0, 0, 0)));
+		v		 = _mm256_add_ps(v, _mm256_mul_ps(c1, _mm256_shuffle_ps(r, r, _MM_SHUFFLE(1, 1, 1, 1))));
+		v		 = _mm256_add_ps(v, _mm256_mul_ps(c2, _mm256_shuffle_ps(r, r, _MM_SHUFFLE(2, 2, 2, 2))));
+		v		 = _mm256_add_ps(v, _mm256_mul_ps(c3, _mm256_shuffle_ps(r, r, _MM_SHUFFLE(3, 3, 3, 3))));
+		_mm256_storeu_ps(out + col * 4, v);
+	}
+	#else
+	__m128 c0 = _mm_loadu_ps(lhs);
+	__m128 c1 = _mm_loadu_ps(lhs + 4);
+	__m128 c2 = _mm_loadu_ps(lhs + 8);
+	__m128 c3 = _mm_loadu_ps(lhs + 12);
+	for (u32 col = 0; col < 4; col++) {
+		__m128 r = _mm_loadu_ps(rhs + col * 4);
+		__m128 v = _mm_mul_ps(c0, _mm_shuffle_ps(r, r, _MM_SHUFFLE(0, 0, 0, 0)));
+		v		 = _mm_add_ps(v, _mm_mul_ps(c1, _mm_shuffle_ps(r, r, _MM_SHUFFLE(1, 1, 1, 1))));
+		v		 = _mm_add_ps(v, _mm_mul_ps(c2, _mm_shuffle_ps(r, r, _MM_SHUFFLE(2, 2, 2, 2))));
+		v		 = _mm_add_ps(v, _mm_mul_ps(c3, _mm_shuffle_ps(r, r, _MM_SHUFFLE(3, 3, 3, 3))));
+		_mm_storeu_ps(out + col * 4, v);
+	}
+	#endif
+}
+
+// Vectors are passed as separate components, building the register from them avoids loading it
+// right after it was stored one float at a time
+inline __m128 matrix4_transform(const f32* matrix, f32 x, f32 y, f32 z, f32 w) {
+	__m128 v = _mm_mul_ps(_mm_loadu_ps(matrix), _mm_set1_ps(x));
+	v		 = _mm_add_ps(v, _mm_mul_ps(_mm_loadu_ps(matrix + 4), _mm_set1_ps(y)));
+	v		 = _mm_add_ps(v, _mm_mul_ps(_mm_loadu_ps(matrix + 8), _mm_set1_ps(z)));
+	v		 = _mm_add_ps(v, _mm_mul_ps(_mm_loadu_ps(matrix + 12), _mm_set1_ps(w)));
+	return v;
+}
+
+inline void matrix4_transpose(const f32* matrix, f32* out) {
+	__m128 c0 = _mm_loadu_ps(matrix);
+	__m128 c1 = _mm_loadu_ps(matrix + 4);
+	__m128 c2 = _mm_loadu_ps(matrix + 8);
+	__m128 c3 = _mm_loadu_ps(matrix + 12);
+	_MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+	_mm_storeu_ps(out, c0);
+	_mm_storeu_ps(out + 4, c1);
+	_mm_storeu_ps(out + 8, c2);
+	_mm_storeu_ps(out + 12, c3);
+}
+
+// Products of 2x2 matrices stored as (m00, m01, m10, m11), # is the adjugate
+inline __m128 matrix2_multiply(__m128 a, __m128 b) {
+	return _mm_add_ps(
+		_mm_mul_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 3, 0))),
+		_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 2, 1, 2))));
+}
+
+// a# * b
+inline __m128 matrix2_adjugate_multiply(__m128 a, __m128 b) {
+	return _mm_sub_ps(
+		_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 3, 3)), b),
+		_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 1, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 0, 3, 2))));
+}
+
+// a * b#
+inline __m128 matrix2_multiply_adjugate(__m128 a, __m128 b) {
+	return _mm_sub_ps(
+		_mm_mul_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 3, 0, 3))),
+		_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 2, 1, 2))));
+}
+
+// Blockwise inversion over the four 2x2 sub matrices, the inverse of the transpose is the
+// transpose of the inverse so it works the same on columns as on rows. Returns false for
+// singular matrices without writing out.
+inline b8 matrix4_inverse(const f32* matrix, f32* out) {
+	__m128 c0 = _mm_loadu_ps(matrix);
+	__m128 c1 = _mm_loadu_ps(matrix + 4);
+	__m128 c2 = _mm_loadu_ps(matrix + 8);
+	__m128 c3 = _mm_loadu_ps(matrix + 12);
+
+	__m128 a = _mm_movelh_ps(c0, c1);
+	__m128 b = _mm_movehl_ps(c1, c0);
+	__m128 c = _mm_movelh_ps(c2, c3);
+	__m128 d = _mm_movehl_ps(c3, c2);
+
+	// Determinants of a, b, c and d
+	__m128 sub_determinants = _mm_sub_ps(
+		_mm_mul_ps(_mm_shuffle_ps(c0, c2, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(c1, c3, _MM_SHUFFLE(3, 1, 3, 1))),
+		_mm_mul_ps(_mm_shuffle_ps(c0, c2, _MM_SHUFFLE(3, 1, 3, 1)), _mm_shuffle_ps(c1, c3, _MM_SHUFFLE(2, 0, 2, 0))));
+	__m128 det_a = _mm_shuffle_ps(sub_determinants, sub_determinants, _MM_SHUFFLE(0, 0, 0, 0));
+	__m128 det_b = _mm_shuffle_ps(sub_determinants, sub_determinants, _MM_SHUFFLE(1, 1, 1, 1));
+	__m128 det_c = _mm_shuffle_ps(sub_determinants, sub_determinants, _MM_SHUFFLE(2, 2, 2, 2));
+	__m128 det_d = _mm_shuffle_ps(sub_determinants, sub_determinants, _MM_SHUFFLE(3, 3, 3, 3));
+
+	__m128 d_c = matrix2_adjugate_multiply(d, c);
+	__m128 a_b = matrix2_adjugate_multiply(a, b);
+	__m128 x   = _mm_sub_ps(_mm_mul_ps(det_d, a), matrix2_multiply(b, d_c));
+	__m128 w   = _mm_sub_ps(_mm_mul_ps(det_a, d), matrix2_multiply(c, a_b));
+	__m128 y   = _mm_sub_ps(_mm_mul_ps(det_b, c), matrix2_multiply_adjugate(d, a_b));
+	__m128 z   = _mm_sub_ps(_mm_mul_ps(det_c, b), matrix2_multiply_adjugate(a, d_c));
+
+	// |M| = |A||D| + |B||C| - tr((A#B)(D#C))
+	__m128 trace = _mm_mul_ps(a_b, _mm_shuffle_ps(d_c, d_c, _MM_SHUFFLE(3, 1, 2, 0)));
+	trace		 = _mm_add_ps(trace, _mm_movehl_ps(trace, trace));
+	trace		 = _mm_add_ps(trace, _mm_shuffle_ps(trace, trace, _MM_SHUFFLE(1, 1, 1, 1)));
+	__m128 determinant = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(det_a, det_d), _mm_mul_ps(det_b, det_c)), trace);
+	determinant		   = _mm_shuffle_ps(determinant, determinant, _MM_SHUFFLE(0, 0, 0, 0));
+	if (_mm_cvtss_f32(determinant) == 0.0f) {
+		return false;
+	}
+
+	__m128 inverse_determinant = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), determinant);
+	x						   = _mm_mul_ps(x, inverse_determinant);
+	y						   = _mm_mul_ps(y, inverse_determinant);
+	z						   = _mm_mul_ps(z, inverse_determinant);
+	w						   = _mm_mul_ps(w, inverse_determinant);
+
+	// Adjugates of the blocks are taken while putting them back together
+	_mm_storeu_ps(out, _mm_shuffle_ps(x, y, _MM_SHUFFLE(1, 3, 1, 3)));
+	_mm_storeu_ps(out + 4, _mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 2, 0, 2)));
+	_mm_storeu_ps(out + 8, _mm_shuffle_ps(z, w, _MM_SHUFFLE(1, 3, 1, 3)));
+	_mm_storeu_ps(out + 12, _mm_shuffle_ps(z, w, _MM_SHUFFLE(0, 2, 0, 2)));
+	return true;
+}
+
+}  // namespace detail
+
+#endif
+
+// Column major, element (row, col) is at index col * 4 + row. Operations are scalar when evaluated
+// at compile time and use SSE (AVX for products when the compiler targets it) at run time.
+class alignas(16) Matrix4 {
 public:
 	constexpr Matrix4();
-	constexpr Matrix4(const f32& value): m(value) {}
+	constexpr Matrix4(const f32& value) {
+		for (u32 i = 0; i < 16; i++) {
+			m[i] = value;
+		}
+	}
 
 	template <typename... Args>
 		requires(sizeof...(Args) == 16 && CConjunction<IsConvertible<Args, f32>...>)
@@ -38,25 +184,37 @@ public:
 
 	constexpr Matrix4& operator*=(const Matrix4& other);
 	constexpr Matrix4 operator*(const Matrix4& other) const;
+	constexpr Vector4 operator*(const Vector4& vector) const;
+
+	// Transforms with w = 1 without dividing by the resulting w, for affine matrices
+	constexpr Vector3 transform_point(const Vector3& point) const;
+	// Transforms with w = 0 so translation is ignored
+	constexpr Vector3 transform_direction(const Vector3& direction) const;
 
 	constexpr Matrix4 translate(const Vector3& position) const;
 	constexpr Matrix4 scale(f32 uniform_scale) const;
 	constexpr Matrix4 scale(const Vector3& scale) const;
 	constexpr Matrix4 rotate(const Vector3& axis, f32 angle) const;
+	constexpr Matrix4 transpose() const;
+	// Identity for singular matrices
 	constexpr Matrix4 inverse() const;
 
 	friend Formatter<Matrix4>;
 
-	const f32& operator[](u64 index) const {
+	constexpr const f32& operator[](u64 index) const {
 		return m[index];
 	}
 
-	f32& operator[](u64 index) {
+	constexpr f32& operator[](u64 index) {
 		return m[index];
 	}
 
+	constexpr const f32* data() const {
+		return m;
+	}
+
 private:
-	Array<f32, 16> m{};
+	f32 m[16]{};
 };
 
 constexpr Matrix4::Matrix4() {
@@ -80,6 +238,13 @@ constexpr Matrix4& Matrix4::operator*=(const Matrix4& other) {
 constexpr Matrix4 Matrix4::operator*(const Matrix4& other) const {
 	Matrix4 result;
 
+#if defined(TK_MATH_X86)
+	if !consteval {
+		detail::matrix4_multiply(m, other.m, result.m);
+		return result;
+	}
+#endif
+
 	for (u32 col = 0; col < 4; col++) {
 		for (u32 row = 0; row < 4; row++) {
 			f32 sum = 0.0f;
@@ -93,6 +258,30 @@ constexpr Matrix4 Matrix4::operator*(const Matrix4& other) const {
 	return result;
 }
 
+constexpr Vector4 Matrix4::operator*(const Vector4& vector) const {
+#if defined(TK_MATH_X86)
+	if !consteval {
+		Vector4 result;
+		_mm_store_ps(&result.x, detail::matrix4_transform(m, vector.x, vector.y, vector.z, vector.w));
+		return result;
+	}
+#endif
+
+	return Vector4(
+		m[0] * vector.x + m[4] * vector.y + m[8] * vector.z + m[12] * vector.w,
+		m[1] * vector.x + m[5] * vector.y + m[9] * vector.z + m[13] * vector.w,
+		m[2] * vector.x + m[6] * vector.y + m[10] * vector.z + m[14] * vector.w,
+		m[3] * vector.x + m[7] * vector.y + m[11] * vector.z + m[15] * vector.w);
+}
+
+constexpr Vector3 Matrix4::transform_point(const Vector3& point) const {
+	return (*this * Vector4(point, 1.0f)).xyz();
+}
+
+constexpr Vector3 Matrix4::transform_direction(const Vector3& direction) const {
+	return (*this * Vector4(direction, 0.0f)).xyz();
+}
+
 constexpr Matrix4 Matrix4::translate(const Vector3& position) const {
 	Matrix4 temp;
 	temp.m[12] = position.x;
@@ -145,9 +334,36 @@ constexpr Matrix4 Matrix4::rotate(const Vector3& axis, f32 angle) const {
 					   0.0f,
 					   1.0f);
 }
+
+constexpr Matrix4 Matrix4::transpose() const {
+	Matrix4 result;
+
+#if defined(TK_MATH_X86)
+	if !consteval {
+		detail::matrix4_transpose(m, result.m);
+		return result;
+	}
+#endif
+
+	for (u32 col = 0; col < 4; col++) {
+		for (u32 row = 0; row < 4; row++) {
+			result.m[row * 4 + col] = m[col * 4 + row];
+		}
+	}
+
+	return result;
+}
+
 constexpr Matrix4 Matrix4::inverse() const {
 	Matrix4 inv;
 
+#if defined(TK_MATH_X86)
+	if !consteval {
+		detail::matrix4_inverse(m, inv.m);
+		return inv;
+	}
+#endif
+
 	inv.m[0] = m[5] * m[10] * m[15] - m[5] * m[11] * m[14] - m[9] * m[6] * m[15] + m[9] * m[7] * m[14] +
 			   m[13] * m[6] * m[11] - m[13] * m[7] * m[10];
 
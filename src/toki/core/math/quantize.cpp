@@ -0,0 +1,214 @@
+#include "toki/core/math/quantize.h"
+
+#include <toki/core/math/simd.h>
+
+namespace toki {
+
+#if defined(TK_MATH_X86)
+
+static b8 has_f16c() {
+	static const b8 supported = __builtin_cpu_supports("f16c");
+	return supported;
+}
+
+// 4 vectors are 3 groups of 4 floats, (x0 y0 z0 x1) (y1 z1 x2 y2) (z2 x3 y3 z3)
+static inline void load_aos4(const Vector3* vectors, __m128& x, __m128& y, __m128& z) {
+	const f32* f = &vectors->x;
+	__m128 m0	 = _mm_loadu_ps(f);
+	__m128 m1	 = _mm_loadu_ps(f + 4);
+	__m128 m2	 = _mm_loadu_ps(f + 8);
+
+	// Pairs of the components that are not in the first register yet, then one shuffle each
+	__m128 x23 = _mm_shuffle_ps(m1, m2, _MM_SHUFFLE(1, 1, 2, 2));
+	__m128 y01 = _mm_shuffle_ps(m0, m1, _MM_SHUFFLE(0, 0, 1, 1));
+	__m128 y23 = _mm_shuffle_ps(m1, m2, _MM_SHUFFLE(2, 2, 3, 3));
+	__m128 z01 = _mm_shuffle_ps(m0, m1, _MM_SHUFFLE(1, 1, 2, 2));
+	__m128 z23 = _mm_shuffle_ps(m2, m2, _MM_SHUFFLE(3, 0, 3, 0));
+	x		   = _mm_shuffle_ps(m0, x23, _MM_SHUFFLE(2, 0, 3, 0));
+	y		   = _mm_shuffle_ps(y01, y23, _MM_SHUFFLE(2, 0, 2, 0));
+	z		   = _mm_shuffle_ps(z01, z23, _MM_SHUFFLE(1, 0, 2, 0));
+}
+
+static inline __m128 sign_not_zero4(__m128 value) {
+	__m128 non_negative = _mm_cmpge_ps(value, _mm_setzero_ps());
+	return _mm_or_ps(_mm_and_ps(non_negative, _mm_set1_ps(1.0f)), _mm_andnot_ps(non_negative, _mm_set1_ps(-1.0f)));
+}
+
+static inline __m128 abs4(__m128 value) {
+	return _mm_andnot_ps(_mm_set1_ps(-0.0f), value);
+}
+
+// Same operations as quantize_snorm, truncation after adding half rounds away from zero
+static inline __m128i quantize_snorm4(__m128 value, f32 max_value) {
+	__m128 clamped = _mm_min_ps(_mm_max_ps(value, _mm_set1_ps(-1.0f)), _mm_set1_ps(1.0f));
+	__m128 half	   = _mm_mul_ps(sign_not_zero4(clamped), _mm_set1_ps(0.5f));
+	return _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(clamped, _mm_set1_ps(max_value)), half));
+}
+
+// Rounds to nearest even through the same bit tricks as f32_to_f16, the results are sign
+// extended to 32 bits so two of them pack into 8 halves with signed saturation
+static inline __m128i f32_to_f16_4(__m128 value) {
+	const __m128i f16_overflow	  = _mm_set1_epi32((127 + 16) << 23);
+	const __m128i f16_min_normal  = _mm_set1_epi32((127 - 14) << 23);
+	const __m128i subnormal_magic = _mm_set1_epi32(((127 - 15) + (23 - 10) + 1) << 23);
+	const __m128i normal_bias	  = _mm_set1_epi32(0xFFF - ((127 - 15) << 23));
+
+	__m128 sign		   = _mm_and_ps(value, _mm_set1_ps(-0.0f));
+	__m128 magnitude   = _mm_xor_ps(value, sign);
+	__m128i bits	   = _mm_castps_si128(magnitude);
+	__m128i is_nan	   = _mm_castps_si128(_mm_cmpunord_ps(magnitude, magnitude));
+	__m128i is_regular = _mm_cmpgt_epi32(f16_overflow, bits);
+	__m128i special	   = _mm_or_si128(_mm_and_si128(is_nan, _mm_set1_epi32(0x200)), _mm_set1_epi32(0x7C00));
+
+	__m128i is_subnormal = _mm_cmpgt_epi32(f16_min_normal, bits);
+	__m128 shifted		 = _mm_add_ps(magnitude, _mm_castsi128_ps(subnormal_magic));
+	__m128i subnormal	 = _mm_sub_epi32(_mm_castps_si128(shifted), subnormal_magic);
+
+	__m128i mantissa_odd = _mm_srai_epi32(_mm_slli_epi32(bits, 31 - 13), 31);
+	__m128i normal		 = _mm_srli_epi32(_mm_sub_epi32(_mm_add_epi32(bits, normal_bias), mantissa_odd), 13);
+
+	__m128i finite = _mm_or_si128(_mm_and_si128(is_subnormal, subnormal), _mm_andnot_si128(is_subnormal, normal));
+	__m128i result = _mm_or_si128(_mm_and_si128(is_regular, finite), _mm_andnot_si128(is_regular, special));
+	return _mm_or_si128(result, _mm_srai_epi32(_mm_castps_si128(sign), 16));
+}
+
+// Halves zero extended to 32 bits, multiplying by 2^112 moves the exponent bias from 15 to 127
+// and renormalizes subnormals in one go
+static inline __m128 f16_to_f32_4(__m128i value) {
+	__m128 magic		  = _mm_castsi128_ps(_mm_set1_epi32((254 - 15) << 23));
+	__m128i magnitude	  = _mm_and_si128(value, _mm_set1_epi32(0x7FFF));
+	__m128i sign		  = _mm_slli_epi32(_mm_xor_si128(value, magnitude), 16);
+	__m128 scaled		  = _mm_mul_ps(_mm_castsi128_ps(_mm_slli_epi32(magnitude, 13)), magic);
+	__m128i is_inf_or_nan = _mm_cmpgt_epi32(magnitude, _mm_set1_epi32(0x7BFF));
+	__m128i exponent	  = _mm_and_si128(is_inf_or_nan, _mm_set1_epi32(255 << 23));
+	return _mm_or_ps(scaled, _mm_castsi128_ps(_mm_or_si128(sign, exponent)));
+}
+
+static u64 f32_to_f16_sse2(const f32* values, u16* values_out, u64 count) {
+	u64 i = 0;
+	for (; i + 8 <= count; i += 8) {
+		__m128i low	 = f32_to_f16_4(_mm_loadu_ps(values + i));
+		__m128i high = f32_to_f16_4(_mm_loadu_ps(values + i + 4));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(values_out + i), _mm_packs_epi32(low, high));
+	}
+	return i;
+}
+
+static u64 f16_to_f32_sse2(const u16* values, f32* values_out, u64 count) {
+	u64 i = 0;
+	for (; i + 8 <= count; i += 8) {
+		__m128i halves = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i));
+		_mm_storeu_ps(values_out + i, f16_to_f32_4(_mm_unpacklo_epi16(halves, _mm_setzero_si128())));
+		_mm_storeu_ps(values_out + i + 4, f16_to_f32_4(_mm_unpackhi_epi16(halves, _mm_setzero_si128())));
+	}
+	return i;
+}
+
+__attribute__((target("f16c"))) static u64 f32_to_f16_f16c(const f32* values, u16* values_out, u64 count) {
+	u64 i = 0;
+	for (; i + 8 <= count; i += 8) {
+		__m128i low	 = _mm_cvtps_ph(_mm_loadu_ps(values + i), _MM_FROUND_TO_NEAREST_INT);
+		__m128i high = _mm_cvtps_ph(_mm_loadu_ps(values + i + 4), _MM_FROUND_TO_NEAREST_INT);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(values_out + i), _mm_unpacklo_epi64(low, high));
+	}
+	return i;
+}
+
+__attribute__((target("f16c"))) static u64 f16_to_f32_f16c(const u16* values, f32* values_out, u64 count) {
+	u64 i = 0;
+	for (; i + 8 <= count; i += 8) {
+		__m128i halves = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i));
+		_mm_storeu_ps(values_out + i, _mm_cvtph_ps(halves));
+		_mm_storeu_ps(values_out + i + 4, _mm_cvtph_ps(_mm_unpackhi_epi64(halves, halves)));
+	}
+	return i;
+}
+
+static u64 encode_octahedral_sse2(const Vector3* normals, i16* encoded_out, u64 count) {
+	u64 i = 0;
+	for (; i + 4 <= count; i += 4) {
+		__m128 x, y, z;
+		load_aos4(normals + i, x, y, z);
+
+		__m128 sum		= _mm_add_ps(_mm_add_ps(abs4(x), abs4(y)), abs4(z));
+		__m128 non_zero = _mm_cmpgt_ps(sum, _mm_setzero_ps());
+		x				= _mm_and_ps(non_zero, _mm_div_ps(x, sum));
+		y				= _mm_and_ps(non_zero, _mm_div_ps(y, sum));
+
+		__m128 one		= _mm_set1_ps(1.0f);
+		__m128 folded_x = _mm_mul_ps(_mm_sub_ps(one, abs4(y)), sign_not_zero4(x));
+		__m128 folded_y = _mm_mul_ps(_mm_sub_ps(one, abs4(x)), sign_not_zero4(y));
+		__m128 fold		= _mm_cmplt_ps(z, _mm_setzero_ps());
+		x				= _mm_or_ps(_mm_and_ps(fold, folded_x), _mm_andnot_ps(fold, x));
+		y				= _mm_or_ps(_mm_and_ps(fold, folded_y), _mm_andnot_ps(fold, y));
+
+		__m128i qx = quantize_snorm4(x, 32767.0f);
+		__m128i qy = quantize_snorm4(y, 32767.0f);
+		_mm_storeu_si128(
+			reinterpret_cast<__m128i*>(encoded_out + i * 2),
+			_mm_packs_epi32(_mm_unpacklo_epi32(qx, qy), _mm_unpackhi_epi32(qx, qy)));
+	}
+	return i;
+}
+
+static u64 pack_normals_sse2(const Vector3* normals, u32* packed_out, u64 count) {
+	const __m128i field_mask = _mm_set1_epi32(0x3FF);
+
+	u64 i = 0;
+	for (; i + 4 <= count; i += 4) {
+		__m128 x, y, z;
+		load_aos4(normals + i, x, y, z);
+		__m128i qx	   = _mm_and_si128(quantize_snorm4(x, 511.0f), field_mask);
+		__m128i qy	   = _mm_and_si128(quantize_snorm4(y, 511.0f), field_mask);
+		__m128i qz	   = _mm_and_si128(quantize_snorm4(z, 511.0f), field_mask);
+		__m128i packed = _mm_or_si128(_mm_or_si128(qx, _mm_slli_epi32(qy, 10)), _mm_slli_epi32(qz, 20));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(packed_out + i), packed);
+	}
+	return i;
+}
+
+#endif
+
+void f32_to_f16_many(Span<f32> values, u16* values_out) {
+	u64 done = 0;
+#if defined(TK_MATH_X86)
+	done = has_f16c() ? f32_to_f16_f16c(values.data(), values_out, values.size())
+					  : f32_to_f16_sse2(values.data(), values_out, values.size());
+#endif
+	for (u64 i = done; i < values.size(); i++) {
+		values_out[i] = f32_to_f16(values[i]);
+	}
+}
+
+void f16_to_f32_many(Span<u16> values, f32* values_out) {
+	u64 done = 0;
+#if defined(TK_MATH_X86)
+	done = has_f16c() ? f16_to_f32_f16c(values.data(), values_out, values.size())
+					  : f16_to_f32_sse2(values.data(), values_out, values.size());
+#endif
+	for (u64 i = done; i < values.size(); i++) {
+		values_out[i] = f16_to_f32(values[i]);
+	}
+}
+
+void encode_octahedral_many(Span<Vector3> normals, i16* encoded_out) {
+	u64 done = 0;
+#if defined(TK_MATH_X86)
+	done = encode_octahedral_sse2(normals.data(), encoded_out, normals.size());
+#endif
+	for (u64 i = done; i < normals.size(); i++) {
+		encode_octahedral(normals[i], encoded_out + i * 2);
+	}
+}
+
+void pack_normals_10_10_10_2(Span<Vector3> normals, u32* packed_out) {
+	u64 done = 0;
+#if defined(TK_MATH_X86)
+	done = pack_normals_sse2(normals.data(), packed_out, normals.size());
+#endif
+	for (u64 i = done; i < normals.size(); i++) {
+		packed_out[i] = pack_snorm_10_10_10_2(Vector4(normals[i], 0.0f));
+	}
+}
+
+}  // namespace toki
@@ -0,0 +1,177 @@
+#pragma once
+
+#include <toki/core/math/math.h>
+#include <toki/core/math/vector3.h>
+#include <toki/core/math/vector4.h>
+#include <toki/core/string/span.h>
+#include <toki/core/types.h>
+
+namespace toki {
+
+// Conversions into the compact vertex attribute formats, used when cooking meshes. The scalar
+// versions are constexpr and the *_many versions convert whole arrays with SSE2, halves use F16C
+// when the CPU has it. Both give the same results apart from NaN payloads.
+
+// Round to nearest even like the hardware conversion, values past the half range become infinity
+// and NaN stays NaN
+constexpr u16 f32_to_f16(f32 value) {
+	constexpr u32 F16_OVERFLOW	  = (127 + 16) << 23;
+	constexpr u32 F16_MIN_NORMAL  = (127 - 14) << 23;
+	constexpr u32 SUBNORMAL_MAGIC = ((127 - 15) + (23 - 10) + 1) << 23;
+
+	u32 bits = __builtin_bit_cast(u32, value);
+	u32 sign = bits & 0x80000000u;
+	bits	^= sign;
+
+	u32 result = 0;
+	if (bits >= F16_OVERFLOW) {
+		result = bits > 0x7F800000u ? 0x7E00u : 0x7C00u;
+	} else if (bits < F16_MIN_NORMAL) {
+		// Adding the magic number lets the float unit round the mantissa into the low bits
+		f32 shifted = __builtin_bit_cast(f32, bits) + __builtin_bit_cast(f32, SUBNORMAL_MAGIC);
+		result		= __builtin_bit_cast(u32, shifted) - SUBNORMAL_MAGIC;
+	} else {
+		u32 mantissa_odd = (bits >> 13) & 1;
+		bits			+= (static_cast<u32>(15 - 127) << 23) + 0xFFFu + mantissa_odd;
+		result			 = bits >> 13;
+	}
+	return static_cast<u16>(result | (sign >> 16));
+}
+
+constexpr f32 f16_to_f32(u16 value) {
+	constexpr u32 SHIFTED_EXPONENT = 0x7C00u << 13;
+
+	u32 bits	 = static_cast<u32>(value & 0x7FFFu) << 13;
+	u32 exponent = bits & SHIFTED_EXPONENT;
+	bits		+= (127 - 15) << 23;
+	if (exponent == SHIFTED_EXPONENT) {
+		bits += (128 - 16) << 23;
+	} else if (exponent == 0) {
+		// Subnormal, renormalized by the float unit
+		bits	 += 1 << 23;
+		f32 magic = __builtin_bit_cast(f32, static_cast<u32>(113) << 23);
+		bits	  = __builtin_bit_cast(u32, __builtin_bit_cast(f32, bits) - magic);
+	}
+	return __builtin_bit_cast(f32, bits | static_cast<u32>(value & 0x8000u) << 16);
+}
+
+// Clamped to [-1, 1] or [0, 1] and rounded half away from zero, snorm decodes with
+// max(value / max, -1) so the most negative value is -1 as well
+
+constexpr i32 quantize_snorm(f32 value, i32 max_value) {
+	f32 clamped = toki::clamp(value, -1.0f, 1.0f);
+	return static_cast<i32>(clamped * static_cast<f32>(max_value) + (clamped >= 0.0f ? 0.5f : -0.5f));
+}
+
+constexpr u32 quantize_unorm(f32 value, u32 max_value) {
+	return static_cast<u32>(toki::clamp(value, 0.0f, 1.0f) * static_cast<f32>(max_value) + 0.5f);
+}
+
+constexpr f32 dequantize_snorm(i32 value, i32 max_value) {
+	return toki::max(static_cast<f32>(value) / static_cast<f32>(max_value), -1.0f);
+}
+
+constexpr f32 dequantize_unorm(u32 value, u32 max_value) {
+	return static_cast<f32>(value) / static_cast<f32>(max_value);
+}
+
+constexpr i8 quantize_snorm8(f32 value) {
+	return static_cast<i8>(quantize_snorm(value, 127));
+}
+
+constexpr u8 quantize_unorm8(f32 value) {
+	return static_cast<u8>(quantize_unorm(value, 255));
+}
+
+constexpr i16 quantize_snorm16(f32 value) {
+	return static_cast<i16>(quantize_snorm(value, 32767));
+}
+
+constexpr u16 quantize_unorm16(f32 value) {
+	return static_cast<u16>(quantize_unorm(value, 65535));
+}
+
+// Red in the low bits and alpha in the top two, the A2B10G10R10 layout of the packed vertex
+// formats
+constexpr u32 pack_snorm_10_10_10_2(const Vector4& value) {
+	return (static_cast<u32>(quantize_snorm(value.x, 511)) & 0x3FFu) |
+		   (static_cast<u32>(quantize_snorm(value.y, 511)) & 0x3FFu) << 10 |
+		   (static_cast<u32>(quantize_snorm(value.z, 511)) & 0x3FFu) << 20 |
+		   static_cast<u32>(quantize_snorm(value.w, 1)) << 30;
+}
+
+constexpr u32 pack_unorm_10_10_10_2(const Vector4& value) {
+	return quantize_unorm(value.x, 1023) | quantize_unorm(value.y, 1023) << 10 | quantize_unorm(value.z, 1023) << 20 |
+		   quantize_unorm(value.w, 3) << 30;
+}
+
+constexpr Vector4 unpack_snorm_10_10_10_2(u32 packed) {
+	// Shifting the field to the top and back sign extends it
+	auto field = [packed](u32 shift, u32 bits) {
+		return static_cast<i32>(packed << (32 - shift - bits)) >> (32 - bits);
+	};
+	return Vector4(
+		dequantize_snorm(field(0, 10), 511),
+		dequantize_snorm(field(10, 10), 511),
+		dequantize_snorm(field(20, 10), 511),
+		dequantize_snorm(field(30, 2), 1));
+}
+
+constexpr Vector4 unpack_unorm_10_10_10_2(u32 packed) {
+	return Vector4(
+		dequantize_unorm(packed & 0x3FFu, 1023),
+		dequantize_unorm(packed >> 10 & 0x3FFu, 1023),
+		dequantize_unorm(packed >> 20 & 0x3FFu, 1023),
+		dequantize_unorm(packed >> 30, 3));
+}
+
+// Projects the unit sphere onto an octahedron and unfolds it into a square, keeps the error
+// roughly uniform over all directions unlike storing two components. Two snorm16 values.
+constexpr void encode_octahedral(const Vector3& normal, i16 encoded_out[2]) {
+	auto sign_not_zero = [](f32 value) {
+		return value >= 0.0f ? 1.0f : -1.0f;
+	};
+
+	f32 sum = toki::abs(normal.x) + toki::abs(normal.y) + toki::abs(normal.z);
+	f32 x	= sum > 0.0f ? normal.x / sum : 0.0f;
+	f32 y	= sum > 0.0f ? normal.y / sum : 0.0f;
+	if (normal.z < 0.0f) {
+		f32 folded_x = (1.0f - toki::abs(y)) * sign_not_zero(x);
+		f32 folded_y = (1.0f - toki::abs(x)) * sign_not_zero(y);
+		x			 = folded_x;
+		y			 = folded_y;
+	}
+
+	encoded_out[0] = quantize_snorm16(x);
+	encoded_out[1] = quantize_snorm16(y);
+}
+
+constexpr Vector3 decode_octahedral(const i16 encoded[2]) {
+	auto sign_not_zero = [](f32 value) {
+		return value >= 0.0f ? 1.0f : -1.0f;
+	};
+
+	f32 x = dequantize_snorm(encoded[0], 32767);
+	f32 y = dequantize_snorm(encoded[1], 32767);
+	f32 z = 1.0f - toki::abs(x) - toki::abs(y);
+	if (z < 0.0f) {
+		f32 unfolded_x = (1.0f - toki::abs(y)) * sign_not_zero(x);
+		f32 unfolded_y = (1.0f - toki::abs(x)) * sign_not_zero(y);
+		x			   = unfolded_x;
+		y			   = unfolded_y;
+	}
+
+	Vector3 normal(x, y, z);
+	return normal.length_squared() > 0.0f ? normal.normalize() : normal;
+}
+
+void f32_to_f16_many(Span<f32> values, u16* values_out);
+void f16_to_f32_many(Span<u16> values, f32* values_out);
+
+// Two i16 per normal in encoded_out
+void encode_octahedral_many(Span<Vector3> normals, i16* encoded_out);
+
+// Normals with alpha 0, normalized by the vertex shader after the hardware unpacks them
+void pack_normals_10_10_10_2(Span<Vector3> normals, u32* packed_out);
+
+}  // namespace toki
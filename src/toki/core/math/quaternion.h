@@ -0,0 +1,224 @@
+#pragma once
+
+#include <toki/core/math/math.h>
+#include <toki/core/math/matrix4.h>
+#include <toki/core/math/simd.h>
+#include <toki/core/math/transcendental.h>
+#include <toki/core/math/vector3.h>
+#include <toki/core/string/basic_string.h>
+#include <toki/core/types.h>
+#include <toki/core/utils/format.h>
+#include <toki/core/utils/string_formatters.h>
+
+namespace toki {
+
+// Rotation as a unit quaternion, (x, y, z) is the axis scaled by the sine of half the angle and w
+// the cosine of it. Composing two rotations is 16 multiplies instead of the 64 of a Matrix4
+// product. Like Matrix4 it is scalar at compile time and uses SSE at run time.
+class alignas(16) Quaternion {
+public:
+	constexpr Quaternion() = default;
+	constexpr Quaternion(f32 x_value, f32 y_value, f32 z_value, f32 w_value):
+		x(x_value),
+		y(y_value),
+		z(z_value),
+		w(w_value) {}
+
+	// Angle in radians, counter clockwise around the axis like Matrix4::rotate
+	static constexpr Quaternion from_axis_angle(const Vector3& axis, f32 angle);
+	// Rotation part of a matrix without scale
+	static constexpr Quaternion from_matrix(const Matrix4& matrix);
+
+	constexpr b8 operator==(const Quaternion&) const = default;
+
+	// Applies other first and then this rotation
+	constexpr Quaternion operator*(const Quaternion& other) const;
+	constexpr Quaternion& operator*=(const Quaternion& other);
+
+	constexpr f32 dot(const Quaternion& other) const;
+	constexpr f32 length() const;
+	constexpr Quaternion normalize() const;
+	// Inverse of a unit quaternion
+	constexpr Quaternion conjugate() const;
+
+	constexpr Vector3 rotate(const Vector3& vector) const;
+	constexpr Matrix4 to_matrix() const;
+
+public:
+	f32 x{}, y{}, z{}, w{ 1.0f };
+};
+
+constexpr Quaternion Quaternion::from_axis_angle(const Vector3& axis, f32 angle) {
+	Vector3 a = axis.normalize();
+	f32 s	  = toki::sin(angle * 0.5f);
+	return Quaternion(a.x * s, a.y * s, a.z * s, toki::cos(angle * 0.5f));
+}
+
+constexpr Quaternion Quaternion::from_matrix(const Matrix4& matrix) {
+	// Element (row, col), the largest of w, x, y and z is computed first so the divisions are
+	// by a value far from zero
+	auto m = [&matrix](u32 row, u32 col) {
+		return matrix[col * 4 + row];
+	};
+
+	f32 trace = m(0, 0) + m(1, 1) + m(2, 2);
+	if (trace > 0.0f) {
+		f32 s = static_cast<f32>(toki::sqrt(trace + 1.0f)) * 2.0f;
+		return Quaternion((m(2, 1) - m(1, 2)) / s, (m(0, 2) - m(2, 0)) / s, (m(1, 0) - m(0, 1)) / s, 0.25f * s);
+	}
+	if (m(0, 0) > m(1, 1) && m(0, 0) > m(2, 2)) {
+		f32 s = static_cast<f32>(toki::sqrt(1.0f + m(0, 0) - m(1, 1) - m(2, 2))) * 2.0f;
+		return Quaternion(0.25f * s, (m(0, 1) + m(1, 0)) / s, (m(0, 2) + m(2, 0)) / s, (m(2, 1) - m(1, 2)) / s);
+	}
+	if (m(1, 1) > m(2, 2)) {
+		f32 s = static_cast<f32>(toki::sqrt(1.0f + m(1, 1) - m(0, 0) - m(2, 2))) * 2.0f;
+		return Quaternion((m(0, 1) + m(1, 0)) / s, 0.25f * s, (m(1, 2) + m(2, 1)) / s, (m(0, 2) - m(2, 0)) / s);
+	}
+	f32 s = static_cast<f32>(toki::sqrt(1.0f + m(2, 2) - m(0, 0) - m(1, 1))) * 2.0f;
+	return Quaternion((m(0, 2) + m(2, 0)) / s, (m(1, 2) + m(2, 1)) / s, 0.25f * s, (m(1, 0) - m(0, 1)) / s);
+}
+
+constexpr Quaternion Quaternion::operator*(const Quaternion& other) const {
+#if defined(TK_MATH_X86)
+	if !consteval {
+		// this.w * other plus this.x, this.y and this.z times other shuffled and negated so the
+		// four products line up with the components of the result
+		__m128 b = _mm_setr_ps(other.x, other.y, other.z, other.w);
+		__m128 b_wzyx =
+			_mm_mul_ps(_mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 1, 2, 3)), _mm_setr_ps(1.0f, -1.0f, 1.0f, -1.0f));
+		__m128 b_zwxy =
+			_mm_mul_ps(_mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 0, 3, 2)), _mm_setr_ps(1.0f, 1.0f, -1.0f, -1.0f));
+		__m128 b_yxwz =
+			_mm_mul_ps(_mm_shuffle_ps(b, b, _MM_SHUFFLE(2, 3, 0, 1)), _mm_setr_ps(-1.0f, 1.0f, 1.0f, -1.0f));
+
+		__m128 r = _mm_mul_ps(_mm_set1_ps(w), b);
+		r		 = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(x), b_wzyx));
+		r		 = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(y), b_zwxy));
+		r		 = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(z), b_yxwz));
+
+		Quaternion result;
+		_mm_store_ps(&result.x, r);
+		return result;
+	}
+#endif
+
+	return Quaternion(
+		w * other.x + x * other.w + y * other.z - z * other.y,
+		w * other.y - x * other.z + y * other.w + z * other.x,
+		w * other.z + x * other.y - y * other.x + z * other.w,
+		w * other.w - x * other.x - y * other.y - z * other.z);
+}
+
+constexpr Quaternion& Quaternion::operator*=(const Quaternion& other) {
+	*this = *this * other;
+	return *this;
+}
+
+constexpr f32 Quaternion::dot(const Quaternion& other) const {
+	return x * other.x + y * other.y + z * other.z + w * other.w;
+}
+
+constexpr f32 Quaternion::length() const {
+	return static_cast<f32>(toki::sqrt(dot(*this)));
+}
+
+constexpr Quaternion Quaternion::normalize() const {
+	f32 inverse_length = 1.0f / length();
+	return Quaternion(x * inverse_length, y * inverse_length, z * inverse_length, w * inverse_length);
+}
+
+constexpr Quaternion Quaternion::conjugate() const {
+	return Quaternion(-x, -y, -z, w);
+}
+
+constexpr Vector3 Quaternion::rotate(const Vector3& vector) const {
+	// v + w * t + u x t with u = (x, y, z) and t = 2 * u x v, cheaper than q * v * q^-1
+	Vector3 u(x, y, z);
+	Vector3 t = u.cross(vector) * 2.0f;
+	return vector + t * w + u.cross(t);
+}
+
+constexpr Matrix4 Quaternion::to_matrix() const {
+	f32 xx = x * x, yy = y * y, zz = z * z;
+	f32 xy = x * y, xz = x * z, yz = y * z;
+	f32 wx = w * x, wy = w * y, wz = w * z;
+
+	return Matrix4(
+		1.0f - 2.0f * (yy + zz),
+		2.0f * (xy + wz),
+		2.0f * (xz - wy),
+		0.0f,
+		2.0f * (xy - wz),
+		1.0f - 2.0f * (xx + zz),
+		2.0f * (yz + wx),
+		0.0f,
+		2.0f * (xz + wy),
+		2.0f * (yz - wx),
+		1.0f - 2.0f * (xx + yy),
+		0.0f,
+		0.0f,
+		0.0f,
+		0.0f,
+		1.0f);
+}
+
+// Normalized linear interpolation, constant speed is lost for large angles but it is a handful of
+// multiplies. Takes the shorter path.
+constexpr Quaternion nlerp(const Quaternion& from, const Quaternion& to, f32 t) {
+	f32 sign = from.dot(to) < 0.0f ? -1.0f : 1.0f;
+	f32 s	 = 1.0f - t;
+	Quaternion result(
+		from.x * s + to.x * t * sign,
+		from.y * s + to.y * t * sign,
+		from.z * s + to.z * t * sign,
+		from.w * s + to.w * t * sign);
+	return result.normalize();
+}
+
+// Spherical linear interpolation at constant angular speed, takes the shorter path. Nearly equal
+// rotations go through nlerp where the sine of the angle gets too small to divide by.
+constexpr Quaternion slerp(const Quaternion& from, const Quaternion& to, f32 t) {
+	f32 cos_angle = from.dot(to);
+	f32 sign	  = 1.0f;
+	if (cos_angle < 0.0f) {
+		cos_angle = -cos_angle;
+		sign	  = -1.0f;
+	}
+	if (cos_angle > 0.9995f) {
+		return nlerp(from, to, t);
+	}
+
+	f32 angle		 = toki::acos(cos_angle);
+	f32 inverse_sine = 1.0f / toki::sin(angle);
+	f32 from_weight	 = toki::sin((1.0f - t) * angle) * inverse_sine;
+	f32 to_weight	 = toki::sin(t * angle) * inverse_sine * sign;
+	return Quaternion(
+		from.x * from_weight + to.x * to_weight,
+		from.y * from_weight + to.y * to_weight,
+		from.z * from_weight + to.z * to_weight,
+		from.w * from_weight + to.w * to_weight);
+}
+
+// Scale first, then rotation, then translation, the same as
+// Matrix4(translation) * rotation.to_matrix() * scale without the two matrix products
+constexpr Matrix4 compose_trs(const Vector3& translation, const Quaternion& rotation, const Vector3& scale) {
+	Matrix4 matrix = rotation.to_matrix();
+	for (u32 row = 0; row < 3; row++) {
+		matrix[0 * 4 + row] *= scale.x;
+		matrix[1 * 4 + row] *= scale.y;
+		matrix[2 * 4 + row] *= scale.z;
+	}
+	matrix[12] = translation.x;
+	matrix[13] = translation.y;
+	matrix[14] = translation.z;
+	return matrix;
+}
+
+template <CIsAllocator AllocatorType>
+struct Formatter<Quaternion, AllocatorType> {
+	static constexpr toki::String<AllocatorType> format(const Quaternion& quaternion) {
+		return toki::format("Quaternion [{} {} {} {}]", quaternion.x, quaternion.y, quaternion.z, quaternion.w);
+	}
+};
+
+}  // namespace toki
@@ -0,0 +1,16 @@
+#pragma once
+
+// Vector instructions used by the math types. SSE2 is part of x86_64 so it needs no runtime check,
+// AVX is only used when the compiler targets it, headers can't dispatch at runtime without
+// losing inlining.
+#if defined(__x86_64__) || defined(_M_X64)
+	#include <immintrin.h>
+	#define TK_MATH_X86
+	#if defined(__AVX__)
+		#define TK_MATH_AVX
+	#endif
+	// 8 wide integer operations, needed where the exponent bits of floats are manipulated
+	#if defined(__AVX2__)
+		#define TK_MATH_AVX2
+	#endif
+#endif
@@ -0,0 +1,112 @@
+#include "toki/core/math/transcendental.h"
+
+#include <toki/core/common/assert.h>
+
+namespace toki {
+
+#if defined(TK_MATH_AVX2)
+using WideLanes = __m256;
+#elif defined(TK_MATH_X86)
+using WideLanes = __m128;
+#else
+using WideLanes = f32;
+#endif
+
+static constexpr u64 WIDTH = sizeof(WideLanes) / sizeof(f32);
+
+// function is called with WideLanes for whole groups and with f32 for the tail
+PUSH_WARNING
+DISABLE_IGNORED_ATTRIBUTES
+
+template <typename Function>
+static void apply_many(Span<f32> values, f32* values_out, Function&& function) {
+	using L = detail::Lanes<WideLanes>;
+	u64 i	= 0;
+	for (; i + WIDTH <= values.size(); i += WIDTH) {
+		L::store(values_out + i, function(L::load(values.data() + i)));
+	}
+	for (; i < values.size(); i++) {
+		values_out[i] = function(values[i]);
+	}
+}
+
+template <typename Function>
+static void apply_many(Span<f32> lhs, Span<f32> rhs, f32* values_out, Function&& function) {
+	TK_ASSERT(lhs.size() == rhs.size());
+	using L = detail::Lanes<WideLanes>;
+	u64 i	= 0;
+	for (; i + WIDTH <= lhs.size(); i += WIDTH) {
+		L::store(values_out + i, function(L::load(lhs.data() + i), L::load(rhs.data() + i)));
+	}
+	for (; i < lhs.size(); i++) {
+		values_out[i] = function(lhs[i], rhs[i]);
+	}
+}
+
+POP_WARNING
+
+template <Accuracy ACCURACY>
+void sin_many(Span<f32> values, f32* values_out) {
+	apply_many(values, values_out, [](auto x) {
+		return sin<ACCURACY>(x);
+	});
+}
+
+template <Accuracy ACCURACY>
+void cos_many(Span<f32> values, f32* values_out) {
+	apply_many(values, values_out, [](auto x) {
+		return cos<ACCURACY>(x);
+	});
+}
+
+template <Accuracy ACCURACY>
+void tan_many(Span<f32> values, f32* values_out) {
+	apply_many(values, values_out, [](auto x) {
+		return tan<ACCURACY>(x);
+	});
+}
+
+template <Accuracy ACCURACY>
+void atan2_many(Span<f32> y, Span<f32> x, f32* values_out) {
+	apply_many(y, x, values_out, [](auto y_value, auto x_value) {
+		return atan2<ACCURACY>(y_value, x_value);
+	});
+}
+
+template <Accuracy ACCURACY>
+void exp_many(Span<f32> values, f32* values_out) {
+	apply_many(values, values_out, [](auto x) {
+		return exp<ACCURACY>(x);
+	});
+}
+
+template <Accuracy ACCURACY>
+void log_many(Span<f32> values, f32* values_out) {
+	apply_many(values, values_out, [](auto x) {
+		return log<ACCURACY>(x);
+	});
+}
+
+template <Accuracy ACCURACY>
+void pow_many(Span<f32> x, Span<f32> y, f32* values_out) {
+	apply_many(x, y, values_out, [](auto x_value, auto y_value) {
+		return pow<ACCURACY>(x_value, y_value);
+	});
+}
+
+template void sin_many<Accuracy::Fast>(Span<f32>, f32*);
+template void sin_many<Accuracy::Precise>(Span<f32>, f32*);
+template void cos_many<Accuracy::Fast>(Span<f32>, f32*);
+template void cos_many<Accuracy::Precise>(Span<f32>, f32*);
+template void tan_many<Accuracy::Fast>(Span<f32>, f32*);
+template void tan_many<Accuracy::Precise>(Span<f32>, f32*);
+template void atan2_many<Accuracy::Fast>(Span<f32>, Span<f32>, f32*);
+template void atan2_many<Accuracy::Precise>(Span<f32>, Span<f32>, f32*);
+template void exp_many<Accuracy::Fast>(Span<f32>, f32*);
+template void exp_many<Accuracy::Precise>(Span<f32>, f32*);
+template void log_many<Accuracy::Fast>(Span<f32>, f32*);
+template void log_many<Accuracy::Precise>(Span<f32>, f32*);
+template void pow_many<Accuracy::Fast>(Span<f32>, Span<f32>, f32*);
+template void pow_many<Accuracy::Precise>(Span<f32>, Span<f32>, f32*);
+
+}  // namespace toki
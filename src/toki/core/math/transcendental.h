@@ -0,0 +1,847 @@
+#pragma once
+
+#include <toki/core/attributes.h>
+#include <toki/core/common/defines.h>
+#include <toki/core/common/type_traits.h>
+#include <toki/core/math/math.h>
+#include <toki/core/math/simd.h>
+#include <toki/core/string/span.h>
+#include <toki/core/types.h>
+
+namespace toki {
+
+// Polynomial approximations of the elementary functions in f32. Each one is written once over a
+// lane type, the same code runs at compile time, on a single f32 and on __m128 (and __m256 when
+// the compiler targets AVX2) values.
+//
+// Fast stays within 1e-4 of the exact result, relative to it for exp and pow and for tan away from
+// its poles. Precise stays within 1 ulp for acos, exp and log and 3 ulp for tan, atan and atan2. sin
+// and cos are within 1 ulp for a few turns and within 1e-7 up to |x| of 8192, farther out the
+// angle reduction loses bits. Precise pow carries log(x) and its product with y in two f32 each
+// and stays within 2 ulp, also where y * log(x) nears the overflow threshold.
+//
+// Special values follow libm where it matters: NaN propagates, log(0) is -inf and exp overflows
+// to inf. sin, cos and tan of |x| past 2^22 are NaN, nothing of the angle is left in an f32 there.
+// Compile time evaluation is limited to finite results.
+enum struct Accuracy {
+	Fast,
+	Precise
+};
+
+namespace detail {
+
+// Operations the approximations need from a lane type. Masks are the result of comparisons and
+// select picks from a where the mask is set and from b elsewhere.
+template <typename V>
+struct Lanes;
+
+template <>
+struct Lanes<f32> {
+	using Mask = b8;
+	using Int  = i32;
+
+	static constexpr f32 splat(f32 value) {
+		return value;
+	}
+	static constexpr i32 splat_int(i32 value) {
+		return value;
+	}
+	static constexpr f32 load(const f32* values) {
+		return *values;
+	}
+	static constexpr void store(f32* values_out, f32 value) {
+		*values_out = value;
+	}
+
+	static constexpr f32 add(f32 a, f32 b) {
+		return a + b;
+	}
+	static constexpr f32 sub(f32 a, f32 b) {
+		return a - b;
+	}
+	static constexpr f32 mul(f32 a, f32 b) {
+		return a * b;
+	}
+	static constexpr f32 div(f32 a, f32 b) {
+		return a / b;
+	}
+	static constexpr f32 min(f32 a, f32 b) {
+		return a < b ? a : b;
+	}
+	static constexpr f32 max(f32 a, f32 b) {
+		return a > b ? a : b;
+	}
+	// Only called with values that are not negative
+	static constexpr f32 sqrt(f32 value) {
+		return static_cast<f32>(toki::sqrt(value));
+	}
+
+	static constexpr b8 less(f32 a, f32 b) {
+		return a < b;
+	}
+	static constexpr b8 less_equal(f32 a, f32 b) {
+		return a <= b;
+	}
+	static constexpr b8 equal(f32 a, f32 b) {
+		return a == b;
+	}
+	static constexpr b8 mask_and(b8 a, b8 b) {
+		return a && b;
+	}
+	static constexpr b8 mask_or(b8 a, b8 b) {
+		return a || b;
+	}
+	static constexpr b8 mask_not(b8 mask) {
+		return !mask;
+	}
+	static constexpr f32 select(b8 mask, f32 a, f32 b) {
+		return mask ? a : b;
+	}
+
+	static constexpr i32 to_int(f32 value) {
+		return static_cast<i32>(value);
+	}
+	static constexpr f32 to_float(i32 value) {
+		return static_cast<f32>(value);
+	}
+	static constexpr i32 int_add(i32 a, i32 b) {
+		return a + b;
+	}
+	static constexpr i32 int_sub(i32 a, i32 b) {
+		return a - b;
+	}
+	static constexpr i32 int_and(i32 a, i32 b) {
+		return a & b;
+	}
+	static constexpr i32 int_or(i32 a, i32 b) {
+		return a | b;
+	}
+	static constexpr i32 int_xor(i32 a, i32 b) {
+		return a ^ b;
+	}
+	template <u32 BITS>
+	static constexpr i32 shift_left(i32 value) {
+		return static_cast<i32>(static_cast<u32>(value) << BITS);
+	}
+	// Arithmetic, the sign is kept
+	template <u32 BITS>
+	static constexpr i32 shift_right(i32 value) {
+		return value >> BITS;
+	}
+	static constexpr b8 int_equal(i32 a, i32 b) {
+		return a == b;
+	}
+	static constexpr i32 as_int(f32 value) {
+		return __builtin_bit_cast(i32, value);
+	}
+	static constexpr f32 as_float(i32 value) {
+		return __builtin_bit_cast(f32, value);
+	}
+};
+
+PUSH_WARNING
+DISABLE_IGNORED_ATTRIBUTES
+
+#if defined(TK_MATH_X86)
+template <>
+struct Lanes<__m128> {
+	using Mask = __m128;
+	using Int  = __m128i;
+
+	static __m128 splat(f32 value) {
+		return _mm_set1_ps(value);
+	}
+	static __m128i splat_int(i32 value) {
+		return _mm_set1_epi32(value);
+	}
+	static __m128 load(const f32* values) {
+		return _mm_loadu_ps(values);
+	}
+	static void store(f32* values_out, __m128 value) {
+		_mm_storeu_ps(values_out, value);
+	}
+
+	static __m128 add(__m128 a, __m128 b) {
+		return _mm_add_ps(a, b);
+	}
+	static __m128 sub(__m128 a, __m128 b) {
+		return _mm_sub_ps(a, b);
+	}
+	static __m128 mul(__m128 a, __m128 b) {
+		return _mm_mul_ps(a, b);
+	}
+	static __m128 div(__m128 a, __m128 b) {
+		return _mm_div_ps(a, b);
+	}
+	static __m128 min(__m128 a, __m128 b) {
+		return _mm_min_ps(a, b);
+	}
+	static __m128 max(__m128 a, __m128 b) {
+		return _mm_max_ps(a, b);
+	}
+	static __m128 sqrt(__m128 value) {
+		return _mm_sqrt_ps(value);
+	}
+
+	static __m128 less(__m128 a, __m128 b) {
+		return _mm_cmplt_ps(a, b);
+	}
+	static __m128 less_equal(__m128 a, __m128 b) {
+		return _mm_cmple_ps(a, b);
+	}
+	static __m128 equal(__m128 a, __m128 b) {
+		return _mm_cmpeq_ps(a, b);
+	}
+	static __m128 mask_and(__m128 a, __m128 b) {
+		return _mm_and_ps(a, b);
+	}
+	static __m128 mask_or(__m128 a, __m128 b) {
+		return _mm_or_ps(a, b);
+	}
+	static __m128 mask_not(__m128 mask) {
+		return _mm_xor_ps(mask, _mm_castsi128_ps(_mm_set1_epi32(-1)));
+	}
+	// SSE2 has no blend
+	static __m128 select(__m128 mask, __m128 a, __m128 b) {
+		return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+	}
+
+	static __m128i to_int(__m128 value) {
+		return _mm_cvttps_epi32(value);
+	}
+	static __m128 to_float(__m128i value) {
+		return _mm_cvtepi32_ps(value);
+	}
+	static __m128i int_add(__m128i a, __m128i b) {
+		return _mm_add_epi32(a, b);
+	}
+	static __m128i int_sub(__m128i a, __m128i b) {
+		return _mm_sub_epi32(a, b);
+	}
+	static __m128i int_and(__m128i a, __m128i b) {
+		return _mm_and_si128(a, b);
+	}
+	static __m128i int_or(__m128i a, __m128i b) {
+		return _mm_or_si128(a, b);
+	}
+	static __m128i int_xor(__m128i a, __m128i b) {
+		return _mm_xor_si128(a, b);
+	}
+	template <u32 BITS>
+	static __m128i shift_left(__m128i value) {
+		return _mm_slli_epi32(value, BITS);
+	}
+	template <u32 BITS>
+	static __m128i shift_right(__m128i value) {
+		return _mm_srai_epi32(value, BITS);
+	}
+	static __m128 int_equal(__m128i a, __m128i b) {
+		return _mm_castsi128_ps(_mm_cmpeq_epi32(a, b));
+	}
+	static __m128i as_int(__m128 value) {
+		return _mm_castps_si128(value);
+	}
+	static __m128 as_float(__m128i value) {
+		return _mm_castsi128_ps(value);
+	}
+};
+#endif
+
+#if defined(TK_MATH_AVX2)
+template <>
+struct Lanes<__m256> {
+	using Mask = __m256;
+	using Int  = __m256i;
+
+	static __m256 splat(f32 value) {
+		return _mm256_set1_ps(value);
+	}
+	static __m256i splat_int(i32 value) {
+		return _mm256_set1_epi32(value);
+	}
+	static __m256 load(const f32* values) {
+		return _mm256_loadu_ps(values);
+	}
+	static void store(f32* values_out, __m256 value) {
+		_mm256_storeu_ps(values_out, value);
+	}
+
+	static __m256 add(__m256 a, __m256 b) {
+		return _mm256_add_ps(a, b);
+	}
+	static __m256 sub(__m256 a, __m256 b) {
+		return _mm256_sub_ps(a, b);
+	}
+	static __m256 mul(__m256 a, __m256 b) {
+		return _mm256_mul_ps(a, b);
+	}
+	static __m256 div(__m256 a, __m256 b) {
+		return _mm256_div_ps(a, b);
+	}
+	static __m256 min(__m256 a, __m256 b) {
+		return _mm256_min_ps(a, b);
+	}
+	static __m256 max(__m256 a, __m256 b) {
+		return _mm256_max_ps(a, b);
+	}
+	static __m256 sqrt(__m256 value) {
+		return _mm256_sqrt_ps(value);
+	}
+
+	static __m256 less(__m256 a, __m256 b) {
+		return _mm256_cmp_ps(a, b, _CMP_LT_OQ);
+	}
+	static __m256 less_equal(__m256 a, __m256 b) {
+		return _mm256_cmp_ps(a, b, _CMP_LE_OQ);
+	}
+	static __m256 equal(__m256 a, __m256 b) {
+		return _mm256_cmp_ps(a, b, _CMP_EQ_OQ);
+	}
+	static __m256 mask_and(__m256 a, __m256 b) {
+		return _mm256_and_ps(a, b);
+	}
+	static __m256 mask_or(__m256 a, __m256 b) {
+		return _mm256_or_ps(a, b);
+	}
+	static __m256 mask_not(__m256 mask) {
+		return _mm256_xor_ps(mask, _mm256_castsi256_ps(_mm256_set1_epi32(-1)));
+	}
+	static __m256 select(__m256 mask, __m256 a, __m256 b) {
+		return _mm256_blendv_ps(b, a, mask);
+	}
+
+	static __m256i to_int(__m256 value) {
+		return _mm256_cvttps_epi32(value);
+	}
+	static __m256 to_float(__m256i value) {
+		return _mm256_cvtepi32_ps(value);
+	}
+	static __m256i int_add(__m256i a, __m256i b) {
+		return _mm256_add_epi32(a, b);
+	}
+	static __m256i int_sub(__m256i a, __m256i b) {
+		return _mm256_sub_epi32(a, b);
+	}
+	static __m256i int_and(__m256i a, __m256i b) {
+		return _mm256_and_si256(a, b);
+	}
+	static __m256i int_or(__m256i a, __m256i b) {
+		return _mm256_or_si256(a, b);
+	}
+	static __m256i int_xor(__m256i a, __m256i b) {
+		return _mm256_xor_si256(a, b);
+	}
+	template <u32 BITS>
+	static __m256i shift_left(__m256i value) {
+		return _mm256_slli_epi32(value, BITS);
+	}
+	template <u32 BITS>
+	static __m256i shift_right(__m256i value) {
+		return _mm256_srai_epi32(value, BITS);
+	}
+	static __m256 int_equal(__m256i a, __m256i b) {
+		return _mm256_castsi256_ps(_mm256_cmpeq_epi32(a, b));
+	}
+	static __m256i as_int(__m256 value) {
+		return _mm256_castps_si256(value);
+	}
+	static __m256 as_float(__m256i value) {
+		return _mm256_castsi256_ps(value);
+	}
+};
+#endif
+
+POP_WARNING
+
+constexpr f32 F32_INFINITY = __builtin_inff();
+constexpr f32 F32_NAN	   = __builtin_nanf("");
+constexpr f32 HALF_PI_F32  = 1.57079632679489661923f;
+constexpr f32 PI_F32	   = 3.14159265358979323846f;
+
+// Evaluates the polynomial with the given coefficients, highest power first
+template <typename V, typename... Coefficients>
+constexpr V polynomial(V x, f32 highest, Coefficients... rest) {
+	using L	 = Lanes<V>;
+	V result = L::splat(highest);
+	((result = L::add(L::mul(result, x), L::splat(rest))), ...);
+	return result;
+}
+
+// Nearest integer, ties to even, for |value| below 2^22. Adding 1.5 * 2^23 leaves no bits below
+// the units so the float adder does the rounding.
+template <typename V>
+constexpr V round_nearest(V value) {
+	using L = Lanes<V>;
+	return L::sub(L::add(value, L::splat(12582912.0f)), L::splat(12582912.0f));
+}
+
+template <typename V>
+constexpr V abs(V value) {
+	using L = Lanes<V>;
+	return L::as_float(L::int_and(L::as_int(value), L::splat_int(0x7fffffff)));
+}
+
+template <typename V>
+constexpr typename Lanes<V>::Int sign_bit(V value) {
+	using L = Lanes<V>;
+	return L::int_and(L::as_int(value), L::splat_int(I32_MIN));
+}
+
+// Negates value where sign has its top bit set
+template <typename V>
+constexpr V flip_sign(V value, typename Lanes<V>::Int sign) {
+	using L = Lanes<V>;
+	return L::as_float(L::int_xor(L::as_int(value), sign));
+}
+
+template <typename V>
+constexpr typename Lanes<V>::Mask is_nan(V value) {
+	using L = Lanes<V>;
+	return L::mask_not(L::equal(value, value));
+}
+
+// value * 2^exponent for exponent in [-150, 128], in two steps so both the denormal results and
+// the ones that overflow come out right
+template <typename V>
+constexpr V scale_by_power_of_two(V value, typename Lanes<V>::Int exponent) {
+	using L		 = Lanes<V>;
+	auto half	 = L::template shift_right<1>(exponent);
+	auto rest	 = L::int_sub(exponent, half);
+	V half_scale = L::as_float(L::template shift_left<23>(L::int_add(half, L::splat_int(127))));
+	V rest_scale = L::as_float(L::template shift_left<23>(L::int_add(rest, L::splat_int(127))));
+	return L::mul(L::mul(value, half_scale), rest_scale);
+}
+
+// a + b = sum + error exactly
+template <typename V>
+constexpr V two_sum(V a, V b, V& error_out) {
+	using L	  = Lanes<V>;
+	V sum	  = L::add(a, b);
+	V b_part  = L::sub(sum, a);
+	error_out = L::add(L::sub(a, L::sub(sum, b_part)), L::sub(b, b_part));
+	return sum;
+}
+
+// a * b = product + error exactly for finite products that do not underflow. Both are split into
+// halves of 12 bits whose products are exact. The split masks bits instead of the usual multiply by
+// 4097 so contracting it into an FMA cannot break it.
+template <typename V>
+constexpr V two_product(V a, V b, V& error_out) {
+	using L	 = Lanes<V>;
+	V a_high = L::as_float(L::int_and(L::as_int(a), L::splat_int(~0xfff)));
+	V b_high = L::as_float(L::int_and(L::as_int(b), L::splat_int(~0xfff)));
+	V a_low	 = L::sub(a, a_high);
+	V b_low	 = L::sub(b, b_high);
+
+	V product = L::mul(a, b);
+	error_out = L::add(L::sub(L::mul(a_high, b_high), product), L::mul(a_high, b_low));
+	error_out = L::add(L::add(error_out, L::mul(a_low, b_high)), L::mul(a_low, b_low));
+	return product;
+}
+
+// x = r + quadrant * pi / 2 with r in [-pi / 4, pi / 4]. pi / 2 is split so the product of the
+// quadrant with the first part is exact, Precise splits the rest once more.
+template <Accuracy ACCURACY, typename V>
+constexpr V reduce_quadrant(V x, typename Lanes<V>::Int& quadrant_out) {
+	using L		 = Lanes<V>;
+	V quadrant	 = round_nearest(L::mul(x, L::splat(0.636619772367581343f)));
+	quadrant_out = L::to_int(quadrant);
+
+	x = L::sub(x, L::mul(quadrant, L::splat(1.5703125f)));
+	if constexpr (ACCURACY == Accuracy::Fast) {
+		return L::sub(x, L::mul(quadrant, L::splat(4.83826794896619231e-4f)));
+	} else {
+		x = L::sub(x, L::mul(quadrant, L::splat(4.837512969970703125e-4f)));
+		return L::sub(x, L::mul(quadrant, L::splat(7.54978995489188216e-8f)));
+	}
+}
+
+// sin and cos of r in [-pi / 4, pi / 4], z = r * r
+template <Accuracy ACCURACY, typename V>
+constexpr V sin_polynomial(V r, V z) {
+	using L = Lanes<V>;
+	if constexpr (ACCURACY == Accuracy::Fast) {
+		return L::add(r, L::mul(L::mul(r, z), polynomial(z, 8.15298775e-3f, -1.66628336e-1f)));
+	} else {
+		return L::add(
+			r, L::mul(L::mul(r, z), polynomial(z, -1.9515295891e-4f, 8.3321608736e-3f, -1.6666654611e-1f)));
+	}
+}
+
+template <Accuracy ACCURACY, typename V>
+constexpr V cos_polynomial(V z) {
+	using L = Lanes<V>;
+	if constexpr (ACCURACY == Accuracy::Fast) {
+		return L::add(L::splat(1.0f), L::mul(z, polynomial(z, 4.04889019e-2f, -4.99776294e-1f)));
+	} else {
+		V high_terms = L::mul(
+			L::mul(z, z), polynomial(z, 2.443315711809948e-5f, -1.388731625493765e-3f, 4.166664568298827e-2f));
+		return L::add(L::sub(L::splat(1.0f), L::mul(z, L::splat(0.5f))), high_terms);
+	}
+}
+
+// sin(x) for quadrant_offset 0 and cos(x) for 1, cos is sin a quarter turn ahead
+template <Accuracy ACCURACY, typename V>
+constexpr V sin_cos(V x, i32 quadrant_offset) {
+	using L					  = Lanes<V>;
+	typename L::Mask in_range = L::less_equal(abs(x), L::splat(4194304.0f));
+	x						  = L::select(in_range, x, L::splat(0.0f));
+
+	typename L::Int quadrant;
+	V r		 = reduce_quadrant<ACCURACY>(x, quadrant);
+	quadrant = L::int_add(quadrant, L::splat_int(quadrant_offset));
+	V z		 = L::mul(r, r);
+
+	// Odd quadrants take cos of r, quadrants 2 and 3 are negated
+	V result = L::select(
+		L::int_equal(L::int_and(quadrant, L::splat_int(1)), L::splat_int(1)),
+		cos_polynomial<ACCURACY>(z),
+		sin_polynomial<ACCURACY>(r, z));
+	result = flip_sign(result, L::template shift_left<30>(L::int_and(quadrant, L::splat_int(2))));
+	return L::select(in_range, result, L::splat(F32_NAN));
+}
+
+// atan(a) for a >= 0. Precise maps a past tan(3pi / 8) to -1 / a and a past tan(pi / 8) to
+// (a - 1) / (a + 1) so the polynomial only covers |t| <= tan(pi / 8). Fast maps a past 1 to 1 / a.
+template <Accuracy ACCURACY, typename V>
+constexpr V atan_positive(V a) {
+	using L = Lanes<V>;
+	if constexpr (ACCURACY == Accuracy::Fast) {
+		typename L::Mask inverted = L::less(L::splat(1.0f), a);
+		V t = L::div(L::select(inverted, L::splat(1.0f), a), L::select(inverted, a, L::splat(1.0f)));
+		V p = L::mul(t, polynomial(L::mul(t, t), 0.0208351f, -0.0851330f, 0.1801410f, -0.3302995f, 0.9998660f));
+		return L::select(inverted, L::sub(L::splat(HALF_PI_F32), p), p);
+	} else {
+		typename L::Mask large	= L::less(L::splat(2.414213562373095f), a);
+		typename L::Mask medium = L::less(L::splat(0.4142135623730950f), a);
+
+		V one		  = L::splat(1.0f);
+		V numerator	  = L::select(large, L::splat(-1.0f), L::select(medium, L::sub(a, one), a));
+		V denominator = L::select(large, a, L::select(medium, L::add(a, one), one));
+		V offset	  = L::select(medium, L::splat(0.785398163397448310f), L::splat(0.0f));
+		offset		  = L::select(large, L::splat(HALF_PI_F32), offset);
+
+		V t = L::div(numerator, denominator);
+		V z = L::mul(t, t);
+		V p = polynomial(z, 8.05374449538e-2f, -1.38776856032e-1f, 1.99777106478e-1f, -3.33329491539e-1f);
+		return L::add(offset, L::add(t, L::mul(L::mul(p, z), t)));
+	}
+}
+
+// x = (1 + t) * 2^e with 1 + t in [sqrt(0.5), sqrt(2)) for x > 0 and finite, t is exact
+template <typename V>
+constexpr V log_reduce(V x, V& e_out) {
+	using L = Lanes<V>;
+
+	// Denormals are scaled into the normal range first
+	typename L::Mask denormal = L::less(x, L::splat(1.17549435e-38f));
+	x						  = L::select(denormal, L::mul(x, L::splat(8388608.0f)), x);
+
+	auto bits = L::as_int(x);
+	V e		  = L::to_float(L::int_sub(L::template shift_right<23>(bits), L::splat_int(126)));
+	e		  = L::sub(e, L::select(denormal, L::splat(23.0f), L::splat(0.0f)));
+	V m		  = L::as_float(L::int_or(L::int_and(bits, L::splat_int(0x007fffff)), L::splat_int(0x3f000000)));
+
+	// m is in [0.5, 1) here
+	typename L::Mask small = L::less(m, L::splat(0.707106781186547524f));
+	e_out				   = L::sub(e, L::select(small, L::splat(1.0f), L::splat(0.0f)));
+	return L::sub(L::select(small, L::add(m, m), m), L::splat(1.0f));
+}
+
+// log(x) for x > 0 and finite. The polynomial is in t and e * ln(2) is added in two parts so the
+// large one is exact.
+template <Accuracy ACCURACY, typename V>
+constexpr V log_positive(V x) {
+	using L = Lanes<V>;
+	V e;
+	V t = log_reduce(x, e);
+	V z = L::mul(t, t);
+
+	if constexpr (ACCURACY == Accuracy::Fast) {
+		V p = polynomial(t, 1.79687251e-1f, -2.72261073e-1f, 3.35873107e-1f, -4.99332281e-1f);
+		return L::add(L::add(t, L::mul(z, p)), L::mul(e, L::splat(0.693147180559945309f)));
+	} else {
+		V p = polynomial(
+			t,
+			7.0376836292e-2f,
+			-1.1514610310e-1f,
+			1.1676998740e-1f,
+			-1.2420140846e-1f,
+			1.4249322787e-1f,
+			-1.6668057665e-1f,
+			2.0000714765e-1f,
+			-2.4999993993e-1f,
+			3.3333331174e-1f);
+		V y = L::mul(L::mul(t, z), p);
+		y	= L::add(y, L::mul(e, L::splat(-2.12194440e-4f)));
+		y	= L::sub(y, L::mul(z, L::splat(0.5f)));
+		return L::add(L::add(t, y), L::mul(e, L::splat(0.693359375f)));
+	}
+}
+
+// log(x) as high + low to about 2^-30 relative for x > 0 and finite, for pow. log(1 + t) is
+// 2 * atanh(s) with s = t / (2 + t) and |s| <= 0.172, the quotient is carried in two parts and the
+// series past 2 * s adds less than 1% so its rounding errors stay far below the f32 result.
+template <typename V>
+constexpr V log_positive_extended(V x, V& low_out) {
+	using L = Lanes<V>;
+	V e;
+	V t = log_reduce(x, e);
+
+	V divisor_low;
+	V divisor = two_sum(L::splat(2.0f), t, divisor_low);
+	V s		  = L::div(t, divisor);
+	V product_error;
+	V product = two_product(s, divisor, product_error);
+	V s_low	  = L::sub(L::sub(L::sub(t, product), product_error), L::mul(s, divisor_low));
+	s_low	  = L::div(s_low, divisor);
+
+	V z		 = L::mul(s, s);
+	V series = polynomial(z, 2.0f / 11.0f, 2.0f / 9.0f, 2.0f / 7.0f, 2.0f / 5.0f, 2.0f / 3.0f);
+	V tail	 = L::mul(L::mul(s, z), series);
+
+	V high_error;
+	V high = two_sum(L::mul(e, L::splat(0.693359375f)), L::add(s, s), high_error);
+	// The series grows by about 2 * z per unit of s, which s_low has to be scaled by as well
+	V low	= L::add(L::mul(L::add(s_low, s_low), L::add(L::splat(1.0f), z)), tail);
+	low		= L::add(L::add(low, L::mul(e, L::splat(-2.12194440e-4f))), high_error);
+	V sum	= L::add(high, low);
+	low_out = L::sub(low, L::sub(sum, high));
+	return sum;
+}
+
+// exp(x + tail) for a tail far below x, Fast ignores it
+template <Accuracy ACCURACY, typename V>
+constexpr V exp_with_tail(V x, V tail) {
+	using L = Lanes<V>;
+	// Past these the result is 0 or inf anyway, the clamp keeps the exponent in range
+	V clamped = L::min(L::max(x, L::splat(-104.0f)), L::splat(89.0f));
+	V n		  = round_nearest(L::mul(clamped, L::splat(1.44269504088896341f)));
+	V result;
+
+	if constexpr (ACCURACY == Accuracy::Fast) {
+		// 2^f for f in [-0.5, 0.5]
+		V f	   = L::sub(L::mul(clamped, L::splat(1.44269504088896341f)), n);
+		V p	   = polynomial(f, 9.58285674e-3f, 5.59064442e-2f, 2.40240987e-1f, 6.93124191e-1f);
+		result = L::add(L::splat(1.0f), L::mul(f, p));
+	} else {
+		// ln(2) in two parts, n times the first is exact
+		V r = L::sub(clamped, L::mul(n, L::splat(0.693359375f)));
+		r	= L::sub(r, L::mul(n, L::splat(-2.12194440e-4f)));
+		r	= L::add(r, tail);
+		V p = polynomial(
+			r,
+			1.9875691500e-4f,
+			1.3981999507e-3f,
+			8.3334519073e-3f,
+			4.1665795894e-2f,
+			1.6666665459e-1f,
+			5.0000001201e-1f);
+		result = L::add(L::add(L::mul(p, L::mul(r, r)), r), L::splat(1.0f));
+	}
+
+	result = scale_by_power_of_two(result, L::to_int(n));
+	return L::select(is_nan(x), x, result);
+}
+
+}  // namespace detail
+
+// Types the functions below take, f32 and the SIMD registers of the target
+template <typename V>
+concept CIsLaneType = requires { typename detail::Lanes<V>::Mask; };
+
+// x - Angle in radians
+template <Accuracy ACCURACY = Accuracy::Precise, CIsLaneType V>
+constexpr V sin(V x) {
+	return detail::sin_cos<ACCURACY>(x, 0);
+}
+
+// x - Angle in radians
+template <Accuracy ACCURACY = Accuracy::Precise, CIsLaneType V>
+constexpr V cos(V x) {
+	return detail::sin_cos<ACCURACY>(x, 1);
+}
+
+// x - Angle in radians
+template <Accuracy ACCURACY = Accuracy::Precise, CIsLaneType V>
+constexpr V tan(V x) {
+	using L					  = detail::Lanes<V>;
+	typename L::Mask in_range = L::less_equal(detail::abs(x), L::splat(4194304.0f));
+	x						  = L::select(in_range, x, L::splat(0.0f));
+
+	typename L::Int quadrant;
+	V r = detail::reduce_quadrant<ACCURACY>(x, quadrant);
+	V z = L::mul(r, r);
+
+	V p;
+	if constexpr (ACCURACY == Accuracy::Fast) {
+		p = detail::polynomial(z, 9.21526836e-2f, 1.18065576e-1f, 3.34961773e-1f);
+	} else {
+		p = detail::polynomial(
+			z,
+			9.38540185543e-3f,
+			3.11992232697e-3f,
+			2.44301354525e-2f,
+			5.34112807005e-2f,
+			1.33387994085e-1f,
+			3.33331568548e-1f);
+	}
+	V t = L::add(r, L::mul(L::mul(r, z), p));
+
+	// Odd quadrants are a quarter turn away, tan(r + pi / 2) = -1 / tan(r)
+	typename L::Mask odd = L::int_equal(L::int_and(quadrant, L::splat_int(1)), L::splat_int(1));
+	V inverse			 = L::div(L::splat(-1.0f), L::select(odd, t, L::splat(1.0f)));
+	return L::select(in_range, L::select(odd, inverse, t), L::splat(detail::F32_NAN));
+}
+
+template <Accuracy ACCURACY = Accuracy::Precise, CIsLaneType V>
+constexpr V atan(V x) {
+	return detail::flip_sign(detail::atan_positive<ACCURACY>(detail::abs(x)), detail::sign_bit(x));
+}
+
+// Angle of the point (x, y) in [-pi, pi]. Only the ratio of the smaller to the larger coordinate
+// goes through atan, so infinite coordinates and points near the axes keep their precision.
+template <Accuracy ACCURACY = Accuracy::Precise, CIsLaneType V>
+constexpr V atan2(V y, V x) {
+	using L = detail::Lanes<V>;
+	V ax	= detail::abs(x);
+	V ay	= detail::abs(y);
+
+	typename L::Mask steep = L::less(ax, ay);
+	V smaller			   = L::select(steep, ax, ay);
+	V larger			   = L::select(steep, ay, ax);
+	// Both infinite is the diagonal, both zero is the positive x axis
+	typename L::Mask both_infinite = L::mask_and(
+		L::equal(ax, L::splat(detail::F32_INFINITY)), L::equal(ay, L::splat(detail::F32_INFINITY)));
+	V ratio = L::div(smaller, L::select(L::equal(larger, L::splat(0.0f)), L::splat(1.0f), larger));
+	ratio	= L::select(both_infinite, L::splat(1.0f), ratio);
+
+	V angle = detail::atan_positive<ACCURACY>(ratio);
+	angle	= L::select(steep, L::sub(L::splat(detail::HALF_PI_F32), angle), angle);
+	// Negative x, including -0, mirrors the angle to the left half plane
+	typename L::Mask left = L::int_equal(detail::sign_bit(x), L::splat_int(I32_MIN));
+	angle				  = L::select(left, L::sub(L::splat(detail::PI_F32), angle), angle);
+	angle				  = detail::flip_sign(angle, detail::sign_bit(y));
+	return L::select(L::mask_or(detail::is_nan(x), detail::is_nan(y)), L::splat(detail::F32_NAN), angle);
+}
+
+// Angle in radians in [0, pi], NaN outside of [-1, 1]
+template <Accuracy ACCURACY = Accuracy::Precise, CIsLaneType V>
+constexpr V acos(V x) {
+	using L					  = detail::Lanes<V>;
+	V a						  = detail::abs(x);
+	typename L::Mask negative = L::less(x, L::splat(0.0f));
+	V result;
+
+	if constexpr (ACCURACY == Accuracy::Fast) {
+		V one  = L::splat(1.0f);
+		V root = L::sqrt(L::max(L::sub(one, a), L::splat(0.0f)));
+		V p	   = L::mul(root, detail::polynomial(a, -0.0187293f, 0.0742610f, -0.2121144f, 1.5707288f));
+		result = L::select(negative, L::sub(L::splat(detail::PI_F32), p), p);
+	} else {
+		// asin(s) for s <= 0.5, acos(a) = 2 * asin(sqrt((1 - a) / 2)) for a past 0.5 and
+		// pi / 2 - asin(x) below
+		typename L::Mask large = L::less(L::splat(0.5f), a);
+		V half_rest			   = L::mul(L::splat(0.5f), L::max(L::sub(L::splat(1.0f), a), L::splat(0.0f)));
+		V z					   = L::select(large, half_rest, L::mul(a, a));
+		V s					   = L::select(large, L::sqrt(z), a);
+
+		V p = detail::polynomial(
+			z, 4.2163199048e-2f, 2.4181311049e-2f, 4.5470025998e-2f, 7.4953002686e-2f, 1.6666752422e-1f);
+
+		V asin_s = L::add(s, L::mul(L::mul(s, z), p));
+
+		V twice		  = L::add(asin_s, asin_s);
+		V large_angle = L::select(negative, L::sub(L::splat(detail::PI_F32), twice), twice);
+		V small_angle = L::sub(L::splat(detail::HALF_PI_F32), detail::flip_sign(asin_s, detail::sign_bit(x)));
+		result		  = L::select(large, large_angle, small_angle);
+	}
+
+	return L::select(L::less_equal(a, L::splat(1.0f)), result, L::splat(detail::F32_NAN));
+}
+
+template <Accuracy ACCURACY = Accuracy::Precise, CIsLaneType V>
+constexpr V exp(V x) {
+	return detail::exp_with_tail<ACCURACY>(x, detail::Lanes<V>::splat(0.0f));
+}
+
+// Natural logarithm, -inf for 0 and NaN for negative values
+template <Accuracy ACCURACY = Accuracy::Precise, CIsLaneType V>
+constexpr V log(V x) {
+	using L = detail::Lanes<V>;
+	typename L::Mask finite_positive =
+		L::mask_and(L::less(L::splat(0.0f), x), L::less(x, L::splat(detail::F32_INFINITY)));
+	V result = detail::log_positive<ACCURACY>(L::select(finite_positive, x, L::splat(1.0f)));
+
+	result					 = L::select(L::equal(x, L::splat(detail::F32_INFINITY)), x, result);
+	result					 = L::select(L::equal(x, L::splat(0.0f)), L::splat(-detail::F32_INFINITY), result);
+	typename L::Mask invalid = L::mask_or(L::less(x, L::splat(0.0f)), detail::is_nan(x));
+	return L::select(invalid, L::splat(detail::F32_NAN), result);
+}
+
+// x^y for real exponents. Negative bases only have a real result for integer exponents, odd ones
+// keep the sign of the base.
+template <Accuracy ACCURACY = Accuracy::Precise, CIsLaneType V>
+constexpr V pow(V x, V y) {
+	using L = detail::Lanes<V>;
+	V ay	= detail::abs(y);
+	V one	= L::splat(1.0f);
+
+	V result;
+	if constexpr (ACCURACY == Accuracy::Fast) {
+		result = exp<ACCURACY>(L::mul(y, log<ACCURACY>(detail::abs(x))));
+	} else {
+		// y * log(|x|) goes up to 89 in magnitude, rounded to f32 it would be off by several ulp of
+		// the result. Both the logarithm and the product are carried in two parts.
+		V ax = detail::abs(x);
+		typename L::Mask finite_positive =
+			L::mask_and(L::less(L::splat(0.0f), ax), L::less(ax, L::splat(detail::F32_INFINITY)));
+		V log_low;
+		V log_high = detail::log_positive_extended(L::select(finite_positive, ax, one), log_low);
+		// log of 0 is -inf, infinity and NaN are their own
+		V special = L::select(L::equal(ax, L::splat(0.0f)), L::splat(-detail::F32_INFINITY), ax);
+		log_high  = L::select(finite_positive, log_high, special);
+
+		V product_error;
+		V product	  = detail::two_product(y, log_high, product_error);
+		V product_low = L::add(product_error, L::mul(y, L::select(finite_positive, log_low, L::splat(0.0f))));
+		// Past 128 the result is 0 or inf anyway and the error of an infinite product is NaN
+		product_low = L::select(L::less(detail::abs(product), L::splat(128.0f)), product_low, L::splat(0.0f));
+		result		= detail::exp_with_tail<ACCURACY>(product, product_low);
+	}
+
+	// Every f32 from 2^23 on is an even integer
+	typename L::Mask large_exponent = L::less_equal(L::splat(8388608.0f), ay);
+	typename L::Mask integer =
+		L::mask_or(large_exponent, L::equal(detail::round_nearest(L::select(large_exponent, one, y)), y));
+	auto whole			 = L::to_int(L::select(large_exponent, L::splat(0.0f), y));
+	typename L::Mask odd = L::mask_and(integer, L::int_equal(L::int_and(whole, L::splat_int(1)), L::splat_int(1)));
+
+	typename L::Mask negative = L::int_equal(detail::sign_bit(x), L::splat_int(I32_MIN));
+	V sign					  = L::select(L::mask_and(negative, odd), L::splat(-1.0f), one);
+	result					  = detail::flip_sign(result, detail::sign_bit(sign));
+	typename L::Mask invalid  = L::mask_and(L::less(x, L::splat(0.0f)), L::mask_not(integer));
+	result					  = L::select(invalid, L::splat(detail::F32_NAN), result);
+
+	// x^0 and 1^y are 1 even for NaN and infinite arguments
+	return L::select(L::mask_or(L::equal(y, L::splat(0.0f)), L::equal(x, one)), one, result);
+}
+
+// Every value of the span at once, 8 lanes at a time when the compiler targets AVX2 and 4 with
+// SSE otherwise. values_out can alias values.
+template <Accuracy ACCURACY = Accuracy::Precise>
+void sin_many(Span<f32> values, f32* values_out);
+template <Accuracy ACCURACY = Accuracy::Precise>
+void cos_many(Span<f32> values, f32* values_out);
+template <Accuracy ACCURACY = Accuracy::Precise>
+void tan_many(Span<f32> values, f32* values_out);
+template <Accuracy ACCURACY = Accuracy::Precise>
+void atan2_many(Span<f32> y, Span<f32> x, f32* values_out);
+template <Accuracy ACCURACY = Accuracy::Precise>
+void exp_many(Span<f32> values, f32* values_out);
+template <Accuracy ACCURACY = Accuracy::Precise>
+void log_many(Span<f32> values, f32* values_out);
+template <Accuracy ACCURACY = Accuracy::Precise>
+void pow_many(Span<f32> x, Span<f32> y, f32* values_out);
+
+}  // namespace toki
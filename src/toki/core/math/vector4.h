@@ -0,0 +1,132 @@
+#pragma once
+
+#include <toki/core/math/math.h>
+#include <toki/core/math/vector3.h>
+#include <toki/core/string/basic_string.h>
+#include <toki/core/types.h>
+#include <toki/core/utils/format.h>
+#include <toki/core/utils/string_formatters.h>
+
+namespace toki {
+
+// Aligned so it can be loaded into a single SSE register, also the homogeneous form of points
+// (w = 1) and directions (w = 0) multiplied with Matrix4
+class alignas(16) Vector4 {
+public:
+	constexpr Vector4() = default;
+	constexpr Vector4(f32 value): x(value), y(value), z(value), w(value) {}
+	constexpr Vector4(f32 x_value, f32 y_value, f32 z_value, f32 w_value):
+		x(x_value),
+		y(y_value),
+		z(z_value),
+		w(w_value) {}
+	constexpr Vector4(const Vector3& vector, f32 w_value): x(vector.x), y(vector.y), z(vector.z), w(w_value) {}
+	constexpr Vector4(const Vector4&) = default;
+	constexpr Vector4(Vector4&&)	  = default;
+
+	constexpr Vector4& operator=(const Vector4&) = default;
+	constexpr Vector4& operator=(Vector4&&)		 = default;
+
+	constexpr Vector4& operator+=(const Vector4& rhs);
+	constexpr Vector4 operator+(const Vector4& rhs) const;
+
+	constexpr Vector4& operator-=(const Vector4& rhs);
+	constexpr Vector4 operator-(const Vector4& rhs) const;
+
+	constexpr Vector4& operator*=(const Vector4& rhs);
+	constexpr Vector4 operator*(const Vector4& rhs) const;
+	constexpr Vector4 operator*(f32 value) const;
+
+	constexpr b8 operator==(const Vector4&) const = default;
+
+	constexpr Vector4 operator-() const;
+
+	constexpr f32 length_squared() const;
+	constexpr f32 length() const;
+	constexpr Vector4 normalize() const;
+	constexpr f32 dot(const Vector4& v) const;
+
+	constexpr Vector3 xyz() const;
+
+public:
+	f32 x{}, y{}, z{}, w{};
+};
+
+constexpr Vector4& Vector4::operator+=(const Vector4& rhs) {
+	x += rhs.x;
+	y += rhs.y;
+	z += rhs.z;
+	w += rhs.w;
+
+	return *this;
+}
+
+constexpr Vector4 Vector4::operator+(const Vector4& rhs) const {
+	Vector4 temp(*this);
+	return (temp += rhs);
+}
+
+constexpr Vector4& Vector4::operator-=(const Vector4& rhs) {
+	x -= rhs.x;
+	y -= rhs.y;
+	z -= rhs.z;
+	w -= rhs.w;
+
+	return *this;
+}
+
+constexpr Vector4 Vector4::operator-(const Vector4& rhs) const {
+	Vector4 temp(*this);
+	return (temp -= rhs);
+}
+
+constexpr Vector4& Vector4::operator*=(const Vector4& rhs) {
+	x *= rhs.x;
+	y *= rhs.y;
+	z *= rhs.z;
+	w *= rhs.w;
+
+	return *this;
+}
+
+constexpr Vector4 Vector4::operator*(const Vector4& rhs) const {
+	Vector4 temp(*this);
+	return (temp *= rhs);
+}
+
+constexpr Vector4 Vector4::operator*(f32 value) const {
+	return Vector4(x * value, y * value, z * value, w * value);
+}
+
+constexpr Vector4 Vector4::operator-() const {
+	return Vector4(-x, -y, -z, -w);
+}
+
+constexpr f32 Vector4::length_squared() const {
+	return dot(*this);
+}
+
+constexpr f32 Vector4::length() const {
+	return toki::sqrt(length_squared());
+}
+
+constexpr Vector4 Vector4::normalize() const {
+	return *this * (1.0f / length());
+}
+
+constexpr f32 Vector4::dot(const Vector4& other) const {
+	return x * other.x + y * other.y + z * other.z + w * other.w;
+}
+
+constexpr Vector3 Vector4::xyz() const {
+	return Vector3(x, y, z);
+}
+
+template <CIsAllocator AllocatorType>
+struct Formatter<Vector4, AllocatorType> {
+	static constexpr toki::String<AllocatorType> format(const Vector4& vector) {
+		return toki::format("Vector4 [{} {} {} {}]", vector.x, vector.y, vector.z, vector.w);
+	}
+};
+
+}  // namespace toki
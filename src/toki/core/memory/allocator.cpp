@@ -1,6 +1,7 @@
 #include "toki/core/memory/allocator.h"
 
 #include <toki/core/common/assert.h>
+#include <toki/core/math/math.h>
 #include <toki/core/memory/memory.h>
 #include <toki/core/platform/syscalls.h>
 #include <toki/core/utils/memory.h>
@@ -144,8 +145,10 @@ void* Allocator::reallocate(void* old, u64 size) {
 		return allocate(size);
 	}
 
+	// Only the smaller of the two sizes is valid data in both blocks
+	u64 old_size  = (reinterpret_cast<MemorySection*>(old) - 1)->size;
 	void* new_ptr = allocate(size);
-	toki::memcpy(new_ptr, old, size);
+	toki::memcpy(new_ptr, old, toki::min(old_size, size));
 	free(old);
 
 	ASSERT_ALLOCATOR_POINTERS;
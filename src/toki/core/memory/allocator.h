@@ -34,7 +34,9 @@ public:
 	void free_aligned(void* ptr);
 
 private:
-	struct MemorySection {
+	// Block sizes are rounded to the alignment of the header, 16 keeps every block aligned for
+	// SSE types like Vector4 and Matrix4
+	struct alignas(16) MemorySection {
 		u64 size;
 		MemorySection* next;
 	};
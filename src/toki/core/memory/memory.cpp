@@ -3,6 +3,7 @@
 #include <toki/core/math/math.h>
 #include <toki/core/memory/allocator.h>
 #include <toki/core/platform/syscalls.h>
+#include <toki/core/platform/threads/mutex.h>
 #include <toki/core/utils/memory.h>
 
 void* operator new([[maybe_unused]] unsigned long size, void* p) noexcept {
@@ -14,6 +15,8 @@ void operator delete(void*, void*) {}
 namespace toki {
 
 static Allocator g_allocator;
+// The free list allocator is not thread safe, every thread goes through this lock
+static Mutex g_allocatorMutex;
 
 void memory_initialize(const MemoryConfig& config) {
 	g_allocator					= toki::move(Allocator(config.total_size));
@@ -25,22 +28,27 @@ void memory_shutdown() {
 }
 
 void* DefaultAllocator::allocate(u64 size) {
+	ScopedLock lock(g_allocatorMutex);
 	return DefaultAllocator::allocator->allocate(size);
 }
 
 void* DefaultAllocator::allocate_aligned(u64 size, u64 alignment) {
+	ScopedLock lock(g_allocatorMutex);
 	return DefaultAllocator::allocator->allocate_aligned(size, alignment);
 }
 
 void DefaultAllocator::free(void* ptr) {
+	ScopedLock lock(g_allocatorMutex);
 	DefaultAllocator::allocator->free(ptr);
 }
 
 void DefaultAllocator::free_aligned(void* ptr) {
+	ScopedLock lock(g_allocatorMutex);
 	DefaultAllocator::allocator->free_aligned(ptr);
 }
 
 void* DefaultAllocator::reallocate(void* ptr, u64 size) {
+	ScopedLock lock(g_allocatorMutex);
 	return DefaultAllocator::allocator->reallocate(ptr, size);
 }
 
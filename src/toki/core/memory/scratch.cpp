@@ -0,0 +1,179 @@
+#include "toki/core/memory/scratch.h"
+
+#include <toki/core/math/math.h>
+#include <toki/core/platform/syscalls.h>
+#include <toki/core/utils/memory.h>
+
+namespace toki {
+
+// Arenas only reserve their address range on first allocation, so threads that never need
+// scratch memory don't pay for it. Destroyed with the thread, which releases the ranges.
+struct ThreadScratch {
+	ScratchArena arenas[SCRATCH_ARENA_COUNT];
+	ScratchScope* current_scope{};
+};
+
+static thread_local ThreadScratch t_scratch;
+
+ScratchArena::~ScratchArena() {
+	if (m_base != nullptr) {
+		release_memory(m_base, RESERVE_SIZE);
+	}
+}
+
+void ScratchArena::ensure_committed(u64 end) {
+	if (m_base == nullptr) {
+		m_base = reinterpret_cast<byte*>(reserve_memory(RESERVE_SIZE).value_or(nullptr));
+		TK_ASSERT(m_base != nullptr, "Could not reserve scratch arena memory");
+	}
+
+	if (end <= m_committed) {
+		return;
+	}
+
+	TK_ASSERT(end <= RESERVE_SIZE, "Scratch arena is out of reserved memory");
+	u64 new_committed = toki::min((end + COMMIT_SIZE - 1) & ~(COMMIT_SIZE - 1), RESERVE_SIZE);
+	toki::Optional<TokiError> error = commit_memory(m_base + m_committed, new_committed - m_committed);
+	TK_ASSERT(!error.has_value(), "Could not commit scratch arena memory");
+	m_committed = new_committed;
+}
+
+void* ScratchArena::allocate(u64 size) {
+	return allocate_aligned(size, alignof(u64));
+}
+
+void* ScratchArena::allocate_aligned(u64 size, u64 alignment) {
+	TK_ASSERT((alignment & (alignment - 1)) == 0);
+
+	u64 offset = (m_position + alignment - 1) & ~(alignment - 1);
+	ensure_committed(offset + size);
+
+	m_lastOffset = offset;
+	m_position	 = offset + size;
+	return m_base + offset;
+}
+
+void* ScratchArena::reallocate(void* ptr, u64 old_size, u64 size, u64 alignment) {
+	if (ptr == nullptr) {
+		return allocate_aligned(size, alignment);
+	}
+	TK_ASSERT(ptr >= m_base && ptr < m_base + m_position, "Pointer was not allocated from this arena");
+
+	if (m_lastOffset != NO_ALLOCATION && ptr == m_base + m_lastOffset) {
+		ensure_committed(m_lastOffset + size);
+		m_position = m_lastOffset + size;
+		return ptr;
+	}
+
+	void* new_ptr = allocate_aligned(size, alignment);
+	toki::memmove(new_ptr, ptr, toki::min(old_size, size));
+	return new_ptr;
+}
+
+ScratchArena* get_scratch(ScratchArena* const* avoid, u32 avoid_count) {
+	for (u32 i = 0; i < SCRATCH_ARENA_COUNT; i++) {
+		ScratchArena* arena = &t_scratch.arenas[i];
+
+		b8 conflicts = false;
+		for (u32 j = 0; j < avoid_count; j++) {
+			if (arena == avoid[j]) {
+				conflicts = true;
+				break;
+			}
+		}
+
+		if (!conflicts) {
+			return arena;
+		}
+	}
+
+	TK_ASSERT(false, "All scratch arenas are in use, increase SCRATCH_ARENA_COUNT");
+	return nullptr;
+}
+
+void ScratchScope::begin(ScratchArena* arena) {
+	m_arena					= arena;
+	m_previous				= t_scratch.current_scope;
+	m_marker				= arena->get_marker();
+	t_scratch.current_scope = this;
+}
+
+ScratchScope::~ScratchScope() {
+	m_arena->free_to_marker(m_marker);
+	t_scratch.current_scope = m_previous;
+}
+
+static ScratchArena* current_scope_arena() {
+	TK_ASSERT(t_scratch.current_scope != nullptr, "ScratchAllocator used outside of a ScratchScope");
+	return t_scratch.current_scope->arena();
+}
+
+// Placed right before every block handed out by ScratchAllocator
+struct ScratchAllocation {
+	ScratchArena* arena;
+	ScratchScope* scope;
+	u64 size;
+	// Bytes from the start of the arena block to the data, a multiple of the alignment
+	u64 header_size;
+};
+
+static ScratchAllocation* allocation_of(void* ptr) {
+	return reinterpret_cast<ScratchAllocation*>(ptr) - 1;
+}
+
+static void* allocate_block(u64 size, u64 alignment) {
+	ScratchArena* arena = current_scope_arena();
+	alignment			= toki::max(alignment, alignof(ScratchAllocation));
+	u64 header_size		= (sizeof(ScratchAllocation) + alignment - 1) & ~(alignment - 1);
+
+	void* block			 = arena->allocate_aligned(header_size + size, alignment);
+	byte* data			 = reinterpret_cast<byte*>(block) + header_size;
+	*allocation_of(data) = { arena, t_scratch.current_scope, size, header_size };
+	return data;
+}
+
+static void* reallocate_block(void* ptr, u64 size, u64 alignment) {
+	if (ptr == nullptr) {
+		return allocate_block(size, alignment);
+	}
+
+	// Grown blocks stay in the arena the container started in. A scope on that arena that began
+	// after the block would free the grown block when it ends, or be overwritten by it.
+	ScratchAllocation allocation = *allocation_of(ptr);
+	for (ScratchScope* scope = t_scratch.current_scope; scope != allocation.scope; scope = scope->previous()) {
+		TK_ASSERT(scope != nullptr, "Scratch container used after the scope it was created in");
+		TK_ASSERT(scope->arena() != allocation.arena, "Scratch container grown inside a newer scope on its arena");
+	}
+
+	void* block = allocation.arena->reallocate(
+		reinterpret_cast<byte*>(ptr) - allocation.header_size,
+		allocation.header_size + allocation.size,
+		allocation.header_size + size,
+		toki::max(alignment, alignof(ScratchAllocation)));
+	byte* data			 = reinterpret_cast<byte*>(block) + allocation.header_size;
+	allocation.size		 = size;
+	*allocation_of(data) = allocation;
+	return data;
+}
+
+void* ScratchAllocator::allocate(u64 size) {
+	return allocate_block(size, alignof(u64));
+}
+
+void* ScratchAllocator::allocate_aligned(u64 size, u64 alignment) {
+	return allocate_block(size, alignment);
+}
+
+void ScratchAllocator::free([[maybe_unused]] void* ptr) {}	// noop
+
+void ScratchAllocator::free_aligned([[maybe_unused]] void* ptr) {}  // noop
+
+void* ScratchAllocator::reallocate(void* ptr, u64 size) {
+	return reallocate_block(ptr, size, alignof(u64));
+}
+
+void* ScratchAllocator::reallocate_aligned(void* ptr, u64 size, u64 alignment) {
+	return reallocate_block(ptr, size, alignment);
+}
+
+}  // namespace toki
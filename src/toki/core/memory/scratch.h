@@ -0,0 +1,139 @@
+#pragma once
+
+#include <toki/core/common/assert.h>
+#include <toki/core/common/defines.h>
+#include <toki/core/common/macros.h>
+#include <toki/core/common/type_traits.h>
+#include <toki/core/containers/dynamic_array.h>
+#include <toki/core/string/basic_string.h>
+#include <toki/core/types.h>
+#include <toki/core/utils/bytes.h>
+
+namespace toki {
+
+// Bump arena over a reserved address range, memory is committed in COMMIT_SIZE steps as the
+// arena grows and kept committed after it is freed to a marker so steady state use never
+// touches the kernel
+class ScratchArena {
+public:
+	static constexpr u64 RESERVE_SIZE = GB(8);
+	static constexpr u64 COMMIT_SIZE  = KB(64);
+
+	ScratchArena() = default;
+	~ScratchArena();
+
+	DELETE_COPY(ScratchArena);
+	DELETE_MOVE(ScratchArena);
+
+	void* allocate(u64 size);
+	void* allocate_aligned(u64 size, u64 alignment);
+	// Grows in place when ptr is the most recent allocation, otherwise copies the smaller of
+	// old_size and size into a new block
+	void* reallocate(void* ptr, u64 old_size, u64 size, u64 alignment);
+
+	template <typename T>
+	T* allocate_array(u64 count) {
+		return reinterpret_cast<T*>(allocate_aligned(sizeof(T) * count, alignof(T)));
+	}
+
+	u64 get_marker() const {
+		return m_position;
+	}
+
+	void free_to_marker(u64 marker) {
+		TK_ASSERT(marker <= m_position);
+		m_position	 = marker;
+		m_lastOffset = NO_ALLOCATION;
+	}
+
+	void reset() {
+		free_to_marker(0);
+	}
+
+private:
+	void ensure_committed(u64 end);
+
+	static constexpr u64 NO_ALLOCATION = U64_MAX;
+
+	byte* m_base{};
+	u64 m_position{};
+	u64 m_committed{};
+	u64 m_lastOffset = NO_ALLOCATION;
+};
+
+// Every thread gets its own set of arenas, created on first use
+static constexpr u32 SCRATCH_ARENA_COUNT = 2;
+
+// Returns a scratch arena of the calling thread that is none of the `avoid` arenas. A function
+// that returns data in a caller provided arena passes that arena here so that its own
+// temporaries don't end up interleaved with, and freed together with, the result.
+ScratchArena* get_scratch(ScratchArena* const* avoid, u32 avoid_count);
+
+template <typename... Avoid>
+	requires(CIsSame<Avoid, ScratchArena*> && ...)
+inline ScratchArena* get_scratch(Avoid... avoid) {
+	ScratchArena* avoid_list[] = { avoid..., nullptr };
+	return get_scratch(avoid_list, sizeof...(Avoid));
+}
+
+// Frees everything allocated from its arena during its lifetime. While a scope is alive it is
+// also the arena ScratchAllocator allocates from on this thread.
+class ScratchScope {
+public:
+	template <typename... Avoid>
+		requires(CIsSame<Avoid, ScratchArena*> && ...)
+	explicit ScratchScope(Avoid... avoid) {
+		begin(get_scratch(avoid...));
+	}
+
+	~ScratchScope();
+
+	DELETE_COPY(ScratchScope);
+	DELETE_MOVE(ScratchScope);
+
+	ScratchArena* arena() const {
+		return m_arena;
+	}
+
+	// The scope that was innermost when this one began
+	ScratchScope* previous() const {
+		return m_previous;
+	}
+
+	void* allocate(u64 size) {
+		return m_arena->allocate(size);
+	}
+
+	template <typename T>
+	T* allocate_array(u64 count) {
+		return m_arena->allocate_array<T>(count);
+	}
+
+private:
+	void begin(ScratchArena* arena);
+
+	ScratchArena* m_arena{};
+	ScratchScope* m_previous{};
+	u64 m_marker{};
+};
+
+// Container allocator backed by the innermost ScratchScope of the calling thread, containers
+// using it must not outlive that scope. Every block remembers its arena and size, so a container
+// grows in the arena it was created in even while a scope on another arena is active.
+struct ScratchAllocator {
+	static void* allocate(u64 size);
+	static void* allocate_aligned(u64 size, u64 alignment);
+	static void free(void* ptr);		  // noop
+	static void free_aligned(void* ptr);  // noop
+	static void* reallocate(void* ptr, u64 size);
+	static void* reallocate_aligned(void* ptr, u64 size, u64 alignment);
+};
+
+static_assert(CIsAllocator<ScratchAllocator>);
+
+template <typename T>
+using ScratchDynamicArray = DynamicArray<T, ScratchAllocator>;
+
+using ScratchString = String<ScratchAllocator>;
+
+}  // namespace toki
@@ -44,7 +44,8 @@ public:
 	void reset(T* ptr = nullptr) {
 		if (m_ptr != nullptr) {
 			static_cast<T*>(m_ptr)->T::~T();
-			AllocatorType::free(m_ptr);
+			// make_unique allocates aligned, free would look for the block header in the wrong place
+			AllocatorType::free_aligned(m_ptr);
 		}
 
 		m_ptr = ptr;
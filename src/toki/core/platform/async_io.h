@@ -0,0 +1,85 @@
+#pragma once
+
+#include <toki/core/common/defines.h>
+#include <toki/core/common/macros.h>
+#include <toki/core/platform/platform_types.h>
+#include <toki/core/string/span.h>
+#include <toki/core/types.h>
+
+namespace toki {
+
+enum struct AsyncIoOperation {
+	READ,
+	WRITE,
+};
+
+struct AsyncIoCompletion {
+	// Bytes transferred, or a negative errno value when the request failed. Requests that
+	// followed a failed request in a linked chain complete with -ECANCELED.
+	i64 result;
+	void* user_data;
+};
+
+using AsyncIoCallback = void (*)(const AsyncIoCompletion& completion);
+
+struct AsyncIoRequest {
+	AsyncIoOperation operation = AsyncIoOperation::READ;
+	NativeHandle handle{};
+	void* buffer{};
+	u32 size{};
+	// Absolute position in the file, the file cursor is neither used nor moved
+	u64 offset{};
+	// Index passed to AsyncIo::register_buffers when `buffer` lies inside a registered buffer
+	u32 registered_buffer = U32_MAX;
+	// The next queued request only starts once this one fully completed, used to chain
+	// dependent reads (header, then the data it describes) without a round trip. A chain ends at
+	// the first request without it or at submit and has to be shorter than queue_depth.
+	b8 link_next = false;
+	AsyncIoCallback callback{};
+	void* user_data{};
+};
+
+struct AsyncIoBuffer {
+	void* data;
+	u64 size;
+};
+
+struct AsyncIoConfig {
+	// Maximum number of requests in flight at the same time
+	u32 queue_depth = 256;
+	// Worker count of the fallback backend used when io_uring is not available
+	u32 fallback_thread_count = 2;
+	b8 force_fallback = false;
+};
+
+// Batched asynchronous file reads and writes. Uses io_uring where the kernel supports it and
+// a small thread pool doing blocking pread/pwrite otherwise. Requests are queued, sent to the
+// kernel in one go with submit, and their callbacks run on the thread that calls poll.
+class AsyncIo {
+public:
+	AsyncIo(const AsyncIoConfig& config = {});
+	~AsyncIo();
+
+	DELETE_COPY(AsyncIo);
+	DELETE_MOVE(AsyncIo);
+
+	// Pins buffers for the lifetime of this object so the kernel does not have to map them
+	// for every request, replaces previously registered buffers
+	b8 register_buffers(Span<AsyncIoBuffer> buffers);
+
+	void queue(const AsyncIoRequest& request);
+	void submit();
+
+	// Runs callbacks of finished requests without blocking, returns how many completed
+	u32 poll();
+	// Submits queued requests and blocks until every request completed
+	void wait_all();
+
+	u32 in_flight() const;
+	b8 uses_io_uring() const;
+
+private:
+	void* m_internalData{};
+};
+
+}  // namespace toki
@@ -17,6 +17,13 @@ enum FileFlags : u32 {
 	FILE_FLAG_TRUNCATE		= 1 << 3,
 };
 
+// Tells the kernel how a mapped file is going to be read so it can tune read ahead
+enum struct FileAccessHint {
+	NORMAL,
+	SEQUENTIAL,
+	RANDOM
+};
+
 enum struct FileCursorStart {
 	BEGIN,
 	CURRENT,
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <toki/core/common/macros.h>
+#include <toki/core/containers/dynamic_array.h>
+#include <toki/core/types.h>
+#include <toki/core/utils/path.h>
+
+namespace toki {
+
+struct FileWatcherConfig {
+	// Editors often save in several steps (truncate, write, rename), a file is only reported once
+	// no event for it arrived for this long
+	u32 debounce_ms = 50;
+};
+
+// Watches directories for files that were written, created or moved into them. Uses inotify,
+// events are read without blocking so poll can be called once per frame.
+class FileWatcher {
+public:
+	FileWatcher(const FileWatcherConfig& config = {});
+	~FileWatcher();
+
+	DELETE_COPY(FileWatcher);
+	DELETE_MOVE(FileWatcher);
+
+	// Subdirectories created later are watched as well when recursive is set
+	b8 watch_directory(const Path& directory, b8 recursive = true);
+
+	// Appends every changed file that settled since the last call, each path at most once,
+	// returns how many were appended. Paths are the watched directory joined with the file name.
+	u32 poll(DynamicArray<Path>& changed_out);
+
+private:
+	void* m_internalData{};
+};
+
+}  // namespace toki
@@ -0,0 +1,568 @@
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <toki/core/common/assert.h>
+#include <toki/core/common/log.h>
+#include <toki/core/containers/dynamic_array.h>
+#include <toki/core/memory/unique_ptr.h>
+#include <toki/core/platform/async_io.h>
+#include <toki/core/platform/threads/thread.h>
+#include <unistd.h>
+
+#include <cerrno>
+
+namespace toki {
+
+class AsyncIoBackend {
+public:
+	virtual ~AsyncIoBackend() = default;
+
+	virtual b8 register_buffers(Span<AsyncIoBuffer> buffers) = 0;
+	virtual void queue(const AsyncIoRequest& request)		 = 0;
+	virtual void submit()									 = 0;
+	virtual u32 poll()										 = 0;
+	// Blocks until at least one submitted request completed
+	virtual void wait_for_completion() = 0;
+	virtual u32 in_flight() const	   = 0;
+	virtual b8 uses_io_uring() const   = 0;
+};
+
+// Blocking read or write of the whole request, stops early on end of file like io_uring does
+static i64 execute_request(const AsyncIoRequest& request) {
+	u64 done = 0;
+	while (done < request.size) {
+		byte* buffer = reinterpret_cast<byte*>(request.buffer) + done;
+		u64 left	 = request.size - done;
+		u64 offset	 = request.offset + done;
+
+		i64 result = request.operation == AsyncIoOperation::READ ? pread(request.handle, buffer, left, offset)
+																 : pwrite(request.handle, buffer, left, offset);
+		if (result < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			return -errno;
+		}
+		if (result == 0) {
+			break;
+		}
+		done += static_cast<u64>(result);
+	}
+	return static_cast<i64>(done);
+}
+
+//
+// io_uring backend, talks to the kernel through the raw syscalls to not depend on liburing
+//
+
+class IoUringBackend final : public AsyncIoBackend {
+public:
+	static IoUringBackend* create(const AsyncIoConfig& config) {
+		io_uring_params params{};
+		i32 ring = static_cast<i32>(syscall(SYS_io_uring_setup, config.queue_depth, &params));
+		if (ring < 0) {
+			return nullptr;
+		}
+
+		// IORING_OP_READ and IORING_OP_WRITE arrived together with this feature flag
+		if ((params.features & IORING_FEAT_RW_CUR_POS) == 0) {
+			::close(ring);
+			return nullptr;
+		}
+
+		IoUringBackend* backend = construct_at<IoUringBackend>(
+			DefaultAllocator::allocate_aligned(sizeof(IoUringBackend), alignof(IoUringBackend)));
+		if (!backend->map_rings(ring, params)) {
+			backend->~IoUringBackend();
+			DefaultAllocator::free_aligned(backend);
+			return nullptr;
+		}
+		return backend;
+	}
+
+	virtual ~IoUringBackend() override {
+		if (m_sqes != nullptr) {
+			munmap(m_sqes, m_sqesSize);
+		}
+		if (m_cqRing != nullptr && m_cqRing != m_sqRing) {
+			munmap(m_cqRing, m_cqRingSize);
+		}
+		if (m_sqRing != nullptr) {
+			munmap(m_sqRing, m_sqRingSize);
+		}
+		if (m_ring >= 0) {
+			::close(m_ring);
+		}
+	}
+
+	virtual b8 register_buffers(Span<AsyncIoBuffer> buffers) override {
+		if (m_buffersRegistered) {
+			syscall(SYS_io_uring_register, m_ring, IORING_UNREGISTER_BUFFERS, nullptr, 0);
+			m_buffersRegistered = false;
+		}
+
+		DynamicArray<iovec> iovecs(buffers.size());
+		for (u32 i = 0; i < buffers.size(); i++) {
+			iovecs[i].iov_base = buffers[i].data;
+			iovecs[i].iov_len  = buffers[i].size;
+		}
+
+		if (syscall(SYS_io_uring_register, m_ring, IORING_REGISTER_BUFFERS, iovecs.data(), iovecs.size()) < 0) {
+			TK_LOG_WARN("Could not register io_uring buffers, errno {}", errno);
+			return false;
+		}
+
+		m_buffersRegistered = true;
+		return true;
+	}
+
+	virtual void queue(const AsyncIoRequest& request) override {
+		// Keep the number of requests in flight below the completion queue size so completions are never dropped.
+		// Making room leaves a chain that is still open queued, the kernel ends chains with the submission.
+		while (m_firstFreeSlot == NO_SLOT) {
+			TK_ASSERT(m_chainLength < m_slots.size(), "Linked chain does not fit in the queue");
+			submit_until(m_localTail - m_chainLength);
+			wait_for_completion();
+			poll();
+		}
+
+		if (m_localTail - __atomic_load_n(m_sqHead, __ATOMIC_ACQUIRE) >= m_sqEntries) {
+			TK_ASSERT(m_chainLength < m_sqEntries, "Linked chain does not fit in the submission queue");
+			submit_until(m_localTail - m_chainLength);
+		}
+
+		u32 slot_index		 = m_firstFreeSlot;
+		Slot& slot			 = m_slots[slot_index];
+		m_firstFreeSlot		 = slot.next_free;
+		slot.callback		 = request.callback;
+		slot.user_data		 = request.user_data;
+		b8 registered_buffer = request.registered_buffer != U32_MAX;
+
+		u32 index		  = m_localTail & *m_sqMask;
+		io_uring_sqe* sqe = &m_sqes[index];
+		*sqe			  = {};
+		if (request.operation == AsyncIoOperation::READ) {
+			sqe->opcode = registered_buffer ? IORING_OP_READ_FIXED : IORING_OP_READ;
+		} else {
+			sqe->opcode = registered_buffer ? IORING_OP_WRITE_FIXED : IORING_OP_WRITE;
+		}
+		sqe->fd		   = request.handle;
+		sqe->addr	   = reinterpret_cast<u64>(request.buffer);
+		sqe->len	   = request.size;
+		sqe->off	   = request.offset;
+		sqe->flags	   = request.link_next ? IOSQE_IO_LINK : 0;
+		sqe->user_data = slot_index;
+		if (registered_buffer) {
+			sqe->buf_index = static_cast<u16>(request.registered_buffer);
+		}
+
+		m_sqArray[index] = index;
+		m_localTail++;
+		m_inFlight++;
+		m_chainLength = request.link_next ? m_chainLength + 1 : 0;
+	}
+
+	virtual void submit() override {
+		submit_until(m_localTail);
+		m_chainLength = 0;
+	}
+
+	virtual u32 poll() override {
+		u32 completed = 0;
+		u32 head	  = *m_cqHead;
+		while (head != __atomic_load_n(m_cqTail, __ATOMIC_ACQUIRE)) {
+			const io_uring_cqe& cqe = m_cqes[head & *m_cqMask];
+			u32 slot_index			= static_cast<u32>(cqe.user_data);
+			AsyncIoCompletion completion{ cqe.res, m_slots[slot_index].user_data };
+			AsyncIoCallback callback = m_slots[slot_index].callback;
+
+			// Hand the entry and the slot back before the callback runs, it may queue more requests
+			__atomic_store_n(m_cqHead, ++head, __ATOMIC_RELEASE);
+			m_slots[slot_index].next_free = m_firstFreeSlot;
+			m_firstFreeSlot				  = slot_index;
+			m_inFlight--;
+			completed++;
+
+			if (callback != nullptr) {
+				callback(completion);
+			}
+			head = *m_cqHead;
+		}
+
+		return completed;
+	}
+
+	virtual void wait_for_completion() override {
+		if (*m_cqHead != __atomic_load_n(m_cqTail, __ATOMIC_ACQUIRE)) {
+			return;
+		}
+
+		while (syscall(SYS_io_uring_enter, m_ring, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0) < 0 && errno == EINTR) {}
+	}
+
+	virtual u32 in_flight() const override {
+		return m_inFlight;
+	}
+
+	virtual b8 uses_io_uring() const override {
+		return true;
+	}
+
+private:
+	struct Slot {
+		AsyncIoCallback callback;
+		void* user_data;
+		u32 next_free;
+	};
+
+	static constexpr u32 NO_SLOT = U32_MAX;
+
+	// Hands the queued entries before tail to the kernel
+	void submit_until(u32 tail) {
+		u32 to_submit = tail - m_submittedTail;
+		if (to_submit == 0) {
+			return;
+		}
+
+		__atomic_store_n(m_sqTail, tail, __ATOMIC_RELEASE);
+
+		while (to_submit > 0) {
+			i64 result = syscall(SYS_io_uring_enter, m_ring, to_submit, 0, 0, nullptr, 0);
+			if (result < 0) {
+				if (errno == EINTR) {
+					continue;
+				}
+				// The kernel is out of resources for now, reaping completions frees them up
+				if (errno == EAGAIN || errno == EBUSY) {
+					wait_for_completion();
+					continue;
+				}
+				TK_ASSERT(false, "io_uring_enter failed");
+				return;
+			}
+			to_submit -= static_cast<u32>(result);
+		}
+
+		m_submittedTail = tail;
+	}
+
+	b8 map_rings(i32 ring, const io_uring_params& params) {
+		m_ring		 = ring;
+		m_sqEntries	 = params.sq_entries;
+		m_sqRingSize = params.sq_off.array + params.sq_entries * sizeof(u32);
+		m_cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+
+		b8 single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+		if (single_mmap) {
+			m_sqRingSize = toki::max(m_sqRingSize, m_cqRingSize);
+			m_cqRingSize = m_sqRingSize;
+		}
+
+		m_sqRing = mmap(nullptr, m_sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring, IORING_OFF_SQ_RING);
+		if (m_sqRing == MAP_FAILED) {
+			m_sqRing = nullptr;
+			return false;
+		}
+
+		if (single_mmap) {
+			m_cqRing = m_sqRing;
+		} else {
+			m_cqRing =
+				mmap(nullptr, m_cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring, IORING_OFF_CQ_RING);
+			if (m_cqRing == MAP_FAILED) {
+				m_cqRing = nullptr;
+				return false;
+			}
+		}
+
+		m_sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+		void* sqes = mmap(nullptr, m_sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring, IORING_OFF_SQES);
+		if (sqes == MAP_FAILED) {
+			return false;
+		}
+		m_sqes = reinterpret_cast<io_uring_sqe*>(sqes);
+
+		byte* sq	= reinterpret_cast<byte*>(m_sqRing);
+		m_sqHead	= reinterpret_cast<u32*>(sq + params.sq_off.head);
+		m_sqTail	= reinterpret_cast<u32*>(sq + params.sq_off.tail);
+		m_sqMask	= reinterpret_cast<u32*>(sq + params.sq_off.ring_mask);
+		m_sqArray	= reinterpret_cast<u32*>(sq + params.sq_off.array);
+		m_localTail = *m_sqTail;
+
+		byte* cq = reinterpret_cast<byte*>(m_cqRing);
+		m_cqHead = reinterpret_cast<u32*>(cq + params.cq_off.head);
+		m_cqTail = reinterpret_cast<u32*>(cq + params.cq_off.tail);
+		m_cqMask = reinterpret_cast<u32*>(cq + params.cq_off.ring_mask);
+		m_cqes	 = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+		m_submittedTail = m_localTail;
+		m_slots.resize(params.cq_entries);
+		for (u32 i = 0; i < m_slots.size(); i++) {
+			m_slots[i].next_free = i + 1 < m_slots.size() ? i + 1 : NO_SLOT;
+		}
+		m_firstFreeSlot = 0;
+
+		return true;
+	}
+
+	i32 m_ring = -1;
+
+	void* m_sqRing{};
+	void* m_cqRing{};
+	u64 m_sqRingSize{};
+	u64 m_cqRingSize{};
+	u64 m_sqesSize{};
+
+	u32* m_sqHead{};
+	u32* m_sqTail{};
+	u32* m_sqMask{};
+	u32* m_sqArray{};
+	io_uring_sqe* m_sqes{};
+	u32 m_sqEntries{};
+	u32 m_localTail{};
+	u32 m_submittedTail{};
+	// Queued requests of a linked chain whose last request still has link_next set
+	u32 m_chainLength{};
+
+	u32* m_cqHead{};
+	u32* m_cqTail{};
+	u32* m_cqMask{};
+	io_uring_cqe* m_cqes{};
+
+	DynamicArray<Slot> m_slots;
+	u32 m_firstFreeSlot = NO_SLOT;
+	u32 m_inFlight{};
+	b8 m_buffersRegistered{};
+};
+
+//
+// Thread pool backend for kernels without io_uring (or where it is blocked, as in many containers)
+//
+
+class ThreadPoolBackend final : public AsyncIoBackend {
+public:
+	ThreadPoolBackend(const AsyncIoConfig& config) {
+		atomic_store(&m_running, 1);
+
+		ThreadConfig thread_config{};
+		thread_config.name		 = "toki-async-io";
+		thread_config.stack_size = KB(64);
+		for (u32 i = 0; i < toki::max(config.fallback_thread_count, 1u); i++) {
+			m_workers.emplace_back(toki::make_unique<Thread>(thread_config, [this]() {
+				worker_loop();
+			}));
+		}
+	}
+
+	virtual ~ThreadPoolBackend() override {
+		atomic_store(&m_running, 0);
+		signal(&m_workSignal);
+		m_workers.clear();
+	}
+
+	// Blocking reads don't go through page pinning, registration has nothing to do
+	virtual b8 register_buffers([[maybe_unused]] Span<AsyncIoBuffer> buffers) override {
+		return true;
+	}
+
+	virtual void queue(const AsyncIoRequest& request) override {
+		m_queued.push_back(request);
+		m_inFlight++;
+	}
+
+	virtual void submit() override {
+		if (m_queued.size() == 0) {
+			return;
+		}
+
+		{
+			ScopedLock lock(m_workMutex);
+			for (u32 i = 0; i < m_queued.size(); i++) {
+				m_work.push_back(m_queued[i]);
+			}
+		}
+		m_queued.clear();
+		signal(&m_workSignal);
+	}
+
+	virtual u32 poll() override {
+		{
+			ScopedLock lock(m_completedMutex);
+			for (u32 i = 0; i < m_completed.size(); i++) {
+				m_polled.push_back(m_completed[i]);
+			}
+			m_completed.clear();
+		}
+
+		u32 count = static_cast<u32>(m_polled.size());
+		for (u32 i = 0; i < count; i++) {
+			m_inFlight--;
+			if (m_polled[i].callback != nullptr) {
+				m_polled[i].callback(m_polled[i].completion);
+			}
+		}
+		m_polled.clear();
+
+		return count;
+	}
+
+	virtual void wait_for_completion() override {
+		while (true) {
+			i32 signal_value = atomic_load(&m_completedSignal);
+			{
+				ScopedLock lock(m_completedMutex);
+				if (m_completed.size() > 0) {
+					return;
+				}
+			}
+			atomic_wait(&m_completedSignal, signal_value);
+		}
+	}
+
+	virtual u32 in_flight() const override {
+		return m_inFlight;
+	}
+
+	virtual b8 uses_io_uring() const override {
+		return false;
+	}
+
+private:
+	struct Completed {
+		AsyncIoCallback callback;
+		AsyncIoCompletion completion;
+	};
+
+	static void signal(i32* value) {
+		atomic_fetch_add(value, 1);
+		atomic_notify_all(value);
+	}
+
+	// Takes the oldest request together with every request linked to it, a chain always runs on one worker
+	b8 take_chain(DynamicArray<AsyncIoRequest>& chain_out) {
+		ScopedLock lock(m_workMutex);
+		if (m_workHead == m_work.size()) {
+			return false;
+		}
+
+		do {
+			chain_out.push_back(m_work[m_workHead++]);
+		} while (chain_out.last().link_next && m_workHead < m_work.size());
+
+		if (m_workHead == m_work.size()) {
+			m_work.clear();
+			m_workHead = 0;
+		}
+		return true;
+	}
+
+	void worker_loop() {
+		DynamicArray<AsyncIoRequest> chain;
+		DynamicArray<Completed> completed;
+
+		for (;;) {
+			// Read before checking m_running, a shutdown signalled in between changes the value and
+			// atomic_wait returns right away instead of missing the wakeup
+			i32 signal_value = atomic_load(&m_workSignal);
+			if (atomic_load(&m_running) == 0) {
+				return;
+			}
+			if (!take_chain(chain)) {
+				atomic_wait(&m_workSignal, signal_value);
+				continue;
+			}
+
+			b8 cancelled = false;
+			for (u32 i = 0; i < chain.size(); i++) {
+				i64 result = cancelled ? -ECANCELED : execute_request(chain[i]);
+				// Same rule as io_uring, a failed or short transfer breaks the chain
+				cancelled = cancelled || result != static_cast<i64>(chain[i].size);
+				completed.push_back({ chain[i].callback, { result, chain[i].user_data } });
+			}
+			chain.clear();
+
+			{
+				ScopedLock lock(m_completedMutex);
+				for (u32 i = 0; i < completed.size(); i++) {
+					m_completed.push_back(completed[i]);
+				}
+			}
+			completed.clear();
+			signal(&m_completedSignal);
+		}
+	}
+
+	DynamicArray<UniquePtr<Thread>> m_workers;
+	i32 m_running{};
+
+	// Owned by the submitting thread
+	DynamicArray<AsyncIoRequest> m_queued;
+	DynamicArray<Completed> m_polled;
+	u32 m_inFlight{};
+
+	Mutex m_workMutex;
+	DynamicArray<AsyncIoRequest> m_work;
+	u64 m_workHead{};
+	i32 m_workSignal{};
+
+	Mutex m_completedMutex;
+	DynamicArray<Completed> m_completed;
+	i32 m_completedSignal{};
+};
+
+#define BACKEND reinterpret_cast<AsyncIoBackend*>(m_internalData)
+
+AsyncIo::AsyncIo(const AsyncIoConfig& config) {
+	if (!config.force_fallback) {
+		m_internalData = IoUringBackend::create(config);
+	}
+
+	if (m_internalData == nullptr) {
+		TK_LOG_INFO("io_uring is not available, using thread pool for async I/O");
+		m_internalData = construct_at<ThreadPoolBackend>(
+			DefaultAllocator::allocate_aligned(sizeof(ThreadPoolBackend), alignof(ThreadPoolBackend)), config);
+	}
+}
+
+AsyncIo::~AsyncIo() {
+	wait_all();
+	BACKEND->~AsyncIoBackend();
+	DefaultAllocator::free_aligned(m_internalData);
+}
+
+b8 AsyncIo::register_buffers(Span<AsyncIoBuffer> buffers) {
+	return BACKEND->register_buffers(buffers);
+}
+
+void AsyncIo::queue(const AsyncIoRequest& request) {
+	TK_ASSERT(request.buffer != nullptr);
+	BACKEND->queue(request);
+}
+
+void AsyncIo::submit() {
+	BACKEND->submit();
+}
+
+u32 AsyncIo::poll() {
+	return BACKEND->poll();
+}
+
+void AsyncIo::wait_all() {
+	submit();
+	while (in_flight() > 0) {
+		if (poll() == 0) {
+			BACKEND->wait_for_completion();
+		}
+	}
+}
+
+u32 AsyncIo::in_flight() const {
+	return BACKEND->in_flight();
+}
+
+b8 AsyncIo::uses_io_uring() const {
+	return BACKEND->uses_io_uring();
+}
+
+}  // namespace toki
@@ -0,0 +1,174 @@
+#include <fcntl.h>
+#include <toki/core/platform/threads/cpu_topology.h>
+#include <toki/core/string/converters.h>
+#include <unistd.h>
+
+namespace toki {
+
+static constexpr const char* CPU_SYSFS_PATH	 = "/sys/devices/system/cpu/";
+static constexpr const char* NODE_SYSFS_PATH = "/sys/devices/system/node/";
+
+// Reads a small sysfs file into a null terminated buffer, missing files are expected (no NUMA
+// support, offline CPUs, ...) so the regular platform open that asserts on failure is not used
+static b8 read_sysfs_file(const char* path, char* buf_out, u64 size) {
+	i32 fd = ::open(path, O_RDONLY);
+	if (fd == -1) {
+		return false;
+	}
+
+	i64 read_bytes = ::read(fd, buf_out, size - 1);
+	::close(fd);
+	if (read_bytes <= 0) {
+		return false;
+	}
+
+	buf_out[read_bytes] = '\0';
+	return true;
+}
+
+// Builds paths like /sys/devices/system/cpu/cpu3/topology/core_id
+static const char* build_path(char* buf_out, const char* base, const char* prefix, u32 index, const char* suffix) {
+	u64 length = toki::strlen(base);
+	toki::memcpy(buf_out, base, length);
+	toki::memcpy(&buf_out[length], prefix, toki::strlen(prefix));
+	length += toki::strlen(prefix);
+	length += toki::itoa(&buf_out[length], index);
+	u64 suffix_length = toki::strlen(suffix);
+	toki::memcpy(&buf_out[length], suffix, suffix_length + 1);
+	return buf_out;
+}
+
+static b8 read_sysfs_u32(const char* path, u32& out_value) {
+	char buf[32];
+	if (!read_sysfs_file(path, buf, sizeof(buf))) {
+		return false;
+	}
+	return toki::atoi(buf, out_value) > 0;
+}
+
+CpuMask parse_cpu_list(const char* list) {
+	CpuMask mask{};
+	const char* it = list;
+	while (toki::is_digit(*it)) {
+		u32 first = 0;
+		it += toki::atoi(it, first);
+
+		u32 last = first;
+		if (*it == '-') {
+			it++;
+			it += toki::atoi(it, last);
+		}
+
+		for (u32 i = first; i <= last && i < MAX_CPU_COUNT; i++) {
+			mask.set(i, true);
+		}
+
+		if (*it != ',') {
+			break;
+		}
+		it++;
+	}
+	return mask;
+}
+
+CpuMask CpuTopology::physical_core_mask(u32 physical_core) const {
+	CpuMask mask{};
+	for (u32 i = 0; i < logical_cpus.size(); i++) {
+		if (logical_cpus[i].physical_core == physical_core) {
+			mask.set(logical_cpus[i].id, true);
+		}
+	}
+	return mask;
+}
+
+CpuMask CpuTopology::numa_node_mask(u32 numa_node) const {
+	CpuMask mask{};
+	for (u32 i = 0; i < logical_cpus.size(); i++) {
+		if (logical_cpus[i].numa_node == numa_node) {
+			mask.set(logical_cpus[i].id, true);
+		}
+	}
+	return mask;
+}
+
+CpuTopology query_cpu_topology() {
+	CpuTopology topology{};
+	char path[128];
+	char buf[1024];
+
+	CpuMask online{};
+	if (read_sysfs_file("/sys/devices/system/cpu/online", buf, sizeof(buf))) {
+		online = parse_cpu_list(buf);
+	}
+
+	// Physical cores are identified by (package, core_id), core ids are only unique within a package
+	struct CoreKey {
+		u32 package;
+		u32 core_id;
+	};
+	DynamicArray<CoreKey> core_keys;
+
+	for (u32 cpu = 0; cpu < MAX_CPU_COUNT; cpu++) {
+		if (!online[cpu]) {
+			continue;
+		}
+
+		LogicalCpu logical_cpu{};
+		logical_cpu.id = cpu;
+
+		u32 core_id = cpu;
+		read_sysfs_u32(
+			build_path(path, CPU_SYSFS_PATH, "cpu", cpu, "/topology/physical_package_id"), logical_cpu.package);
+		read_sysfs_u32(build_path(path, CPU_SYSFS_PATH, "cpu", cpu, "/topology/core_id"), core_id);
+
+		u32 core_index = 0;
+		for (; core_index < core_keys.size(); core_index++) {
+			if (core_keys[core_index].package == logical_cpu.package && core_keys[core_index].core_id == core_id) {
+				break;
+			}
+		}
+		if (core_index == core_keys.size()) {
+			core_keys.emplace_back(logical_cpu.package, core_id);
+			topology.physical_cores.push_back(cpu);
+		}
+
+		logical_cpu.physical_core = core_index;
+		topology.package_count	  = toki::max(topology.package_count, logical_cpu.package + 1);
+		topology.logical_cpus.push_back(logical_cpu);
+	}
+
+	// Fall back to whatever the scheduler reports when sysfs is not mounted
+	if (topology.logical_cpus.size() == 0) {
+		i64 cpu_count = toki::min(sysconf(_SC_NPROCESSORS_ONLN), static_cast<i64>(MAX_CPU_COUNT));
+		for (u32 cpu = 0; cpu < static_cast<u32>(toki::max(cpu_count, static_cast<i64>(1))); cpu++) {
+			topology.logical_cpus.push_back({ cpu, cpu, 0, 0 });
+			topology.physical_cores.push_back(cpu);
+		}
+		topology.package_count = 1;
+	}
+
+	topology.numa_node_count = 1;
+	if (read_sysfs_file("/sys/devices/system/node/online", buf, sizeof(buf))) {
+		CpuMask nodes = parse_cpu_list(buf);
+		for (u32 node = 0; node < MAX_CPU_COUNT; node++) {
+			if (!nodes[node]) {
+				continue;
+			}
+			if (!read_sysfs_file(build_path(path, NODE_SYSFS_PATH, "node", node, "/cpulist"), buf, sizeof(buf))) {
+				continue;
+			}
+
+			CpuMask node_cpus = parse_cpu_list(buf);
+			for (u32 i = 0; i < topology.logical_cpus.size(); i++) {
+				if (node_cpus[topology.logical_cpus[i].id]) {
+					topology.logical_cpus[i].numa_node = node;
+				}
+			}
+			topology.numa_node_count = toki::max(topology.numa_node_count, node + 1);
+		}
+	}
+
+	return topology;
+}
+
+}  // namespace toki
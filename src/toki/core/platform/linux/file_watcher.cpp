@@ -0,0 +1,219 @@
+#include <dirent.h>
+#include <sys/inotify.h>
+#include <toki/core/common/common.h>
+#include <toki/core/common/log.h>
+#include <toki/core/common/time.h>
+#include <toki/core/memory/memory.h>
+#include <toki/core/platform/file_watcher.h>
+#include <toki/core/utils/bytes.h>
+#include <unistd.h>
+
+#include <cerrno>
+
+namespace toki {
+
+// Written files are reported once they are closed, files saved through a temporary file show up
+// as moved in. Directories are also watched for creation so new subdirectories get watches.
+static constexpr u32 WATCH_MASK = IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_ONLYDIR;
+
+struct WatchedDirectory {
+	i32 descriptor;
+	Path path;
+	b8 recursive;
+};
+
+struct PendingChange {
+	Path path;
+	// Milliseconds of the last event for this file
+	f64 last_event;
+};
+
+struct FileWatcherState {
+	i32 inotify{};
+	FileWatcherConfig config{};
+	DynamicArray<WatchedDirectory> directories;
+	DynamicArray<PendingChange> pending;
+};
+
+static Path join_path(const char* directory, const char* name) {
+	u64 directory_size = toki::strlen(directory);
+	u64 name_size	   = toki::strlen(name);
+
+	String<> joined(directory_size + 1 + name_size);
+	toki::memcpy(joined.data(), directory, directory_size);
+	joined.data()[directory_size] = '/';
+	toki::memcpy(joined.data() + directory_size + 1, name, name_size);
+	return Path(StringView(joined));
+}
+
+static b8 paths_equal(const Path& lhs, const Path& rhs) {
+	u64 size = toki::strlen(lhs.c_str());
+	return size == toki::strlen(rhs.c_str()) && toki::strncmp(lhs.c_str(), rhs.c_str(), size) == 0;
+}
+
+static b8 add_watch(FileWatcherState* state, const Path& directory, b8 recursive) {
+	i32 descriptor = inotify_add_watch(state->inotify, directory.c_str(), WATCH_MASK);
+	if (descriptor < 0) {
+		TK_LOG_WARN("Could not watch directory {}, errno {}", directory.c_str(), errno);
+		return false;
+	}
+
+	// Watching the same directory twice returns the existing descriptor
+	for (u32 i = 0; i < state->directories.size(); i++) {
+		if (state->directories[i].descriptor == descriptor) {
+			return true;
+		}
+	}
+	state->directories.emplace_back(descriptor, directory, recursive);
+
+	if (!recursive) {
+		return true;
+	}
+
+	DIR* dir = opendir(directory.c_str());
+	if (dir == nullptr) {
+		return true;
+	}
+
+	while (dirent* entry = readdir(dir)) {
+		// Skips . and .. as well as hidden directories like .git
+		if (entry->d_type != DT_DIR || toki::strncmp(entry->d_name, ".", 1) == 0) {
+			continue;
+		}
+		add_watch(state, join_path(directory.c_str(), entry->d_name), true);
+	}
+	closedir(dir);
+
+	return true;
+}
+
+static const WatchedDirectory* find_directory(const FileWatcherState* state, i32 descriptor) {
+	for (u32 i = 0; i < state->directories.size(); i++) {
+		if (state->directories[i].descriptor == descriptor) {
+			return &state->directories[i];
+		}
+	}
+	return nullptr;
+}
+
+static void record_change(FileWatcherState* state, Path&& path, f64 now) {
+	for (u32 i = 0; i < state->pending.size(); i++) {
+		if (paths_equal(state->pending[i].path, path)) {
+			state->pending[i].last_event = now;
+			return;
+		}
+	}
+	state->pending.emplace_back(toki::move(path), now);
+}
+
+static void read_events(FileWatcherState* state) {
+	// Aligned the way inotify_event needs, a read returns whole events only
+	alignas(inotify_event) char buffer[KB(4)];
+
+	f64 now = Time::now().as<TimePrecision::Millis>();
+	while (true) {
+		i64 size = ::read(state->inotify, buffer, sizeof(buffer));
+		if (size <= 0) {
+			if (size < 0 && errno == EINTR) {
+				continue;
+			}
+			break;
+		}
+
+		for (i64 offset = 0; offset < size;) {
+			const inotify_event* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+			offset += sizeof(inotify_event) + event->len;
+
+			if (event->mask & IN_Q_OVERFLOW) {
+				TK_LOG_WARN("File watcher queue overflowed, some changes were missed");
+				continue;
+			}
+
+			const WatchedDirectory* directory = find_directory(state, event->wd);
+			if (directory == nullptr || event->len == 0) {
+				continue;
+			}
+
+			Path path = join_path(directory->path.c_str(), event->name);
+			if (event->mask & IN_ISDIR) {
+				if (directory->recursive && event->mask & (IN_CREATE | IN_MOVED_TO)) {
+					add_watch(state, path, true);
+				}
+				continue;
+			}
+
+			// Created files are reported once they are closed after writing
+			if (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO)) {
+				record_change(state, toki::move(path), now);
+			}
+		}
+	}
+}
+
+#define STATE reinterpret_cast<FileWatcherState*>(m_internalData)
+
+FileWatcher::FileWatcher(const FileWatcherConfig& config) {
+	FileWatcherState* state = construct_at<FileWatcherState>(
+		DefaultAllocator::allocate_aligned(sizeof(FileWatcherState), alignof(FileWatcherState)));
+	state->config  = config;
+	state->inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (state->inotify < 0) {
+		TK_LOG_WARN("Could not initialize inotify, errno {}", errno);
+	}
+	m_internalData = state;
+}
+
+FileWatcher::~FileWatcher() {
+	if (STATE->inotify >= 0) {
+		::close(STATE->inotify);
+	}
+	// DynamicArray does not destroy its elements
+	STATE->directories.clear();
+	STATE->pending.clear();
+	STATE->~FileWatcherState();
+	DefaultAllocator::free_aligned(m_internalData);
+}
+
+b8 FileWatcher::watch_directory(const Path& directory, b8 recursive) {
+	if (STATE->inotify < 0) {
+		return false;
+	}
+	return add_watch(STATE, directory, recursive);
+}
+
+u32 FileWatcher::poll(DynamicArray<Path>& changed_out) {
+	if (STATE->inotify < 0) {
+		return 0;
+	}
+
+	read_events(STATE);
+	if (STATE->pending.size() == 0) {
+		return 0;
+	}
+
+	f64 now			  = Time::now().as<TimePrecision::Millis>();
+	u32 changed_count = 0;
+
+	// Reported changes are moved out, the ones still settling are compacted to the front
+	u32 kept_count = 0;
+	for (u32 i = 0; i < STATE->pending.size(); i++) {
+		PendingChange& change = STATE->pending[i];
+		if (now - change.last_event >= STATE->config.debounce_ms) {
+			changed_out.emplace_back(toki::move(change.path));
+			changed_count++;
+		} else {
+			if (kept_count != i) {
+				toki::swap(STATE->pending[kept_count], change);
+			}
+			kept_count++;
+		}
+	}
+	for (u32 i = kept_count; i < STATE->pending.size(); i++) {
+		toki::destroy_at(&STATE->pending[i]);
+	}
+	STATE->pending.shrink_to_size(kept_count);
+
+	return changed_count;
+}
+
+}  // namespace toki
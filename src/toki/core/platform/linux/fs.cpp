@@ -1,4 +1,8 @@
+#include <errno.h>
 #include <fcntl.h>
+#include <stdio.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <unistd.h>
 
 #include "toki/core/common/assert.h"
@@ -34,7 +38,6 @@ toki::Expected<NativeHandle, TokiError> open(const char* filename, FileMode mode
 
 	i64 result = ::open(filename, linux_flags, 0777);  // All permissions for now
 	if (result == -1) {
-		TK_ASSERT(false, "Need to handle error");
 		return toki::Unexpected(TokiError::FileOpen);
 	}
 
@@ -84,4 +87,65 @@ toki::Expected<u64, TokiError> get_file_pointer(NativeHandle handle) {
 	return static_cast<u64>(result);
 }
 
+toki::Expected<u64, TokiError> get_file_size(NativeHandle handle) {
+	struct stat file_stat{};
+	if (::fstat(handle.handle, &file_stat) == -1) {
+		return TokiError::Unknown;
+	}
+
+	return static_cast<u64>(file_stat.st_size);
+}
+
+toki::Optional<TokiError> create_directory(const char* path) {
+	if (::mkdir(path, 0777) == -1 && errno != EEXIST) {
+		return toki::Optional{ TokiError::Unknown };
+	}
+
+	return toki::NullOpt{};
+}
+
+toki::Optional<TokiError> rename_file(const char* from, const char* to) {
+	if (::rename(from, to) == -1) {
+		return toki::Optional{ TokiError::Unknown };
+	}
+
+	return toki::NullOpt{};
+}
+
+toki::Expected<const void*, TokiError> map_file(NativeHandle handle, u64 size, FileAccessHint hint) {
+	void* ptr = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, handle.handle, 0);
+	if (ptr == MAP_FAILED) {
+		return toki::Unexpected(TokiError::FileMap);
+	}
+
+	switch (hint) {
+		case FileAccessHint::NORMAL:
+			break;
+		case FileAccessHint::SEQUENTIAL:
+			// Advice values are not flags, they have to be given one at a time
+			::madvise(ptr, size, MADV_SEQUENTIAL);
+			::madvise(ptr, size, MADV_WILLNEED);
+			break;
+		case FileAccessHint::RANDOM:
+			::madvise(ptr, size, MADV_RANDOM);
+			break;
+	}
+
+	return static_cast<const void*>(ptr);
+}
+
+void unmap_file(const void* ptr, u64 size) {
+	::munmap(const_cast<void*>(ptr), size);
+}
+
+toki::Optional<TokiError> drop_file_cache(NativeHandle handle) {
+	// Dirty pages are skipped by the kernel, write them back first
+	::fdatasync(handle.handle);
+	if (::posix_fadvise(handle.handle, 0, 0, POSIX_FADV_DONTNEED) != 0) {
+		return toki::Optional{ TokiError::Unknown };
+	}
+
+	return toki::NullOpt{};
+}
+
 }  // namespace toki
@@ -9,8 +9,8 @@ namespace toki {
 toki::Expected<u64, TokiError> write(NativeHandle handle, const void* data, u64 size) {
 	i64 result = ::write(static_cast<i32>(handle), data, size);
 	if (result == -1) {
-		TK_ASSERT(false, "Need to handle error");
-		return toki::Unexpected(TokiError::Unknown);
+		// Full disks and files not opened for writing end up here, callers see a failed write
+		return toki::Unexpected(TokiError::FileWrite);
 	}
 
 	return static_cast<u64>(result);
@@ -4,18 +4,44 @@
 
 namespace toki {
 
+// The size of the mapping is stored in front of the returned memory, the header is 16 bytes so the
+// memory stays aligned for SSE types
+static constexpr u64 ALLOCATION_HEADER_SIZE = 16;
+
 toki::Expected<void*, TokiError> allocate(u64 size) {
-	void* ptr = mmap(0, size + sizeof(u64), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_STACK, -1, 0);
-	if (ptr == nullptr) {
+	u64 mapped_size = size + ALLOCATION_HEADER_SIZE;
+	void* ptr = mmap(0, mapped_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_STACK, -1, 0);
+	if (ptr == MAP_FAILED) {
 		return TokiError::MEMORY_ALLOCATION_FAILED;
 	}
 
-	*reinterpret_cast<u64*>(ptr) = size;
-	return reinterpret_cast<u64*>(ptr) + 1;
+	*reinterpret_cast<u64*>(ptr) = mapped_size;
+	return reinterpret_cast<byte*>(ptr) + ALLOCATION_HEADER_SIZE;
 }
 
 void free(void* ptr) {
-	u64 size = *(reinterpret_cast<u64*>(ptr) - 1);
+	byte* mapping = reinterpret_cast<byte*>(ptr) - ALLOCATION_HEADER_SIZE;
+	munmap(mapping, *reinterpret_cast<u64*>(mapping));
+}
+
+toki::Expected<void*, TokiError> reserve_memory(u64 size) {
+	void* ptr = mmap(0, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+	if (ptr == MAP_FAILED) {
+		return TokiError::MEMORY_ALLOCATION_FAILED;
+	}
+
+	return ptr;
+}
+
+toki::Optional<TokiError> commit_memory(void* ptr, u64 size) {
+	if (mprotect(ptr, size, PROT_READ | PROT_WRITE) != 0) {
+		return toki::Optional{ TokiError::MEMORY_ALLOCATION_FAILED };
+	}
+
+	return toki::NullOpt{};
+}
+
+void release_memory(void* ptr, u64 size) {
 	munmap(ptr, size);
 }
 
@@ -7,28 +7,26 @@
 namespace toki {
 
 void Mutex::lock() {
-	while (true) {
-		MutexState expected = MUTEX_UNLOCKED;
-
-		if (atomic_compare_exchange_strong(&m_state, &expected, MUTEX_LOCKED)) {
-			return;
-		}
+	MutexState expected = MUTEX_UNLOCKED;
+	if (atomic_compare_exchange_strong(&m_state, &expected, MUTEX_LOCKED)) {
+		return;
+	}
 
-		while (atomic_load(&m_state) == MUTEX_LOCKED) {
-			syscall(SYS_futex, &m_state, FUTEX_WAIT, MUTEX_LOCKED, nullptr, nullptr, 0);
-		}
+	// Mark the mutex as contended so unlock knows it has to wake someone up
+	while (atomic_exchange(&m_state, MUTEX_CONTENDED) != MUTEX_UNLOCKED) {
+		syscall(SYS_futex, &m_state, FUTEX_WAIT_PRIVATE, MUTEX_CONTENDED, nullptr, nullptr, 0);
 	}
 }
 
 void Mutex::unlock() {
-	atomic_store(&m_state, MUTEX_UNLOCKED);
-	syscall(SYS_futex, &m_state, FUTEX_WAKE, 1, nullptr, nullptr, 0);
+	if (atomic_exchange(&m_state, MUTEX_UNLOCKED) == MUTEX_CONTENDED) {
+		syscall(SYS_futex, &m_state, FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+	}
 }
 
 b8 Mutex::try_lock() {
 	MutexState expected = MUTEX_UNLOCKED;
-	i32 value			= atomic_load(&m_state);
-	return atomic_compare_exchange_strong(&value, &expected, MUTEX_LOCKED);
+	return atomic_compare_exchange_strong(&m_state, &expected, MUTEX_LOCKED);
 }
 
 }  // namespace toki
@@ -1,20 +1,120 @@
-#include <linux/futex.h>
-#include <linux/sched.h>
+#include <linux/mempolicy.h>
+#include <pthread.h>
 #include <sched.h>
-#include <sys/wait.h>
+#include <sys/mman.h>
+#include <sys/prctl.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <toki/core/common/log.h>
 #include <toki/core/common/print.h>
 #include <toki/core/platform/threads/thread.h>
-
-#include <cerrno>
+#include <unistd.h>
 
 namespace toki {
 
-void Thread::_start_internal(void* stack_top, void* ptr) {
-	i32 flags = CLONE_VM | CLONE_FS | CLONE_FILES | CLONE_SIGHAND | CLONE_THREAD | SIGCHLD | CLONE_CHILD_CLEARTID;
+void* Thread::_allocate_stack(u64 size, b8 guard_page) {
+	u64 guard_size	   = guard_page ? STACK_ALIGNMENT : 0;
+	m_stackMappingSize = size + guard_size;
+	m_stackMapping =
+		mmap(nullptr, m_stackMappingSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_STACK, -1, 0);
+	if (m_stackMapping == MAP_FAILED) {
+		m_stackMapping = nullptr;
+		return nullptr;
+	}
+
+	if (guard_page) {
+		mprotect(m_stackMapping, guard_size, PROT_NONE);
+	}
+
+	return reinterpret_cast<byte*>(m_stackMapping) + guard_size;
+}
+
+// Threads are started through pthreads instead of a raw clone so that every thread gets
+// its own TLS block, libc and driver code called from other threads rely on that
+void Thread::_start_internal(void* stack, u64 stack_size, State* state) {
+	pthread_attr_t attributes;
+	pthread_attr_init(&attributes);
+	pthread_attr_setstack(&attributes, stack, stack_size);
+
+	pthread_t thread{};
+	i32 result = pthread_create(
+		&thread,
+		&attributes,
+		[](void* argument) -> void* {
+			Thread::_trampoline(argument);
+			return nullptr;
+		},
+		state);
+	pthread_attr_destroy(&attributes);
+
+	if (result != 0) {
+		toki::println("Can't create thread {}", result);
+		return;
+	}
+
+	m_handle = static_cast<ThreadHandle>(thread);
+}
+
+void Thread::_destroy_internal() {
+	if (m_handle != 0) {
+		pthread_join(static_cast<pthread_t>(m_handle), nullptr);
+		m_handle = 0;
+	}
+
+	if (m_stackMapping != nullptr) {
+		munmap(m_stackMapping, m_stackMappingSize);
+		m_stackMapping = nullptr;
+	}
+}
+
+void Thread::_apply_config(State* state) {
+	const ThreadConfig& config = state->config;
+
+	if (state->name[0] != '\0') {
+		prctl(PR_SET_NAME, state->name, 0, 0, 0);
+	}
+
+	if (config.affinity.get_first_with_value(true).has_value()) {
+		cpu_set_t cpu_set;
+		CPU_ZERO(&cpu_set);
+		for (u32 i = 0; i < MAX_CPU_COUNT; i++) {
+			if (config.affinity[i]) {
+				CPU_SET(i, &cpu_set);
+			}
+		}
+
+		if (sched_setaffinity(0, sizeof(cpu_set), &cpu_set) != 0) {
+			TK_LOG_WARN("Could not set affinity for thread {}", state->name);
+		}
+	}
+
+	switch (config.priority) {
+		case ThreadPriority::NORMAL:
+			// Nice values are per thread on Linux when given a thread id
+			if (config.nice != 0 && setpriority(PRIO_PROCESS, static_cast<id_t>(gettid()), config.nice) != 0) {
+				TK_LOG_WARN("Could not set nice value {} for thread {}", config.nice, state->name);
+			}
+			break;
+		case ThreadPriority::REALTIME: {
+			sched_param param{};
+			param.sched_priority = config.realtime_priority;
+			if (pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) != 0) {
+				TK_LOG_WARN("Could not set SCHED_FIFO priority for thread {}", state->name);
+			}
+			break;
+		}
+	}
 
-	m_pid = clone(Thread::_trampoline, stack_top, flags, ptr);
-	if (m_pid == -1) {
-		toki::println("Can't create thread {}", errno);
+	// Nodes are numbered below the CPU count, the mask has one bit per CPU
+	if (config.numa_node >= static_cast<i32>(MAX_CPU_COUNT)) {
+		TK_LOG_WARN("NUMA node {} of thread {} is out of range", config.numa_node, state->name);
+	} else if (config.numa_node >= 0) {
+		// Called directly to not depend on libnuma
+		u64 node_mask[MAX_CPU_COUNT / 64]{};
+		node_mask[config.numa_node / 64] = BIT(config.numa_node % 64);
+		if (syscall(SYS_set_mempolicy, MPOL_PREFERRED, node_mask, MAX_CPU_COUNT + 1) != 0) {
+			TK_LOG_WARN("Could not set preferred NUMA node {} for thread {}", config.numa_node, state->name);
+		}
 	}
 }
 
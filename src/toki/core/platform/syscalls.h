@@ -15,6 +15,11 @@ toki::Expected<void*, TokiError> allocate(u64 size);
 
 void free(void* ptr);
 
+// Reserves address space without backing it with memory, ranges have to be committed before use
+toki::Expected<void*, TokiError> reserve_memory(u64 size);
+toki::Optional<TokiError> commit_memory(void* ptr, u64 size);
+void release_memory(void* ptr, u64 size);
+
 toki::Expected<u64, TokiError> write(NativeHandle handle, const void* data, u64 size);
 
 toki::Expected<u64, TokiError> read(NativeHandle handle, void* data, u64 size);
@@ -24,6 +29,19 @@ toki::Optional<TokiError> close(NativeHandle handle);
 toki::Expected<i64, TokiError> set_file_pointer(
 	NativeHandle handle, i64 position, FileCursorStart start_from = FileCursorStart::CURRENT);
 toki::Expected<u64, TokiError> get_file_pointer(NativeHandle handle);
+toki::Expected<u64, TokiError> get_file_size(NativeHandle handle);
+// Succeeds when the directory already exists
+toki::Optional<TokiError> create_directory(const char* path);
+// Replaces to when it exists, readers of to see either the old or the new file and never a mix
+toki::Optional<TokiError> rename_file(const char* from, const char* to);
+
+// Maps size bytes of the file read only, the mapping stays valid after the handle is closed
+toki::Expected<const void*, TokiError> map_file(
+	NativeHandle handle, u64 size, FileAccessHint hint = FileAccessHint::NORMAL);
+void unmap_file(const void* ptr, u64 size);
+
+// Asks the kernel to drop the cached pages of the file, the next read goes to the disk
+toki::Optional<TokiError> drop_file_cache(NativeHandle handle);
 
 // Current time in nanoseconds since epoch
 toki::u64 get_current_time();
@@ -15,7 +15,12 @@ inline void atomic_store(i32* t, const i32 value) {
 }
 
 inline i32 atomic_exchange(i32* t, const i32 desired) {
-	return __atomic_exchange_n(t, desired, __ATOMIC_ACQUIRE);
+	return __atomic_exchange_n(t, desired, __ATOMIC_ACQ_REL);
+}
+
+// Returns the value before the addition
+inline i32 atomic_fetch_add(i32* t, const i32 value) {
+	return __atomic_fetch_add(t, value, __ATOMIC_ACQ_REL);
 }
 
 inline b8 atomic_compare_exchange_strong(i32* ptr, i32* expected, const i32 desired) {
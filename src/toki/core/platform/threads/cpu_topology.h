@@ -0,0 +1,38 @@
+#pragma once
+
+#include <toki/core/containers/dynamic_array.h>
+#include <toki/core/platform/threads/thread.h>
+#include <toki/core/types.h>
+
+namespace toki {
+
+struct LogicalCpu {
+	// Index the OS uses for this CPU, also the bit in CpuMask
+	u32 id;
+	// Dense index into CpuTopology::physical_cores, shared by SMT siblings
+	u32 physical_core;
+	u32 package;
+	u32 numa_node;
+};
+
+struct CpuTopology {
+	DynamicArray<LogicalCpu> logical_cpus;
+	// One logical CPU id per physical core (the lowest id of its siblings), pinning one
+	// worker to each of these keeps workers from competing for the same core
+	DynamicArray<u32> physical_cores;
+	u32 package_count{};
+	u32 numa_node_count{};
+
+	// All logical CPUs of a physical core
+	CpuMask physical_core_mask(u32 physical_core) const;
+	CpuMask numa_node_mask(u32 numa_node) const;
+};
+
+// Reads the layout of online CPUs, falls back to one core per logical CPU in a single
+// package and NUMA node when the information is not available
+CpuTopology query_cpu_topology();
+
+// Parses the kernel cpulist format, for example "0-3,8,10-11", CPUs past MAX_CPU_COUNT are dropped
+CpuMask parse_cpu_list(const char* list);
+
+}  // namespace toki
@@ -22,6 +22,8 @@ public:
 
 	static constexpr MutexState MUTEX_UNLOCKED = 0;
 	static constexpr MutexState MUTEX_LOCKED   = 1;
+	// Locked with at least one thread possibly sleeping on the futex
+	static constexpr MutexState MUTEX_CONTENDED = 2;
 
 private:
 	i32 m_state;
@@ -2,16 +2,46 @@
 
 #include <toki/core/common/assert.h>
 #include <toki/core/common/utility.h>
+#include <toki/core/containers/bitset.h>
 #include <toki/core/containers/tuple.h>
+#include <toki/core/math/math.h>
 #include <toki/core/memory/unique_ptr.h>
 #include <toki/core/platform/platform_types.h>
 #include <toki/core/platform/threads/atomic.h>
 #include <toki/core/platform/threads/mutex.h>
+#include <toki/core/utils/bytes.h>
 #include <toki/core/utils/memory.h>
 
 namespace toki {
 
-using ThreadHandle = i32;
+using ThreadHandle = u64;
+
+static constexpr u32 MAX_CPU_COUNT = 256;
+using CpuMask					   = Bitset<MAX_CPU_COUNT>;
+
+enum struct ThreadPriority {
+	// Default time sharing scheduler, ThreadConfig::nice adjusts the priority
+	NORMAL,
+	// SCHED_FIFO with ThreadConfig::realtime_priority, needs CAP_SYS_NICE or a matching RLIMIT_RTPRIO
+	REALTIME,
+};
+
+struct ThreadConfig {
+	// Shown in debuggers and /proc/<pid>/task/<tid>/comm, truncated to 15 characters
+	const char* name{};
+	u64 stack_size = MB(1);
+	// Maps an inaccessible page below the stack so an overflow faults instead of corrupting memory
+	b8 guard_page = true;
+	// CPUs the thread may run on, no bits set means no restriction
+	CpuMask affinity{};
+	ThreadPriority priority = ThreadPriority::NORMAL;
+	// -20 (highest) to 19 (lowest)
+	i32 nice = 0;
+	// 1 (lowest) to 99 (highest)
+	i32 realtime_priority = 1;
+	// Preferred NUMA node for memory the thread touches first, -1 keeps the default policy
+	i32 numa_node = -1;
+};
 
 class Thread {
 private:
@@ -20,6 +50,8 @@ private:
 		virtual void invoke() = 0;
 
 		i32 joinable{};
+		ThreadConfig config{};
+		char name[16]{};
 	};
 
 	template <typename Callable>
@@ -57,39 +89,68 @@ public:
 	template <typename Callable, typename... Args>
 		requires CIsCorrectCallable<Callable, void, Args...>
 	explicit Thread(Callable&& callable, Args&&... args) {
-		start_thread(toki::forward<Callable>(callable), toki::forward<Args>(args)...);
+		start_thread(ThreadConfig{}, toki::forward<Callable>(callable), toki::forward<Args>(args)...);
+	}
+
+	template <typename Callable, typename... Args>
+		requires CIsCorrectCallable<Callable, void, Args...>
+	explicit Thread(const ThreadConfig& config, Callable&& callable, Args&&... args) {
+		start_thread(config, toki::forward<Callable>(callable), toki::forward<Args>(args)...);
 	}
 
 	~Thread() {
 		join();
+		m_state->~State();
+		_destroy_internal();
 	}
 
+	DELETE_COPY(Thread);
+	DELETE_MOVE(Thread);
+
 	void join() {
 		atomic_wait(&m_state->joinable, 0);
 	}
 
 private:
 	template <typename Callable, typename... Args>
-	void start_thread(Callable&& callable, Args&&... args) {
-		m_stack = DefaultAllocator::allocate_aligned(STACK_SIZE, 16);
+	void start_thread(const ThreadConfig& config, Callable&& callable, Args&&... args) {
+		using StateType = StateImpl<Invoker<Tuple<Callable, Args...>>>;
+
+		// The state is placed above the top of the stack so that an overflow runs into the guard page
+		// before it can reach it, [guard page][stack][state]
+		u64 stack_size = (config.stack_size + STACK_ALIGNMENT - 1) & ~(STACK_ALIGNMENT - 1);
+		u64 state_size = (sizeof(StateType) + STACK_ALIGNMENT - 1) & ~(STACK_ALIGNMENT - 1);
+		void* stack	   = _allocate_stack(stack_size + state_size, config.guard_page);
+		TK_ASSERT(stack != nullptr, "Could not allocate thread stack");
+
+		m_state = construct_at<StateType>(
+			reinterpret_cast<byte*>(stack) + stack_size,
+			toki::forward<Callable>(callable),
+			toki::forward<Args>(args)...);
+		m_state->config = config;
+		if (config.name != nullptr) {
+			u64 length = toki::min(toki::strlen(config.name), static_cast<u64>(sizeof(m_state->name) - 1));
+			toki::memcpy(m_state->name, config.name, length);
+			m_state->config.name = m_state->name;
+		}
 
-		m_state = construct_at<StateImpl<Invoker<Tuple<Callable, Args...>>>>(
-			m_stack, toki::forward<Callable>(callable), toki::forward<Args>(args)...);
-		_setup_thread(m_state);
+		_start_internal(stack, stack_size, m_state);
 	}
 
-	void _setup_thread(State* state) {
-		byte* stack_top = reinterpret_cast<byte*>(m_stack) + STACK_SIZE;
-		_start_internal(stack_top, state);
-	}
+	// Returns the start of the usable part of the mapping, after the guard page
+	void* _allocate_stack(u64 size, b8 guard_page);
+	void _start_internal(void* stack, u64 stack_size, State* state);
+	void _destroy_internal();
 
-	void _start_internal(void* stack_top, void* ptr);
+	// Applies the parts of ThreadConfig that can only be set from inside the thread
+	static void _apply_config(State* state);
 
 	static int _trampoline(void* ptr) {
 		State* state = reinterpret_cast<State*>(ptr);
 
 		atomic_store(&state->joinable, static_cast<i32>(0));
 
+		_apply_config(state);
 		state->invoke();
 
 		atomic_store(&state->joinable, static_cast<i32>(1));
@@ -99,11 +160,12 @@ private:
 	}
 
 private:
-	static constexpr const u64 STACK_SIZE = 1024 * 1024;
+	static constexpr const u64 STACK_ALIGNMENT = KB(4);
 
-	void* m_stack{};
+	void* m_stackMapping{};
+	u64 m_stackMappingSize{};
 	State* m_state{};
-	i64 m_pid{};
+	ThreadHandle m_handle{};
 };
 
 }  // namespace toki
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <toki/core/common/macros.h>
+#include <toki/core/platform/threads/atomic.h>
+#include <toki/core/types.h>
+
+namespace toki {
+
+// Single producer, single consumer handoff of the latest value. Writer and reader each
+// own one slot and the third one is swapped between them on publish and consume, so
+// neither side has to wait on the other unless it explicitly asks to.
+template <typename T>
+class TripleBuffer {
+public:
+	TripleBuffer() = default;
+
+	DELETE_COPY(TripleBuffer);
+	DELETE_MOVE(TripleBuffer);
+
+	T& write_slot() {
+		return m_slots[m_writeIndex];
+	}
+
+	const T& read_slot() const {
+		return m_slots[m_readIndex];
+	}
+
+	// Hands the write slot over to the reader, the writer continues with the previously shared slot
+	void publish() {
+		i32 previous = atomic_exchange(&m_shared, m_writeIndex | FRESH_BIT);
+		m_writeIndex = previous & INDEX_MASK;
+		atomic_notify_all(&m_shared);
+	}
+
+	// Swaps the most recently published value into the read slot, returns false if nothing new was published
+	b8 consume() {
+		if ((atomic_load(&m_shared) & FRESH_BIT) == 0) {
+			return false;
+		}
+
+		i32 previous = atomic_exchange(&m_shared, m_readIndex);
+		m_readIndex	 = previous & INDEX_MASK;
+		atomic_notify_all(&m_shared);
+		return true;
+	}
+
+	// Reader side, blocks until there is a published value that was not consumed yet
+	void wait_for_published() {
+		for (i32 shared = atomic_load(&m_shared); (shared & FRESH_BIT) == 0; shared = atomic_load(&m_shared)) {
+			atomic_wait(&m_shared, shared);
+		}
+	}
+
+	// Writer side, blocks until the reader consumed the last published value. Calling this
+	// before publish keeps the writer at most one value ahead without dropping any.
+	void wait_for_consumed() {
+		for (i32 shared = atomic_load(&m_shared); (shared & FRESH_BIT) != 0; shared = atomic_load(&m_shared)) {
+			atomic_wait(&m_shared, shared);
+		}
+	}
+
+private:
+	static constexpr i32 INDEX_MASK = 0b011;
+	static constexpr i32 FRESH_BIT	= 0b100;
+
+	T m_slots[3]{};
+	i32 m_writeIndex{ 0 };
+	i32 m_shared{ 1 };
+	i32 m_readIndex{ 2 };
+};
+
+}  // namespace toki
@@ -87,11 +87,14 @@ public:
 private:
 	constexpr void _copy(const BasicString& other) {
 		initialize_based_on_size(other.size());
-		toki::memcpy(get_ptr(), other.m_data.heap, other.m_size * sizeof(T));
+		copy_to_buffer(other.get_ptr(), other.m_size);
 	}
 
-	constexpr void _swap(BasicString&& other) {
+	constexpr void _swap(BasicString& other) {
 		toki::swap(m_data, other.m_data);
+		u64 size	 = m_size;
+		m_size		 = other.m_size;
+		other.m_size = size;
 	}
 
 private:
@@ -101,7 +104,7 @@ private:
 		}
 
 		if (is_on_heap(len)) {
-			m_data.heap = static_cast<T*>(AllocatorType::allocate_aligned((len) * sizeof(T), alignof(T)));
+			m_data.heap = static_cast<T*>(AllocatorType::allocate_aligned((len + 1) * sizeof(T), alignof(T)));
 		}
 
 		m_size = len;
@@ -116,7 +119,7 @@ private:
 	}
 
 	void copy_to_buffer(const T* str, u64 length) {
-		toki::memcpy(get_ptr(), str, (length + 1) * sizeof(T));
+		toki::memcpy(get_ptr(), str, length * sizeof(T));
 		get_ptr()[length] = 0;
 	}
 
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <toki/core/string/string_view.h>
+#include <toki/core/types.h>
+
+namespace toki {
+
+// Returned for bytes that don't form a valid sequence, each invalid byte is replaced on its own
+static constexpr u32 UTF8_REPLACEMENT_CHARACTER = 0xFFFD;
+
+// Decodes the code point starting at offset and moves offset past it, offset has to be below
+// the size of the text. Overlong encodings, surrogates and truncated sequences decode to
+// UTF8_REPLACEMENT_CHARACTER.
+inline u32 utf8_decode(StringView text, u64& offset) {
+	const u8* bytes = reinterpret_cast<const u8*>(text.data());
+	u8 lead			= bytes[offset++];
+	if (lead < 0x80) {
+		return lead;
+	}
+
+	u32 continuation_count = 0;
+	u32 code_point		   = 0;
+	u32 min_code_point	   = 0;
+	if ((lead & 0xE0) == 0xC0) {
+		continuation_count = 1;
+		code_point		   = lead & 0x1F;
+		min_code_point	   = 0x80;
+	} else if ((lead & 0xF0) == 0xE0) {
+		continuation_count = 2;
+		code_point		   = lead & 0x0F;
+		min_code_point	   = 0x800;
+	} else if ((lead & 0xF8) == 0xF0) {
+		continuation_count = 3;
+		code_point		   = lead & 0x07;
+		min_code_point	   = 0x10000;
+	} else {
+		return UTF8_REPLACEMENT_CHARACTER;
+	}
+
+	u64 end = offset + continuation_count;
+	if (end > text.size()) {
+		return UTF8_REPLACEMENT_CHARACTER;
+	}
+
+	for (u64 i = offset; i < end; i++) {
+		if ((bytes[i] & 0xC0) != 0x80) {
+			return UTF8_REPLACEMENT_CHARACTER;
+		}
+		code_point = (code_point << 6) | (bytes[i] & 0x3F);
+	}
+	offset = end;
+
+	if (code_point < min_code_point || code_point > 0x10FFFF || (code_point >= 0xD800 && code_point <= 0xDFFF)) {
+		return UTF8_REPLACEMENT_CHARACTER;
+	}
+	return code_point;
+}
+
+}  // namespace toki
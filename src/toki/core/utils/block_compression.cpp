@@ -0,0 +1,690 @@
+#include "toki/core/utils/block_compression.h"
+
+#include <toki/core/common/assert.h>
+#include <toki/core/common/common.h>
+#include <toki/core/math/math.h>
+#include <toki/core/memory/memory.h>
+#include <toki/core/utils/image.h>
+
+#if defined(__x86_64__) || defined(_M_X64)
+	#include <immintrin.h>
+	#define TK_BLOCK_COMPRESSION_X86
+#endif
+
+namespace toki {
+
+static constexpr u32 BLOCK_PIXELS = BLOCK_DIMENSION * BLOCK_DIMENSION;
+static constexpr u32 CHANNELS	  = 4;
+// Larger than the error of any block
+static constexpr f32 MAX_BLOCK_ERROR = 1e30f;
+
+// BC1 palette entries in the order they sit on the line from color0 to color1
+static constexpr u8 BC1_INDEX_FOR_STEP[4] = { 0, 2, 3, 1 };
+static constexpr f32 BC1_WEIGHTS[4]		  = { 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f };
+
+// BC7 interpolation weights of 4 bit indices, out of 64
+static constexpr u32 BC7_WEIGHTS[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+static constexpr u32 BC7_MODE6		 = 6;
+
+u32 block_format_size(BlockFormat format) {
+	switch (format) {
+		case BlockFormat::BC1:
+		case BlockFormat::BC4:
+			return 8;
+		case BlockFormat::BC3:
+		case BlockFormat::BC7:
+			return 16;
+	}
+
+	TK_UNREACHABLE();
+}
+
+static u32 block_count(u32 size) {
+	return (size + BLOCK_DIMENSION - 1) / BLOCK_DIMENSION;
+}
+
+u64 compressed_level_size(BlockFormat format, u32 width, u32 height) {
+	return static_cast<u64>(block_count(width)) * block_count(height) * block_format_size(format);
+}
+
+u64 compressed_chain_size(BlockFormat format, u32 width, u32 height, u32 level_count) {
+	u64 size = 0;
+	for (u32 level = 0; level < level_count; level++) {
+		size += compressed_level_size(format, mip_dimension(width, level), mip_dimension(height, level));
+	}
+	return size;
+}
+
+// Block split into one array per channel so four pixels can be processed at once, values are in
+// the 0 to 255 range
+struct BlockPixels {
+	alignas(16) f32 channels[CHANNELS][BLOCK_PIXELS];
+};
+
+struct Endpoints {
+	f32 start[CHANNELS];
+	f32 end[CHANNELS];
+};
+
+static void load_block(
+	const byte* pixels, u32 width, u32 height, u32 channel_count, u32 block_x, u32 block_y, BlockPixels& block) {
+	for (u32 y = 0; y < BLOCK_DIMENSION; y++) {
+		u32 source_y	= toki::min(block_y * BLOCK_DIMENSION + y, height - 1);
+		const byte* row = pixels + static_cast<u64>(source_y) * width * channel_count;
+		for (u32 x = 0; x < BLOCK_DIMENSION; x++) {
+			u32 source_x	  = toki::min(block_x * BLOCK_DIMENSION + x, width - 1);
+			const byte* pixel = row + static_cast<u64>(source_x) * channel_count;
+			for (u32 c = 0; c < CHANNELS; c++) {
+				block.channels[c][y * BLOCK_DIMENSION + x] = c < channel_count ? pixel[c] : 255.0f;
+			}
+		}
+	}
+}
+
+// Position of every pixel projected onto the line from start to end, 0 at start and 1 at end
+static void project_on_line(
+	const BlockPixels& block,
+	u32 channel_count,
+	const f32 start[CHANNELS],
+	const f32 end[CHANNELS],
+	f32 positions[BLOCK_PIXELS]) {
+	f32 direction[CHANNELS]{};
+	f32 length_squared = 0.0f;
+	for (u32 c = 0; c < channel_count; c++) {
+		direction[c] = end[c] - start[c];
+		length_squared += direction[c] * direction[c];
+	}
+
+	if (length_squared <= 0.0f) {
+		toki::memset(positions, 0.0f, BLOCK_PIXELS);
+		return;
+	}
+
+	for (u32 c = 0; c < channel_count; c++) {
+		direction[c] /= length_squared;
+	}
+
+#if defined(TK_BLOCK_COMPRESSION_X86)
+	for (u32 i = 0; i < BLOCK_PIXELS; i += 4) {
+		__m128 position = _mm_setzero_ps();
+		for (u32 c = 0; c < channel_count; c++) {
+			__m128 offset = _mm_sub_ps(_mm_load_ps(block.channels[c] + i), _mm_set1_ps(start[c]));
+			position	  = _mm_add_ps(position, _mm_mul_ps(offset, _mm_set1_ps(direction[c])));
+		}
+		_mm_storeu_ps(positions + i, position);
+	}
+#else
+	for (u32 i = 0; i < BLOCK_PIXELS; i++) {
+		f32 position = 0.0f;
+		for (u32 c = 0; c < channel_count; c++) {
+			position += (block.channels[c][i] - start[c]) * direction[c];
+		}
+		positions[i] = position;
+	}
+#endif
+}
+
+// Squared error of the block against the palette entries selected by indices
+static f32 palette_error(
+	const BlockPixels& block, u32 channel_count, const f32 (*palette)[CHANNELS], const u8 indices[BLOCK_PIXELS]) {
+	f32 error = 0.0f;
+	for (u32 i = 0; i < BLOCK_PIXELS; i++) {
+		for (u32 c = 0; c < channel_count; c++) {
+			f32 difference = block.channels[c][i] - palette[indices[i]][c];
+			error += difference * difference;
+		}
+	}
+	return error;
+}
+
+// Line through the mean of the pixels along their principal axis, cut off where the pixels end
+static Endpoints fit_endpoints(const BlockPixels& block, u32 channel_count) {
+	f32 mean[CHANNELS]{};
+	f32 axis[CHANNELS]{};
+	for (u32 c = 0; c < channel_count; c++) {
+		f32 low	 = block.channels[c][0];
+		f32 high = block.channels[c][0];
+		for (u32 i = 0; i < BLOCK_PIXELS; i++) {
+			mean[c] += block.channels[c][i];
+			low	 = toki::min(low, block.channels[c][i]);
+			high = toki::max(high, block.channels[c][i]);
+		}
+		mean[c] /= BLOCK_PIXELS;
+		axis[c] = high - low;
+	}
+
+	f32 covariance[CHANNELS][CHANNELS]{};
+	for (u32 i = 0; i < BLOCK_PIXELS; i++) {
+		for (u32 a = 0; a < channel_count; a++) {
+			for (u32 b = 0; b < channel_count; b++) {
+				covariance[a][b] += (block.channels[a][i] - mean[a]) * (block.channels[b][i] - mean[b]);
+			}
+		}
+	}
+
+	// Power iteration starting from the bounding box diagonal, a few steps are plenty for 16 pixels
+	for (u32 iteration = 0; iteration < 8; iteration++) {
+		f32 next[CHANNELS]{};
+		f32 largest = 0.0f;
+		for (u32 a = 0; a < channel_count; a++) {
+			for (u32 b = 0; b < channel_count; b++) {
+				next[a] += covariance[a][b] * axis[b];
+			}
+			largest = toki::max(largest, toki::abs(next[a]));
+		}
+
+		if (largest <= 0.0f) {
+			break;
+		}
+		for (u32 c = 0; c < channel_count; c++) {
+			axis[c] = next[c] / largest;
+		}
+	}
+
+	Endpoints endpoints{};
+	f32 positions[BLOCK_PIXELS];
+	f32 end[CHANNELS]{};
+	for (u32 c = 0; c < channel_count; c++) {
+		end[c] = mean[c] + axis[c];
+	}
+	project_on_line(block, channel_count, mean, end, positions);
+
+	f32 low	 = positions[0];
+	f32 high = positions[0];
+	for (u32 i = 1; i < BLOCK_PIXELS; i++) {
+		low	 = toki::min(low, positions[i]);
+		high = toki::max(high, positions[i]);
+	}
+
+	for (u32 c = 0; c < channel_count; c++) {
+		endpoints.start[c] = toki::clamp(mean[c] + axis[c] * low, 0.0f, 255.0f);
+		endpoints.end[c]   = toki::clamp(mean[c] + axis[c] * high, 0.0f, 255.0f);
+	}
+	return endpoints;
+}
+
+// Least squares endpoints for fixed indices, weights[i] is how far pixel i sits from start towards
+// end. Fails when every pixel has the same weight.
+static b8 refine_endpoints(
+	const BlockPixels& block, u32 channel_count, const f32 weights[BLOCK_PIXELS], Endpoints& endpoints) {
+	f32 start_start = 0.0f;
+	f32 end_end		= 0.0f;
+	f32 start_end	= 0.0f;
+	f32 start_sum[CHANNELS]{};
+	f32 end_sum[CHANNELS]{};
+	for (u32 i = 0; i < BLOCK_PIXELS; i++) {
+		f32 start_weight = 1.0f - weights[i];
+		f32 end_weight	 = weights[i];
+		start_start += start_weight * start_weight;
+		end_end += end_weight * end_weight;
+		start_end += start_weight * end_weight;
+		for (u32 c = 0; c < channel_count; c++) {
+			start_sum[c] += start_weight * block.channels[c][i];
+			end_sum[c] += end_weight * block.channels[c][i];
+		}
+	}
+
+	f32 determinant = start_start * end_end - start_end * start_end;
+	if (toki::abs(determinant) < 1e-6f) {
+		return false;
+	}
+
+	for (u32 c = 0; c < channel_count; c++) {
+		f32 start = (start_sum[c] * end_end - end_sum[c] * start_end) / determinant;
+		f32 end	  = (end_sum[c] * start_start - start_sum[c] * start_end) / determinant;
+
+		endpoints.start[c] = toki::clamp(start, 0.0f, 255.0f);
+		endpoints.end[c]   = toki::clamp(end, 0.0f, 255.0f);
+	}
+	return true;
+}
+
+// BC1
+
+struct Bc1Block {
+	u16 color0;
+	u16 color1;
+	u8 indices[BLOCK_PIXELS];
+	f32 error;
+};
+
+static u16 pack_565(const f32 color[CHANNELS]) {
+	u32 r = static_cast<u32>(toki::clamp(color[0], 0.0f, 255.0f) * 31.0f / 255.0f + 0.5f);
+	u32 g = static_cast<u32>(toki::clamp(color[1], 0.0f, 255.0f) * 63.0f / 255.0f + 0.5f);
+	u32 b = static_cast<u32>(toki::clamp(color[2], 0.0f, 255.0f) * 31.0f / 255.0f + 0.5f);
+	return static_cast<u16>(r << 11 | g << 5 | b);
+}
+
+static void unpack_565(u16 value, u32 color[CHANNELS]) {
+	u32 r	 = value >> 11 & 31;
+	u32 g	 = value >> 5 & 63;
+	u32 b	 = value & 31;
+	color[0] = r << 3 | r >> 2;
+	color[1] = g << 2 | g >> 4;
+	color[2] = b << 3 | b >> 2;
+	color[3] = 255;
+}
+
+// Always uses the 4 color mode, which is the only one BC3 supports
+static Bc1Block quantize_bc1(const BlockPixels& block, const Endpoints& endpoints) {
+	Bc1Block result{};
+	result.color0 = pack_565(endpoints.start);
+	result.color1 = pack_565(endpoints.end);
+	if (result.color0 < result.color1) {
+		toki::swap(result.color0, result.color1);
+	}
+
+	u32 colors[2][CHANNELS];
+	unpack_565(result.color0, colors[0]);
+	unpack_565(result.color1, colors[1]);
+
+	f32 palette[4][CHANNELS];
+	for (u32 c = 0; c < CHANNELS; c++) {
+		palette[0][c] = static_cast<f32>(colors[0][c]);
+		palette[1][c] = static_cast<f32>(colors[1][c]);
+		palette[2][c] = (2.0f * palette[0][c] + palette[1][c]) / 3.0f;
+		palette[3][c] = (palette[0][c] + 2.0f * palette[1][c]) / 3.0f;
+	}
+
+	// The palette lies on a line, the nearest entry is the one nearest along it
+	f32 positions[BLOCK_PIXELS];
+	project_on_line(block, 3, palette[0], palette[1], positions);
+	for (u32 i = 0; i < BLOCK_PIXELS; i++) {
+		u32 step		  = static_cast<u32>(toki::clamp(positions[i], 0.0f, 1.0f) * 3.0f + 0.5f);
+		result.indices[i] = BC1_INDEX_FOR_STEP[step];
+	}
+
+	result.error = palette_error(block, 3, palette, result.indices);
+	return result;
+}
+
+static void encode_bc1_color(const BlockPixels& block, byte* out) {
+	Bc1Block best = quantize_bc1(block, fit_endpoints(block, 3));
+
+	// Refitting the endpoints to the chosen indices removes most of the error from rounding the
+	// principal axis fit to 565
+	for (u32 iteration = 0; iteration < 2; iteration++) {
+		f32 weights[BLOCK_PIXELS];
+		for (u32 i = 0; i < BLOCK_PIXELS; i++) {
+			weights[i] = BC1_WEIGHTS[best.indices[i]];
+		}
+
+		Endpoints refined{};
+		if (!refine_endpoints(block, 3, weights, refined)) {
+			break;
+		}
+
+		Bc1Block candidate = quantize_bc1(block, refined);
+		if (candidate.error >= best.error) {
+			break;
+		}
+		best = candidate;
+	}
+
+	u32 indices = 0;
+	for (u32 i = 0; i < BLOCK_PIXELS; i++) {
+		indices |= static_cast<u32>(best.indices[i]) << (2 * i);
+	}
+
+	toki::memcpy(out, &best.color0, sizeof(u16));
+	toki::memcpy(out + 2, &best.color1, sizeof(u16));
+	toki::memcpy(out + 4, &indices, sizeof(u32));
+}
+
+// BC4, also the alpha block of BC3
+
+static void encode_bc4_channel(const f32 values[BLOCK_PIXELS], byte* out) {
+#if defined(TK_BLOCK_COMPRESSION_X86)
+	__m128 low_values  = _mm_loadu_ps(values);
+	__m128 high_values = low_values;
+	for (u32 i = 4; i < BLOCK_PIXELS; i += 4) {
+		low_values	= _mm_min_ps(low_values, _mm_loadu_ps(values + i));
+		high_values = _mm_max_ps(high_values, _mm_loadu_ps(values + i));
+	}
+	low_values	= _mm_min_ps(low_values, _mm_shuffle_ps(low_values, low_values, _MM_SHUFFLE(1, 0, 3, 2)));
+	low_values	= _mm_min_ps(low_values, _mm_shuffle_ps(low_values, low_values, _MM_SHUFFLE(2, 3, 0, 1)));
+	high_values = _mm_max_ps(high_values, _mm_shuffle_ps(high_values, high_values, _MM_SHUFFLE(1, 0, 3, 2)));
+	high_values = _mm_max_ps(high_values, _mm_shuffle_ps(high_values, high_values, _MM_SHUFFLE(2, 3, 0, 1)));
+	f32 low		= _mm_cvtss_f32(low_values);
+	f32 high	= _mm_cvtss_f32(high_values);
+#else
+	f32 low	 = values[0];
+	f32 high = values[0];
+	for (u32 i = 1; i < BLOCK_PIXELS; i++) {
+		low	 = toki::min(low, values[i]);
+		high = toki::max(high, values[i]);
+	}
+#endif
+
+	// Endpoint 0 above endpoint 1 selects the mode with 6 interpolated values, index 0 and 1 are
+	// the endpoints and 2 to 7 step from endpoint 0 towards endpoint 1
+	u32 endpoint0 = static_cast<u32>(high + 0.5f);
+	u32 endpoint1 = static_cast<u32>(low + 0.5f);
+
+	u64 indices = 0;
+	if (endpoint0 > endpoint1) {
+		f32 scale = 7.0f / static_cast<f32>(endpoint0 - endpoint1);
+		for (u32 i = 0; i < BLOCK_PIXELS; i++) {
+			u32 step  = static_cast<u32>((static_cast<f32>(endpoint0) - values[i]) * scale + 0.5f);
+			u32 index = step == 0 ? 0 : step == 7 ? 1 : step + 1;
+			indices |= static_cast<u64>(index) << (3 * i);
+		}
+	}
+
+	out[0] = static_cast<byte>(endpoint0);
+	out[1] = static_cast<byte>(endpoint1);
+	for (u32 i = 0; i < 6; i++) {
+		out[2 + i] = static_cast<byte>(indices >> (8 * i));
+	}
+}
+
+// BC7, only mode 6 which has a single RGBA line with 7 bit endpoints, a lowest bit per endpoint
+// and 4 bit indices. Other modes split the block into partitions and would be better for blocks
+// with several distinct colors at a much higher search cost.
+
+struct Bc7Block {
+	u32 endpoints[2][CHANNELS];
+	u32 p_bits[2];
+	u8 indices[BLOCK_PIXELS];
+	f32 error;
+};
+
+struct BitStream {
+	u64 bits[2];
+	u32 position;
+};
+
+static void write_bits(BitStream& stream, u32 value, u32 count) {
+	for (u32 i = 0; i < count; i++, stream.position++) {
+		stream.bits[stream.position / 64] |= static_cast<u64>(value >> i & 1) << (stream.position % 64);
+	}
+}
+
+static u32 read_bits(BitStream& stream, u32 count) {
+	u32 value = 0;
+	for (u32 i = 0; i < count; i++, stream.position++) {
+		value |= static_cast<u32>(stream.bits[stream.position / 64] >> (stream.position % 64) & 1) << i;
+	}
+	return value;
+}
+
+static u32 bc7_interpolate(u32 endpoint0, u32 endpoint1, u32 weight) {
+	return ((64 - weight) * endpoint0 + weight * endpoint1 + 32) >> 6;
+}
+
+// Picks the lowest bit that gets the 7 bit endpoint closest to value
+static void quantize_bc7_endpoint(const f32 value[CHANNELS], u32 endpoint[CHANNELS], u32& p_bit) {
+	f32 best_error = MAX_BLOCK_ERROR;
+	for (u32 p = 0; p < 2; p++) {
+		u32 candidate[CHANNELS];
+		f32 error = 0.0f;
+		for (u32 c = 0; c < CHANNELS; c++) {
+			f32 rounded	   = (value[c] - static_cast<f32>(p)) / 2.0f + 0.5f;
+			candidate[c]   = static_cast<u32>(toki::clamp(rounded, 0.0f, 127.0f));
+			f32 difference = static_cast<f32>(candidate[c] * 2 + p) - value[c];
+			error += difference * difference;
+		}
+
+		if (error < best_error) {
+			best_error = error;
+			p_bit	   = p;
+			toki::memcpy(endpoint, candidate, sizeof(candidate));
+		}
+	}
+}
+
+static Bc7Block quantize_bc7(const BlockPixels& block, const Endpoints& endpoints) {
+	Bc7Block result{};
+	quantize_bc7_endpoint(endpoints.start, result.endpoints[0], result.p_bits[0]);
+	quantize_bc7_endpoint(endpoints.end, result.endpoints[1], result.p_bits[1]);
+
+	f32 decoded[2][CHANNELS];
+	f32 palette[16][CHANNELS];
+	for (u32 c = 0; c < CHANNELS; c++) {
+		u32 endpoint0 = result.endpoints[0][c] * 2 + result.p_bits[0];
+		u32 endpoint1 = result.endpoints[1][c] * 2 + result.p_bits[1];
+		decoded[0][c] = static_cast<f32>(endpoint0);
+		decoded[1][c] = static_cast<f32>(endpoint1);
+		for (u32 k = 0; k < 16; k++) {
+			palette[k][c] = static_cast<f32>(bc7_interpolate(endpoint0, endpoint1, BC7_WEIGHTS[k]));
+		}
+	}
+
+	// Weights are almost evenly spaced, the nearest one is at most one step from the rounded guess
+	f32 positions[BLOCK_PIXELS];
+	project_on_line(block, CHANNELS, decoded[0], decoded[1], positions);
+	for (u32 i = 0; i < BLOCK_PIXELS; i++) {
+		f32 position = toki::clamp(positions[i], 0.0f, 1.0f) * 64.0f;
+		u32 guess	 = static_cast<u32>(position * 15.0f / 64.0f + 0.5f);
+		u32 best	 = guess;
+		for (u32 k = guess > 0 ? guess - 1 : 0; k <= toki::min(guess + 1, 15u); k++) {
+			if (toki::abs(position - BC7_WEIGHTS[k]) < toki::abs(position - BC7_WEIGHTS[best])) {
+				best = k;
+			}
+		}
+		result.indices[i] = static_cast<u8>(best);
+	}
+
+	result.error = palette_error(block, CHANNELS, palette, result.indices);
+	return result;
+}
+
+static void encode_bc7(const BlockPixels& block, byte* out) {
+	Bc7Block best = quantize_bc7(block, fit_endpoints(block, CHANNELS));
+
+	for (u32 iteration = 0; iteration < 2; iteration++) {
+		f32 weights[BLOCK_PIXELS];
+		for (u32 i = 0; i < BLOCK_PIXELS; i++) {
+			weights[i] = static_cast<f32>(BC7_WEIGHTS[best.indices[i]]) / 64.0f;
+		}
+
+		Endpoints refined{};
+		if (!refine_endpoints(block, CHANNELS, weights, refined)) {
+			break;
+		}
+
+		Bc7Block candidate = quantize_bc7(block, refined);
+		if (candidate.error >= best.error) {
+			break;
+		}
+		best = candidate;
+	}
+
+	// The highest bit of the first index is implied to be 0, the weights are symmetric so swapping
+	// the endpoints and mirroring the indices decodes to the same colors
+	if (best.indices[0] >= 8) {
+		for (u32 c = 0; c < CHANNELS; c++) {
+			toki::swap(best.endpoints[0][c], best.endpoints[1][c]);
+		}
+		toki::swap(best.p_bits[0], best.p_bits[1]);
+		for (u32 i = 0; i < BLOCK_PIXELS; i++) {
+			best.indices[i] = static_cast<u8>(15 - best.indices[i]);
+		}
+	}
+
+	BitStream stream{};
+	write_bits(stream, 1 << BC7_MODE6, BC7_MODE6 + 1);
+	for (u32 c = 0; c < CHANNELS; c++) {
+		write_bits(stream, best.endpoints[0][c], 7);
+		write_bits(stream, best.endpoints[1][c], 7);
+	}
+	write_bits(stream, best.p_bits[0], 1);
+	write_bits(stream, best.p_bits[1], 1);
+	for (u32 i = 0; i < BLOCK_PIXELS; i++) {
+		write_bits(stream, best.indices[i], i == 0 ? 3 : 4);
+	}
+
+	toki::memcpy(out, stream.bits, sizeof(stream.bits));
+}
+
+void compress_blocks(BlockFormat format, const byte* pixels, u32 width, u32 height, u32 channel_count, byte* dst) {
+	TK_ASSERT(width > 0 && height > 0);
+	TK_ASSERT(format == BlockFormat::BC4 || channel_count == CHANNELS);
+
+	u32 blocks_x   = block_count(width);
+	u32 blocks_y   = block_count(height);
+	u32 block_size = block_format_size(format);
+
+	BlockPixels block;
+	for (u32 block_y = 0; block_y < blocks_y; block_y++) {
+		for (u32 block_x = 0; block_x < blocks_x; block_x++) {
+			load_block(pixels, width, height, channel_count, block_x, block_y, block);
+			byte* out = dst + (static_cast<u64>(block_y) * blocks_x + block_x) * block_size;
+
+			switch (format) {
+				case BlockFormat::BC1:
+					encode_bc1_color(block, out);
+					break;
+				case BlockFormat::BC3:
+					encode_bc4_channel(block.channels[3], out);
+					encode_bc1_color(block, out + 8);
+					break;
+				case BlockFormat::BC4:
+					encode_bc4_channel(block.channels[0], out);
+					break;
+				case BlockFormat::BC7:
+					encode_bc7(block, out);
+					break;
+			}
+		}
+	}
+}
+
+void compress_mip_chain(BlockFormat format, const byte* levels, u32 width, u32 height, u32 level_count, byte* dst) {
+	for (u32 level = 0; level < level_count; level++) {
+		u32 level_width	 = mip_dimension(width, level);
+		u32 level_height = mip_dimension(height, level);
+		compress_blocks(format, levels, level_width, level_height, CHANNELS, dst);
+
+		levels += static_cast<u64>(level_width) * level_height * CHANNELS;
+		dst += compressed_level_size(format, level_width, level_height);
+	}
+}
+
+// Decoding
+
+static void decode_bc1_color(const byte* in, b8 allow_transparent, byte pixels[BLOCK_PIXELS][CHANNELS]) {
+	u16 color0	= 0;
+	u16 color1	= 0;
+	u32 indices = 0;
+	toki::memcpy(&color0, in, sizeof(u16));
+	toki::memcpy(&color1, in + 2, sizeof(u16));
+	toki::memcpy(&indices, in + 4, sizeof(u32));
+
+	u32 palette[4][CHANNELS];
+	unpack_565(color0, palette[0]);
+	unpack_565(color1, palette[1]);
+	for (u32 c = 0; c < CHANNELS; c++) {
+		if (color0 > color1 || !allow_transparent) {
+			palette[2][c] = (2 * palette[0][c] + palette[1][c] + 1) / 3;
+			palette[3][c] = (palette[0][c] + 2 * palette[1][c] + 1) / 3;
+		} else {
+			palette[2][c] = (palette[0][c] + palette[1][c] + 1) / 2;
+			palette[3][c] = 0;
+		}
+	}
+
+	for (u32 i = 0; i < BLOCK_PIXELS; i++) {
+		const u32* color = palette[indices >> (2 * i) & 3];
+		for (u32 c = 0; c < CHANNELS; c++) {
+			pixels[i][c] = static_cast<byte>(color[c]);
+		}
+	}
+}
+
+static void decode_bc4_channel(const byte* in, byte pixels[BLOCK_PIXELS][CHANNELS], u32 channel) {
+	u32 palette[8];
+	palette[0] = in[0];
+	palette[1] = in[1];
+	if (palette[0] > palette[1]) {
+		for (u32 i = 1; i < 7; i++) {
+			palette[i + 1] = ((7 - i) * palette[0] + i * palette[1] + 3) / 7;
+		}
+	} else {
+		for (u32 i = 1; i < 5; i++) {
+			palette[i + 1] = ((5 - i) * palette[0] + i * palette[1] + 2) / 5;
+		}
+		palette[6] = 0;
+		palette[7] = 255;
+	}
+
+	u64 indices = 0;
+	for (u32 i = 0; i < 6; i++) {
+		indices |= static_cast<u64>(in[2 + i]) << (8 * i);
+	}
+	for (u32 i = 0; i < BLOCK_PIXELS; i++) {
+		pixels[i][channel] = static_cast<byte>(palette[indices >> (3 * i) & 7]);
+	}
+}
+
+static void decode_bc7(const byte* in, byte pixels[BLOCK_PIXELS][CHANNELS]) {
+	BitStream stream{};
+	toki::memcpy(stream.bits, in, sizeof(stream.bits));
+	if (read_bits(stream, BC7_MODE6 + 1) != 1 << BC7_MODE6) {
+		toki::memset(&pixels[0][0], static_cast<byte>(0), BLOCK_PIXELS * CHANNELS);
+		return;
+	}
+
+	u32 endpoints[2][CHANNELS];
+	for (u32 c = 0; c < CHANNELS; c++) {
+		endpoints[0][c] = read_bits(stream, 7) << 1;
+		endpoints[1][c] = read_bits(stream, 7) << 1;
+	}
+	u32 p_bit0 = read_bits(stream, 1);
+	u32 p_bit1 = read_bits(stream, 1);
+	for (u32 c = 0; c < CHANNELS; c++) {
+		endpoints[0][c] |= p_bit0;
+		endpoints[1][c] |= p_bit1;
+	}
+
+	for (u32 i = 0; i < BLOCK_PIXELS; i++) {
+		u32 weight = BC7_WEIGHTS[read_bits(stream, i == 0 ? 3 : 4)];
+		for (u32 c = 0; c < CHANNELS; c++) {
+			pixels[i][c] = static_cast<byte>(bc7_interpolate(endpoints[0][c], endpoints[1][c], weight));
+		}
+	}
+}
+
+void decompress_blocks(BlockFormat format, const byte* blocks, u32 width, u32 height, byte* dst) {
+	u32 blocks_x   = block_count(width);
+	u32 blocks_y   = block_count(height);
+	u32 block_size = block_format_size(format);
+
+	byte pixels[BLOCK_PIXELS][CHANNELS];
+	for (u32 block_y = 0; block_y < blocks_y; block_y++) {
+		for (u32 block_x = 0; block_x < blocks_x; block_x++) {
+			const byte* in = blocks + (static_cast<u64>(block_y) * blocks_x + block_x) * block_size;
+
+			switch (format) {
+				case BlockFormat::BC1:
+					decode_bc1_color(in, true, pixels);
+					break;
+				case BlockFormat::BC3:
+					decode_bc1_color(in + 8, false, pixels);
+					decode_bc4_channel(in, pixels, 3);
+					break;
+				case BlockFormat::BC4:
+					for (u32 i = 0; i < BLOCK_PIXELS; i++) {
+						pixels[i][1] = 0;
+						pixels[i][2] = 0;
+						pixels[i][3] = 255;
+					}
+					decode_bc4_channel(in, pixels, 0);
+					break;
+				case BlockFormat::BC7:
+					decode_bc7(in, pixels);
+					break;
+			}
+
+			// Blocks past the edge of the image only hold padding
+			for (u32 y = 0; y < BLOCK_DIMENSION && block_y * BLOCK_DIMENSION + y < height; y++) {
+				for (u32 x = 0; x < BLOCK_DIMENSION && block_x * BLOCK_DIMENSION + x < width; x++) {
+					u64 pixel = static_cast<u64>(block_y * BLOCK_DIMENSION + y) * width + block_x * BLOCK_DIMENSION + x;
+					toki::memcpy(dst + pixel * CHANNELS, pixels[y * BLOCK_DIMENSION + x], CHANNELS);
+				}
+			}
+		}
+	}
+}
+
+}  // namespace toki
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <toki/core/types.h>
+
+namespace toki {
+
+// Block compressed formats store 4x4 pixel blocks in a fixed number of bytes, row by row. Images
+// that are not a multiple of 4 in size are padded with their edge pixels.
+
+enum struct BlockFormat : u32 {
+	// RGB, 8 bytes per block, alpha is always opaque
+	BC1,
+	// BC1 color and a separate alpha channel, 16 bytes per block
+	BC3,
+	// Single channel, 8 bytes per block
+	BC4,
+	// RGBA, 16 bytes per block, best quality of the four
+	BC7,
+};
+
+static constexpr u32 BLOCK_DIMENSION = 4;
+
+u32 block_format_size(BlockFormat format);
+
+u64 compressed_level_size(BlockFormat format, u32 width, u32 height);
+
+// Size of the chain of levels laid out like generate_mip_chain, compressed one after the other
+u64 compressed_chain_size(BlockFormat format, u32 width, u32 height, u32 level_count);
+
+// Compresses an image with channel_count channels per pixel into dst, which has to hold
+// compressed_level_size bytes. BC4 reads the first channel, the others need 4 channels.
+void compress_blocks(BlockFormat format, const byte* pixels, u32 width, u32 height, u32 channel_count, byte* dst);
+
+// Compresses every level of an RGBA8 chain written by generate_mip_chain
+void compress_mip_chain(BlockFormat format, const byte* levels, u32 width, u32 height, u32 level_count, byte* dst);
+
+// Decodes into RGBA8 the way the GPU samples it, BC4 expands to red with opaque alpha. BC7 blocks
+// are only decoded if they use mode 6, the only one compress_blocks writes.
+void decompress_blocks(BlockFormat format, const byte* blocks, u32 width, u32 height, byte* dst);
+
+}  // namespace toki
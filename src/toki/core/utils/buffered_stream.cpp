@@ -0,0 +1,193 @@
+#include "toki/core/utils/buffered_stream.h"
+
+#include <toki/core/common/assert.h>
+#include <toki/core/math/math.h>
+#include <toki/core/memory/memory.h>
+#include <toki/core/utils/memory.h>
+
+namespace toki {
+
+BufferedReader::BufferedReader(File& file, u64 buffer_size): m_file(&file), m_capacity(buffer_size) {
+	TK_ASSERT(buffer_size > 0);
+	m_buffer = reinterpret_cast<byte*>(DefaultAllocator::allocate(m_capacity));
+}
+
+BufferedReader::~BufferedReader() {
+	DefaultAllocator::free(m_buffer);
+}
+
+Optional<StringView> BufferedReader::next_line() {
+	u64 scanned = 0;
+	while (true) {
+		const byte* newline =
+			reinterpret_cast<const byte*>(toki::memchr(m_buffer + m_begin + scanned, '\n', m_end - m_begin - scanned));
+
+		if (newline != nullptr) {
+			u64 line_begin = m_begin;
+			u64 line_end   = static_cast<u64>(newline - m_buffer);
+			m_begin		   = line_end + 1;
+
+			if (line_end > line_begin && m_buffer[line_end - 1] == '\r') {
+				line_end--;
+			}
+			return StringView(reinterpret_cast<const char*>(m_buffer + line_begin), line_end - line_begin);
+		}
+
+		// Bytes that are already in the buffer have no newline, only look at the new ones after refilling
+		scanned = m_end - m_begin;
+		if (!refill()) {
+			break;
+		}
+	}
+
+	if (m_begin == m_end) {
+		return {};
+	}
+
+	// Last line of a file that doesn't end with a newline
+	u64 line_begin = m_begin;
+	m_begin		   = m_end;
+	return StringView(reinterpret_cast<const char*>(m_buffer + line_begin), m_end - line_begin);
+}
+
+Optional<byte> BufferedReader::peek() {
+	if (m_begin == m_end && !refill()) {
+		return {};
+	}
+	return m_buffer[m_begin];
+}
+
+u64 BufferedReader::skip(u64 count) {
+	u64 skipped = 0;
+	while (skipped < count) {
+		if (m_begin == m_end && !refill()) {
+			break;
+		}
+
+		u64 step = toki::min(count - skipped, m_end - m_begin);
+		m_begin += step;
+		skipped += step;
+	}
+	return skipped;
+}
+
+u64 BufferedReader::read(void* data, u64 size) {
+	byte* out = reinterpret_cast<byte*>(data);
+
+	u64 buffered = toki::min(size, m_end - m_begin);
+	toki::memcpy(out, m_buffer + m_begin, buffered);
+	m_begin += buffered;
+	u64 done = buffered;
+
+	// Large reads go straight to the destination instead of through the buffer
+	while (size - done >= m_capacity && !m_fileEnd) {
+		u64 read_count = m_file->read(out + done, size - done);
+		if (read_count == 0) {
+			m_fileEnd = true;
+		}
+		done += read_count;
+	}
+
+	while (done < size) {
+		if (m_begin == m_end && !refill()) {
+			break;
+		}
+
+		u64 step = toki::min(size - done, m_end - m_begin);
+		toki::memcpy(out + done, m_buffer + m_begin, step);
+		m_begin += step;
+		done += step;
+	}
+
+	return done;
+}
+
+b8 BufferedReader::at_end() {
+	return !peek().has_value();
+}
+
+b8 BufferedReader::refill() {
+	if (m_fileEnd) {
+		return false;
+	}
+
+	if (m_begin > 0) {
+		toki::memmove(m_buffer, m_buffer + m_begin, m_end - m_begin);
+		m_end -= m_begin;
+		m_begin = 0;
+	}
+
+	if (m_end == m_capacity) {
+		m_capacity *= 2;
+		m_buffer = reinterpret_cast<byte*>(DefaultAllocator::reallocate(m_buffer, m_capacity));
+	}
+
+	u64 read_count = m_file->read(m_buffer + m_end, m_capacity - m_end);
+	if (read_count == 0) {
+		m_fileEnd = true;
+		return false;
+	}
+
+	m_end += read_count;
+	return true;
+}
+
+BufferedWriter::BufferedWriter(File& file, u64 buffer_size): m_file(&file), m_capacity(buffer_size) {
+	TK_ASSERT(buffer_size > 0);
+	m_buffer = reinterpret_cast<byte*>(DefaultAllocator::allocate(m_capacity));
+}
+
+BufferedWriter::~BufferedWriter() {
+	flush();
+	DefaultAllocator::free(m_buffer);
+}
+
+void BufferedWriter::write(const void* data, u64 size) {
+	const byte* in = reinterpret_cast<const byte*>(data);
+
+	if (m_size + size > m_capacity) {
+		flush();
+	}
+	if (m_failed) {
+		return;
+	}
+
+	// Would not fit even into an empty buffer, copying it first gains nothing
+	if (size >= m_capacity) {
+		m_failed = !write_to_file(in, size);
+		return;
+	}
+
+	toki::memcpy(m_buffer + m_size, in, size);
+	m_size += size;
+}
+
+void BufferedWriter::write(StringView string) {
+	write(string.data(), string.size());
+}
+
+void BufferedWriter::write_line(StringView string) {
+	write(string.data(), string.size());
+	write("\n", 1);
+}
+
+b8 BufferedWriter::flush() {
+	if (!m_failed && m_size > 0) {
+		m_failed = !write_to_file(m_buffer, m_size);
+	}
+	m_size = 0;
+	return !m_failed;
+}
+
+b8 BufferedWriter::write_to_file(const byte* data, u64 size) {
+	for (u64 written = 0; written < size;) {
+		u64 write_count = m_file->write(data + written, size - written);
+		if (write_count == 0) {
+			return false;
+		}
+		written += write_count;
+	}
+	return true;
+}
+
+}  // namespace toki
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <toki/core/common/macros.h>
+#include <toki/core/common/optional.h>
+#include <toki/core/string/string_view.h>
+#include <toki/core/types.h>
+#include <toki/core/utils/bytes.h>
+#include <toki/core/utils/file.h>
+
+namespace toki {
+
+// Reads a file through an internal buffer so that line and byte sized reads don't each cost a
+// syscall. The file must stay open for the lifetime of the reader and should not be read or
+// seeked directly while the reader is in use.
+class BufferedReader {
+public:
+	static constexpr u64 DEFAULT_BUFFER_SIZE = KB(64);
+
+	BufferedReader(File& file, u64 buffer_size = DEFAULT_BUFFER_SIZE);
+	~BufferedReader();
+
+	DELETE_COPY(BufferedReader);
+	DELETE_MOVE(BufferedReader);
+
+	// Returns the next line without its '\n' or "\r\n" ending, or nothing at the end of the file.
+	// The view points into the internal buffer and is only valid until the next call on this
+	// reader. Lines longer than the buffer grow it.
+	Optional<StringView> next_line();
+
+	// Returns the next byte without consuming it
+	Optional<byte> peek();
+	// Returns how many bytes were skipped, less than count only at the end of the file
+	u64 skip(u64 count);
+	u64 read(void* data, u64 size);
+
+	b8 at_end();
+
+private:
+	// Moves unread bytes to the front of the buffer and fills the rest from the file, returns
+	// false once the file has nothing more to give
+	b8 refill();
+
+	File* m_file{};
+	byte* m_buffer{};
+	u64 m_capacity{};
+	u64 m_begin{};
+	u64 m_end{};
+	b8 m_fileEnd{};
+};
+
+// Collects small writes and hands them to the file in buffer sized chunks, flushes on destruction.
+// Once the file takes fewer bytes than it was given every later write is dropped, flush reports it.
+class BufferedWriter {
+public:
+	static constexpr u64 DEFAULT_BUFFER_SIZE = KB(64);
+
+	BufferedWriter(File& file, u64 buffer_size = DEFAULT_BUFFER_SIZE);
+	~BufferedWriter();
+
+	DELETE_COPY(BufferedWriter);
+	DELETE_MOVE(BufferedWriter);
+
+	void write(const void* data, u64 size);
+	void write(StringView string);
+	void write_line(StringView string);
+
+	// Returns false when any write so far did not fully reach the file
+	b8 flush();
+
+private:
+	// Returns false on a short write
+	b8 write_to_file(const byte* data, u64 size);
+
+	File* m_file{};
+	byte* m_buffer{};
+	u64 m_capacity{};
+	u64 m_size{};
+	b8 m_failed{};
+};
+
+}  // namespace toki
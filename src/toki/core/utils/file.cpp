@@ -26,7 +26,8 @@ u64 File::tell() const {
 }
 
 u64 File::write(const void* data, u64 size) {
-	return toki::write(m_handle, data, size).assert_ok_and_value();
+	// A failed write is reported as a short one, a full disk is not a programming error
+	return toki::write(m_handle, data, size).value_or(0);
 }
 
 u64 File::read(void* data, u64 size) {
@@ -34,7 +35,9 @@ u64 File::read(void* data, u64 size) {
 }
 
 void File::open(const Path& path, FileMode mode, u32 flags) {
-	m_handle = toki::open(path.c_str(), mode, flags);
+	// Left invalid when the file can't be opened, callers check is_open
+	auto handle = toki::open(path.c_str(), mode, flags);
+	m_handle	= handle ? handle.value() : NativeHandle{};
 }
 
 void File::close() {
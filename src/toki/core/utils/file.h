@@ -16,12 +16,17 @@ public:
 	void seek(i64 pos, FileCursorStart start = FileCursorStart::CURRENT);
 	u64 tell() const;
 
+	// Returns how many bytes were written, less than size when the write fails
 	u64 write(const void* data, u64 size);
 	u64 read(void* data, u64 size);
 
 	void open(const Path& path, FileMode mode, u32 flags = 0);
 	void close();
 
+	b8 is_open() const {
+		return m_handle.valid();
+	}
+
 	u64 read_line(char* data, u64 count, byte delim = '\n');
 
 private:
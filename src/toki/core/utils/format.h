@@ -24,7 +24,9 @@ struct Formatter<StringView, AllocatorType> {
 	}
 
 	static constexpr u64 format_to(char* buf_out, const StringView& str) {
-		return ::toki::format_to(format_string, buf_out, str.data());
+		// Views aren't necessarily null terminated
+		toki::memcpy(buf_out, str.data(), str.size());
+		return str.size();
 	}
 };
 
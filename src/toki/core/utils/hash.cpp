@@ -0,0 +1,42 @@
+#include "toki/core/utils/hash.h"
+
+#include <toki/core/utils/memory.h>
+
+namespace toki {
+
+u64 hash_bytes(const void* data, u64 size, u64 seed) {
+	constexpr u64 MULTIPLIER = 0xC6A4A7935BD1E995;
+	constexpr u32 SHIFT		 = 47;
+
+	const byte* bytes = reinterpret_cast<const byte*>(data);
+	u64 hash		  = seed ^ (size * MULTIPLIER);
+
+	u64 block_count = size / sizeof(u64);
+	for (u64 i = 0; i < block_count; i++) {
+		u64 block;
+		toki::memcpy(&block, bytes + i * sizeof(u64), sizeof(u64));
+
+		block *= MULTIPLIER;
+		block ^= block >> SHIFT;
+		block *= MULTIPLIER;
+
+		hash ^= block;
+		hash *= MULTIPLIER;
+	}
+
+	const byte* tail = bytes + block_count * sizeof(u64);
+	u64 tail_size	 = size % sizeof(u64);
+	if (tail_size > 0) {
+		for (u64 i = tail_size; i > 0; i--) {
+			hash ^= static_cast<u64>(tail[i - 1]) << ((i - 1) * 8);
+		}
+		hash *= MULTIPLIER;
+	}
+
+	hash ^= hash >> SHIFT;
+	hash *= MULTIPLIER;
+	hash ^= hash >> SHIFT;
+	return hash;
+}
+
+}  // namespace toki
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <toki/core/string/string_view.h>
+#include <toki/core/types.h>
+
+namespace toki {
+
+static constexpr u64 FNV1A_OFFSET_BASIS = 0xCBF29CE484222325;
+static constexpr u64 FNV1A_PRIME		= 0x100000001B3;
+
+// 64 bit FNV-1a, one byte per step so it is meant for short keys like paths
+constexpr u64 hash_fnv1a(const char* data, u64 size, u64 seed = FNV1A_OFFSET_BASIS) {
+	u64 hash = seed;
+	for (u64 i = 0; i < size; i++) {
+		hash ^= static_cast<u8>(data[i]);
+		hash *= FNV1A_PRIME;
+	}
+	return hash;
+}
+
+constexpr u64 hash_fnv1a(StringView string, u64 seed = FNV1A_OFFSET_BASIS) {
+	return hash_fnv1a(string.data(), string.size(), seed);
+}
+
+// MurmurHash64A, consumes eight bytes per step and is meant for file contents
+u64 hash_bytes(const void* data, u64 size, u64 seed = 0);
+
+}  // namespace toki
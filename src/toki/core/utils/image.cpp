@@ -0,0 +1,405 @@
+#include "toki/core/utils/image.h"
+
+#include <toki/core/common/assert.h>
+#include <toki/core/math/math.h>
+#include <toki/core/memory/memory.h>
+#include <toki/core/utils/memory.h>
+
+#if defined(__x86_64__) || defined(_M_X64)
+	#include <immintrin.h>
+	#define TK_IMAGE_X86
+#endif
+
+namespace toki {
+
+static constexpr u32 CHANNELS = 4;
+// Support of the Kaiser filter in destination pixels on each side and the window shape, same
+// defaults as NVIDIA Texture Tools
+static constexpr u32 KAISER_WIDTH = 3;
+static constexpr f64 KAISER_ALPHA = 4.0;
+static constexpr u32 MAX_TAPS	  = KAISER_WIDTH * 4;
+// Linear values are quantized to this many steps before encoding to sRGB, enough to keep every
+// 8 bit output value reachable
+static constexpr u32 SRGB_ENCODE_STEPS = 4096;
+
+u32 mip_level_count(u32 width, u32 height) {
+	TK_ASSERT(width > 0 && height > 0);
+	return 32 - static_cast<u32>(__builtin_clz(toki::max(width, height)));
+}
+
+u64 mip_level_offset(u32 width, u32 height, u32 level) {
+	u64 offset = 0;
+	for (u32 i = 0; i < level; i++) {
+		offset += static_cast<u64>(mip_dimension(width, i)) * mip_dimension(height, i) * CHANNELS;
+	}
+	return offset;
+}
+
+u64 mip_chain_size(u32 width, u32 height, u32 level_count) {
+	return mip_level_offset(width, height, level_count);
+}
+
+// Plain 2x2 average, every destination pixel reads the pixels (2x, 2x + 1) of rows 0 and 1.
+// Source columns past the edge are clamped, which only happens for 1 pixel wide images.
+static void box_row_scalar(const byte* row0, const byte* row1, u32 width, byte* dst, u32 begin, u32 end) {
+	for (u32 x = begin; x < end; x++) {
+		u32 x0 = toki::min(2 * x, width - 1) * CHANNELS;
+		u32 x1 = toki::min(2 * x + 1, width - 1) * CHANNELS;
+		for (u32 c = 0; c < CHANNELS; c++) {
+			u32 sum				  = row0[x0 + c] + row0[x1 + c] + row1[x0 + c] + row1[x1 + c];
+			dst[x * CHANNELS + c] = static_cast<byte>((sum + 2) >> 2);
+		}
+	}
+}
+
+#if defined(TK_IMAGE_X86)
+
+// SSE2 is part of x86_64, no runtime check needed. Returns how many destination pixels were written.
+static u32 box_row_sse2(const byte* row0, const byte* row1, byte* dst, u32 dst_width) {
+	const __m128i zero	= _mm_setzero_si128();
+	const __m128i round = _mm_set1_epi16(2);
+
+	// Pixels are widened to 16 bits so the sum of 4 can't overflow, the 8 source pixels of each
+	// row give 4 destination pixels
+	auto average = [&](const byte* source0, const byte* source1) {
+		__m128i a	= _mm_loadu_si128(reinterpret_cast<const __m128i*>(source0));
+		__m128i b	= _mm_loadu_si128(reinterpret_cast<const __m128i*>(source1));
+		__m128i lo	= _mm_add_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero));
+		__m128i hi	= _mm_add_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero));
+		__m128i sum = _mm_add_epi16(_mm_unpacklo_epi64(lo, hi), _mm_unpackhi_epi64(lo, hi));
+		return _mm_srli_epi16(_mm_add_epi16(sum, round), 2);
+	};
+
+	u32 x = 0;
+	for (; x + 4 <= dst_width; x += 4) {
+		const byte* source0 = row0 + x * 2 * CHANNELS;
+		const byte* source1 = row1 + x * 2 * CHANNELS;
+		__m128i first		= average(source0, source1);
+		__m128i second		= average(source0 + 16, source1 + 16);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x * CHANNELS), _mm_packus_epi16(first, second));
+	}
+	return x;
+}
+
+#endif
+
+static void downsample_box(const byte* src, u32 width, u32 height, byte* dst) {
+	u32 dst_width  = mip_dimension(width, 1);
+	u32 dst_height = mip_dimension(height, 1);
+	u64 stride	   = static_cast<u64>(width) * CHANNELS;
+
+	for (u32 y = 0; y < dst_height; y++) {
+		const byte* row0 = src + toki::min(2 * y, height - 1) * stride;
+		const byte* row1 = src + toki::min(2 * y + 1, height - 1) * stride;
+		byte* dst_row	 = dst + static_cast<u64>(y) * dst_width * CHANNELS;
+
+		u32 written = 0;
+#if defined(TK_IMAGE_X86)
+		if (width > 1) {
+			written = box_row_sse2(row0, row1, dst_row, dst_width);
+		}
+#endif
+		box_row_scalar(row0, row1, width, dst_row, written, dst_width);
+	}
+}
+
+// Filtering in float works on a whole RGBA pixel at once
+#if defined(TK_IMAGE_X86)
+
+using Pixel = __m128;
+
+static Pixel pixel_zero() {
+	return _mm_setzero_ps();
+}
+
+static Pixel pixel_load(const f32* pixel) {
+	return _mm_loadu_ps(pixel);
+}
+
+static void pixel_store(f32* pixel, Pixel value) {
+	_mm_storeu_ps(pixel, value);
+}
+
+static Pixel pixel_add(Pixel a, Pixel b) {
+	return _mm_add_ps(a, b);
+}
+
+static Pixel pixel_add_scaled(Pixel accumulator, Pixel value, f32 weight) {
+	return _mm_add_ps(accumulator, _mm_mul_ps(value, _mm_set1_ps(weight)));
+}
+
+#else
+
+struct Pixel {
+	f32 channels[CHANNELS];
+};
+
+static Pixel pixel_zero() {
+	return {};
+}
+
+static Pixel pixel_load(const f32* pixel) {
+	Pixel value;
+	toki::memcpy(value.channels, pixel, sizeof(value.channels));
+	return value;
+}
+
+static void pixel_store(f32* pixel, Pixel value) {
+	toki::memcpy(pixel, value.channels, sizeof(value.channels));
+}
+
+static Pixel pixel_add(Pixel a, Pixel b) {
+	for (u32 c = 0; c < CHANNELS; c++) {
+		a.channels[c] += b.channels[c];
+	}
+	return a;
+}
+
+static Pixel pixel_add_scaled(Pixel accumulator, Pixel value, f32 weight) {
+	for (u32 c = 0; c < CHANNELS; c++) {
+		accumulator.channels[c] += value.channels[c] * weight;
+	}
+	return accumulator;
+}
+
+#endif
+
+// Symmetric kernel for halving, tap k reads the source pixel 2x + 1 - tap_count / 2 + k
+struct MipKernel {
+	f32 weights[MAX_TAPS];
+	u32 tap_count;
+};
+
+static f64 bessel_i0(f64 x) {
+	f64 sum	 = 1.0;
+	f64 term = 1.0;
+	for (u32 k = 1; term > sum * 1e-12; k++) {
+		f64 factor = x / (2.0 * k);
+		term *= factor * factor;
+		sum += term;
+	}
+	return sum;
+}
+
+static MipKernel make_kaiser_kernel() {
+	MipKernel kernel{};
+	kernel.tap_count = MAX_TAPS;
+
+	f64 total = 0.0;
+	for (u32 k = 0; k < kernel.tap_count; k++) {
+		// Distance between the source and destination pixel centers in destination pixels
+		f64 x	   = (static_cast<f64>(k) - kernel.tap_count / 2.0 + 0.5) / 2.0;
+		f64 sinc   = toki::sin(PI * x) / (PI * x);
+		f64 ratio  = x / KAISER_WIDTH;
+		f64 window = bessel_i0(KAISER_ALPHA * toki::sqrt(1.0 - ratio * ratio)) / bessel_i0(KAISER_ALPHA);
+
+		kernel.weights[k] = static_cast<f32>(sinc * window);
+		total += kernel.weights[k];
+	}
+	for (u32 k = 0; k < kernel.tap_count; k++) {
+		kernel.weights[k] = static_cast<f32>(kernel.weights[k] / total);
+	}
+
+	return kernel;
+}
+
+static const MipKernel& get_kernel(MipFilter filter) {
+	static const MipKernel box	  = { { 0.5f, 0.5f }, 2 };
+	static const MipKernel kaiser = make_kaiser_kernel();
+	return filter == MipFilter::KAISER ? kaiser : box;
+}
+
+struct ChannelTables {
+	f32 unorm_to_float[256];
+	f32 srgb_to_linear[256];
+	byte linear_to_srgb[SRGB_ENCODE_STEPS];
+};
+
+static ChannelTables make_channel_tables() {
+	ChannelTables tables{};
+	for (u32 i = 0; i < 256; i++) {
+		f64 value				 = i / 255.0;
+		f64 linear				 = value <= 0.04045 ? value / 12.92 : __builtin_pow((value + 0.055) / 1.055, 2.4);
+		tables.unorm_to_float[i] = static_cast<f32>(value);
+		tables.srgb_to_linear[i] = static_cast<f32>(linear);
+	}
+	for (u32 i = 0; i < SRGB_ENCODE_STEPS; i++) {
+		f64 value				 = static_cast<f64>(i) / (SRGB_ENCODE_STEPS - 1);
+		f64 encoded				 = value <= 0.0031308 ? value * 12.92 : 1.055 * __builtin_pow(value, 1.0 / 2.4) - 0.055;
+		tables.linear_to_srgb[i] = static_cast<byte>(encoded * 255.0 + 0.5);
+	}
+	return tables;
+}
+
+static const ChannelTables& get_channel_tables() {
+	static const ChannelTables tables = make_channel_tables();
+	return tables;
+}
+
+static byte encode_unorm(f32 value) {
+	return static_cast<byte>(toki::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+}
+
+// Same 2x2 average in linear space. Every color channel goes through the lookup tables, which
+// leaves nothing to vectorize but is still much cheaper than the generic separable path.
+static void downsample_box_srgb(const byte* src, u32 width, u32 height, byte* dst) {
+	const ChannelTables& tables = get_channel_tables();
+	const f32* to_linear		= tables.srgb_to_linear;
+	constexpr f32 SUM_TO_INDEX	= (SRGB_ENCODE_STEPS - 1) / 4.0f;
+	u32 dst_width				= mip_dimension(width, 1);
+	u32 dst_height				= mip_dimension(height, 1);
+	u64 stride					= static_cast<u64>(width) * CHANNELS;
+
+	for (u32 y = 0; y < dst_height; y++) {
+		const byte* row0 = src + toki::min(2 * y, height - 1) * stride;
+		const byte* row1 = src + toki::min(2 * y + 1, height - 1) * stride;
+		byte* out		 = dst + static_cast<u64>(y) * dst_width * CHANNELS;
+
+		for (u32 x = 0; x < dst_width; x++, out += CHANNELS) {
+			u32 x0 = toki::min(2 * x, width - 1) * CHANNELS;
+			u32 x1 = toki::min(2 * x + 1, width - 1) * CHANNELS;
+			for (u32 c = 0; c < 3; c++) {
+				f32 sum = to_linear[row0[x0 + c]] + to_linear[row0[x1 + c]] + to_linear[row1[x0 + c]] +
+						  to_linear[row1[x1 + c]];
+				out[c]	= tables.linear_to_srgb[static_cast<u32>(sum * SUM_TO_INDEX + 0.5f)];
+			}
+			u32 alpha = row0[x0 + 3] + row0[x1 + 3] + row1[x0 + 3] + row1[x1 + 3];
+			out[3]	  = static_cast<byte>((alpha + 2) >> 2);
+		}
+	}
+}
+
+// Applies the kernel to tap_count pixels that are stride floats apart. Even and odd taps go to
+// separate sums so the adds don't all wait on each other.
+static Pixel apply_kernel(const MipKernel& kernel, const f32* first, u64 stride) {
+	Pixel even = pixel_zero();
+	Pixel odd  = pixel_zero();
+	for (u32 k = 0; k + 1 < kernel.tap_count; k += 2) {
+		even = pixel_add_scaled(even, pixel_load(first + k * stride), kernel.weights[k]);
+		odd	 = pixel_add_scaled(odd, pixel_load(first + (k + 1) * stride), kernel.weights[k + 1]);
+	}
+	if (kernel.tap_count % 2 != 0) {
+		u32 k = kernel.tap_count - 1;
+		even  = pixel_add_scaled(even, pixel_load(first + k * stride), kernel.weights[k]);
+	}
+	return pixel_add(even, odd);
+}
+
+// Separable path used by the Kaiser filter, horizontally filtered rows are kept in a ring so each
+// source row is only filtered once.
+static void downsample_separable(const byte* src, u32 width, u32 height, byte* dst, const MipConfig& config) {
+	const MipKernel& kernel		= get_kernel(config.filter);
+	const ChannelTables& tables = get_channel_tables();
+	const f32* color_table		= config.srgb ? tables.srgb_to_linear : tables.unorm_to_float;
+	u32 dst_width				= mip_dimension(width, 1);
+	u32 dst_height				= mip_dimension(height, 1);
+	u32 padding					= kernel.tap_count / 2;
+	u64 padded_width			= static_cast<u64>(width) + padding * 2;
+
+	// The decoded source row is padded with copies of its edge pixels, taps never need clamping
+	u64 row_size = static_cast<u64>(dst_width) * CHANNELS * sizeof(f32);
+	f32* decoded = reinterpret_cast<f32*>(DefaultAllocator::allocate(padded_width * CHANNELS * sizeof(f32)));
+	f32* rows	 = reinterpret_cast<f32*>(DefaultAllocator::allocate(kernel.tap_count * row_size));
+	i64 row_tags[MAX_TAPS];
+	for (u32 i = 0; i < kernel.tap_count; i++) {
+		row_tags[i] = -1;
+	}
+
+	auto filtered_row = [&](u32 source_y) -> const f32* {
+		u32 slot = source_y % kernel.tap_count;
+		f32* row = rows + static_cast<u64>(slot) * dst_width * CHANNELS;
+		if (row_tags[slot] == source_y) {
+			return row;
+		}
+		row_tags[slot] = source_y;
+
+		const byte* source = src + static_cast<u64>(source_y) * width * CHANNELS;
+		for (u64 x = 0; x < padded_width; x++) {
+			u64 clamped = toki::min<u64>(x > padding ? x - padding : 0, width - 1) * CHANNELS;
+			f32* pixel	= decoded + x * CHANNELS;
+			pixel[0]	= color_table[source[clamped + 0]];
+			pixel[1]	= color_table[source[clamped + 1]];
+			pixel[2]	= color_table[source[clamped + 2]];
+			pixel[3]	= tables.unorm_to_float[source[clamped + 3]];
+		}
+
+		// Tap k of destination pixel x reads source pixel 2x + 1 - padding + k, which is at
+		// 2x + 1 + k in the padded row
+		for (u32 x = 0; x < dst_width; x++) {
+			pixel_store(row + x * CHANNELS, apply_kernel(kernel, decoded + (2 * x + 1) * CHANNELS, CHANNELS));
+		}
+		return row;
+	};
+
+	// Vertical taps of a destination row, rows past the edges are clamped
+	const f32* taps[MAX_TAPS];
+
+	for (u32 y = 0; y < dst_height; y++) {
+		i64 first_row = 2 * static_cast<i64>(y) + 1 - padding;
+		for (u32 k = 0; k < kernel.tap_count; k++) {
+			taps[k] = filtered_row(static_cast<u32>(toki::clamp<i64>(first_row + k, 0, height - 1)));
+		}
+
+		byte* dst_row = dst + static_cast<u64>(y) * dst_width * CHANNELS;
+		for (u32 x = 0; x < dst_width; x++) {
+			Pixel even = pixel_zero();
+			Pixel odd  = pixel_zero();
+			for (u32 k = 0; k + 1 < kernel.tap_count; k += 2) {
+				even = pixel_add_scaled(even, pixel_load(taps[k] + x * CHANNELS), kernel.weights[k]);
+				odd	 = pixel_add_scaled(odd, pixel_load(taps[k + 1] + x * CHANNELS), kernel.weights[k + 1]);
+			}
+			if (kernel.tap_count % 2 != 0) {
+				u32 k = kernel.tap_count - 1;
+				even  = pixel_add_scaled(even, pixel_load(taps[k] + x * CHANNELS), kernel.weights[k]);
+			}
+			f32 pixel[CHANNELS];
+			pixel_store(pixel, pixel_add(even, odd));
+
+			byte* out = dst_row + x * CHANNELS;
+			if (config.srgb) {
+				for (u32 c = 0; c < 3; c++) {
+					f32 clamped = toki::clamp(pixel[c], 0.0f, 1.0f);
+					out[c]		= tables.linear_to_srgb[static_cast<u32>(clamped * (SRGB_ENCODE_STEPS - 1) + 0.5f)];
+				}
+			} else {
+				for (u32 c = 0; c < 3; c++) {
+					out[c] = encode_unorm(pixel[c]);
+				}
+			}
+			out[3] = encode_unorm(pixel[3]);
+		}
+	}
+
+	DefaultAllocator::free(rows);
+	DefaultAllocator::free(decoded);
+}
+
+void downsample_rgba8(const byte* src, u32 width, u32 height, byte* dst, const MipConfig& config) {
+	TK_ASSERT(width > 0 && height > 0);
+
+	if (config.filter == MipFilter::BOX) {
+		if (config.srgb) {
+			downsample_box_srgb(src, width, height, dst);
+		} else {
+			downsample_box(src, width, height, dst);
+		}
+	} else {
+		downsample_separable(src, width, height, dst, config);
+	}
+}
+
+void generate_mip_chain(
+	const byte* level0, u32 width, u32 height, u32 level_count, byte* levels_out, const MipConfig& config) {
+	TK_ASSERT(level_count <= mip_level_count(width, height));
+
+	const byte* source = level0;
+	byte* destination  = levels_out;
+	for (u32 level = 1; level < level_count; level++) {
+		downsample_rgba8(source, mip_dimension(width, level - 1), mip_dimension(height, level - 1), destination, config);
+
+		source = destination;
+		destination += static_cast<u64>(mip_dimension(width, level)) * mip_dimension(height, level) * CHANNELS;
+	}
+}
+
+}  // namespace toki
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <toki/core/types.h>
+
+namespace toki {
+
+// Mip chains are RGBA8 levels stored one after the other starting with level 0. Each level is
+// half the size of the previous one rounded down, the last one is 1x1.
+
+enum struct MipFilter : u32 {
+	// 2x2 average, cheapest
+	BOX,
+	// Kaiser windowed sinc, keeps smaller levels sharper at the cost of slight ringing
+	KAISER,
+};
+
+struct MipConfig {
+	MipFilter filter = MipFilter::BOX;
+	// Color channels are sRGB encoded and filtered in linear space, alpha is always linear
+	b8 srgb = false;
+};
+
+u32 mip_level_count(u32 width, u32 height);
+
+inline u32 mip_dimension(u32 size, u32 level) {
+	u32 scaled = size >> level;
+	return scaled > 0 ? scaled : 1;
+}
+
+// Bytes before the level in the chain
+u64 mip_level_offset(u32 width, u32 height, u32 level);
+
+u64 mip_chain_size(u32 width, u32 height, u32 level_count);
+
+// Writes the next level of the source image, dst has to hold mip_dimension(width, 1) by
+// mip_dimension(height, 1) pixels
+void downsample_rgba8(const byte* src, u32 width, u32 height, byte* dst, const MipConfig& config = {});
+
+// Writes levels 1 to level_count - 1 packed one after the other to levels_out. Every level is
+// filtered from the previous one, which is read back from levels_out. Pass the memory right after
+// level 0 to fill a whole chain in place.
+void generate_mip_chain(
+	const byte* level0, u32 width, u32 height, u32 level_count, byte* levels_out, const MipConfig& config = {});
+
+}  // namespace toki
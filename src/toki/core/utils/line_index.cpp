@@ -0,0 +1,169 @@
+#include "toki/core/utils/line_index.h"
+
+#include <toki/core/common/assert.h>
+#include <toki/core/common/defines.h>
+#include <toki/core/math/math.h>
+#include <toki/core/utils/bytes.h>
+#include <toki/core/utils/memory.h>
+
+#if defined(__x86_64__) || defined(_M_X64)
+	#include <immintrin.h>
+	#define TK_LINE_INDEX_X86
+#endif
+
+namespace toki {
+
+// Text indexed per step, large enough for the scan loop to dominate and small enough that asking
+// for one of the first lines only touches the start of the file
+static constexpr u64 INDEX_STEP_SIZE = KB(64);
+
+static StringView make_line(const char* start, const char* end) {
+	if (end > start && end[-1] == '\r') {
+		end--;
+	}
+	return StringView(start, static_cast<u64>(end - start));
+}
+
+static void scan_newlines_scalar(const char* text, u64 begin, u64 end, DynamicArray<u64>& starts) {
+	for (u64 i = begin; i < end; i++) {
+		if (text[i] == '\n') {
+			starts.push_back(i + 1);
+		}
+	}
+}
+
+#if defined(TK_LINE_INDEX_X86)
+
+// Every set bit of the compare mask is a newline, lines are usually short so all of them are taken
+// from the mask instead of searching again after each one
+static void push_newlines(u32 mask, u64 offset, DynamicArray<u64>& starts) {
+	while (mask != 0) {
+		starts.push_back(offset + __builtin_ctz(mask) + 1);
+		mask &= mask - 1;
+	}
+}
+
+static void scan_newlines_sse2(const char* text, u64 begin, u64 end, DynamicArray<u64>& starts) {
+	const __m128i newline = _mm_set1_epi8('\n');
+
+	u64 i = begin;
+	for (; i + 16 <= end; i += 16) {
+		__m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i));
+		push_newlines(static_cast<u32>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, newline))), i, starts);
+	}
+
+	scan_newlines_scalar(text, i, end, starts);
+}
+
+__attribute__((target("avx2"))) static void scan_newlines_avx2(
+	const char* text, u64 begin, u64 end, DynamicArray<u64>& starts) {
+	const __m256i newline = _mm256_set1_epi8('\n');
+
+	u64 i = begin;
+	for (; i + 32 <= end; i += 32) {
+		__m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(text + i));
+		push_newlines(static_cast<u32>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, newline))), i, starts);
+	}
+
+	scan_newlines_sse2(text, i, end, starts);
+}
+
+#endif
+
+// Appends the start of the line after every newline in [begin, end)
+static void scan_newlines(const char* text, u64 begin, u64 end, DynamicArray<u64>& starts) {
+#if defined(TK_LINE_INDEX_X86)
+	static const b8 has_avx2 = __builtin_cpu_supports("avx2");
+	if (has_avx2) {
+		scan_newlines_avx2(text, begin, end, starts);
+	} else {
+		scan_newlines_sse2(text, begin, end, starts);
+	}
+#else
+	scan_newlines_scalar(text, begin, end, starts);
+#endif
+}
+
+LineIterator::LineIterator(StringView text): m_position(text.data()), m_end(text.data() + text.size()) {
+	find_line();
+}
+
+LineIterator& LineIterator::operator++() {
+	m_position = m_next;
+	find_line();
+	return *this;
+}
+
+void LineIterator::find_line() {
+	if (m_position == m_end) {
+		m_next = m_end;
+		m_line = {};
+		return;
+	}
+
+	const char* newline = reinterpret_cast<const char*>(
+		toki::memchr(m_position, '\n', static_cast<u64>(m_end - m_position)));
+	if (newline != nullptr) {
+		m_line = make_line(m_position, newline);
+		m_next = newline + 1;
+	} else {
+		m_line = make_line(m_position, m_end);
+		m_next = m_end;
+	}
+}
+
+LineIndex::LineIndex(StringView text) {
+	reset(text);
+}
+
+void LineIndex::reset(StringView text) {
+	m_text	  = text;
+	m_scanned = 0;
+	m_starts.clear();
+	if (text.size() > 0) {
+		m_starts.push_back(0);
+	}
+}
+
+u64 LineIndex::line_count() {
+	index_until(U64_MAX - 1);
+	return m_starts.size();
+}
+
+StringView LineIndex::line(u64 index) {
+	index_until(index);
+	TK_ASSERT(index < m_starts.size());
+
+	const char* start = m_text.data() + m_starts[index];
+	if (index + 1 < m_starts.size()) {
+		return make_line(start, m_text.data() + m_starts[index + 1] - 1);
+	}
+
+	// Last line, only reached once the whole text is indexed
+	const char* end = m_text.data() + m_text.size();
+	if (end[-1] == '\n') {
+		end--;
+	}
+	return make_line(start, end);
+}
+
+b8 LineIndex::has_line(u64 index) {
+	index_until(index);
+	return index < m_starts.size();
+}
+
+void LineIndex::index_until(u64 index) {
+	// The end of a line is the start of the next one, so one more start than the line is needed
+	while (m_starts.size() <= index + 1 && !is_complete()) {
+		u64 end = toki::min(m_scanned + INDEX_STEP_SIZE, m_text.size());
+		scan_newlines(m_text.data(), m_scanned, end, m_starts);
+		m_scanned = end;
+	}
+
+	// A newline at the very end does not start another line
+	if (is_complete() && m_starts.size() > 0 && m_starts.last() == m_text.size()) {
+		m_starts.shrink_to_size(m_starts.size() - 1);
+	}
+}
+
+}  // namespace toki
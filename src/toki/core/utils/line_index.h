@@ -0,0 +1,87 @@
+#pragma once
+
+#include <toki/core/containers/dynamic_array.h>
+#include <toki/core/string/string_view.h>
+#include <toki/core/types.h>
+
+namespace toki {
+
+// Lines of a text, split at '\n' with a '\r' before it dropped. A newline at the very end does
+// not start another line, an empty text has no lines.
+
+// Iterates lines front to back without building an index, each step searches for the next newline
+class LineIterator {
+public:
+	LineIterator() = default;
+	LineIterator(StringView text);
+
+	StringView operator*() const {
+		return m_line;
+	}
+
+	LineIterator& operator++();
+
+	b8 operator==(const LineIterator& other) const {
+		return m_position == other.m_position;
+	}
+
+private:
+	void find_line();
+
+	// Start of the current line, equal to m_end once every line was visited
+	const char* m_position{};
+	const char* m_next{};
+	const char* m_end{};
+	StringView m_line;
+};
+
+struct LineRange {
+	StringView text;
+
+	LineIterator begin() const {
+		return LineIterator(text);
+	}
+
+	LineIterator end() const {
+		return LineIterator(StringView(text.data() + text.size(), 0));
+	}
+};
+
+// Start offsets of the lines of a text, found on demand. Looking up line N only scans as far as
+// the end of line N, so the start of a large file can be read without touching the rest of it.
+// The text has to outlive the index.
+class LineIndex {
+public:
+	LineIndex() = default;
+	LineIndex(StringView text);
+
+	void reset(StringView text);
+
+	// Scans the rest of the text if it was not indexed yet
+	u64 line_count();
+
+	// Index has to be below line_count, lines that were indexed before are found in O(1)
+	StringView line(u64 index);
+
+	// Only scans as far as needed to tell if the line exists
+	b8 has_line(u64 index);
+
+	b8 is_complete() const {
+		return m_scanned == m_text.size();
+	}
+
+	// Bytes of the text indexed so far
+	u64 scanned_size() const {
+		return m_scanned;
+	}
+
+private:
+	// Scans until index + 1 line starts are known or the text ended
+	void index_until(u64 index);
+
+	StringView m_text;
+	DynamicArray<u64> m_starts;
+	u64 m_scanned{};
+};
+
+}  // namespace toki
@@ -0,0 +1,244 @@
+#include "toki/core/utils/lz4.h"
+
+#include <toki/core/common/defines.h>
+#include <toki/core/math/math.h>
+#include <toki/core/utils/memory.h>
+
+namespace toki {
+
+static constexpr u32 MIN_MATCH = 4;
+// The format requires the last 5 bytes to be literals and the last match to start at least
+// 12 bytes before the end of the block
+static constexpr u64 LAST_LITERALS	  = 5;
+static constexpr u64 MATCH_FIND_LIMIT = 12;
+static constexpr u64 MAX_OFFSET		  = 65535;
+static constexpr u32 HASH_BITS		  = 12;
+// After this many positions without a match the search starts skipping ahead, incompressible
+// data is then passed over quickly
+static constexpr u32 SKIP_TRIGGER = 6;
+// Fast copies write up to this many bytes past the end of what they copy
+static constexpr u64 WILD_COPY_SLACK = 16;
+static constexpr u32 NO_POSITION	  = U32_MAX;
+
+static u32 read_u32(const byte* data) {
+	u32 value;
+	toki::memcpy(&value, data, sizeof(value));
+	return value;
+}
+
+static void copy_8(byte* destination, const byte* source) {
+	u64 value;
+	toki::memcpy(&value, source, sizeof(value));
+	toki::memcpy(destination, &value, sizeof(value));
+}
+
+// Copies in 8 byte steps and may write past destination + size, callers make sure there is room
+static void wild_copy(byte* destination, const byte* source, u64 size) {
+	for (u64 i = 0; i < size; i += 8) {
+		copy_8(destination + i, source + i);
+	}
+}
+
+static u32 hash_sequence(u32 sequence) {
+	return (sequence * 2654435761u) >> (32 - HASH_BITS);
+}
+
+// Lengths that don't fit into the token nibble continue in bytes of 255 until a smaller one
+static b8 write_length(byte*& out, const byte* out_end, u64 length) {
+	for (; length >= 255; length -= 255) {
+		if (out == out_end) {
+			return false;
+		}
+		*out++ = 255;
+	}
+	if (out == out_end) {
+		return false;
+	}
+	*out++ = static_cast<byte>(length);
+	return true;
+}
+
+static b8 write_sequence(
+	byte*& out, const byte* out_end, const byte* literals, u64 literal_count, u64 offset, u64 match_length) {
+	if (out == out_end) {
+		return false;
+	}
+
+	byte* token = out++;
+	*token		= static_cast<byte>(toki::min<u64>(literal_count, 15) << 4);
+	if (literal_count >= 15 && !write_length(out, out_end, literal_count - 15)) {
+		return false;
+	}
+
+	if (static_cast<u64>(out_end - out) < literal_count) {
+		return false;
+	}
+	toki::memcpy(out, literals, literal_count);
+	out += literal_count;
+
+	// Last sequence of a block, literals only
+	if (match_length == 0) {
+		return true;
+	}
+
+	if (out_end - out < 2) {
+		return false;
+	}
+	*out++ = static_cast<byte>(offset & 0xFF);
+	*out++ = static_cast<byte>(offset >> 8);
+
+	u64 length = match_length - MIN_MATCH;
+	*token	   = static_cast<byte>(*token | toki::min<u64>(length, 15));
+	return length < 15 || write_length(out, out_end, length - 15);
+}
+
+u64 lz4_compress(const void* source, u64 size, void* destination, u64 capacity) {
+	const byte* in		= reinterpret_cast<const byte*>(source);
+	byte* out			= reinterpret_cast<byte*>(destination);
+	const byte* out_end = out + capacity;
+
+	u64 anchor = 0;
+	if (size > MATCH_FIND_LIMIT) {
+		u32 table[1 << HASH_BITS];
+		for (u32& entry : table) {
+			entry = NO_POSITION;
+		}
+
+		u64 match_limit	  = size - LAST_LITERALS;
+		u32 search_count = 1 << SKIP_TRIGGER;
+		for (u64 position = 0; position < size - MATCH_FIND_LIMIT;) {
+			u32 sequence  = read_u32(in + position);
+			u32 hash	  = hash_sequence(sequence);
+			u32 candidate = table[hash];
+			table[hash]	  = static_cast<u32>(position);
+
+			if (candidate == NO_POSITION || position - candidate > MAX_OFFSET || read_u32(in + candidate) != sequence) {
+				position += search_count++ >> SKIP_TRIGGER;
+				continue;
+			}
+			search_count = 1 << SKIP_TRIGGER;
+
+			u64 match_start = position;
+			u64 length		= MIN_MATCH;
+			while (position + length < match_limit && in[candidate + length] == in[position + length]) {
+				length++;
+			}
+			// Matches can also grow backwards into literals that weren't emitted yet
+			while (match_start > anchor && candidate > 0 && in[match_start - 1] == in[candidate - 1]) {
+				match_start--;
+				candidate--;
+				length++;
+			}
+
+			if (!write_sequence(out, out_end, in + anchor, match_start - anchor, match_start - candidate, length)) {
+				return 0;
+			}
+			position = match_start + length;
+			anchor	 = position;
+		}
+	}
+
+	if (!write_sequence(out, out_end, in + anchor, size - anchor, 0, 0)) {
+		return 0;
+	}
+	return static_cast<u64>(out - reinterpret_cast<byte*>(destination));
+}
+
+static b8 read_length(const byte*& in, const byte* in_end, u64& length) {
+	byte value;
+	do {
+		if (in == in_end) {
+			return false;
+		}
+		value = *in++;
+		length += value;
+	} while (value == 255);
+	return true;
+}
+
+Expected<u64, TokiError> lz4_decompress(const void* source, u64 size, void* destination, u64 capacity) {
+	const byte* in	   = reinterpret_cast<const byte*>(source);
+	const byte* in_end = in + size;
+	byte* out_begin	   = reinterpret_cast<byte*>(destination);
+	byte* out		   = out_begin;
+	byte* out_end	   = out_begin + capacity;
+
+	while (true) {
+		if (in == in_end) {
+			return Unexpected(TokiError::CorruptData);
+		}
+		byte token = *in++;
+
+		// Most sequences have short literal runs and matches, those are copied with a fixed size
+		// so the length doesn't cost a branch
+		u64 literal_count = token >> 4;
+		if (literal_count < 15 && in_end - in >= 16 && out_end - out >= 16) {
+			copy_8(out, in);
+			copy_8(out + 8, in + 8);
+		} else {
+			if (literal_count == 15 && !read_length(in, in_end, literal_count)) {
+				return Unexpected(TokiError::CorruptData);
+			}
+			u64 in_left	 = static_cast<u64>(in_end - in);
+			u64 out_left = static_cast<u64>(out_end - out);
+			if (in_left < literal_count || out_left < literal_count) {
+				return Unexpected(TokiError::CorruptData);
+			}
+			if (in_left >= literal_count + WILD_COPY_SLACK && out_left >= literal_count + WILD_COPY_SLACK) {
+				wild_copy(out, in, literal_count);
+			} else {
+				toki::memcpy(out, in, literal_count);
+			}
+		}
+		in += literal_count;
+		out += literal_count;
+
+		if (in == in_end) {
+			break;
+		}
+
+		if (in_end - in < 2) {
+			return Unexpected(TokiError::CorruptData);
+		}
+		u64 offset = static_cast<u64>(in[0]) | (static_cast<u64>(in[1]) << 8);
+		in += 2;
+		if (offset == 0 || offset > static_cast<u64>(out - out_begin)) {
+			return Unexpected(TokiError::CorruptData);
+		}
+
+		const byte* match = out - offset;
+		u64 match_length  = token & 0xF;
+		if (match_length < 15 && offset >= 8 && out_end - out >= 24) {
+			copy_8(out, match);
+			copy_8(out + 8, match + 8);
+			copy_8(out + 16, match + 16);
+			out += match_length + MIN_MATCH;
+			continue;
+		}
+
+		if (match_length == 15 && !read_length(in, in_end, match_length)) {
+			return Unexpected(TokiError::CorruptData);
+		}
+		match_length += MIN_MATCH;
+		if (static_cast<u64>(out_end - out) < match_length) {
+			return Unexpected(TokiError::CorruptData);
+		}
+
+		// Matches closer than 8 bytes repeat the bytes they are still writing, those are copied
+		// one at a time
+		if (offset >= 8 && static_cast<u64>(out_end - out) >= match_length + WILD_COPY_SLACK) {
+			wild_copy(out, match, match_length);
+		} else if (offset >= match_length) {
+			toki::memcpy(out, match, match_length);
+		} else {
+			for (u64 i = 0; i < match_length; i++) {
+				out[i] = match[i];
+			}
+		}
+		out += match_length;
+	}
+
+	return static_cast<u64>(out - out_begin);
+}
+
+}  // namespace toki
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <toki/core/common/expected.h>
+#include <toki/core/errors.h>
+#include <toki/core/types.h>
+
+namespace toki {
+
+// Compressor and decompressor for the LZ4 block format, output is readable by the reference
+// implementation and the other way around. Blocks don't store their decompressed size, the
+// caller has to keep track of it.
+
+// Compressed size of incompressible input, destinations this large never run out of space
+constexpr u64 lz4_compress_bound(u64 size) {
+	return size + size / 255 + 16;
+}
+
+// Returns the compressed size, 0 if it didn't fit into capacity
+u64 lz4_compress(const void* source, u64 size, void* destination, u64 capacity);
+
+// Fails on malformed input instead of reading or writing out of bounds
+Expected<u64, TokiError> lz4_decompress(const void* source, u64 size, void* destination, u64 capacity);
+
+}  // namespace toki
@@ -0,0 +1,76 @@
+#include "toki/core/utils/mapped_file.h"
+
+#include <toki/core/platform/syscalls.h>
+
+namespace toki {
+
+MappedFile::MappedFile(const Path& path, FileAccessHint hint) {
+	open(path, hint);
+}
+
+MappedFile::~MappedFile() {
+	close();
+}
+
+MappedFile::MappedFile(MappedFile&& other): m_data(other.m_data), m_size(other.m_size), m_open(other.m_open) {
+	other.m_data = nullptr;
+	other.m_size = 0;
+	other.m_open = false;
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) {
+	if (&other == this) {
+		return *this;
+	}
+
+	close();
+	m_data		 = other.m_data;
+	m_size		 = other.m_size;
+	m_open		 = other.m_open;
+	other.m_data = nullptr;
+	other.m_size = 0;
+	other.m_open = false;
+
+	return *this;
+}
+
+b8 MappedFile::open(const Path& path, FileAccessHint hint) {
+	close();
+
+	auto handle = toki::open(path.c_str(), FileMode::READ);
+	if (!handle) {
+		return false;
+	}
+
+	auto size = toki::get_file_size(handle.value());
+	if (!size) {
+		toki::close(handle.value());
+		return false;
+	}
+
+	if (size.value() > 0) {
+		auto data = toki::map_file(handle.value(), size.value(), hint);
+		if (!data) {
+			toki::close(handle.value());
+			return false;
+		}
+		m_data = reinterpret_cast<const byte*>(data.value());
+		m_size = size.value();
+	}
+
+	// The mapping keeps its own reference to the file
+	toki::close(handle.value());
+	m_open = true;
+	return true;
+}
+
+void MappedFile::close() {
+	if (m_data != nullptr) {
+		toki::unmap_file(m_data, m_size);
+	}
+	m_data = nullptr;
+	m_size = 0;
+	m_open = false;
+}
+
+}  // namespace toki
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <toki/core/common/macros.h>
+#include <toki/core/platform/defines.h>
+#include <toki/core/string/string_view.h>
+#include <toki/core/types.h>
+#include <toki/core/utils/path.h>
+
+namespace toki {
+
+// Read only view of a whole file mapped into memory, pages are loaded by the kernel on first
+// access so parsing it costs no read syscalls and no copies
+class MappedFile {
+public:
+	MappedFile() = default;
+	MappedFile(const Path& path, FileAccessHint hint = FileAccessHint::NORMAL);
+	~MappedFile();
+
+	MappedFile(MappedFile&& other);
+	MappedFile& operator=(MappedFile&& other);
+
+	DELETE_COPY(MappedFile)
+
+	b8 open(const Path& path, FileAccessHint hint = FileAccessHint::NORMAL);
+	void close();
+
+	// Empty files are open but have no data
+	b8 is_open() const {
+		return m_open;
+	}
+
+	const byte* data() const {
+		return m_data;
+	}
+
+	u64 size() const {
+		return m_size;
+	}
+
+	StringView as_string() const {
+		return StringView(reinterpret_cast<const char*>(m_data), m_size);
+	}
+
+private:
+	const byte* m_data{};
+	u64 m_size{};
+	b8 m_open{};
+};
+
+}  // namespace toki
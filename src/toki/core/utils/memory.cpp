@@ -0,0 +1,65 @@
+#include "toki/core/utils/memory.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+	#include <immintrin.h>
+	#define TK_MEMCHR_X86
+#endif
+
+namespace toki {
+
+static const void* memchr_scalar(const byte* data, byte value, u64 size) {
+	for (u64 i = 0; i < size; i++) {
+		if (data[i] == value) {
+			return &data[i];
+		}
+	}
+	return nullptr;
+}
+
+#if defined(TK_MEMCHR_X86)
+
+// SSE2 is part of x86_64, no runtime check needed
+static const void* memchr_sse2(const byte* data, byte value, u64 size) {
+	const __m128i needle = _mm_set1_epi8(static_cast<char>(value));
+
+	u64 i = 0;
+	for (; i + 16 <= size; i += 16) {
+		__m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+		u32 mask	  = static_cast<u32>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, needle)));
+		if (mask != 0) {
+			return data + i + __builtin_ctz(mask);
+		}
+	}
+
+	return memchr_scalar(data + i, value, size - i);
+}
+
+__attribute__((target("avx2"))) static const void* memchr_avx2(const byte* data, byte value, u64 size) {
+	const __m256i needle = _mm256_set1_epi8(static_cast<char>(value));
+
+	u64 i = 0;
+	for (; i + 32 <= size; i += 32) {
+		__m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+		u32 mask	  = static_cast<u32>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, needle)));
+		if (mask != 0) {
+			return data + i + __builtin_ctz(mask);
+		}
+	}
+
+	return memchr_sse2(data + i, value, size - i);
+}
+
+#endif
+
+const void* memchr(const void* data, byte value, u64 size) {
+	const byte* bytes = reinterpret_cast<const byte*>(data);
+
+#if defined(TK_MEMCHR_X86)
+	static const b8 has_avx2 = __builtin_cpu_supports("avx2");
+	return has_avx2 ? memchr_avx2(bytes, value, size) : memchr_sse2(bytes, value, size);
+#else
+	return memchr_scalar(bytes, value, size);
+#endif
+}
+
+}  // namespace toki
@@ -32,9 +32,30 @@ constexpr int strncmp(const char* s1, const char* s2, u32 length) {
 	return 0;
 }
 
+// Regions must not overlap, use memmove for that
 constexpr void memcpy(void* dst, const void* src, u64 size) {
-	for (u32 i = 0; i < size; i++) {
-		reinterpret_cast<byte*>(dst)[i] = reinterpret_cast<const byte*>(src)[i];
+	if consteval {
+		for (u64 i = 0; i < size; i++) {
+			reinterpret_cast<byte*>(dst)[i] = reinterpret_cast<const byte*>(src)[i];
+		}
+	} else {
+		__builtin_memcpy(dst, src, size);
+	}
+}
+
+constexpr void memmove(void* dst, const void* src, u64 size) {
+	if consteval {
+		if (dst < src) {
+			for (u64 i = 0; i < size; i++) {
+				reinterpret_cast<byte*>(dst)[i] = reinterpret_cast<const byte*>(src)[i];
+			}
+		} else {
+			for (u64 i = size; i > 0; i--) {
+				reinterpret_cast<byte*>(dst)[i - 1] = reinterpret_cast<const byte*>(src)[i - 1];
+			}
+		}
+	} else {
+		__builtin_memmove(dst, src, size);
 	}
 }
 
@@ -45,6 +66,10 @@ constexpr void memset(void* dst, const T& ch, u64 size) {
 	}
 }
 
+// Returns the first occurrence of value in data or nullptr, scans 16 or 32 bytes at a time
+// depending on what the CPU supports
+const void* memchr(const void* data, byte value, u64 size);
+
 constexpr b8 is_space(char c) {
 	return c == ' ';
 }
@@ -0,0 +1,353 @@
+#include "toki/core/utils/mesh_optimizer.h"
+
+#include <toki/core/common/assert.h>
+#include <toki/core/common/defines.h>
+#include <toki/core/math/math.h>
+#include <toki/core/utils/memory.h>
+#include <toki/core/utils/sort.h>
+
+namespace toki {
+
+static constexpr u32 FETCH_LINE_SIZE   = 64;
+static constexpr u32 FETCH_CACHE_LINES = 64;
+
+// First in first out cache kept as the time each entry was inserted, an entry is cached while
+// fewer than size insertions happened after it. Flushing is a jump of the clock.
+struct FifoCache {
+	DynamicArray<u32> inserted_at;
+	u32 size;
+	u32 time;
+
+	FifoCache(u64 entry_count, u32 cache_size): inserted_at(entry_count, 0), size(cache_size), time(cache_size + 1) {}
+
+	// Returns true on a miss
+	b8 access(u64 entry) {
+		if (time - inserted_at[entry] <= size) {
+			return false;
+		}
+		inserted_at[entry] = time++;
+		return true;
+	}
+
+	void flush() {
+		time += size + 1;
+	}
+};
+
+VertexCacheStatistics analyze_vertex_cache(Span<u32> indices, u32 vertex_count, u32 cache_size) {
+	FifoCache cache(vertex_count, cache_size);
+	u32 misses = 0;
+	for (u64 i = 0; i < indices.size(); i++) {
+		TK_ASSERT(indices[i] < vertex_count);
+		misses += cache.access(indices[i]);
+	}
+
+	VertexCacheStatistics statistics{};
+	statistics.vertices_transformed = misses;
+	statistics.acmr = indices.size() >= 3 ? static_cast<f32>(misses) / static_cast<f32>(indices.size() / 3) : 0.0f;
+	statistics.atvr = vertex_count > 0 ? static_cast<f32>(misses) / static_cast<f32>(vertex_count) : 0.0f;
+	return statistics;
+}
+
+VertexFetchStatistics analyze_vertex_fetch(Span<u32> indices, u32 vertex_count, u32 vertex_stride) {
+	u64 buffer_size = static_cast<u64>(vertex_count) * vertex_stride;
+	FifoCache cache((buffer_size + FETCH_LINE_SIZE - 1) / FETCH_LINE_SIZE, FETCH_CACHE_LINES);
+
+	VertexFetchStatistics statistics{};
+	for (u64 i = 0; i < indices.size(); i++) {
+		TK_ASSERT(indices[i] < vertex_count);
+		u64 begin = static_cast<u64>(indices[i]) * vertex_stride;
+		for (u64 line = begin / FETCH_LINE_SIZE; line <= (begin + vertex_stride - 1) / FETCH_LINE_SIZE; line++) {
+			statistics.bytes_fetched += cache.access(line) ? FETCH_LINE_SIZE : 0;
+		}
+	}
+	statistics.overfetch =
+		buffer_size > 0 ? static_cast<f32>(statistics.bytes_fetched) / static_cast<f32>(buffer_size) : 0.0f;
+	return statistics;
+}
+
+// Triangles using each vertex, the ones of vertex v are triangles[offsets[v], offsets[v + 1])
+struct TriangleAdjacency {
+	DynamicArray<u32> offsets;
+	DynamicArray<u32> triangles;
+};
+
+static TriangleAdjacency build_adjacency(Span<u32> indices, u32 vertex_count) {
+	TriangleAdjacency adjacency{};
+	adjacency.offsets	= DynamicArray<u32>(static_cast<u64>(vertex_count) + 1, 0);
+	adjacency.triangles = DynamicArray<u32>(indices.size());
+
+	for (u64 i = 0; i < indices.size(); i++) {
+		TK_ASSERT(indices[i] < vertex_count);
+		adjacency.offsets[indices[i] + 1]++;
+	}
+	for (u32 v = 0; v < vertex_count; v++) {
+		adjacency.offsets[v + 1] += adjacency.offsets[v];
+	}
+
+	// Filled through a second set of offsets that ends up one vertex ahead
+	DynamicArray<u32> fill(static_cast<u64>(vertex_count) + 1, 0);
+	toki::memcpy(fill.data(), adjacency.offsets.data(), fill.size() * sizeof(u32));
+	for (u64 i = 0; i < indices.size(); i++) {
+		adjacency.triangles[fill[indices[i]]++] = static_cast<u32>(i / 3);
+	}
+	return adjacency;
+}
+
+void optimize_vertex_cache(Span<u32> indices, u32 vertex_count, u32* indices_out, u32 cache_size) {
+	TK_ASSERT(indices.size() % 3 == 0);
+	TK_ASSERT(indices.data() != indices_out);
+
+	u64 triangle_count			= indices.size() / 3;
+	TriangleAdjacency adjacency = build_adjacency(indices, vertex_count);
+	DynamicArray<u32> live_count(vertex_count, 0);
+	DynamicArray<u32> cached_at(vertex_count, 0);
+	DynamicArray<b8> emitted(triangle_count, false);
+	for (u32 v = 0; v < vertex_count; v++) {
+		live_count[v] = adjacency.offsets[v + 1] - adjacency.offsets[v];
+	}
+
+	// Vertices of emitted triangles, revisited when the fan candidates run out
+	DynamicArray<u32> dead_end;
+	DynamicArray<u32> candidates;
+	u32 time		 = cache_size + 1;
+	u32 cursor		 = 0;
+	u64 output_count = 0;
+
+	auto skip_dead_end = [&]() -> i64 {
+		while (dead_end.size() > 0) {
+			u32 vertex = dead_end.last();
+			dead_end.shrink_to_size(dead_end.size() - 1);
+			if (live_count[vertex] > 0) {
+				return vertex;
+			}
+		}
+		for (; cursor < vertex_count; cursor++) {
+			if (live_count[cursor] > 0) {
+				return cursor;
+			}
+		}
+		return -1;
+	};
+
+	i64 fan_vertex = skip_dead_end();
+	while (fan_vertex >= 0) {
+		candidates.clear();
+		u32 vertex = static_cast<u32>(fan_vertex);
+		for (u32 i = adjacency.offsets[vertex]; i < adjacency.offsets[vertex + 1]; i++) {
+			u32 triangle = adjacency.triangles[i];
+			if (emitted[triangle]) {
+				continue;
+			}
+			emitted[triangle] = true;
+
+			for (u32 corner = 0; corner < 3; corner++) {
+				u32 v						= indices[triangle * 3 + corner];
+				indices_out[output_count++] = v;
+				dead_end.push_back(v);
+				candidates.push_back(v);
+				live_count[v]--;
+				if (time - cached_at[v] > cache_size) {
+					cached_at[v] = time++;
+				}
+			}
+		}
+
+		// The candidate that stays in the cache the longest while all of its remaining triangles
+		// are emitted, one that would fall out of it on the way is only taken when nothing else
+		// is left
+		fan_vertex	  = -1;
+		i64 best_rank = -1;
+		for (u32 i = 0; i < candidates.size(); i++) {
+			u32 v = candidates[i];
+			if (live_count[v] == 0) {
+				continue;
+			}
+
+			i64 rank = 0;
+			if (time - cached_at[v] + 2 * live_count[v] <= cache_size) {
+				rank = time - cached_at[v];
+			}
+			if (rank > best_rank) {
+				best_rank  = rank;
+				fan_vertex = v;
+			}
+		}
+		if (fan_vertex < 0) {
+			fan_vertex = skip_dead_end();
+		}
+	}
+
+	TK_ASSERT(output_count == triangle_count * 3);
+}
+
+void optimize_overdraw(
+	Span<u32> indices,
+	const Vector3* positions,
+	u32 positions_stride,
+	u32 vertex_count,
+	u32* indices_out,
+	f32 threshold) {
+	TK_ASSERT(indices.size() % 3 == 0);
+	TK_ASSERT(indices.data() != indices_out);
+
+	u64 triangle_count = indices.size() / 3;
+	if (triangle_count == 0) {
+		return;
+	}
+
+	struct Cluster {
+		u64 first_triangle;
+		u64 triangle_count;
+		f32 sort_key;
+	};
+
+	// A cluster ends once its ACMR with a cold cache at its start is close enough to the one of
+	// the whole mesh, where it starts in the output the cache is as good as cold
+	f32 limit = analyze_vertex_cache(indices, vertex_count).acmr * threshold;
+	FifoCache cache(vertex_count, VERTEX_CACHE_SIZE);
+	DynamicArray<Cluster> clusters;
+	u64 first  = 0;
+	u32 misses = 0;
+	for (u64 triangle = 0; triangle < triangle_count; triangle++) {
+		for (u32 corner = 0; corner < 3; corner++) {
+			misses += cache.access(indices[triangle * 3 + corner]);
+		}
+
+		u64 count = triangle - first + 1;
+		if (static_cast<f32>(misses) <= limit * static_cast<f32>(count) || triangle + 1 == triangle_count) {
+			clusters.push_back(Cluster{ first, count, 0.0f });
+			first  = triangle + 1;
+			misses = 0;
+			cache.flush();
+		}
+	}
+
+	auto position = [positions, positions_stride](u32 vertex) -> const Vector3& {
+		return *reinterpret_cast<const Vector3*>(
+			reinterpret_cast<const byte*>(positions) + static_cast<u64>(vertex) * positions_stride);
+	};
+
+	// Area weighted centers and normals, the cross product of two edges is the normal scaled by
+	// twice the area
+	DynamicArray<Vector3> centers(clusters.size(), Vector3{});
+	DynamicArray<Vector3> normals(clusters.size(), Vector3{});
+	Vector3 mesh_center{};
+	f32 mesh_area = 0.0f;
+	for (u32 i = 0; i < clusters.size(); i++) {
+		Vector3 center_sum{};
+		Vector3 normal_sum{};
+		f32 area = 0.0f;
+		for (u64 triangle = clusters[i].first_triangle;
+			 triangle < clusters[i].first_triangle + clusters[i].triangle_count;
+			 triangle++) {
+			const Vector3& a = position(indices[triangle * 3]);
+			const Vector3& b = position(indices[triangle * 3 + 1]);
+			const Vector3& c = position(indices[triangle * 3 + 2]);
+			Vector3 normal	 = (b - a).cross(c - a);
+			f32 weight		 = normal.length();
+			center_sum		 = center_sum + (a + b + c) * (weight / 3.0f);
+			normal_sum		 = normal_sum + normal;
+			area			+= weight;
+		}
+
+		centers[i]	= area > 0.0f ? center_sum * (1.0f / area) : position(indices[clusters[i].first_triangle * 3]);
+		normals[i]	= normal_sum;
+		mesh_center = mesh_center + center_sum;
+		mesh_area  += area;
+	}
+	if (mesh_area > 0.0f) {
+		mesh_center = mesh_center * (1.0f / mesh_area);
+	}
+
+	for (u32 i = 0; i < clusters.size(); i++) {
+		f32 length			 = normals[i].length();
+		clusters[i].sort_key = length > 0.0f ? (centers[i] - mesh_center).dot(normals[i]) / length : 0.0f;
+	}
+
+	toki::sort(clusters.data(), clusters.size(), [](const Cluster& lhs, const Cluster& rhs) {
+		if (lhs.sort_key != rhs.sort_key) {
+			return lhs.sort_key > rhs.sort_key;
+		}
+		return lhs.first_triangle < rhs.first_triangle;
+	});
+
+	u64 output_count = 0;
+	for (u32 i = 0; i < clusters.size(); i++) {
+		u64 count = clusters[i].triangle_count * 3;
+		toki::memcpy(indices_out + output_count, indices.data() + clusters[i].first_triangle * 3, count * sizeof(u32));
+		output_count += count;
+	}
+}
+
+u32 optimize_vertex_fetch(u32* indices, u64 index_count, void* vertices, u32 vertex_count, u32 vertex_stride) {
+	DynamicArray<u32> remap(vertex_count, U32_MAX);
+	u32 new_count = 0;
+	for (u64 i = 0; i < index_count; i++) {
+		TK_ASSERT(indices[i] < vertex_count);
+		u32& new_index = remap[indices[i]];
+		if (new_index == U32_MAX) {
+			new_index = new_count++;
+		}
+		indices[i] = new_index;
+	}
+
+	byte* data = reinterpret_cast<byte*>(vertices);
+	DynamicArray<byte> original(static_cast<u64>(vertex_count) * vertex_stride);
+	toki::memcpy(original.data(), data, original.size());
+	for (u32 v = 0; v < vertex_count; v++) {
+		if (remap[v] != U32_MAX) {
+			toki::memcpy(
+				data + static_cast<u64>(remap[v]) * vertex_stride,
+				original.data() + static_cast<u64>(v) * vertex_stride,
+				vertex_stride);
+		}
+	}
+	return new_count;
+}
+
+void encode_indices(Span<u32> indices, DynamicArray<byte>& encoded_out) {
+	encoded_out.clear();
+	encoded_out.reserve(indices.size() * 2);
+
+	u32 previous = 0;
+	for (u64 i = 0; i < indices.size(); i++) {
+		u32 delta  = indices[i] - previous;
+		u32 zigzag = (delta << 1) ^ static_cast<u32>(static_cast<i32>(delta) >> 31);
+		previous   = indices[i];
+		while (zigzag >= 0x80) {
+			encoded_out.push_back(static_cast<byte>(zigzag | 0x80));
+			zigzag >>= 7;
+		}
+		encoded_out.push_back(static_cast<byte>(zigzag));
+	}
+}
+
+Expected<u64, TokiError> decode_indices(const byte* encoded, u64 size, u32* indices_out, u64 index_count) {
+	u64 position = 0;
+	u32 previous = 0;
+	for (u64 i = 0; i < index_count; i++) {
+		u32 zigzag = 0;
+		for (u32 shift = 0;; shift += 7) {
+			// Five bytes hold 32 bits, the last one only has room for four of them
+			if (position == size || shift > 28) {
+				return Unexpected(TokiError::CorruptData);
+			}
+			byte value = encoded[position++];
+			if (shift == 28 && (value & 0x70) != 0) {
+				return Unexpected(TokiError::CorruptData);
+			}
+
+			zigzag |= static_cast<u32>(value & 0x7F) << shift;
+			if ((value & 0x80) == 0) {
+				break;
+			}
+		}
+
+		previous	  += (zigzag >> 1) ^ (0u - (zigzag & 1));
+		indices_out[i] = previous;
+	}
+	return position;
+}
+
+}  // namespace toki
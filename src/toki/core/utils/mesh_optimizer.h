@@ -0,0 +1,68 @@
+#pragma once
+
+#include <toki/core/common/expected.h>
+#include <toki/core/containers/dynamic_array.h>
+#include <toki/core/errors.h>
+#include <toki/core/math/vector3.h>
+#include <toki/core/string/span.h>
+#include <toki/core/types.h>
+
+namespace toki {
+
+// Reordering of indexed triangle lists for the GPU. Meshes go through optimize_vertex_cache, then
+// optimize_overdraw and last optimize_vertex_fetch, each step keeps the triangles and their winding
+// and only changes the order. The analyze functions simulate the caches to measure the result.
+
+// Entries of the simulated post transform cache, at or below what current GPUs reuse
+static constexpr u32 VERTEX_CACHE_SIZE = 16;
+
+struct VertexCacheStatistics {
+	u32 vertices_transformed;
+	// Transformed vertices per triangle, 3 without any reuse and about 0.6 for a well ordered
+	// regular mesh
+	f32 acmr;
+	// Transformed vertices per vertex, 1 when every vertex is transformed once
+	f32 atvr;
+};
+
+struct VertexFetchStatistics {
+	u64 bytes_fetched;
+	// Bytes fetched over the size of the vertex buffer, 1 when every vertex is read once
+	f32 overfetch;
+};
+
+// First in first out cache of cache_size vertices
+VertexCacheStatistics analyze_vertex_cache(Span<u32> indices, u32 vertex_count, u32 cache_size = VERTEX_CACHE_SIZE);
+
+// Memory reads in 64 byte lines through a 4 KiB first in first out cache
+VertexFetchStatistics analyze_vertex_fetch(Span<u32> indices, u32 vertex_count, u32 vertex_stride);
+
+// Tipsify (Sander et al., Fast Triangle Reordering for Vertex Locality and Reduced Overdraw),
+// emits the triangles around one vertex at a time and moves on to a neighbour that is still in
+// the cache. Linear in the number of triangles. indices_out can't be indices.
+void optimize_vertex_cache(Span<u32> indices, u32 vertex_count, u32* indices_out, u32 cache_size = VERTEX_CACHE_SIZE);
+
+// Splits cache optimized indices into clusters where a cold cache costs little and draws the
+// clusters facing away from the center of the mesh first, those tend to hide the others.
+// threshold is how much worse the ACMR may get, 1.05 allows 5%. positions_stride is in bytes.
+// indices_out can't be indices.
+void optimize_overdraw(
+	Span<u32> indices,
+	const Vector3* positions,
+	u32 positions_stride,
+	u32 vertex_count,
+	u32* indices_out,
+	f32 threshold = 1.05f);
+
+// Moves the vertices into the order the indices first use them and rewrites the indices to match,
+// vertices no triangle uses are dropped. Returns the new vertex count.
+u32 optimize_vertex_fetch(u32* indices, u64 index_count, void* vertices, u32 vertex_count, u32 vertex_stride);
+
+// Zigzag encoded difference to the previous index as a variable length integer, a little over a
+// byte per index once the vertices are in fetch order
+void encode_indices(Span<u32> indices, DynamicArray<byte>& encoded_out);
+
+// Returns the bytes read, fails on malformed input instead of reading past size
+Expected<u64, TokiError> decode_indices(const byte* encoded, u64 size, u32* indices_out, u64 index_count);
+
+}  // namespace toki
@@ -0,0 +1,514 @@
+#include "toki/core/utils/mesh_simplifier.h"
+
+#include <toki/core/common/assert.h>
+#include <toki/core/math/math.h>
+#include <toki/core/utils/memory.h>
+#include <toki/core/utils/mesh_optimizer.h>
+#include <toki/core/utils/sort.h>
+
+namespace toki {
+
+// Border planes are weighted by the squared edge length times this, they have to outweigh the
+// triangles on the one side of the edge to keep the outline in place
+static constexpr f64 BORDER_WEIGHT = 10.0;
+
+// Wedges are the vertices sharing one position, collapses of positions with more are skipped
+static constexpr u32 MAX_WEDGES = 16;
+
+// Sum of squared distances to planes as a symmetric 4x4 matrix, weighted by the area of the
+// triangles the planes come from
+struct Quadric {
+	f64 a2, b2, c2, ab, ac, bc, ad, bd, cd, d2;
+	f64 weight;
+};
+
+static Quadric plane_quadric(const Vector3& normal, const Vector3& point, f64 weight) {
+	f64 a = normal.x;
+	f64 b = normal.y;
+	f64 c = normal.z;
+	f64 d = -(a * point.x + b * point.y + c * point.z);
+	return Quadric{ a * a * weight, b * b * weight, c * c * weight, a * b * weight, a * c * weight, b * c * weight,
+					a * d * weight, b * d * weight, c * d * weight, d * d * weight, weight };
+}
+
+static void add_quadric(Quadric& quadric, const Quadric& other) {
+	quadric.a2	   += other.a2;
+	quadric.b2	   += other.b2;
+	quadric.c2	   += other.c2;
+	quadric.ab	   += other.ab;
+	quadric.ac	   += other.ac;
+	quadric.bc	   += other.bc;
+	quadric.ad	   += other.ad;
+	quadric.bd	   += other.bd;
+	quadric.cd	   += other.cd;
+	quadric.d2	   += other.d2;
+	quadric.weight += other.weight;
+}
+
+// Mean squared distance of point to the planes of both quadrics
+static f64 collapse_error(const Quadric& lhs, const Quadric& rhs, const Vector3& point) {
+	f64 x = point.x;
+	f64 y = point.y;
+	f64 z = point.z;
+
+	f64 error = (lhs.a2 + rhs.a2) * x * x + (lhs.b2 + rhs.b2) * y * y + (lhs.c2 + rhs.c2) * z * z +
+				2.0 * ((lhs.ab + rhs.ab) * x * y + (lhs.ac + rhs.ac) * x * z + (lhs.bc + rhs.bc) * y * z) +
+				2.0 * ((lhs.ad + rhs.ad) * x + (lhs.bd + rhs.bd) * y + (lhs.cd + rhs.cd) * z) + lhs.d2 + rhs.d2;
+	f64 weight = lhs.weight + rhs.weight;
+	return weight > 0.0 ? toki::max(error, 0.0) / weight : 0.0;
+}
+
+static u64 edge_key(u32 from, u32 to) {
+	return (static_cast<u64>(from) << 32) | to;
+}
+
+// Sorted directed edges between positions, an edge whose opposite is missing is on a border
+static void collect_edges(const u32* indices, u64 index_count, const u32* canonical, DynamicArray<u64>& edges_out) {
+	edges_out.clear();
+	edges_out.reserve(index_count);
+	for (u64 i = 0; i < index_count; i += 3) {
+		for (u32 corner = 0; corner < 3; corner++) {
+			u32 from = canonical[indices[i + corner]];
+			u32 to	 = canonical[indices[i + (corner + 1) % 3]];
+			edges_out.push_back(edge_key(from, to));
+		}
+	}
+	toki::sort(edges_out.data(), edges_out.size());
+}
+
+static b8 has_edge(const DynamicArray<u64>& edges, u32 from, u32 to) {
+	u64 key	  = edge_key(from, to);
+	u64 first = 0;
+	u64 last  = edges.size();
+	while (first < last) {
+		u64 middle = first + (last - first) / 2;
+		if (edges[middle] < key) {
+			first = middle + 1;
+		} else {
+			last = middle;
+		}
+	}
+	return first < edges.size() && edges[first] == key;
+}
+
+static b8 is_border_edge(const DynamicArray<u64>& edges, u32 a, u32 b) {
+	return has_edge(edges, a, b) != has_edge(edges, b, a);
+}
+
+// Drops triangles with two corners at the same position, returns the new index count
+static u64 remove_degenerate(u32* indices, u64 index_count, const u32* canonical) {
+	u64 kept = 0;
+	for (u64 i = 0; i < index_count; i += 3) {
+		u32 a = canonical[indices[i]];
+		u32 b = canonical[indices[i + 1]];
+		u32 c = canonical[indices[i + 2]];
+		if (a == b || b == c || a == c) {
+			continue;
+		}
+		indices[kept++] = indices[i];
+		indices[kept++] = indices[i + 1];
+		indices[kept++] = indices[i + 2];
+	}
+	return kept;
+}
+
+struct Collapse {
+	u32 from;
+	u32 to;
+	f64 error;
+};
+
+// Simplification state, kept between targets so a LOD chain simplifies the mesh once and every
+// LOD still measures its error against the full mesh
+struct Simplifier {
+	Simplifier(Span<u32> indices, const Vector3* positions, u32 positions_stride, u32 vertex_count, u32* indices_out);
+
+	// Continues from the previous target, returns the index count
+	u64 simplify(u64 target_index_count, f32 max_error, b8 lock_seams);
+	b8 try_collapse(const Collapse& collapse, b8 lock_seams, u64& removed);
+
+	const Vector3& position(u32 vertex) const {
+		return *reinterpret_cast<const Vector3*>(
+			reinterpret_cast<const byte*>(positions) + static_cast<u64>(vertex) * positions_stride);
+	}
+
+	const Vector3* positions;
+	u32 positions_stride;
+	u32 vertex_count;
+	u32* indices;
+	u64 index_count;
+	// Largest error of the collapses so far, squared
+	f64 error{};
+
+	// Wedges are linked in a ring through next_wedge, the first one in sorted order stands in
+	// for the position everywhere else
+	DynamicArray<u32> canonical;
+	DynamicArray<u32> next_wedge;
+	DynamicArray<Quadric> quadrics;
+
+	DynamicArray<u64> edges;
+	DynamicArray<u32> border_count;
+	// Triangles around each position, the ones of v are triangles[offsets[v], offsets[v + 1])
+	DynamicArray<u32> triangle_offsets;
+	DynamicArray<u32> triangle_fill;
+	DynamicArray<u32> triangles;
+	DynamicArray<u32> best_target;
+	DynamicArray<f64> best_error;
+	DynamicArray<b8> locked;
+	DynamicArray<Collapse> collapses;
+};
+
+Simplifier::Simplifier(
+	Span<u32> source_indices,
+	const Vector3* source_positions,
+	u32 source_positions_stride,
+	u32 source_vertex_count,
+	u32* indices_out):
+	positions(source_positions),
+	positions_stride(source_positions_stride),
+	vertex_count(source_vertex_count),
+	indices(indices_out),
+	canonical(source_vertex_count),
+	next_wedge(source_vertex_count),
+	quadrics(source_vertex_count, Quadric{}),
+	border_count(source_vertex_count, 0),
+	triangle_offsets(static_cast<u64>(source_vertex_count) + 1, 0),
+	triangle_fill(static_cast<u64>(source_vertex_count) + 1, 0),
+	best_target(source_vertex_count, U32_MAX),
+	best_error(source_vertex_count, 0.0),
+	locked(source_vertex_count, false) {
+	TK_ASSERT(source_indices.size() % 3 == 0);
+
+	{
+		DynamicArray<u32> sorted(vertex_count);
+		for (u32 v = 0; v < vertex_count; v++) {
+			sorted[v] = v;
+		}
+		toki::sort(sorted.data(), sorted.size(), [this](u32 lhs, u32 rhs) {
+			const Vector3& a = position(lhs);
+			const Vector3& b = position(rhs);
+			if (a.x != b.x) {
+				return a.x < b.x;
+			}
+			if (a.y != b.y) {
+				return a.y < b.y;
+			}
+			return a.z < b.z;
+		});
+
+		for (u32 first = 0; first < vertex_count;) {
+			u32 end = first + 1;
+			while (end < vertex_count && position(sorted[end]) == position(sorted[first])) {
+				end++;
+			}
+			for (u32 i = first; i < end; i++) {
+				canonical[sorted[i]]  = sorted[first];
+				next_wedge[sorted[i]] = sorted[i + 1 < end ? i + 1 : first];
+			}
+			first = end;
+		}
+	}
+
+	toki::memcpy(indices, source_indices.data(), source_indices.size() * sizeof(u32));
+	index_count = remove_degenerate(indices, source_indices.size(), canonical.data());
+	collect_edges(indices, index_count, canonical.data(), edges);
+
+	for (u64 i = 0; i < index_count; i += 3) {
+		u32 corners[3]{ canonical[indices[i]], canonical[indices[i + 1]], canonical[indices[i + 2]] };
+		const Vector3& origin = position(corners[0]);
+		Vector3 normal		  = (position(corners[1]) - origin).cross(position(corners[2]) - origin);
+		f32 length			  = normal.length();
+		if (length == 0.0f) {
+			continue;
+		}
+		normal = normal * (1.0f / length);
+
+		Quadric quadric = plane_quadric(normal, origin, length * 0.5);
+		for (u32 corner = 0; corner < 3; corner++) {
+			add_quadric(quadrics[corners[corner]], quadric);
+
+			// Plane through the border edge at a right angle to the triangle
+			u32 from = corners[corner];
+			u32 to	 = corners[(corner + 1) % 3];
+			if (!has_edge(edges, to, from)) {
+				Vector3 edge	  = position(to) - position(from);
+				Vector3 border	  = edge.cross(normal);
+				f32 border_length = border.length();
+				if (border_length > 0.0f) {
+					Quadric border_quadric = plane_quadric(
+						border * (1.0f / border_length), position(from), edge.length_squared() * BORDER_WEIGHT);
+					add_quadric(quadrics[from], border_quadric);
+					add_quadric(quadrics[to], border_quadric);
+				}
+			}
+		}
+	}
+}
+
+u64 Simplifier::simplify(u64 target_index_count, f32 max_error, b8 lock_seams) {
+	f64 max_collapse_error = static_cast<f64>(max_error) * max_error;
+
+	// Every pass collapses the cheapest edges whose neighbourhoods don't overlap, then the
+	// collapsed triangles are dropped and the edges around the changes are evaluated again
+	while (index_count > target_index_count) {
+		collect_edges(indices, index_count, canonical.data(), edges);
+		border_count.fill(0);
+		for (u64 i = 0; i < edges.size(); i++) {
+			u32 from = static_cast<u32>(edges[i] >> 32);
+			u32 to	 = static_cast<u32>(edges[i]);
+			if (!has_edge(edges, to, from)) {
+				border_count[from]++;
+				border_count[to]++;
+			}
+		}
+
+		triangle_offsets.fill(0);
+		for (u64 i = 0; i < index_count; i++) {
+			triangle_offsets[canonical[indices[i]] + 1]++;
+		}
+		for (u32 v = 0; v < vertex_count; v++) {
+			triangle_offsets[v + 1] += triangle_offsets[v];
+		}
+		triangles.resize(index_count);
+		toki::memcpy(triangle_fill.data(), triangle_offsets.data(), triangle_fill.size() * sizeof(u32));
+		for (u64 i = 0; i < index_count; i++) {
+			triangles[triangle_fill[canonical[indices[i]]]++] = static_cast<u32>(i / 3);
+		}
+
+		// Cheapest collapse of every position. A border position only moves along the border,
+		// one where borders meet doesn't move at all.
+		best_target.fill(U32_MAX);
+		for (u64 i = 0; i < index_count; i++) {
+			u32 from = canonical[indices[i]];
+			u32 to	 = canonical[indices[i % 3 == 2 ? i - 2 : i + 1]];
+			for (u32 direction = 0; direction < 2; direction++) {
+				if (direction == 1) {
+					toki::swap(from, to);
+				}
+				if (border_count[from] > 2 || (border_count[from] == 2 && !is_border_edge(edges, from, to))) {
+					continue;
+				}
+
+				f64 collapse_cost = collapse_error(quadrics[from], quadrics[to], position(to));
+				if (best_target[from] == U32_MAX || collapse_cost < best_error[from]) {
+					best_target[from] = to;
+					best_error[from]  = collapse_cost;
+				}
+			}
+		}
+
+		collapses.clear();
+		for (u32 v = 0; v < vertex_count; v++) {
+			if (best_target[v] != U32_MAX && best_error[v] <= max_collapse_error) {
+				collapses.push_back(Collapse{ v, best_target[v], best_error[v] });
+			}
+		}
+		if (collapses.size() == 0) {
+			break;
+		}
+		toki::sort(collapses.data(), collapses.size(), [](const Collapse& lhs, const Collapse& rhs) {
+			return lhs.error < rhs.error;
+		});
+
+		// Locking keeps a pass from collapsing an edge whose cost an earlier collapse changed,
+		// taking only the cheaper half keeps passes from going far down the order on stale costs
+		locked.fill(false);
+		u64 goal		   = index_count - target_index_count;
+		u64 removed		   = 0;
+		u32 applied		   = 0;
+		u64 collapse_limit = toki::max<u64>(collapses.size() / 2, 1);
+		for (u64 c = 0; c < collapse_limit && removed < goal; c++) {
+			applied += try_collapse(collapses[c], lock_seams, removed);
+		}
+
+		if (applied == 0) {
+			break;
+		}
+		index_count = remove_degenerate(indices, index_count, canonical.data());
+	}
+
+	return index_count;
+}
+
+b8 Simplifier::try_collapse(const Collapse& collapse, b8 lock_seams, u64& removed) {
+	u32 from = collapse.from;
+	u32 to	 = collapse.to;
+	if (locked[from] || locked[to]) {
+		return false;
+	}
+
+	// Wedges of from take the wedge of to they share a triangle with, a wedge that would get two
+	// or none would change how the attributes are interpolated
+	u32 wedges_from[MAX_WEDGES];
+	u32 wedges_to[MAX_WEDGES];
+	u32 wedge_count = 0;
+	u32 wedge		= from;
+	do {
+		if (wedge_count == MAX_WEDGES) {
+			return false;
+		}
+		wedges_from[wedge_count] = wedge;
+		wedges_to[wedge_count++] = U32_MAX;
+		wedge					 = next_wedge[wedge];
+	} while (wedge != from);
+
+	for (u32 t = triangle_offsets[from]; t < triangle_offsets[from + 1]; t++) {
+		const u32* corners = &indices[static_cast<u64>(triangles[t]) * 3];
+		u32 from_vertex	   = U32_MAX;
+		u32 to_vertex	   = U32_MAX;
+		for (u32 corner = 0; corner < 3; corner++) {
+			from_vertex = canonical[corners[corner]] == from ? corners[corner] : from_vertex;
+			to_vertex	= canonical[corners[corner]] == to ? corners[corner] : to_vertex;
+		}
+		if (to_vertex == U32_MAX) {
+			continue;
+		}
+
+		for (u32 i = 0; i < wedge_count; i++) {
+			if (wedges_from[i] != from_vertex) {
+				continue;
+			}
+			if (lock_seams && wedges_to[i] != U32_MAX && wedges_to[i] != to_vertex) {
+				return false;
+			}
+			wedges_to[i] = to_vertex;
+		}
+	}
+
+	// The edge has a triangle so at least one wedge got a partner
+	for (u32 i = 0; !lock_seams && i < wedge_count; i++) {
+		for (u32 j = 0; wedges_to[i] == U32_MAX && j < wedge_count; j++) {
+			wedges_to[i] = wedges_to[j];
+		}
+	}
+
+	auto wedge_target = [&](u32 vertex) -> u32 {
+		for (u32 i = 0; i < wedge_count; i++) {
+			if (wedges_from[i] == vertex) {
+				return wedges_to[i];
+			}
+		}
+		return U32_MAX;
+	};
+
+	// The triangles that stay must not flip or turn too far
+	for (u32 t = triangle_offsets[from]; t < triangle_offsets[from + 1]; t++) {
+		const u32* corners = &indices[static_cast<u64>(triangles[t]) * 3];
+		Vector3 before[3];
+		Vector3 after[3];
+		b8 collapses_away = false;
+		for (u32 corner = 0; corner < 3; corner++) {
+			u32 v		   = canonical[corners[corner]];
+			before[corner] = position(v);
+			after[corner]  = position(v == from ? to : v);
+			collapses_away = collapses_away || v == to;
+			if (v == from && wedge_target(corners[corner]) == U32_MAX) {
+				return false;
+			}
+		}
+		if (collapses_away) {
+			continue;
+		}
+
+		Vector3 normal_before = (before[1] - before[0]).cross(before[2] - before[0]);
+		Vector3 normal_after  = (after[1] - after[0]).cross(after[2] - after[0]);
+		f32 limit			  = 0.25f * normal_before.length() * normal_after.length();
+		if (normal_before.length_squared() > 0.0f && normal_before.dot(normal_after) < limit) {
+			return false;
+		}
+	}
+
+	for (u32 t = triangle_offsets[from]; t < triangle_offsets[from + 1]; t++) {
+		u32* corners	  = &indices[static_cast<u64>(triangles[t]) * 3];
+		b8 collapses_away = false;
+		for (u32 corner = 0; corner < 3; corner++) {
+			u32 v		   = canonical[corners[corner]];
+			collapses_away = collapses_away || v == to;
+			if (v == from) {
+				corners[corner] = wedge_target(corners[corner]);
+			}
+		}
+		removed += collapses_away ? 3 : 0;
+	}
+
+	locked[from] = true;
+	locked[to]	 = true;
+	add_quadric(quadrics[to], quadrics[from]);
+	error = toki::max(error, collapse.error);
+	return true;
+}
+
+u64 simplify_mesh(
+	Span<u32> indices,
+	const Vector3* positions,
+	u32 positions_stride,
+	u32 vertex_count,
+	const SimplifyConfig& config,
+	u32* indices_out,
+	f32* error_out) {
+	Simplifier simplifier(indices, positions, positions_stride, vertex_count, indices_out);
+	u64 index_count = simplifier.simplify(config.target_index_count, config.max_error, config.lock_seams);
+	if (error_out != nullptr) {
+		*error_out = static_cast<f32>(toki::sqrt(simplifier.error));
+	}
+	return index_count;
+}
+
+void build_lod_chain(
+	Span<u32> indices,
+	const Vector3* positions,
+	u32 positions_stride,
+	u32 vertex_count,
+	const LodChainConfig& config,
+	DynamicArray<u32>& indices_out,
+	DynamicArray<MeshLod>& lods_out) {
+	TK_ASSERT(config.max_lod_count <= MAX_MESH_LODS);
+
+	indices_out.clear();
+	lods_out.clear();
+	indices_out.reserve(indices.size() * 2);
+	indices_out.resize(indices.size());
+	toki::memcpy(indices_out.data(), indices.data(), indices.size() * sizeof(u32));
+	lods_out.push_back(MeshLod{ 0, static_cast<u32>(indices.size()), 0.0f });
+
+	DynamicArray<u32> simplified(indices.size());
+	Simplifier simplifier(indices, positions, positions_stride, vertex_count, simplified.data());
+	for (u32 lod = 1; lod < config.max_lod_count; lod++) {
+		u64 previous_count = lods_out.last().index_count;
+		u64 target		   = static_cast<u64>(static_cast<f32>(previous_count / 3) * config.reduction) * 3;
+		u64 count		   = simplifier.simplify(target, config.max_error, config.lock_seams);
+
+		// Not worth a LOD once the error limit keeps it close to the previous one
+		if (count == 0 || count * 10 > previous_count * 9) {
+			break;
+		}
+
+		u64 offset = indices_out.size();
+		if (offset + count > indices_out.capacity()) {
+			indices_out.reserve(toki::max(indices_out.capacity() * 2, offset + count));
+		}
+		indices_out.resize(offset + count);
+		optimize_vertex_cache(Span<u32>(simplified.data(), count), vertex_count, indices_out.data() + offset);
+		f32 error = static_cast<f32>(toki::sqrt(simplifier.error));
+		lods_out.push_back(MeshLod{ static_cast<u32>(offset), static_cast<u32>(count), error });
+	}
+}
+
+f32 lod_pixel_scale(const Matrix4& projection, f32 viewport_height) {
+	// Element (1, 1) is the cotangent of half the vertical field of view
+	return toki::abs(projection[5]) * viewport_height * 0.5f;
+}
+
+u32 select_lod(Span<MeshLod> lods, f32 distance, f32 pixel_scale, f32 pixel_threshold) {
+	u32 selected = 0;
+	for (u32 i = 1; i < lods.size(); i++) {
+		// error * pixel_scale / distance <= pixel_threshold, without dividing by a zero distance
+		if (lods[i].error * pixel_scale > pixel_threshold * distance) {
+			break;
+		}
+		selected = i;
+	}
+	return selected;
+}
+
+}  // namespace toki
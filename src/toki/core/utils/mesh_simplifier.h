@@ -0,0 +1,79 @@
+#pragma once
+
+#include <toki/core/common/defines.h>
+#include <toki/core/containers/dynamic_array.h>
+#include <toki/core/math/matrix4.h>
+#include <toki/core/math/vector3.h>
+#include <toki/core/string/span.h>
+#include <toki/core/types.h>
+
+namespace toki {
+
+// Quadric error metric simplification (Garland and Heckbert, Surface Simplification Using Quadric
+// Error Metrics). Edges collapse onto one of their two vertices, so simplified indices still point
+// into the vertex buffer of the full mesh and all LODs of a mesh share one vertex buffer.
+
+static constexpr u32 MAX_MESH_LODS = 8;
+
+struct MeshLod {
+	u32 first_index;
+	u32 index_count;
+	// How far the LOD is from the surface of the full mesh in model units, 0 for the full mesh
+	f32 error;
+};
+
+struct SimplifyConfig {
+	u64 target_index_count;
+	// Model units, no collapse moves the surface further from the original
+	f32 max_error = F32_MAX;
+	// Vertices split for different normals or texture coordinates only collapse along the seam
+	// between them. Otherwise the split vertices collapse onto any of the other position's, which
+	// smears attributes across the seam but lets faceted meshes simplify at all.
+	b8 lock_seams = true;
+};
+
+// Collapses edges until at most target_index_count indices are left or the cheapest collapse is
+// over max_error. Vertices on open borders only collapse along the border. Returns the index
+// count written to indices_out, which needs room for all of indices, error_out receives the
+// error reached.
+u64 simplify_mesh(
+	Span<u32> indices,
+	const Vector3* positions,
+	u32 positions_stride,
+	u32 vertex_count,
+	const SimplifyConfig& config,
+	u32* indices_out,
+	f32* error_out = nullptr);
+
+struct LodChainConfig {
+	// Including the full mesh, at most MAX_MESH_LODS
+	u32 max_lod_count = 4;
+	// Triangles of a LOD relative to the one before it
+	f32 reduction = 0.5f;
+	// Model units, LODs past it are not built
+	f32 max_error = F32_MAX;
+	// Off since the LODs are seen from far enough that attributes bleeding over seams is hard to
+	// notice, while locked seams keep faceted meshes from simplifying
+	b8 lock_seams = false;
+};
+
+// LOD 0 is indices as they are, the others are simplified from it and ordered for the vertex
+// cache. The chain ends early once simplification stops making progress. The LODs are appended to
+// indices_out one after another and lods_out gets their ranges, errors never decrease.
+void build_lod_chain(
+	Span<u32> indices,
+	const Vector3* positions,
+	u32 positions_stride,
+	u32 vertex_count,
+	const LodChainConfig& config,
+	DynamicArray<u32>& indices_out,
+	DynamicArray<MeshLod>& lods_out);
+
+// Pixels covered by one unit at distance 1 from the camera for a perspective projection
+f32 lod_pixel_scale(const Matrix4& projection, f32 viewport_height);
+
+// The coarsest LOD whose error covers at most pixel_threshold pixels seen from distance. Errors
+// are in model units, scale pixel_scale along with objects drawn at a different scale.
+u32 select_lod(Span<MeshLod> lods, f32 distance, f32 pixel_scale, f32 pixel_threshold = 1.0f);
+
+}  // namespace toki
@@ -0,0 +1,72 @@
+#include "toki/core/utils/shelf_packer.h"
+
+#include <toki/core/common/defines.h>
+#include <toki/core/math/math.h>
+
+namespace toki {
+
+static constexpr u32 SHELF_HEIGHT_STEP = 4;
+
+ShelfPacker::ShelfPacker(u32 width, u32 height) {
+	reset(width, height);
+}
+
+void ShelfPacker::reset(u32 width, u32 height) {
+	m_width		 = width;
+	m_height	 = height;
+	m_usedHeight = 0;
+	m_shelves.clear();
+}
+
+b8 ShelfPacker::pack(u32 width, u32 height, Vector2u32& position_out) {
+	if (width > m_width || height > m_height) {
+		return false;
+	}
+
+	// Least wasted height first, a shelf much taller than the rectangle is only used once no new
+	// shelf can be opened
+	const u32 max_waste = height / 4;
+
+	Shelf* best		   = nullptr;
+	u32 best_waste	   = U32_MAX;
+	Shelf* fallback	   = nullptr;
+	u32 fallback_waste = U32_MAX;
+	for (u32 i = 0; i < m_shelves.size(); i++) {
+		Shelf& shelf = m_shelves[i];
+		if (shelf.height < height || m_width - shelf.used_width < width) {
+			continue;
+		}
+
+		u32 waste = shelf.height - height;
+		if (waste <= max_waste && waste < best_waste) {
+			best	   = &shelf;
+			best_waste = waste;
+		} else if (waste < fallback_waste) {
+			fallback	   = &shelf;
+			fallback_waste = waste;
+		}
+	}
+
+	if (best == nullptr && m_height - m_usedHeight >= height) {
+		// Rounded up so rectangles a few rows taller still fit on the same shelf
+		u32 shelf_height = (height + SHELF_HEIGHT_STEP - 1) / SHELF_HEIGHT_STEP * SHELF_HEIGHT_STEP;
+		shelf_height	 = toki::min(shelf_height, m_height - m_usedHeight);
+		m_shelves.push_back(Shelf{ m_usedHeight, shelf_height, 0 });
+		best = &m_shelves.last();
+		m_usedHeight += shelf_height;
+	}
+
+	if (best == nullptr) {
+		best = fallback;
+	}
+
+	if (best == nullptr) {
+		return false;
+	}
+
+	position_out = { best->used_width, best->y };
+	best->used_width += width;
+	return true;
+}
+
+}  // namespace toki
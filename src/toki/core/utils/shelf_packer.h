@@ -0,0 +1,50 @@
+#pragma once
+
+#include <toki/core/containers/dynamic_array.h>
+#include <toki/core/math/vector2.h>
+#include <toki/core/types.h>
+
+namespace toki {
+
+// Packs rectangles of similar height into rows (shelves) of a fixed size area, meant for glyph
+// atlases where rectangles are added one at a time and never removed. A rectangle goes on the
+// shelf that wastes the least height, a new shelf is only opened when every existing one is too
+// low or too wasteful.
+class ShelfPacker {
+public:
+	ShelfPacker() = default;
+	ShelfPacker(u32 width, u32 height);
+
+	// Forgets every packed rectangle
+	void reset(u32 width, u32 height);
+
+	// Writes the top left corner of the rectangle, returns false if it does not fit anymore
+	b8 pack(u32 width, u32 height, Vector2u32& position_out);
+
+	u32 width() const {
+		return m_width;
+	}
+
+	u32 height() const {
+		return m_height;
+	}
+
+	// Rows of the area covered by shelves so far
+	u32 used_height() const {
+		return m_usedHeight;
+	}
+
+private:
+	struct Shelf {
+		u32 y;
+		u32 height;
+		u32 used_width;
+	};
+
+	DynamicArray<Shelf> m_shelves;
+	u32 m_width{};
+	u32 m_height{};
+	u32 m_usedHeight{};
+};
+
+}  // namespace toki
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <toki/core/common/common.h>
+#include <toki/core/types.h>
+
+namespace toki {
+
+namespace detail {
+
+static constexpr u64 INSERTION_SORT_THRESHOLD = 16;
+
+template <typename T, typename Less>
+constexpr void insertion_sort(T* data, u64 count, Less& less) {
+	for (u64 i = 1; i < count; i++) {
+		for (u64 j = i; j > 0 && less(data[j], data[j - 1]); j--) {
+			toki::swap(data[j], data[j - 1]);
+		}
+	}
+}
+
+}  // namespace detail
+
+// Unstable in-place quicksort with a median of three pivot, small ranges are finished with
+// insertion sort. Recursing into the smaller half keeps the stack depth logarithmic.
+template <typename T, typename Less>
+constexpr void sort(T* data, u64 count, Less less) {
+	while (count > detail::INSERTION_SORT_THRESHOLD) {
+		u64 middle = count / 2;
+		if (less(data[middle], data[0])) {
+			toki::swap(data[middle], data[0]);
+		}
+		if (less(data[count - 1], data[0])) {
+			toki::swap(data[count - 1], data[0]);
+		}
+		if (less(data[count - 1], data[middle])) {
+			toki::swap(data[count - 1], data[middle]);
+		}
+
+		// Hoare partition, elements equal to the pivot end up on both sides so runs of equal
+		// values still split evenly
+		T pivot = data[middle];
+		i64 i	= -1;
+		i64 j	= static_cast<i64>(count);
+		while (true) {
+			do {
+				i++;
+			} while (less(data[i], pivot));
+			do {
+				j--;
+			} while (less(pivot, data[j]));
+
+			if (i >= j) {
+				break;
+			}
+			toki::swap(data[i], data[j]);
+		}
+
+		u64 left_count	= static_cast<u64>(j) + 1;
+		u64 right_count = count - left_count;
+		if (left_count < right_count) {
+			toki::sort(data, left_count, less);
+			data += left_count;
+			count = right_count;
+		} else {
+			toki::sort(data + left_count, right_count, less);
+			count = left_count;
+		}
+	}
+
+	detail::insertion_sort(data, count, less);
+}
+
+template <typename T>
+constexpr void sort(T* data, u64 count) {
+	toki::sort(data, count, [](const T& lhs, const T& rhs) {
+		return lhs < rhs;
+	});
+}
+
+}  // namespace toki
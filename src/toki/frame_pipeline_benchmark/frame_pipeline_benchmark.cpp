@@ -0,0 +1,88 @@
+#include <toki/core/core.h>
+#include <toki/runtime/runtime.h>
+
+// Headless harness for FramePipeline, runs synthetic update and render workloads serially and
+// on separate threads and reports how much of the render work got hidden behind update.
+//
+// usage: frame_pipeline_benchmark [frame_count] [update_micros] [render_micros]
+
+using namespace toki;
+
+struct BenchmarkSnapshot {
+	Matrix4 transforms[64];
+};
+
+static void busy_wait(u64 micros) {
+	u64 end = get_current_time() + micros * 1000;
+	while (get_current_time() < end) {}
+}
+
+static FramePipelineStats run_pipeline(b8 threaded, u64 frame_count, u64 update_micros, u64 render_micros) {
+	FramePipelineConfig config{};
+	config.threaded		   = threaded;
+	config.collect_timings = true;
+
+	auto pipeline = toki::make_unique<FramePipeline>(
+		config,
+		[frame_count, update_micros](FrameSnapshot& snapshot) -> b8 {
+			if (snapshot.frame_index >= frame_count) {
+				return false;
+			}
+
+			busy_wait(update_micros);
+
+			BenchmarkSnapshot* data = snapshot.allocate<BenchmarkSnapshot>();
+			for (u32 i = 0; i < CARRAY_SIZE(data->transforms); i++) {
+				data->transforms[i] = Matrix4(Vector3(static_cast<f32>(snapshot.frame_index), 0.0f, 0.0f));
+			}
+			return true;
+		},
+		[render_micros](const FrameSnapshot& snapshot) {
+			TK_ASSERT(snapshot.get<BenchmarkSnapshot>(0) != nullptr);
+			busy_wait(render_micros);
+		});
+
+	pipeline->run();
+	return pipeline->stats();
+}
+
+static void report(StringView name, const FramePipelineStats& stats) {
+	f64 frame_ms   = stats.total_time * 1000.0 / static_cast<f64>(stats.frame_count);
+	f64 overlap_pc = stats.render_time > 0.0 ? stats.overlap_time / stats.render_time * 100.0 : 0.0;
+
+	toki::println("{}:", name);
+	toki::println("  frames         {}", stats.frame_count);
+	toki::println("  total          {} s", stats.total_time);
+	toki::println("  frame time     {} ms", frame_ms);
+	toki::println("  update         {} s", stats.update_time);
+	toki::println("  render         {} s", stats.render_time);
+	toki::println("  overlap        {} s ({}% of render)", stats.overlap_time, overlap_pc);
+}
+
+toki::i32 toki::toki_entrypoint(toki::Span<char*> args) {
+	u64 frame_count	  = 500;
+	u64 update_micros = 4000;
+	u64 render_micros = 4000;
+
+	if (args.size() > 1) {
+		toki::atoi(args[1], frame_count);
+	}
+	if (args.size() > 2) {
+		toki::atoi(args[2], update_micros);
+	}
+	if (args.size() > 3) {
+		toki::atoi(args[3], render_micros);
+	}
+
+	toki::println(
+		"Running {} frames, update {} us, render {} us per frame", frame_count, update_micros, render_micros);
+
+	FramePipelineStats serial	= run_pipeline(false, frame_count, update_micros, render_micros);
+	FramePipelineStats threaded = run_pipeline(true, frame_count, update_micros, render_micros);
+
+	report("serial", serial);
+	report("threaded", threaded);
+	toki::println("speedup          {}x", serial.total_time / threaded.total_time);
+
+	return 0;
+}
@@ -0,0 +1,360 @@
+#include <toki/core/core.h>
+#include <toki/runtime/runtime.h>
+
+// Times transforming points and multiplying matrices with Matrix4 against the scalar loops it
+// used before, on a million random inputs each. Both produce the same results up to rounding.
+// The batch versions from core/math/batch.h run over the same inputs. sin, exp and log from
+// core/math/transcendental.h are timed against the f64 series in math.h. Frustum culling of a
+// tenth as many boxes tests each one against the frustum, then culls the same boxes through a Bvh
+// on the calling thread and with a Culler.
+//
+// usage: math_benchmark [count]
+
+using namespace toki;
+
+static u64 s_seed = 0x9E3779B97F4A7C15;
+
+// Values in [-1, 1)
+static f32 random_float() {
+	s_seed ^= s_seed << 13;
+	s_seed ^= s_seed >> 7;
+	s_seed ^= s_seed << 17;
+	return static_cast<f32>(s_seed >> 40) / static_cast<f32>(1 << 23) - 1.0f;
+}
+
+static Matrix4 random_matrix() {
+	Matrix4 matrix;
+	for (u32 i = 0; i < 16; i++) {
+		matrix[i] = random_float();
+	}
+	return matrix;
+}
+
+static Vector3 transform_point_scalar(const Matrix4& m, const Vector3& p) {
+	return Vector3(
+		m[0] * p.x + m[4] * p.y + m[8] * p.z + m[12],
+		m[1] * p.x + m[5] * p.y + m[9] * p.z + m[13],
+		m[2] * p.x + m[6] * p.y + m[10] * p.z + m[14]);
+}
+
+static Matrix4 multiply_scalar(const Matrix4& lhs, const Matrix4& rhs) {
+	Matrix4 result;
+	for (u32 col = 0; col < 4; col++) {
+		for (u32 row = 0; row < 4; row++) {
+			f32 sum = 0.0f;
+			for (u32 k = 0; k < 4; k++) {
+				sum += lhs[k * 4 + row] * rhs[col * 4 + k];
+			}
+			result[col * 4 + row] = sum;
+		}
+	}
+	return result;
+}
+
+static f64 elapsed_ms(u64 start) {
+	return static_cast<f64>(get_current_time() - start) / 1e6;
+}
+
+static f32 checksum(const Vector3* points, u64 count) {
+	f32 sum = 0.0f;
+	for (u64 i = 0; i < count; i++) {
+		sum += points[i].x + points[i].y + points[i].z;
+	}
+	return sum;
+}
+
+static f32 checksum(const f32* values, u64 count) {
+	f32 sum = 0.0f;
+	for (u64 i = 0; i < count; i++) {
+		sum += values[i];
+	}
+	return sum;
+}
+
+static f32 checksum(const Matrix4* matrices, u64 count) {
+	f32 sum = 0.0f;
+	for (u64 i = 0; i < count; i++) {
+		for (u32 j = 0; j < 16; j++) {
+			sum += matrices[i][j];
+		}
+	}
+	return sum;
+}
+
+toki::i32 toki::toki_entrypoint(toki::Span<char*> args) {
+	u64 count = 1'000'000;
+	if (args.size() > 1) {
+		toki::atoi(args[1], count);
+		count = toki::max<u64>(count, 1);
+	}
+
+	Matrix4 transform = Matrix4(Vector3(1.0f, 2.0f, 3.0f)).rotate(Vector3(1.0f, 1.0f, 0.0f), 0.5f).scale(2.0f);
+
+	DynamicArray<Vector3> points(count, Vector3{});
+	DynamicArray<Vector3> transformed(count, Vector3{});
+	for (u64 i = 0; i < count; i++) {
+		points[i] = Vector3(random_float(), random_float(), random_float());
+	}
+
+	u64 start = get_current_time();
+	for (u64 i = 0; i < count; i++) {
+		transformed[i] = transform_point_scalar(transform, points[i]);
+	}
+	f64 points_scalar_ms = elapsed_ms(start);
+	f32 points_reference = checksum(transformed.data(), count);
+
+	start = get_current_time();
+	for (u64 i = 0; i < count; i++) {
+		transformed[i] = transform.transform_point(points[i]);
+	}
+	f64 points_simd_ms = elapsed_ms(start);
+	f32 points_result  = checksum(transformed.data(), count);
+
+	start = get_current_time();
+	transform_points(points, transform, transformed.data());
+	f64 points_batch_ms = elapsed_ms(start);
+	f32 points_batch	= checksum(transformed.data(), count);
+
+	DynamicArray<f32> soa_x(count, 0.0f);
+	DynamicArray<f32> soa_y(count, 0.0f);
+	DynamicArray<f32> soa_z(count, 0.0f);
+	for (u64 i = 0; i < count; i++) {
+		soa_x[i] = points[i].x;
+		soa_y[i] = points[i].y;
+		soa_z[i] = points[i].z;
+	}
+	Vector3Soa soa_points{ soa_x.data(), soa_y.data(), soa_z.data(), count };
+
+	start = get_current_time();
+	transform_points(soa_points, transform, soa_points);
+	f64 points_soa_ms = elapsed_ms(start);
+
+	start = get_current_time();
+	normalize_many(points, transformed.data());
+	f64 normalize_ms = elapsed_ms(start);
+
+	start		= get_current_time();
+	Aabb aabb	= compute_aabb(points);
+	f64 aabb_ms = elapsed_ms(start);
+
+	// Matrices are reused from a set that fits in cache, otherwise both versions only measure
+	// memory bandwidth
+	constexpr u64 MATRIX_SET_SIZE = 4096;
+	DynamicArray<Matrix4> lhs(MATRIX_SET_SIZE, Matrix4{});
+	DynamicArray<Matrix4> rhs(MATRIX_SET_SIZE, Matrix4{});
+	DynamicArray<Matrix4> products(MATRIX_SET_SIZE, Matrix4{});
+	for (u64 i = 0; i < MATRIX_SET_SIZE; i++) {
+		lhs[i] = random_matrix();
+		rhs[i] = random_matrix();
+	}
+
+	start = get_current_time();
+	for (u64 i = 0; i < count; i++) {
+		u64 index		= i & (MATRIX_SET_SIZE - 1);
+		products[index] = multiply_scalar(lhs[index], rhs[(i >> 12) & (MATRIX_SET_SIZE - 1)]);
+	}
+	f64 multiply_scalar_ms = elapsed_ms(start);
+	f32 multiply_reference = checksum(products.data(), MATRIX_SET_SIZE);
+
+	start = get_current_time();
+	for (u64 i = 0; i < count; i++) {
+		u64 index		= i & (MATRIX_SET_SIZE - 1);
+		products[index] = lhs[index] * rhs[(i >> 12) & (MATRIX_SET_SIZE - 1)];
+	}
+	f64 multiply_simd_ms = elapsed_ms(start);
+	f32 multiply_result	 = checksum(products.data(), MATRIX_SET_SIZE);
+
+	// The batch call goes over the whole set each time, count products in total
+	start = get_current_time();
+	for (u64 i = 0; i < count; i += MATRIX_SET_SIZE) {
+		multiply_matrices(lhs, rhs, products.data());
+	}
+	f64 multiply_batch_ms = elapsed_ms(start);
+
+	start = get_current_time();
+	for (u64 i = 0; i < count; i++) {
+		u64 index		= i & (MATRIX_SET_SIZE - 1);
+		products[index] = lhs[index].inverse();
+	}
+	f64 inverse_ms = elapsed_ms(start);
+
+	start = get_current_time();
+	for (u64 i = 0; i < count; i++) {
+		u64 index		= i & (MATRIX_SET_SIZE - 1);
+		products[index] = lhs[index].transpose();
+	}
+	f64 transpose_ms = elapsed_ms(start);
+
+	// Local transforms of a scene, from matrix products against the quaternion composition
+	DynamicArray<Vector3> translations(MATRIX_SET_SIZE, Vector3{});
+	DynamicArray<Quaternion> rotations(MATRIX_SET_SIZE, Quaternion{});
+	DynamicArray<Vector3> scales(MATRIX_SET_SIZE, Vector3{});
+	for (u64 i = 0; i < MATRIX_SET_SIZE; i++) {
+		translations[i] = Vector3(random_float(), random_float(), random_float());
+		rotations[i]	= Quaternion(random_float(), random_float(), random_float(), random_float()).normalize();
+		scales[i]		= Vector3(1.0f + random_float() * 0.5f);
+	}
+
+	start = get_current_time();
+	for (u64 i = 0; i < count; i++) {
+		u64 index = i & (MATRIX_SET_SIZE - 1);
+		Matrix4 scale_matrix;
+		scale_matrix[0]	 = scales[index].x;
+		scale_matrix[5]	 = scales[index].y;
+		scale_matrix[10] = scales[index].z;
+		products[index]	 = Matrix4(translations[index]) * rotations[index].to_matrix() * scale_matrix;
+	}
+	f64 trs_products_ms = elapsed_ms(start);
+
+	start = get_current_time();
+	for (u64 i = 0; i < count; i++) {
+		u64 index		= i & (MATRIX_SET_SIZE - 1);
+		products[index] = compose_trs(translations[index], rotations[index], scales[index]);
+	}
+	f64 trs_compose_ms = elapsed_ms(start);
+
+	start = get_current_time();
+	for (u64 i = 0; i < count; i += MATRIX_SET_SIZE) {
+		compose_trs(translations, rotations, scales, products.data());
+	}
+	f64 trs_batch_ms = elapsed_ms(start);
+
+	// Angles in [-8, 8) and positive values in (0, 16) for log
+	DynamicArray<f32> angles(count, 0.0f);
+	DynamicArray<f32> positives(count, 0.0f);
+	DynamicArray<f32> results(count, 0.0f);
+	for (u64 i = 0; i < count; i++) {
+		angles[i]	 = random_float() * 8.0f;
+		positives[i] = random_float() * 8.0f + 8.0001f;
+	}
+
+	start = get_current_time();
+	for (u64 i = 0; i < count; i++) {
+		results[i] = static_cast<f32>(toki::sin(static_cast<f64>(angles[i])));
+	}
+	f64 sin_series_ms	  = elapsed_ms(start);
+	f32 sin_series_result = checksum(results.data(), count);
+
+	start = get_current_time();
+	for (u64 i = 0; i < count; i++) {
+		results[i] = toki::sin(angles[i]);
+	}
+	f64 sin_ms	   = elapsed_ms(start);
+	f32 sin_result = checksum(results.data(), count);
+
+	start = get_current_time();
+	sin_many(angles, results.data());
+	f64 sin_batch_ms = elapsed_ms(start);
+
+	start = get_current_time();
+	sin_many<Accuracy::Fast>(angles, results.data());
+	f64 sin_fast_ms		= elapsed_ms(start);
+	f32 sin_fast_result = checksum(results.data(), count);
+
+	start = get_current_time();
+	for (u64 i = 0; i < count; i++) {
+		results[i] = toki::exp(angles[i]);
+	}
+	f64 exp_ms = elapsed_ms(start);
+
+	start = get_current_time();
+	exp_many(angles, results.data());
+	f64 exp_batch_ms = elapsed_ms(start);
+
+	start = get_current_time();
+	exp_many<Accuracy::Fast>(angles, results.data());
+	f64 exp_fast_ms = elapsed_ms(start);
+
+	start = get_current_time();
+	for (u64 i = 0; i < count; i++) {
+		results[i] = toki::log(positives[i]);
+	}
+	f64 log_ms = elapsed_ms(start);
+
+	start = get_current_time();
+	log_many(positives, results.data());
+	f64 log_batch_ms = elapsed_ms(start);
+
+	start = get_current_time();
+	log_many<Accuracy::Fast>(positives, results.data());
+	f64 log_fast_ms = elapsed_ms(start);
+
+	u32 object_count = static_cast<u32>(toki::max<u64>(count / 10, 1));
+	DynamicArray<Aabb> objects(object_count);
+	for (u32 i = 0; i < object_count; i++) {
+		Vector3 center(random_float() * 500.0f, random_float() * 50.0f, random_float() * 500.0f);
+		Vector3 extent(random_float() + 1.5f, random_float() + 1.5f, random_float() + 1.5f);
+		objects[i] = Aabb{ center - extent, center + extent };
+	}
+
+	Matrix4 view	= look_at(Vector3(0.0f), Vector3(1.0f, 0.0f, 0.3f), Vector3(0.0f, 1.0f, 0.0f));
+	Frustum frustum = Frustum::from_matrix(perspective(1.2, 16.0 / 9.0, 0.1, 300.0) * view);
+	DynamicArray<u32> visible;
+
+	start = get_current_time();
+	for (u32 i = 0; i < object_count; i++) {
+		if (frustum.intersects(objects[i])) {
+			visible.push_back(i);
+		}
+	}
+	f64 cull_brute_ms = elapsed_ms(start);
+	u64 visible_count = visible.size();
+
+	Bvh bvh;
+	start = get_current_time();
+	bvh.build(objects);
+	f64 bvh_build_ms = elapsed_ms(start);
+
+	// A hundredth of the objects moving in a frame
+	start = get_current_time();
+	for (u32 i = 0; i < object_count; i += 100) {
+		Vector3 offset(random_float(), 0.0f, random_float());
+		objects[i] = Aabb{ objects[i].min + offset, objects[i].max + offset };
+		bvh.update(i, objects[i]);
+	}
+	bvh.refit();
+	f64 bvh_refit_ms = elapsed_ms(start);
+
+	visible.clear();
+	start = get_current_time();
+	bvh.cull(frustum, visible);
+	f64 cull_bvh_ms = elapsed_ms(start);
+
+	Culler culler;
+	start = get_current_time();
+	culler.cull(bvh, frustum, visible);
+	f64 cull_parallel_ms = elapsed_ms(start);
+
+	toki::println("{} elements", count);
+	toki::println("  transform points, scalar {} ms (checksum {})", points_scalar_ms, points_reference);
+	toki::println("  transform points         {} ms (checksum {})", points_simd_ms, points_result);
+	toki::println("  transform points, batch  {} ms (checksum {})", points_batch_ms, points_batch);
+	toki::println("  transform points, SoA    {} ms", points_soa_ms);
+	toki::println("  normalize, batch         {} ms", normalize_ms);
+	toki::println("  bounds, batch            {} ms ({} {} {})", aabb_ms, aabb.min.x, aabb.min.y, aabb.min.z);
+	toki::println("  multiply, scalar         {} ms (checksum {})", multiply_scalar_ms, multiply_reference);
+	toki::println("  multiply                 {} ms (checksum {})", multiply_simd_ms, multiply_result);
+	toki::println("  multiply, batch          {} ms", multiply_batch_ms);
+	toki::println("  inverse                  {} ms", inverse_ms);
+	toki::println("  transpose                {} ms", transpose_ms);
+	toki::println("  TRS, matrix products     {} ms", trs_products_ms);
+	toki::println("  TRS, compose             {} ms", trs_compose_ms);
+	toki::println("  TRS, compose batch       {} ms", trs_batch_ms);
+	toki::println("  sin, f64 series          {} ms (checksum {})", sin_series_ms, sin_series_result);
+	toki::println("  sin                      {} ms (checksum {})", sin_ms, sin_result);
+	toki::println("  sin, batch               {} ms", sin_batch_ms);
+	toki::println("  sin, batch fast          {} ms (checksum {})", sin_fast_ms, sin_fast_result);
+	toki::println("  exp                      {} ms", exp_ms);
+	toki::println("  exp, batch               {} ms", exp_batch_ms);
+	toki::println("  exp, batch fast          {} ms", exp_fast_ms);
+	toki::println("  log                      {} ms", log_ms);
+	toki::println("  log, batch               {} ms", log_batch_ms);
+	toki::println("  log, batch fast          {} ms", log_fast_ms);
+	toki::println("{} objects, {} visible", object_count, visible_count);
+	toki::println("  cull, each object        {} ms", cull_brute_ms);
+	toki::println("  BVH build                {} ms", bvh_build_ms);
+	toki::println("  BVH refit                {} ms", bvh_refit_ms);
+	toki::println("  cull, BVH                {} ms ({} visible)", cull_bvh_ms, visible.size());
+	toki::println("  cull, parallel           {} ms", cull_parallel_ms);
+	return 0;
+}
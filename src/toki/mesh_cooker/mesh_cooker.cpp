@@ -0,0 +1,79 @@
+#include <toki/core/core.h>
+#include <toki/runtime/runtime.h>
+
+// Converts an .obj model into the cooked mesh format loaded by CookedMesh.
+//
+// usage: mesh_cooker <input.obj> <output> [--quantize | --packed] [--meshlets] [--optimize] [--compress-indices]
+//                    [--lods]
+
+using namespace toki;
+
+static b8 is_option(StringView arg, StringView option) {
+	return arg.size() == option.size() && arg == option;
+}
+
+toki::i32 toki::toki_entrypoint(toki::Span<char*> args) {
+	if (args.size() < 3) {
+		toki::println(
+			"usage: mesh_cooker <input.obj> <output> [--quantize | --packed] [--meshlets] [--optimize] "
+			"[--compress-indices] [--lods]");
+		return 1;
+	}
+
+	MeshCookConfig config{};
+	b8 optimize = false;
+	for (u64 i = 3; i < args.size(); i++) {
+		if (is_option(args[i], "--quantize")) {
+			config.vertex_format = CookedVertexFormat::QUANTIZED;
+		} else if (is_option(args[i], "--packed")) {
+			config.vertex_format = CookedVertexFormat::PACKED;
+		} else if (is_option(args[i], "--meshlets")) {
+			config.build_meshlets = true;
+		} else if (is_option(args[i], "--optimize")) {
+			optimize = true;
+		} else if (is_option(args[i], "--compress-indices")) {
+			config.compress_indices = true;
+		} else if (is_option(args[i], "--lods")) {
+			config.lods.max_lod_count = 4;
+		} else {
+			toki::println("Unknown option {}", args[i]);
+			return 1;
+		}
+	}
+
+	ObjData data = load_obj(args[1]);
+	if (optimize) {
+		MeshOptimizationStatistics statistics = optimize_mesh(data);
+		toki::println(
+			"Optimized {}: ACMR {} -> {}, ATVR {} -> {}, overfetch {} -> {}",
+			args[1],
+			statistics.cache_before.acmr,
+			statistics.cache_after.acmr,
+			statistics.cache_before.atvr,
+			statistics.cache_after.atvr,
+			statistics.fetch_before.overfetch,
+			statistics.fetch_after.overfetch);
+	}
+
+	if (!cook_mesh(data, config, args[2])) {
+		return 1;
+	}
+
+	CookedMesh mesh;
+	if (!mesh.load(args[2])) {
+		return 1;
+	}
+
+	const CookedMeshHeader& header = mesh.header();
+	toki::println("Cooked {} into {}", args[1], args[2]);
+	toki::println("  vertices       {}", header.vertex_count);
+	toki::println("  triangles      {}", header.index_count / 3);
+	toki::println("  meshlets       {}", header.meshlet_count);
+	toki::println("  vertex stride  {} bytes", header.vertex_stride);
+	toki::println("  index stream   {} bytes", header.indices.size);
+	for (u32 i = 0; i < mesh.lod_count(); i++) {
+		const MeshLod& lod = mesh.lods()[i];
+		toki::println("  lod {}          {} triangles, error {}", i, lod.index_count / 3, lod.error);
+	}
+	return 0;
+}
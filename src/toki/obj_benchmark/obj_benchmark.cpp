@@ -0,0 +1,162 @@
+#include <toki/core/core.h>
+#include <toki/runtime/runtime.h>
+
+// Times load_obj on a real model and on a generated grid of quads, the grid is large enough
+// that parsing with one thread and with one thread per physical core can be compared. Both
+// models are then cooked and the time to map and read the cooked mesh is measured against that.
+//
+// usage: obj_benchmark [model_path] [grid_triangles] [grid_path]
+
+using namespace toki;
+
+static void write_number(BufferedWriter& writer, u64 value) {
+	char buffer[32]{};
+	writer.write(buffer, toki::itoa(buffer, value));
+}
+
+static void write_float(BufferedWriter& writer, f32 value) {
+	char buffer[32]{};
+	writer.write(buffer, toki::ftoa(buffer, value, 4));
+}
+
+// Every quad is a single 4 sided face so the triangulation path gets exercised, positions and
+// texture coordinates are shared between neighbouring quads so deduplication has work to do
+static void generate_grid(StringView path, u64 triangle_count) {
+	u64 side = 1;
+	while (side * side * 2 < triangle_count) {
+		side++;
+	}
+
+	File file(path, FileMode::WRITE, FILE_FLAG_CREATE | FILE_FLAG_TRUNCATE);
+	BufferedWriter writer(file, MB(1));
+
+	for (u64 y = 0; y <= side; y++) {
+		for (u64 x = 0; x <= side; x++) {
+			f32 u = static_cast<f32>(x) / static_cast<f32>(side);
+			f32 v = static_cast<f32>(y) / static_cast<f32>(side);
+
+			writer.write("v ");
+			write_float(writer, u * 100.0f);
+			writer.write(" 0.0 ");
+			write_float(writer, v * 100.0f);
+			writer.write("\nvt ");
+			write_float(writer, u);
+			writer.write(" ");
+			write_float(writer, v);
+			writer.write("\n");
+		}
+	}
+
+	writer.write_line("vn 0.0 1.0 0.0");
+
+	for (u64 y = 0; y < side; y++) {
+		for (u64 x = 0; x < side; x++) {
+			u64 corners[4] = { y * (side + 1) + x + 1,
+							   y * (side + 1) + x + 2,
+							   (y + 1) * (side + 1) + x + 2,
+							   (y + 1) * (side + 1) + x + 1 };
+
+			writer.write("f");
+			for (u32 i = 0; i < 4; i++) {
+				writer.write(" ");
+				write_number(writer, corners[i]);
+				writer.write("/");
+				write_number(writer, corners[i]);
+				writer.write("/1");
+			}
+			writer.write("\n");
+		}
+	}
+}
+
+static void measure(StringView name, const Path& path, const ObjLoadConfig& config, u32 iterations) {
+	u64 vertex_count = 0;
+	u64 index_count	 = 0;
+
+	u64 start = get_current_time();
+	for (u32 i = 0; i < iterations; i++) {
+		ObjData data = load_obj(path, config);
+		vertex_count = data.vertex_data.size();
+		index_count	 = data.index_data.size();
+	}
+	f64 seconds = static_cast<f64>(get_current_time() - start) / 1e9 / static_cast<f64>(iterations);
+
+	toki::println("{}, {} thread(s):", name, config.thread_count);
+	toki::println("  vertices       {}", vertex_count);
+	toki::println("  triangles      {}", index_count / 3);
+	toki::println("  load time      {} ms", seconds * 1000.0);
+	toki::println("  throughput     {} M triangles/s", static_cast<f64>(index_count / 3) / seconds / 1e6);
+}
+
+// Every page of the index stream is read so the mapping is paid for the same way an upload
+// would pay for it
+static void measure_cooked(StringView name, const Path& obj_path, const Path& cooked_path, u32 iterations) {
+	ObjData data = load_obj(obj_path);
+	if (!cook_mesh(data, {}, cooked_path)) {
+		return;
+	}
+
+	u64 vertex_count = 0;
+	u64 index_count	 = 0;
+	u64 checksum	 = 0;
+
+	u64 start = get_current_time();
+	for (u32 i = 0; i < iterations; i++) {
+		CookedMesh mesh;
+		if (!mesh.load(cooked_path)) {
+			return;
+		}
+
+		vertex_count = mesh.header().vertex_count;
+		index_count	 = mesh.index_count();
+		for (u32 j = 0; j < mesh.index_count(); j++) {
+			checksum += mesh.indices()[j];
+		}
+	}
+	f64 seconds = static_cast<f64>(get_current_time() - start) / 1e9 / static_cast<f64>(iterations);
+
+	toki::println("{}, cooked:", name);
+	toki::println("  vertices       {}", vertex_count);
+	toki::println("  triangles      {}", index_count / 3);
+	toki::println("  load time      {} ms", seconds * 1000.0);
+	toki::println("  index checksum {}", checksum);
+}
+
+toki::i32 toki::toki_entrypoint(toki::Span<char*> args) {
+	const char* model_path = "assets/models/rabbit.obj";
+	u64 grid_triangles	   = 10'000'000;
+	const char* grid_path  = "obj_benchmark_grid.obj";
+
+	const char* cooked_model_path = "obj_benchmark_model.tmsh";
+	const char* cooked_grid_path  = "obj_benchmark_grid.tmsh";
+
+	if (args.size() > 1) {
+		model_path = args[1];
+	}
+	if (args.size() > 2) {
+		toki::atoi(args[2], grid_triangles);
+	}
+	if (args.size() > 3) {
+		grid_path = args[3];
+	}
+
+	CpuTopology topology = query_cpu_topology();
+	u32 thread_count	 = toki::max(static_cast<u32>(topology.physical_cores.size()), 1u);
+
+	ObjLoadConfig serial{};
+	ObjLoadConfig parallel{};
+	parallel.thread_count		= thread_count;
+	parallel.parallel_threshold = 0;
+
+	measure(model_path, model_path, serial, 100);
+	measure_cooked(model_path, model_path, cooked_model_path, 100);
+
+	toki::println("Generating a grid with {} triangles in {}", grid_triangles, grid_path);
+	generate_grid(grid_path, grid_triangles);
+
+	measure("grid", grid_path, serial, 1);
+	measure("grid", grid_path, parallel, 1);
+	measure_cooked("grid", grid_path, cooked_grid_path, 1);
+
+	return 0;
+}
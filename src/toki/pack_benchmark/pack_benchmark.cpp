@@ -0,0 +1,141 @@
+#include <toki/core/core.h>
+#include <toki/core/platform/syscalls.h>
+#include <toki/runtime/runtime.h>
+
+// Compares reading a set of generated assets as loose files with reading them from a pack,
+// stored and LZ4 compressed. Every configuration is timed with cold page cache, where all
+// files are dropped from the cache first, and with warm page cache.
+//
+// usage: pack_benchmark [file_count] [directory]
+
+using namespace toki;
+
+static void generate_files(StringView directory, DynamicArray<String<>>& paths_out, u64 file_count) {
+	toki::create_directory(directory.data());
+
+	// Sizes between 4 KB and 132 KB filled with text shaped like shader or model sources
+	u64 state = 1;
+	for (u64 i = 0; i < file_count; i++) {
+		char name[64]{};
+		u64 length = toki::itoa(name, i);
+		toki::memcpy(name + length, ".asset", 6);
+
+		String<> path = toki::format("{}/{}", directory, StringView(name));
+		File file(StringView(path.data()), FileMode::WRITE, FILE_FLAG_CREATE | FILE_FLAG_TRUNCATE);
+		BufferedWriter writer(file);
+
+		state	 = state * 6364136223846793005 + 1442695040888963407;
+		u64 size = KB(4) + (state >> 33) % KB(128);
+		for (u64 written = 0; written < size;) {
+			state = state * 6364136223846793005 + 1442695040888963407;
+
+			char line[64]{};
+			toki::memcpy(line, "v 0.", 4);
+			u64 line_length		= 4 + toki::itoa(line + 4, state >> 44);
+			line[line_length++] = '\n';
+
+			writer.write(line, line_length);
+			written += line_length;
+		}
+
+		paths_out.emplace_back(toki::move(path));
+	}
+}
+
+static void drop_cache(StringView path) {
+	auto handle = toki::open(path.data(), FileMode::READ);
+	if (handle) {
+		toki::drop_file_cache(handle.value());
+		toki::close(handle.value());
+	}
+}
+
+// Reads a file the way load_text does, seek to the end for the size and read it whole
+static u64 read_loose(StringView path, DynamicArray<byte>& buffer) {
+	File file(path, FileMode::READ);
+	file.seek(0, FileCursorStart::END);
+	u64 size = file.tell();
+	file.seek(0, FileCursorStart::BEGIN);
+
+	buffer.resize(size);
+	file.read(buffer.data(), size);
+	return toki::hash_bytes(buffer.data(), size);
+}
+
+static f64 measure_loose(const DynamicArray<String<>>& paths, u64& checksum_out) {
+	DynamicArray<byte> buffer;
+
+	u64 start = get_current_time();
+	for (u64 i = 0; i < paths.size(); i++) {
+		checksum_out ^= read_loose(StringView(paths[i].data()), buffer);
+	}
+	return static_cast<f64>(get_current_time() - start) / 1e6;
+}
+
+static f64 measure_pack(StringView pack_path, const DynamicArray<String<>>& paths, u64& checksum_out) {
+	u64 start = get_current_time();
+
+	PackFileSystem pack;
+	pack.open(pack_path);
+	for (u64 i = 0; i < paths.size(); i++) {
+		Optional<StringView> contents = pack.read(StringView(paths[i].data()));
+		checksum_out ^= toki::hash_bytes(contents.value().data(), contents.value().size());
+	}
+
+	return static_cast<f64>(get_current_time() - start) / 1e6;
+}
+
+toki::i32 toki::toki_entrypoint(toki::Span<char*> args) {
+	u64 file_count		  = 500;
+	const char* directory = "pack_benchmark_files";
+
+	if (args.size() > 1) {
+		toki::atoi(args[1], file_count);
+	}
+	if (args.size() > 2) {
+		directory = args[2];
+	}
+
+	toki::println("Generating {} files in {}", file_count, directory);
+	DynamicArray<String<>> paths;
+	generate_files(directory, paths, file_count);
+
+	DynamicArray<StringView> inputs;
+	for (u64 i = 0; i < paths.size(); i++) {
+		inputs.push_back(StringView(paths[i].data()));
+	}
+
+	String<> stored_pack	 = toki::format("{}/stored.pak", StringView(directory));
+	String<> compressed_pack = toki::format("{}/compressed.pak", StringView(directory));
+	write_pack(StringView(stored_pack.data()), inputs, {});
+	write_pack(StringView(compressed_pack.data()), inputs, { .compress = true });
+
+	StringView packs[] = { StringView(stored_pack.data()), StringView(compressed_pack.data()) };
+	b8 cache_states[] = { true, false };
+	for (b8 cold : cache_states) {
+		if (cold) {
+			for (u64 i = 0; i < inputs.size(); i++) {
+				drop_cache(inputs[i]);
+			}
+			for (StringView pack : packs) {
+				drop_cache(pack);
+			}
+		}
+
+		u64 loose_checksum		= 0;
+		u64 stored_checksum		= 0;
+		u64 compressed_checksum = 0;
+		f64 loose_ms			= measure_loose(paths, loose_checksum);
+		f64 stored_ms			= measure_pack(packs[0], paths, stored_checksum);
+		f64 compressed_ms		= measure_pack(packs[1], paths, compressed_checksum);
+		TK_ASSERT(loose_checksum == stored_checksum && loose_checksum == compressed_checksum);
+
+		toki::println("{} page cache:", cold ? "cold" : "warm");
+		toki::println("  loose files      {} ms", loose_ms);
+		toki::println("  pack             {} ms", stored_ms);
+		toki::println("  pack, lz4        {} ms", compressed_ms);
+	}
+
+	paths.clear();
+	return 0;
+}
@@ -17,11 +17,13 @@ public:
 
 	virtual void bind_shader(ShaderHandle handle);
 	virtual void bind_index_buffer(BufferHandle handle);
-	virtual void bind_vertex_buffer(BufferHandle handle);
+	virtual void bind_vertex_buffer(BufferHandle handle, u64 offset = 0);
 	virtual void bind_uniforms(ShaderLayoutHandle handle);
+	// vertex_layout_hash of the shader bound last, 0 before one is bound
+	virtual u64 bound_vertex_layout() const;
 
 	virtual void draw(u32 vertex_count);
-	virtual void draw_indexed(u32 index_count);
+	virtual void draw_indexed(u32 index_count, u32 first_index = 0);
 
 private:
 	void* m_data;
@@ -5,7 +5,8 @@ namespace toki {
 enum class RendererErrors {
 	NoError,
 	Unknown,
-	ShaderCompileError
+	ShaderCompileError,
+	UnsupportedVertexFormat
 };
 
 }  // namespace toki
@@ -9,6 +9,9 @@ namespace toki {
 
 struct RendererConfig {
 	Window* window;
+	// Compiled shaders and the pipeline cache are stored here between runs, caching is disabled
+	// when this is nullptr
+	const char* cache_directory{};
 };
 
 class Renderer {
@@ -41,10 +44,30 @@ public:
 	void destroy_handle(SamplerHandle);
 	void destroy_handle(CommandsHandle);
 
+	// Rebuilds the pipeline of a shader from new sources, the handle stays valid. Waits for the
+	// device to be idle, so it's meant for hot reloading. Returns false and keeps the previous
+	// pipeline if the sources don't compile.
+	b8 reload_shader(ShaderHandle handle, const ShaderConfig& config);
+	// Waits until every submitted frame has finished on the GPU. Resources that frames in flight
+	// may still use, like a hot reloaded texture and the descriptors pointing at it, can only be
+	// destroyed or rewritten after this.
+	void wait_idle();
+
 	// Buffer functions
 	void set_buffer_data(BufferHandle handle, const void* data, u32 size);
+	// Memory of a dynamic buffer, stays valid until the buffer is destroyed. Writes are seen by
+	// commands submitted afterwards, memory a frame in flight reads must not be overwritten.
+	void* get_mapped_buffer(BufferHandle handle);
 
 	void set_texture_data(TextureHandle handle, const void* data, u32 size);
+	// Returns upload memory for the data of every level so pixels can be decoded straight into it
+	// instead of into a buffer that gets copied. The memory may be written from other threads,
+	// end_texture_upload records the copy to the texture and has to be called in the same frame.
+	TextureUpload begin_texture_upload(TextureHandle handle);
+	void end_texture_upload(const TextureUpload& upload);
+	// Copies only the regions of an uncompressed single level texture. Pixels is the whole level
+	// with rows of the texture width, the rest of the texture keeps its contents.
+	void update_texture_regions(TextureHandle handle, const void* pixels, Span<TextureRegion> regions);
 
 	void set_uniforms(const SetUniformConfig& config);
 
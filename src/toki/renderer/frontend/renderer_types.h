@@ -6,6 +6,9 @@
 
 namespace toki {
 
+// Frames recorded ahead of the GPU, resources rewritten every frame need this many copies
+constexpr const u32 MAX_FRAMES_IN_FLIGHT = 3;
+
 struct ShaderHandle : public Handle {};
 struct ShaderLayoutHandle : public Handle {};
 struct BufferHandle : public Handle {};
@@ -22,6 +25,11 @@ enum struct ColorFormat : u16 {
 	// DEPTH,
 	// STENCIL,
 	DEPTH_STENCIL,
+	// Block compressed, 4x4 pixel blocks, see BlockFormat. Can only be sampled.
+	BC1_RGBA,
+	BC3_RGBA,
+	BC4_R,
+	BC7_RGBA,
 
 	COLOR_FORMAT_COUNT
 };
@@ -41,11 +49,24 @@ enum struct VertexInputRate : u8 {
 	INSTANCE,
 };
 
+// Three component formats other than FLOAT3 are left out, vertex input support for them is
+// optional. Normalized formats are read as floats in [-1, 1] or [0, 1].
 enum struct VertexFormat : u8 {
 	FLOAT1,
 	FLOAT2,
 	FLOAT3,
 	FLOAT4,
+	HALF2,
+	HALF4,
+	SNORM8_4,
+	UNORM8_4,
+	SNORM16_2,
+	SNORM16_4,
+	UNORM16_2,
+	UNORM16_4,
+	// Red in the low bits and a 2 bit alpha at the top
+	SNORM_10_10_10_2,
+	UNORM_10_10_10_2,
 };
 
 struct VertexAttributeDescription {
@@ -61,6 +82,23 @@ struct VertexBindingDescription {
 	VertexInputRate inputRate;
 };
 
+// Identifies a vertex input layout so vertex data can be checked against the shader reading it,
+// 0 when there are no bindings
+inline u64 vertex_layout_hash(Span<VertexBindingDescription> bindings, Span<VertexAttributeDescription> attributes) {
+	u64 hash = 0;
+	for (u64 i = 0; i < bindings.size(); i++) {
+		u32 fields[]{ bindings[i].binding, bindings[i].stride, static_cast<u32>(bindings[i].inputRate) };
+		hash = hash_bytes(fields, sizeof(fields), hash);
+	}
+	for (u64 i = 0; i < attributes.size(); i++) {
+		u32 fields[]{
+			attributes[i].location, attributes[i].binding, static_cast<u32>(attributes[i].format), attributes[i].offset
+		};
+		hash = hash_bytes(fields, sizeof(fields), hash);
+	}
+	return hash;
+}
+
 enum struct BufferType : u8 {
 	VERTEX,
 	INDEX,
@@ -199,6 +237,9 @@ struct UniformSetConfig {
 struct BufferConfig {
 	u64 size;
 	BufferType type;
+	// Dynamic buffers stay mapped in host visible memory for data rewritten every frame, see
+	// Renderer::get_mapped_buffer
+	BufferUsage usage = BufferUsage::STATIC;
 };
 
 struct TextureConfig {
@@ -207,6 +248,25 @@ struct TextureConfig {
 	u32 height;
 	u32 channels;
 	ColorFormat format;
+	// Texture data holds every level packed one after the other starting with level 0
+	u32 mip_levels = 1;
+};
+
+// Texels of level 0 of a texture, see Renderer::update_texture_regions
+struct TextureRegion {
+	u32 x;
+	u32 y;
+	u32 width;
+	u32 height;
+};
+
+// Upload memory of a texture, see Renderer::begin_texture_upload
+struct TextureUpload {
+	TextureHandle handle;
+	// Can be write combined, it should only be written and preferably in order
+	void* data;
+	u64 size;
+	u64 staging_offset;
 };
 
 struct SamplerConfig {
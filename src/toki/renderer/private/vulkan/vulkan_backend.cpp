@@ -2,6 +2,7 @@
 
 #include <GLFW/glfw3.h>
 #include <toki/core/core.h>
+#include <toki/core/platform/syscalls.h>
 #include <toki/renderer/private/vulkan/vulkan_resources_utils.h>
 #include <toki/renderer/renderer_allocators.h>
 #include <toki/renderer/types.h>
@@ -26,6 +27,13 @@ void VulkanBackend::initialize(const RendererConfig& config) {
 	// Important to query device speific data BEFORE creating resources
 	vkGetPhysicalDeviceMemoryProperties(m_state.physical_device, &m_state.physical_device_memory_properties);
 
+	if (config.cache_directory != nullptr) {
+		m_state.cache_directory = Path(config.cache_directory);
+		toki::create_directory(config.cache_directory);
+		toki::create_directory(toki::format("{}/shaders", StringView(config.cache_directory)).data());
+	}
+	initialize_pipeline_cache();
+
 	m_state.frames = VulkanFrames::create(m_state);
 
 	VulkanSwapchainConfig swapchain_config{};
@@ -63,6 +71,8 @@ void VulkanBackend::initialize(const RendererConfig& config) {
 void VulkanBackend::cleanup() {
 	vkDeviceWaitIdle(m_state.logical_device);
 
+	save_pipeline_cache();
+
 	m_state.staging_buffer.destroy(m_state);
 	m_state.command_pool.destroy(m_state);
 	m_state.temporary_command_pool.destroy(m_state);
@@ -207,7 +217,19 @@ void Renderer::present() {
 
 void Renderer::set_buffer_data(BufferHandle handle, const void* data, u32 size) {
 	TK_ASSERT(STATE.buffers.exists(handle));
-	STATE.staging_buffer.set_data_for_buffer(STATE, STATE.buffers.at(handle), data, size);
+	VulkanBuffer& buffer = STATE.buffers.at(handle);
+	if (buffer.mapped_memory() != nullptr) {
+		TK_ASSERT(size <= buffer.size());
+		toki::memcpy(buffer.mapped_memory(), data, size);
+		return;
+	}
+	STATE.staging_buffer.set_data_for_buffer(STATE, buffer, data, size);
+}
+
+void* Renderer::get_mapped_buffer(BufferHandle handle) {
+	TK_ASSERT(STATE.buffers.exists(handle));
+	TK_ASSERT(STATE.buffers.at(handle).mapped_memory() != nullptr, "Only dynamic buffers are mapped");
+	return STATE.buffers.at(handle).mapped_memory();
 }
 
 void Renderer::set_texture_data(TextureHandle handle, const void* data, u32 size) {
@@ -215,6 +237,49 @@ void Renderer::set_texture_data(TextureHandle handle, const void* data, u32 size
 	STATE.staging_buffer.set_data_for_image(STATE, STATE.textures.at(handle), data, size);
 }
 
+TextureUpload Renderer::begin_texture_upload(TextureHandle handle) {
+	TK_ASSERT(STATE.textures.exists(handle));
+
+	TextureUpload upload{};
+	upload.handle		  = handle;
+	upload.size			  = STATE.textures.at(handle).data_size();
+	upload.staging_offset = STATE.staging_buffer.reserve(upload.size);
+	upload.data			  = STATE.staging_buffer.data_at(upload.staging_offset);
+	return upload;
+}
+
+void Renderer::end_texture_upload(const TextureUpload& upload) {
+	TK_ASSERT(STATE.textures.exists(upload.handle));
+	STATE.staging_buffer.copy_to_image(STATE, STATE.textures.at(upload.handle), upload.staging_offset);
+}
+
+void Renderer::update_texture_regions(TextureHandle handle, const void* pixels, Span<TextureRegion> regions) {
+	TK_ASSERT(STATE.textures.exists(handle));
+	if (regions.size() == 0) {
+		return;
+	}
+	STATE.staging_buffer.set_regions_for_image(STATE, STATE.textures.at(handle), pixels, regions);
+}
+
+b8 Renderer::reload_shader(ShaderHandle handle, const ShaderConfig& config) {
+	TK_ASSERT(STATE.shaders.exists(handle));
+
+	auto shader = VulkanShader::try_create(config, STATE);
+	if (!shader) {
+		return false;
+	}
+
+	// Frames in flight may still be using the old pipeline
+	vkDeviceWaitIdle(STATE.logical_device);
+	STATE.shaders.at(handle).destroy(STATE);
+	STATE.shaders.at(handle) = shader.value();
+	return true;
+}
+
+void Renderer::wait_idle() {
+	vkDeviceWaitIdle(STATE.logical_device);
+}
+
 void Renderer::set_uniforms(const SetUniformConfig& config) {
 	TK_ASSERT(STATE.shader_layouts.exists(config.layout));
 	STATE.shader_layouts.at(config.layout).set_descriptors(STATE, config);
@@ -364,8 +429,13 @@ void VulkanBackend::initialize_device(Window* window) {
 	// 	toki::println("{}", device_extensions[i]);
 	// }
 
+	VkPhysicalDeviceFeatures supported_features{};
+	vkGetPhysicalDeviceFeatures(m_state.physical_device, &supported_features);
+	m_state.supports_bc_textures = supported_features.textureCompressionBC == VK_TRUE;
+
 	VkPhysicalDeviceFeatures physical_device_features{};
-	physical_device_features.samplerAnisotropy = VK_TRUE;
+	physical_device_features.samplerAnisotropy	  = VK_TRUE;
+	physical_device_features.textureCompressionBC = supported_features.textureCompressionBC;
 
 	VkPhysicalDeviceDynamicRenderingFeatures dynamic_rendering_features{};
 	dynamic_rendering_features.sType			= VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES;
@@ -390,6 +460,70 @@ void VulkanBackend::initialize_device(Window* window) {
 	vkGetDeviceQueue(m_state.logical_device, m_state.indices[PRESENT_FAMILY_INDEX], 0, &m_state.present_queue);
 }
 
+static Path pipeline_cache_path(const VulkanState& state) {
+	String<> path = toki::format("{}/pipeline_cache.bin", StringView(state.cache_directory.c_str()));
+	return Path(StringView(path));
+}
+
+// Drivers are not required to reject data written by another driver or device, so the header is
+// checked before the data is handed over
+static b8 is_pipeline_cache_compatible(const VulkanState& state, const byte* data, u64 size) {
+	if (size < sizeof(VkPipelineCacheHeaderVersionOne)) {
+		return false;
+	}
+
+	VkPipelineCacheHeaderVersionOne header;
+	toki::memcpy(&header, data, sizeof(header));
+
+	VkPhysicalDeviceProperties properties{};
+	vkGetPhysicalDeviceProperties(state.physical_device, &properties);
+
+	if (header.headerSize < sizeof(header) || header.headerVersion != VK_PIPELINE_CACHE_HEADER_VERSION_ONE ||
+		header.vendorID != properties.vendorID || header.deviceID != properties.deviceID) {
+		return false;
+	}
+
+	for (u32 i = 0; i < VK_UUID_SIZE; i++) {
+		if (header.pipelineCacheUUID[i] != properties.pipelineCacheUUID[i]) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void VulkanBackend::initialize_pipeline_cache() {
+	VkPipelineCacheCreateInfo pipeline_cache_create_info{};
+	pipeline_cache_create_info.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+
+	// Only has to stay mapped until the cache is created
+	MappedFile cached;
+	if (m_state.cache_directory.c_str()[0] != '\0' && cached.open(pipeline_cache_path(m_state)) &&
+		is_pipeline_cache_compatible(m_state, cached.data(), cached.size())) {
+		pipeline_cache_create_info.initialDataSize = cached.size();
+		pipeline_cache_create_info.pInitialData	   = cached.data();
+	}
+
+	VkResult result = vkCreatePipelineCache(
+		m_state.logical_device, &pipeline_cache_create_info, m_state.allocation_callbacks, &m_state.pipeline_cache);
+	TK_ASSERT(result == VK_SUCCESS, "Could not create pipeline cache");
+}
+
+void VulkanBackend::save_pipeline_cache() {
+	if (m_state.cache_directory.c_str()[0] != '\0') {
+		size_t size = 0;
+		vkGetPipelineCacheData(m_state.logical_device, m_state.pipeline_cache, &size, nullptr);
+
+		DynamicArray<byte> data(size);
+		VkResult result = vkGetPipelineCacheData(m_state.logical_device, m_state.pipeline_cache, &size, data.data());
+		if (result == VK_SUCCESS) {
+			write_cache_file(pipeline_cache_path(m_state), nullptr, 0, data.data(), size);
+		}
+	}
+
+	vkDestroyPipelineCache(m_state.logical_device, m_state.pipeline_cache, m_state.allocation_callbacks);
+}
+
 #define DEFINE_CREATE_RESOURCE(type, lowercase_type)                                              \
 	type##Handle Renderer::create_##lowercase_type(const type##Config& config) {                  \
 		return { STATE.lowercase_type##s.emplace_at_first(Vulkan##type::create(config, STATE)) }; \
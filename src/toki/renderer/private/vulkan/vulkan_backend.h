@@ -31,6 +31,8 @@ private:
 
 	void initialize_instance();
 	void initialize_device(Window* window);
+	void initialize_pipeline_cache();
+	void save_pipeline_cache();
 
 private:
 	VulkanState m_state{};
@@ -85,14 +85,19 @@ void Commands::end_pass() {
 void Commands::bind_shader(ShaderHandle handle) {
 	TK_ASSERT(STATE->shaders.exists(handle));
 	vkCmdBindPipeline(CMD, VK_PIPELINE_BIND_POINT_GRAPHICS, STATE->shaders.at(handle));
+	reinterpret_cast<VulkanCommandsData*>(m_data)->bound_vertex_layout = STATE->shaders.at(handle).vertex_layout();
+}
+
+u64 Commands::bound_vertex_layout() const {
+	return reinterpret_cast<VulkanCommandsData*>(m_data)->bound_vertex_layout;
 }
 
 void Commands::draw(u32 vertex_count) {
 	vkCmdDraw(CMD, vertex_count, 1, 0, 0);
 }
 
-void Commands::draw_indexed(u32 index_count) {
-	vkCmdDrawIndexed(CMD, index_count, 1, 0, 0, 0);
+void Commands::draw_indexed(u32 index_count, u32 first_index) {
+	vkCmdDrawIndexed(CMD, index_count, 1, first_index, 0, 0);
 }
 
 void Commands::bind_index_buffer(BufferHandle handle) {
@@ -101,11 +106,11 @@ void Commands::bind_index_buffer(BufferHandle handle) {
 	vkCmdBindIndexBuffer(CMD, buf.buffer(), 0, VK_INDEX_TYPE_UINT32);
 }
 
-void Commands::bind_vertex_buffer(BufferHandle handle) {
+void Commands::bind_vertex_buffer(BufferHandle handle, u64 offset) {
 	TK_ASSERT(STATE->buffers.exists(handle));
 	VulkanBuffer& buffer	= STATE->buffers.at(handle);
 	VkBuffer buffer_array[] = { buffer.buffer() };
-	VkDeviceSize offsets[]	= { 0 };
+	VkDeviceSize offsets[]	= { offset };
 	vkCmdBindVertexBuffers(CMD, 0, 1, buffer_array, offsets);
 }
 
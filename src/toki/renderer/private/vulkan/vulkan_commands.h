@@ -7,6 +7,8 @@ namespace toki {
 struct VulkanCommandsData {
 	const VulkanState* state;
 	VulkanCommandBuffer cmd;
+	// Vertex layout of the shader bound last
+	u64 bound_vertex_layout;
 };
 
 }  // namespace toki
@@ -292,7 +292,21 @@ void VulkanShaderLayout::set_descriptors(const VulkanState& state, const SetUnif
 	vkUpdateDescriptorSets(state.logical_device, writes.size(), writes.data(), 0, nullptr);
 }
 
+static void destroy_shader_stages(
+	const VulkanState& state, const TempDynamicArray<VkPipelineShaderStageCreateInfo>& shader_stage_create_infos) {
+	for (u32 i = 0; i < shader_stage_create_infos.size(); i++) {
+		vkDestroyShaderModule(state.logical_device, shader_stage_create_infos[i].module, state.allocation_callbacks);
+	}
+}
+
 VulkanShader VulkanShader::create(const ShaderConfig& config, const VulkanState& state) {
+	auto shader = try_create(config, state);
+	TK_ASSERT(shader);
+	return shader.value();
+}
+
+toki::Expected<VulkanShader, RendererErrors> VulkanShader::try_create(
+	const ShaderConfig& config, const VulkanState& state) {
 	TK_ASSERT(config.color_formats.size() > 0);
 
 	TempDynamicArray<VkPipelineShaderStageCreateInfo> shader_stage_create_infos;
@@ -303,8 +317,11 @@ VulkanShader VulkanShader::create(const ShaderConfig& config, const VulkanState&
 			continue;
 		}
 
-		auto compile_shader_result = compile_shader(static_cast<ShaderStageFlags>(i), config.sources[i]);
-		TK_ASSERT(compile_shader_result);
+		auto compile_shader_result = compile_shader_cached(state, static_cast<ShaderStageFlags>(i), config.sources[i]);
+		if (!compile_shader_result) {
+			destroy_shader_stages(state, shader_stage_create_infos);
+			return RendererErrors::ShaderCompileError;
+		}
 
 		shader_stage_create_infos.push_back({});
 		VkPipelineShaderStageCreateInfo& shader_stage_create_info = shader_stage_create_infos.last();
@@ -359,9 +376,51 @@ VulkanShader VulkanShader::create(const ShaderConfig& config, const VulkanState&
 			case VertexFormat::FLOAT4:
 				vertex_attribute_descriptions[i].format = VK_FORMAT_R32G32B32A32_SFLOAT;
 				break;
+			case VertexFormat::HALF2:
+				vertex_attribute_descriptions[i].format = VK_FORMAT_R16G16_SFLOAT;
+				break;
+			case VertexFormat::HALF4:
+				vertex_attribute_descriptions[i].format = VK_FORMAT_R16G16B16A16_SFLOAT;
+				break;
+			case VertexFormat::SNORM8_4:
+				vertex_attribute_descriptions[i].format = VK_FORMAT_R8G8B8A8_SNORM;
+				break;
+			case VertexFormat::UNORM8_4:
+				vertex_attribute_descriptions[i].format = VK_FORMAT_R8G8B8A8_UNORM;
+				break;
+			case VertexFormat::SNORM16_2:
+				vertex_attribute_descriptions[i].format = VK_FORMAT_R16G16_SNORM;
+				break;
+			case VertexFormat::SNORM16_4:
+				vertex_attribute_descriptions[i].format = VK_FORMAT_R16G16B16A16_SNORM;
+				break;
+			case VertexFormat::UNORM16_2:
+				vertex_attribute_descriptions[i].format = VK_FORMAT_R16G16_UNORM;
+				break;
+			case VertexFormat::UNORM16_4:
+				vertex_attribute_descriptions[i].format = VK_FORMAT_R16G16B16A16_UNORM;
+				break;
+			case VertexFormat::SNORM_10_10_10_2:
+				vertex_attribute_descriptions[i].format = VK_FORMAT_A2B10G10R10_SNORM_PACK32;
+				break;
+			case VertexFormat::UNORM_10_10_10_2:
+				vertex_attribute_descriptions[i].format = VK_FORMAT_A2B10G10R10_UNORM_PACK32;
+				break;
 			default:
 				TK_UNREACHABLE();
 		}
+
+		// Vertex buffer support is not mandatory for every format, snorm 10:10:10:2 for one
+		VkFormatProperties format_properties{};
+		vkGetPhysicalDeviceFormatProperties(
+			state.physical_device, vertex_attribute_descriptions[i].format, &format_properties);
+		if ((format_properties.bufferFeatures & VK_FORMAT_FEATURE_VERTEX_BUFFER_BIT) == 0) {
+			TK_LOG_WARN(
+				"Vertex attribute {} uses a format the device cannot read from vertex buffers",
+				config.attributes[i].location);
+			destroy_shader_stages(state, shader_stage_create_infos);
+			return RendererErrors::UnsupportedVertexFormat;
+		}
 	}
 
 	VkPipelineVertexInputStateCreateInfo vertex_input_state_create_info{};
@@ -582,17 +641,19 @@ VulkanShader VulkanShader::create(const ShaderConfig& config, const VulkanState&
 	VulkanShader shader{};
 	VkResult result = vkCreateGraphicsPipelines(
 		state.logical_device,
-		nullptr,
+		state.pipeline_cache,
 		1,
 		&graphics_pipeline_create_info,
 		state.allocation_callbacks,
 		&shader.m_pipeline);
-	TK_ASSERT(result == VK_SUCCESS);
 
-	for (u32 i = 0; i < shader_stage_create_infos.size(); i++) {
-		vkDestroyShaderModule(state.logical_device, shader_stage_create_infos[i].module, state.allocation_callbacks);
+	destroy_shader_stages(state, shader_stage_create_infos);
+
+	if (result != VK_SUCCESS) {
+		return RendererErrors::Unknown;
 	}
 
+	shader.m_vertexLayout = vertex_layout_hash(config.bindings, config.attributes);
 	return shader;
 }
 
@@ -615,21 +676,36 @@ VulkanBuffer VulkanBuffer::create(const VulkanBufferConfig& config, const Vulkan
 	VkResult result = vkCreateBuffer(state.logical_device, &bufferInfo, state.allocation_callbacks, &buffer.m_buffer);
 	TK_ASSERT(result == VK_SUCCESS);
 
+	// Dynamic buffers are written by the CPU every frame and read by the GPU once, so they are
+	// written in place instead of going through staging
+	const b8 is_dynamic = config.override_memory_properties == 0 && config.buffer_config.usage == BufferUsage::DYNAMIC;
+
 	MemoryAllocateConfig device_allocate_config{};
-	device_allocate_config.memory_property_flags =
-		config.override_memory_properties != 0
-			? config.override_memory_properties
-			: static_cast<VkMemoryPropertyFlags>(VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+	if (config.override_memory_properties != 0) {
+		device_allocate_config.memory_property_flags = config.override_memory_properties;
+	} else if (is_dynamic) {
+		device_allocate_config.memory_property_flags =
+			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+	} else {
+		device_allocate_config.memory_property_flags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+	}
 	vkGetBufferMemoryRequirements(state.logical_device, buffer.m_buffer, &device_allocate_config.memory_requirements);
 	buffer.m_deviceMemory = allocate_device_memory(device_allocate_config, state);
 
 	result = vkBindBufferMemory(state.logical_device, buffer.m_buffer, buffer.m_deviceMemory, 0);
 	TK_ASSERT(result == VK_SUCCESS);
 
+	if (is_dynamic) {
+		buffer.m_mappedMemory = buffer.map_memory(state);
+	}
+
 	return buffer;
 }
 
 void VulkanBuffer::destroy(const VulkanState& state) {
+	if (m_mappedMemory != nullptr) {
+		unmap_memory(state);
+	}
 	vkDestroyBuffer(state.logical_device, m_buffer, state.allocation_callbacks);
 	vkFreeMemory(state.logical_device, m_deviceMemory, state.allocation_callbacks);
 }
@@ -661,16 +737,18 @@ void VulkanBuffer::copy_to_buffer(
 }
 
 void VulkanBuffer::copy_to_image(
-	VulkanCommandBuffer cmd, const VulkanBufferImageCopyConfig& dst_image_copy_config, u32 self_offset) const {
+	VulkanCommandBuffer cmd, const VulkanBufferImageCopyConfig& dst_image_copy_config, u64 self_offset) const {
 	VkBufferImageCopy buffer_image_copy{};
 	buffer_image_copy.bufferOffset					  = self_offset;
 	buffer_image_copy.bufferRowLength				  = 0;
 	buffer_image_copy.bufferImageHeight				  = 0;
 	buffer_image_copy.imageSubresource.aspectMask	  = VK_IMAGE_ASPECT_COLOR_BIT;
-	buffer_image_copy.imageSubresource.mipLevel		  = 0;
+	buffer_image_copy.imageSubresource.mipLevel		  = dst_image_copy_config.mip_level;
 	buffer_image_copy.imageSubresource.baseArrayLayer = 0;
 	buffer_image_copy.imageSubresource.layerCount	  = 1;
-	buffer_image_copy.imageOffset					  = VkOffset3D{ 0, 0, 0 };
+	buffer_image_copy.imageOffset.x					  = static_cast<i32>(dst_image_copy_config.x);
+	buffer_image_copy.imageOffset.y					  = static_cast<i32>(dst_image_copy_config.y);
+	buffer_image_copy.imageOffset.z					  = 0;
 	buffer_image_copy.imageExtent = VkExtent3D{ dst_image_copy_config.width, dst_image_copy_config.height, 1 };
 
 	vkCmdCopyBufferToImage(
@@ -682,20 +760,14 @@ VulkanTexture VulkanTexture::create(const TextureConfig& config, const VulkanSta
 
 	texture.m_metadata = config;
 
-	VkFormat format = VK_FORMAT_R8G8B8A8_SRGB;
-	switch (config.format) {
-		case ColorFormat::R8:
-			format = VK_FORMAT_R8_UNORM;
-			break;
-		case ColorFormat::RGBA8:
-			format = VK_FORMAT_R8G8B8A8_SRGB;
-			break;
-		case ColorFormat::DEPTH_STENCIL:
-			format = VK_FORMAT_D32_SFLOAT_S8_UINT;
-			break;
-		case ColorFormat::COLOR_FORMAT_COUNT:
-		case ColorFormat::NONE:
-			TK_UNREACHABLE();
+	TK_ASSERT(config.format != ColorFormat::NONE && config.format != ColorFormat::COLOR_FORMAT_COUNT);
+	VkFormat format = map_color_format(config.format);
+
+	if (get_block_format(config.format).has_value()) {
+		TK_ASSERT(state.supports_bc_textures, "Device does not support BC compressed textures");
+		TK_ASSERT(
+			!(config.flags & (TextureFlags::COLOR_ATTACHMENT | TextureFlags::DEPTH_STENCIL_ATTACHMENT)),
+			"Block compressed textures can't be rendered to");
 	}
 
 	VkImageCreateInfo image_create_info{};
@@ -704,7 +776,7 @@ VulkanTexture VulkanTexture::create(const TextureConfig& config, const VulkanSta
 	image_create_info.extent.width	= static_cast<uint32_t>(config.width);
 	image_create_info.extent.height = static_cast<uint32_t>(config.height);
 	image_create_info.extent.depth	= 1;
-	image_create_info.mipLevels		= 1;
+	image_create_info.mipLevels		= toki::max(config.mip_levels, 1u);
 	image_create_info.arrayLayers	= 1;
 	image_create_info.format		= format;
 	image_create_info.tiling		= VK_IMAGE_TILING_OPTIMAL;
@@ -726,13 +798,23 @@ VulkanTexture VulkanTexture::create(const TextureConfig& config, const VulkanSta
 	TK_ASSERT(result == VK_SUCCESS);
 
 	ImageViewConfig image_view_config{};
-	image_view_config.image	 = texture.m_image;
-	image_view_config.format = format;
-	texture.m_imageView		 = create_image_view(image_view_config, state);
+	image_view_config.image		 = texture.m_image;
+	image_view_config.format	 = format;
+	image_view_config.mip_levels = image_create_info.mipLevels;
+	texture.m_imageView			 = create_image_view(image_view_config, state);
 
 	return texture;
 }
 
+u64 VulkanTexture::data_size() const {
+	u64 size = 0;
+	for (u32 level = 0; level < toki::max(m_metadata.mip_levels, 1u); level++) {
+		size += get_image_size(
+			m_metadata.format, mip_dimension(m_metadata.width, level), mip_dimension(m_metadata.height, level));
+	}
+	return size;
+}
+
 void VulkanTexture::destroy(const VulkanState& state) {
 	vkDestroyImageView(state.logical_device, m_imageView, state.allocation_callbacks);
 	vkDestroyImage(state.logical_device, m_image, state.allocation_callbacks);
@@ -749,7 +831,7 @@ void VulkanTexture::transition_layout(VulkanCommandBuffer cmd, VkImageLayout old
 	barrier.image							= m_image;
 	barrier.subresourceRange.aspectMask		= VK_IMAGE_ASPECT_COLOR_BIT;
 	barrier.subresourceRange.baseMipLevel	= 0;
-	barrier.subresourceRange.levelCount		= 1;
+	barrier.subresourceRange.levelCount		= VK_REMAINING_MIP_LEVELS;
 	barrier.subresourceRange.baseArrayLayer = 0;
 	barrier.subresourceRange.layerCount		= 1;
 
@@ -767,6 +849,13 @@ void VulkanTexture::transition_layout(VulkanCommandBuffer cmd, VkImageLayout old
 		barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
 		src_stage			  = VK_PIPELINE_STAGE_TRANSFER_BIT;
 		dst_stage			  = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+	} else if (
+		old_layout == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL && new_layout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL) {
+		// Previous frames may still be sampling the texture
+		barrier.srcAccessMask = VK_ACCESS_SHADER_READ_BIT;
+		barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		src_stage			  = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+		dst_stage			  = VK_PIPELINE_STAGE_TRANSFER_BIT;
 	} else if (
 		old_layout == VK_IMAGE_LAYOUT_PRESENT_SRC_KHR && new_layout == VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL) {
 		barrier.srcAccessMask = 0;
@@ -813,7 +902,7 @@ VulkanSampler VulkanSampler::create(const SamplerConfig& config, const VulkanSta
 	VkSamplerCreateInfo sampler_create_info{};
 	sampler_create_info.sType					= VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
 	sampler_create_info.magFilter				= get_filter(config.mag_filter);
-	sampler_create_info.minFilter				= get_filter(config.mag_filter);
+	sampler_create_info.minFilter				= get_filter(config.min_filter);
 	sampler_create_info.addressModeU			= get_address_mode(config.address_mode_u);
 	sampler_create_info.addressModeV			= get_address_mode(config.address_mode_v);
 	sampler_create_info.addressModeW			= get_address_mode(config.address_mode_w);
@@ -822,7 +911,7 @@ VulkanSampler VulkanSampler::create(const SamplerConfig& config, const VulkanSta
 	sampler_create_info.mipmapMode				= VK_SAMPLER_MIPMAP_MODE_LINEAR;
 	sampler_create_info.mipLodBias				= 0.0f;
 	sampler_create_info.minLod					= 0.0f;
-	sampler_create_info.maxLod					= 0.0f;
+	sampler_create_info.maxLod					= VK_LOD_CLAMP_NONE;
 	sampler_create_info.borderColor				= VK_BORDER_COLOR_INT_OPAQUE_BLACK;
 	sampler_create_info.unnormalizedCoordinates = !config.use_normalized_coords;
 	sampler_create_info.anisotropyEnable		= VK_TRUE;
@@ -883,25 +972,74 @@ void VulkanStagingBuffer::set_data_for_buffer(
 
 void VulkanStagingBuffer::set_data_for_image(
 	const VulkanState& state, VulkanTexture& dst_texture, const void* data, u64 size) {
-	TK_ASSERT(data != nullptr && size != 0);
+	TK_ASSERT(data != nullptr && size != 0 && size <= dst_texture.data_size());
 
-	toki::memcpy(&reinterpret_cast<byte*>(m_mappedMemory)[m_offset], data, size);
+	u64 offset = reserve(size);
+	toki::memcpy(data_at(offset), data, size);
+	copy_to_image(state, dst_texture, offset);
+}
 
-	VulkanBufferImageCopyConfig dst_image_copy_config{};
-	dst_image_copy_config.image	 = dst_texture.image();
-	dst_image_copy_config.width	 = dst_texture.width();
-	dst_image_copy_config.height = dst_texture.height();
+void VulkanStagingBuffer::set_regions_for_image(
+	const VulkanState& state, VulkanTexture& dst_texture, const void* pixels, Span<TextureRegion> regions) {
+	TK_ASSERT(!get_block_format(dst_texture.format()).has_value() && dst_texture.mip_levels() <= 1);
 
-	{
-		VulkanCommandBuffer cmd = state.temporary_command_pool.begin_single_time_submit_command_buffer(state);
-		dst_texture.transition_layout(cmd, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
-		m_buffer.copy_to_image(cmd, dst_image_copy_config, m_offset);
-		dst_texture.transition_layout(
-			cmd, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-		state.temporary_command_pool.submit_single_time_submit_command_buffer(state, cmd);
+	const u64 texel_size = get_image_size(dst_texture.format(), 1, 1);
+	const u64 row_pitch	 = texel_size * dst_texture.width();
+
+	VulkanCommandBuffer cmd = state.temporary_command_pool.begin_single_time_submit_command_buffer(state);
+	dst_texture.transition_layout(cmd, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+
+	for (u32 i = 0; i < regions.size(); i++) {
+		const TextureRegion& region = regions[i];
+		TK_ASSERT(region.x + region.width <= dst_texture.width() && region.y + region.height <= dst_texture.height());
+
+		// Rows of the region are packed tightly, only they are staged instead of the whole level
+		const u64 region_pitch = texel_size * region.width;
+		u64 offset			   = reserve(region_pitch * region.height);
+		const byte* src		   = reinterpret_cast<const byte*>(pixels) + region.y * row_pitch + region.x * texel_size;
+		byte* dst			   = reinterpret_cast<byte*>(data_at(offset));
+		for (u32 row = 0; row < region.height; row++) {
+			toki::memcpy(dst + row * region_pitch, src + row * row_pitch, region_pitch);
+		}
+
+		VulkanBufferImageCopyConfig dst_image_copy_config{};
+		dst_image_copy_config.image	 = dst_texture.image();
+		dst_image_copy_config.width	 = region.width;
+		dst_image_copy_config.height = region.height;
+		dst_image_copy_config.x		 = region.x;
+		dst_image_copy_config.y		 = region.y;
+		m_buffer.copy_to_image(cmd, dst_image_copy_config, offset);
 	}
 
-	m_offset += size;
+	dst_texture.transition_layout(cmd, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+	state.temporary_command_pool.submit_single_time_submit_command_buffer(state, cmd);
+}
+
+u64 VulkanStagingBuffer::reserve(u64 size) {
+	// Image copies need offsets aligned to the texel or block size, 16 covers every format
+	u64 offset = (m_offset + 15) & ~static_cast<u64>(15);
+	TK_ASSERT(offset + size <= m_buffer.size(), "Staging buffer is full");
+	m_offset = offset + size;
+	return offset;
+}
+
+void VulkanStagingBuffer::copy_to_image(const VulkanState& state, VulkanTexture& dst_texture, u64 offset) {
+	VulkanCommandBuffer cmd = state.temporary_command_pool.begin_single_time_submit_command_buffer(state);
+	dst_texture.transition_layout(cmd, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+
+	for (u32 level = 0; level < toki::max(dst_texture.mip_levels(), 1u); level++) {
+		VulkanBufferImageCopyConfig dst_image_copy_config{};
+		dst_image_copy_config.image		= dst_texture.image();
+		dst_image_copy_config.width		= mip_dimension(dst_texture.width(), level);
+		dst_image_copy_config.height	= mip_dimension(dst_texture.height(), level);
+		dst_image_copy_config.mip_level = level;
+		m_buffer.copy_to_image(cmd, dst_image_copy_config, offset);
+
+		offset += get_image_size(dst_texture.format(), dst_image_copy_config.width, dst_image_copy_config.height);
+	}
+
+	dst_texture.transition_layout(cmd, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+	state.temporary_command_pool.submit_single_time_submit_command_buffer(state, cmd);
 }
 
 void VulkanStagingBuffer::reset() {
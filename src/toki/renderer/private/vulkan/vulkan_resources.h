@@ -4,6 +4,7 @@
 #include <vulkan/vulkan_core.h>
 
 #include "toki/core/string/span.h"
+#include "toki/renderer/errors.h"
 #include "toki/renderer/private/vulkan/vulkan_types.h"
 #include "toki/renderer/types.h"
 
@@ -82,14 +83,23 @@ private:
 struct VulkanShader {
 public:
 	static VulkanShader create(const ShaderConfig& config, const VulkanState& state);
+	// Same as create but returns an error instead of asserting when a stage fails to compile,
+	// used when shaders are reloaded while the application is running
+	static toki::Expected<VulkanShader, RendererErrors> try_create(
+		const ShaderConfig& config, const VulkanState& state);
 	void destroy(const VulkanState& state);
 
 	operator VkPipeline() const {
 		return m_pipeline;
 	}
 
+	u64 vertex_layout() const {
+		return m_vertexLayout;
+	}
+
 private:
 	VkPipeline m_pipeline;
+	u64 m_vertexLayout;
 };
 
 struct VulkanBufferConfig {
@@ -111,6 +121,10 @@ struct VulkanBufferImageCopyConfig {
 	VkImage image;
 	u32 width;
 	u32 height;
+	u32 mip_level;
+	// Texel offset of the copied region
+	u32 x;
+	u32 y;
 };
 
 struct VulkanBuffer {
@@ -128,7 +142,7 @@ public:
 	void copy_to_image(
 		VulkanCommandBuffer cmd,
 		const VulkanBufferImageCopyConfig& dst_buffer_copy_config = {},
-		u32 self_offset											  = 0) const;
+		u64 self_offset											  = 0) const;
 
 	operator VkBuffer() const {
 		return m_buffer;
@@ -146,11 +160,17 @@ public:
 		return m_size;
 	}
 
+	// Only dynamic buffers are mapped, for the whole lifetime of the buffer
+	void* mapped_memory() const {
+		return m_mappedMemory;
+	}
+
 private:
 	BufferType m_type;
 	VkBuffer m_buffer;
 	VkDeviceMemory m_deviceMemory;
 	u64 m_size;
+	void* m_mappedMemory;
 };
 
 struct VulkanTexture {
@@ -182,6 +202,17 @@ public:
 		return m_metadata.channels;
 	}
 
+	u32 mip_levels() const {
+		return m_metadata.mip_levels;
+	}
+
+	ColorFormat format() const {
+		return m_metadata.format;
+	}
+
+	// Bytes of every level, packed one after the other
+	u64 data_size() const;
+
 private:
 	VkImage m_image;
 	VkImageView m_imageView;
@@ -222,8 +253,19 @@ public:
 
 	void set_data_for_buffer(const VulkanState& state, VulkanBuffer& dst_buffer, const void* data, u64 size);
 	void set_data_for_image(const VulkanState& state, VulkanTexture& dst_texture, const void* data, u64 size);
+	// Copies the regions out of pixels, a whole level 0, into the texture which has to hold data already
+	void set_regions_for_image(
+		const VulkanState& state, VulkanTexture& dst_texture, const void* pixels, Span<TextureRegion> regions);
+	// Returns the offset of size bytes of mapped memory, valid until the next reset
+	u64 reserve(u64 size);
+	// Copies every level of the texture from the reserved memory at offset
+	void copy_to_image(const VulkanState& state, VulkanTexture& dst_texture, u64 offset);
 	void reset();
 
+	void* data_at(u64 offset) const {
+		return reinterpret_cast<byte*>(m_mappedMemory) + offset;
+	}
+
 private:
 	VulkanBuffer m_buffer;
 	u64 m_offset;
@@ -31,7 +31,7 @@ VkImageView create_image_view(const ImageViewConfig& config, const VulkanState&
 	image_view_create_info.components.b					   = VK_COMPONENT_SWIZZLE_IDENTITY;
 	image_view_create_info.components.a					   = VK_COMPONENT_SWIZZLE_IDENTITY;
 	image_view_create_info.subresourceRange.baseMipLevel   = 0;
-	image_view_create_info.subresourceRange.levelCount	   = 1;
+	image_view_create_info.subresourceRange.levelCount	   = config.mip_levels;
 	image_view_create_info.subresourceRange.baseArrayLayer = 0;
 	image_view_create_info.subresourceRange.layerCount	   = 1;
 
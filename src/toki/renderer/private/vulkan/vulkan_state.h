@@ -16,9 +16,12 @@ struct VulkanState {
 	VkQueue graphics_queue;
 	VkQueue present_queue;
 	VkPhysicalDeviceMemoryProperties physical_device_memory_properties;
+	b8 supports_bc_textures;
 
 	// Settings
 	VulkanSettings settings;
+	// Empty when caching is disabled
+	Path cache_directory;
 
 	// Swapchain
 	VulkanSwapchain swapchain;
@@ -38,6 +41,7 @@ struct VulkanState {
 	// Resources
 	VulkanDescriptorPool descriptor_pool;
 	VulkanStagingBuffer staging_buffer;
+	VkPipelineCache pipeline_cache;
 	PersistentArena<VulkanShaderLayout, 4> shader_layouts;
 	PersistentArena<VulkanShader, 16> shaders;
 	PersistentArena<VulkanBuffer, 16> buffers;
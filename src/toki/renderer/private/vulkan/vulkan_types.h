@@ -7,8 +7,6 @@
 
 namespace toki {
 
-constexpr const u32 MAX_FRAMES_IN_FLIGHT = 3;
-
 enum VsyncStatus : u8 {
 	VSYNC_STATUS_DISABLED = 0,
 	VSYNC_STATUS_ENABLED  = 1,
@@ -45,6 +43,7 @@ union PresentModes {
 struct ImageViewConfig {
 	VkImage image;
 	VkFormat format;
+	u32 mip_levels = 1;
 };
 
 struct MemoryAllocateConfig {
@@ -4,14 +4,23 @@
 
 namespace toki {
 
+// Color formats are sRGB encoded, single channel ones hold linear data like masks and glyphs
 VkFormat map_color_format(ColorFormat format) {
 	switch (format) {
 		case ColorFormat::R8:
 			return VK_FORMAT_R8_UNORM;
 		case ColorFormat::RGBA8:
-			return VK_FORMAT_R8G8B8A8_UNORM;
+			return VK_FORMAT_R8G8B8A8_SRGB;
 		case ColorFormat::DEPTH_STENCIL:
 			return VK_FORMAT_D32_SFLOAT_S8_UINT;
+		case ColorFormat::BC1_RGBA:
+			return VK_FORMAT_BC1_RGBA_SRGB_BLOCK;
+		case ColorFormat::BC3_RGBA:
+			return VK_FORMAT_BC3_SRGB_BLOCK;
+		case ColorFormat::BC4_R:
+			return VK_FORMAT_BC4_UNORM_BLOCK;
+		case ColorFormat::BC7_RGBA:
+			return VK_FORMAT_BC7_SRGB_BLOCK;
 		case ColorFormat::COLOR_FORMAT_COUNT:
 		case ColorFormat::NONE:
 			return VK_FORMAT_UNDEFINED;
@@ -21,6 +30,39 @@ VkFormat map_color_format(ColorFormat format) {
 	TK_UNREACHABLE();
 }
 
+Optional<BlockFormat> get_block_format(ColorFormat format) {
+	switch (format) {
+		case ColorFormat::BC1_RGBA:
+			return BlockFormat::BC1;
+		case ColorFormat::BC3_RGBA:
+			return BlockFormat::BC3;
+		case ColorFormat::BC4_R:
+			return BlockFormat::BC4;
+		case ColorFormat::BC7_RGBA:
+			return BlockFormat::BC7;
+		default:
+			return {};
+	}
+}
+
+u64 get_image_size(ColorFormat format, u32 width, u32 height) {
+	Optional<BlockFormat> block_format = get_block_format(format);
+	if (block_format.has_value()) {
+		return compressed_level_size(block_format.value(), width, height);
+	}
+
+	switch (format) {
+		case ColorFormat::R8:
+			return static_cast<u64>(width) * height;
+		case ColorFormat::RGBA8:
+			return static_cast<u64>(width) * height * 4;
+		default:
+			break;
+	}
+
+	TK_UNREACHABLE();
+}
+
 toki::Expected<TempDynamicArray<toki::byte>, RendererErrors> compile_shader(ShaderStageFlags stage, StringView source) {
 	shaderc_compiler_t compiler = shaderc_compiler_initialize();
 	TK_ASSERT(compiler != nullptr);
@@ -74,6 +116,98 @@ toki::Expected<TempDynamicArray<toki::byte>, RendererErrors> compile_shader(Shad
 	return compiled_data;
 }
 
+// Cached SPIR-V is stored as <cache directory>/shaders/<key>.spv, a ShaderCacheHeader followed
+// by the code
+static constexpr u32 SHADER_CACHE_MAGIC	  = 0x56505354;	 // "TSPV"
+static constexpr u32 SHADER_CACHE_VERSION = 1;
+
+struct ShaderCacheHeader {
+	u32 magic;
+	u32 version;
+	u64 key;
+	u64 source_size;
+	u64 spirv_size;
+};
+
+// Everything that changes the compiled code goes into the key. There are no defines passed to the
+// compiler, they are part of the source. A compiler update that keeps the SPIR-V version may use
+// code from the previous compiler, which is still valid.
+static u64 shader_cache_key(ShaderStageFlags stage, StringView source) {
+	u32 spirv_version  = 0;
+	u32 spirv_revision = 0;
+	shaderc_get_spv_version(&spirv_version, &spirv_revision);
+
+#if defined(TK_DIST)
+	constexpr u32 optimized = 1;
+#else
+	constexpr u32 optimized = 0;
+#endif
+
+	const u32 inputs[] = { SHADER_CACHE_VERSION, static_cast<u32>(stage), spirv_version, spirv_revision, optimized };
+	return toki::hash_bytes(source.data(), source.size(), toki::hash_bytes(inputs, sizeof(inputs)));
+}
+
+toki::Expected<TempDynamicArray<toki::byte>, RendererErrors> compile_shader_cached(
+	const VulkanState& state, ShaderStageFlags stage, StringView source) {
+	if (state.cache_directory.c_str()[0] == '\0') {
+		auto compiled = compile_shader(stage, source);
+		if (!compiled) {
+			return RendererErrors::ShaderCompileError;
+		}
+		return toki::move(compiled.value());
+	}
+
+	u64 key		  = shader_cache_key(stage, source);
+	String<> path = toki::format("{}/shaders/{}.spv", StringView(state.cache_directory.c_str()), key);
+
+	MappedFile cached;
+	if (cached.open(Path(StringView(path)), FileAccessHint::SEQUENTIAL) && cached.size() >= sizeof(ShaderCacheHeader)) {
+		const ShaderCacheHeader* header = reinterpret_cast<const ShaderCacheHeader*>(cached.data());
+		if (header->magic == SHADER_CACHE_MAGIC && header->version == SHADER_CACHE_VERSION && header->key == key &&
+			header->source_size == source.size() && header->spirv_size == cached.size() - sizeof(ShaderCacheHeader)) {
+			TempDynamicArray<toki::byte> spirv(header->spirv_size);
+			toki::memcpy(spirv.data(), cached.data() + sizeof(ShaderCacheHeader), header->spirv_size);
+			return spirv;
+		}
+	}
+
+	auto compiled = compile_shader(stage, source);
+	if (!compiled) {
+		return RendererErrors::ShaderCompileError;
+	}
+
+	ShaderCacheHeader header{};
+	header.magic	   = SHADER_CACHE_MAGIC;
+	header.version	   = SHADER_CACHE_VERSION;
+	header.key		   = key;
+	header.source_size = source.size();
+	header.spirv_size  = compiled.value().size();
+
+	// A write that fails only costs a compile on the next run
+	write_cache_file(Path(StringView(path)), &header, sizeof(header), compiled.value().data(), compiled.value().size());
+
+	return toki::move(compiled.value());
+}
+
+b8 write_cache_file(const Path& path, const void* header, u64 header_size, const void* data, u64 data_size) {
+	String<> temporary_string = toki::format("{}.tmp", StringView(path.c_str()));
+	Path temporary_path{ StringView(temporary_string) };
+	{
+		File file(temporary_path, FileMode::WRITE, FILE_FLAG_CREATE | FILE_FLAG_TRUNCATE);
+		if (!file.is_open() || file.write(header, header_size) != header_size ||
+			file.write(data, data_size) != data_size) {
+			TK_LOG_WARN("Could not write cache file {}", temporary_path.c_str());
+			return false;
+		}
+	}
+
+	if (toki::rename_file(temporary_path.c_str(), path.c_str()).has_value()) {
+		TK_LOG_WARN("Could not move cache file {} into place", temporary_path.c_str());
+		return false;
+	}
+	return true;
+}
+
 VkShaderModule create_shader_module(const VulkanState& state, Span<toki::byte> spirv) {
 	VkShaderModuleCreateInfo shader_module_create_info{};
 	shader_module_create_info.sType	   = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
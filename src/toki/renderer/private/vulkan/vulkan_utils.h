@@ -15,8 +15,17 @@ inline VkExtent2D convert_to<VkExtent2D>(const Vector2u32& vec) {
 }
 
 toki::Expected<TempDynamicArray<toki::byte>, RendererErrors> compile_shader(ShaderStageFlags stage, StringView source);
+// Looks the SPIR-V up in the shader cache first and stores what had to be compiled there
+toki::Expected<TempDynamicArray<toki::byte>, RendererErrors> compile_shader_cached(
+	const VulkanState& state, ShaderStageFlags stage, StringView source);
+// Writes header and data to a temporary file that is renamed over path once complete, a crash or
+// a failed write leaves the previous file in place instead of a truncated one
+b8 write_cache_file(const Path& path, const void* header, u64 header_size, const void* data, u64 data_size);
 VkShaderModule create_shader_module(const VulkanState& state, Span<toki::byte> spirv);
 
 VkFormat map_color_format(ColorFormat format);
+Optional<BlockFormat> get_block_format(ColorFormat format);
+// Bytes of one level of a sampled image in the layout buffer to image copies expect
+u64 get_image_size(ColorFormat format, u32 width, u32 height);
 
 }  // namespace toki
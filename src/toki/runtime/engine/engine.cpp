@@ -2,7 +2,7 @@
 
 namespace toki {
 
-Engine::Engine([[maybe_unused]] const EngineConfig& config): m_running(true) {
+Engine::Engine(const EngineConfig& config): m_config(config), m_running(true) {
 	TK_LOG_INFO("Initializing engine");
 
 	WindowConfig window_config{};
@@ -13,11 +13,22 @@ Engine::Engine([[maybe_unused]] const EngineConfig& config): m_running(true) {
 	m_window					 = toki::make_unique<Window>(window_config);
 
 	RendererConfig renderer_config{};
-	renderer_config.window = m_window.get();
-	m_renderer			   = Renderer::create(renderer_config);
+	renderer_config.window			= m_window.get();
+	renderer_config.cache_directory = m_config.cache_directory;
+	m_renderer						= Renderer::create(renderer_config);
 
 	SystemManagerConfig system_manager_config{};
 	m_systemManager = SystemManager::create(system_manager_config);
+
+	m_asyncIo		  = toki::make_unique<AsyncIo>();
+	m_resourceManager = toki::make_unique<ResourceManager>();
+
+	if (m_config.hot_reload) {
+		m_fileWatcher = toki::make_unique<FileWatcher>();
+		if (!m_fileWatcher->watch_directory(m_config.asset_directory)) {
+			m_fileWatcher.reset();
+		}
+	}
 }
 
 Engine::~Engine() {
@@ -27,55 +38,137 @@ Engine::~Engine() {
 void Engine::run() {
 	TK_LOG_INFO("Starting application");
 
-	Time now		   = Time::now();
-	Time previous_time = now;
-	while (m_running) {
-		m_window->pre_poll_events();
-		window_system_poll_events();
+	FramePipelineConfig pipeline_config{};
+	pipeline_config.threaded = m_config.threaded_rendering;
 
-		EventQueue& event_queue = m_window->get_event_queue();
-		for (Event& event : event_queue) {
-			if (event.type() == EventType::NONE) {
-				continue;
-			}
-			for (i32 i = static_cast<i32>(m_layers.size() - 1); i >= 0; i--) {
-				m_layers[static_cast<u32>(i)]->on_event(event);
-				if (event.handled()) {
-					break;
-				}
-			}
-		}
-		event_queue.clear();
+	auto pipeline = toki::make_unique<FramePipeline>(
+		pipeline_config,
+		[this](FrameSnapshot& snapshot) -> b8 {
+			return update_frame(snapshot);
+		},
+		[this](const FrameSnapshot& snapshot) {
+			render_frame(snapshot);
+		});
 
-		now			   = Time::now();
-		f64 delta_time = (now - previous_time).as<TimePrecision::Seconds>();
-		previous_time  = now;
+	m_previousTime = Time::now();
+	pipeline->run();
 
-		m_renderer->frame_prepare();
+	toki::println("Stopping application");
+}
 
-		for (i32 i = static_cast<i32>(m_layers.size() - 1); i >= 0; i--) {
-			m_layers[static_cast<u32>(i)]->on_update(delta_time);
-		}
+b8 Engine::update_frame(FrameSnapshot& snapshot) {
+	m_window->pre_poll_events();
+	window_system_poll_events();
 
+	EventQueue& event_queue = m_window->get_event_queue();
+	for (Event& event : event_queue) {
+		if (event.type() == EventType::NONE) {
+			continue;
+		}
 		for (i32 i = static_cast<i32>(m_layers.size() - 1); i >= 0; i--) {
-			m_layers[static_cast<u32>(i)]->on_render();
+			m_layers[static_cast<u32>(i)]->on_event(event);
+			if (event.handled()) {
+				break;
+			}
 		}
+	}
+	event_queue.clear();
 
-		m_renderer->present();
+	m_asyncIo->submit();
+	m_asyncIo->poll();
 
-		m_renderer->frame_cleanup();
+	if (m_fileWatcher.get() != nullptr) {
+		poll_changed_files();
 	}
 
-	toki::println("Stopping application");
+	Time now	   = Time::now();
+	f64 delta_time = (now - m_previousTime).as<TimePrecision::Seconds>();
+	m_previousTime = now;
+
+	snapshot.delta_time		   = static_cast<f32>(delta_time);
+	snapshot.window_dimensions = m_window->get_dimensions();
+
+	for (i32 i = static_cast<i32>(m_layers.size() - 1); i >= 0; i--) {
+		m_layers[static_cast<u32>(i)]->on_update(delta_time);
+	}
+
+	for (u32 i = 0; i < m_layers.size(); i++) {
+		snapshot.m_currentLayer = m_layers[i]->m_index;
+		m_layers[i]->on_snapshot(snapshot);
+	}
+
+	return m_running;
+}
+
+void Engine::render_frame(const FrameSnapshot& snapshot) {
+	if (m_fileWatcher.get() != nullptr) {
+		dispatch_changed_files();
+	}
+
+	m_renderer->frame_prepare();
+
+	for (i32 i = static_cast<i32>(m_layers.size() - 1); i >= 0; i--) {
+		Layer* layer	  = m_layers[static_cast<u32>(i)].get();
+		layer->m_snapshot = &snapshot;
+		layer->on_render();
+		layer->m_snapshot = nullptr;
+	}
+
+	m_renderer->present();
+
+	m_renderer->frame_cleanup();
+}
+
+void Engine::poll_changed_files() {
+	DynamicArray<Path> changed_files;
+	if (m_fileWatcher->poll(changed_files) == 0) {
+		return;
+	}
+
+	ScopedLock lock(m_changedFilesMutex);
+	for (u32 i = 0; i < changed_files.size(); i++) {
+		// Cached copies are dropped right away so loads from now on read the new file
+		m_resourceManager->invalidate(changed_files[i]);
+		m_changedFiles.emplace_back(toki::move(changed_files[i]));
+	}
+	changed_files.clear();
+}
+
+// Runs before the frame is recorded, so layers can replace the resources they use in it
+void Engine::dispatch_changed_files() {
+	DynamicArray<Path> changed_files;
+	{
+		ScopedLock lock(m_changedFilesMutex);
+		if (m_changedFiles.size() == 0) {
+			return;
+		}
+		changed_files.move(toki::move(m_changedFiles));
+	}
+
+	for (u32 i = 0; i < changed_files.size(); i++) {
+		TK_LOG_INFO("Reloading {}", changed_files[i].c_str());
+		for (u32 j = 0; j < m_layers.size(); j++) {
+			m_layers[j]->on_file_changed(changed_files[i]);
+		}
+	}
+	changed_files.clear();
 }
 
 void Engine::attach_layer(UniquePtr<Layer>&& layer) {
+	TK_ASSERT(m_layers.size() < FrameSnapshot::MAX_LAYERS);
+
 	layer->m_engine = this;
+	layer->m_index	= static_cast<u32>(m_layers.size());
 	layer->on_attach();
 	m_layers.emplace_back(toki::move(layer));
 }
 
 void Engine::cleanup() {
+	// Completion callbacks may still reference layers or renderer resources
+	m_asyncIo.reset();
+	m_fileWatcher.reset();
+	m_changedFiles.clear();
+	m_resourceManager.reset();
 	m_renderer.reset();
 	m_window.reset();
 }
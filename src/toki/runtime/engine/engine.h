@@ -2,13 +2,24 @@
 
 #include <toki/core/core.h>
 #include <toki/renderer/renderer.h>
+#include <toki/runtime/engine/frame_pipeline.h>
 #include <toki/runtime/engine/layer.h>
+#include <toki/runtime/resources/resource_manager.h>
 
 #include "toki/runtime/systems/system_manager.h"
 
 namespace toki {
 
-struct EngineConfig {};
+struct EngineConfig {
+	// Record and submit frame N on a render thread while the layers update frame N + 1,
+	// see Layer::on_snapshot and Layer::on_render for what layers have to do to support it
+	b8 threaded_rendering = false;
+	// Watch the asset directory and pass files that changed to Layer::on_file_changed
+	b8 hot_reload				= false;
+	const char* asset_directory = "assets";
+	// Compiled shaders and pipelines are kept here so later runs start faster, nullptr disables it
+	const char* cache_directory = "cache";
+};
 
 class Engine {
 public:
@@ -31,15 +42,38 @@ public:
 		return m_systemManager.get();
 	}
 
+	// Requests queued here are submitted and their callbacks run once per frame on the game thread
+	AsyncIo* async_io() const {
+		return m_asyncIo.get();
+	}
+
+	ResourceManager* resource_manager() const {
+		return m_resourceManager.get();
+	}
+
 private:
+	b8 update_frame(FrameSnapshot& snapshot);
+	void render_frame(const FrameSnapshot& snapshot);
+	void poll_changed_files();
+	void dispatch_changed_files();
 	void cleanup();
 
+	EngineConfig m_config{};
+
 	toki::UniquePtr<Renderer> m_renderer{};
 	toki::UniquePtr<Window> m_window{};
 	toki::UniquePtr<SystemManager> m_systemManager{};
+	toki::UniquePtr<AsyncIo> m_asyncIo{};
+	toki::UniquePtr<ResourceManager> m_resourceManager{};
+	toki::UniquePtr<FileWatcher> m_fileWatcher{};
 	toki::b32 m_running{};
+	Time m_previousTime{};
 
 	DynamicArray<UniquePtr<Layer>> m_layers;
+
+	// Found on the game thread and handed to the layers where they render
+	Mutex m_changedFilesMutex;
+	DynamicArray<Path> m_changedFiles;
 };
 
 }  // namespace toki
@@ -0,0 +1,129 @@
+#include "toki/runtime/engine/frame_pipeline.h"
+
+namespace toki {
+
+void FramePipeline::run() {
+	m_stats = {};
+	m_updateTimings.clear();
+	m_renderTimings.clear();
+
+	u64 start = get_current_time();
+
+	if (m_config.threaded) {
+		run_threaded();
+	} else {
+		run_serial();
+	}
+
+	m_stats.total_time = Time(get_current_time() - start).as<TimePrecision::Seconds>();
+	compute_overlap();
+}
+
+void FramePipeline::run_serial() {
+	for (u64 frame_index = 0;; frame_index++) {
+		FrameSnapshot& snapshot = m_snapshots.write_slot();
+		snapshot.reset(frame_index);
+
+		u64 update_start = get_current_time();
+		b8 keep_running	 = m_update(snapshot);
+		record_update(update_start, get_current_time());
+
+		if (!keep_running) {
+			break;
+		}
+
+		u64 render_start = get_current_time();
+		m_render(snapshot);
+		record_render(render_start, get_current_time());
+
+		m_stats.frame_count++;
+	}
+}
+
+void FramePipeline::run_threaded() {
+	atomic_store(&m_renderThreadRunning, 1);
+
+	Thread render_thread([this]() {
+		render_loop();
+	});
+
+	for (u64 frame_index = 0;; frame_index++) {
+		FrameSnapshot& snapshot = m_snapshots.write_slot();
+		snapshot.reset(frame_index);
+
+		u64 update_start = get_current_time();
+		b8 keep_running	 = m_update(snapshot);
+		record_update(update_start, get_current_time());
+
+		// Update may run at most one frame ahead of render, waiting here instead of
+		// overwriting the shared slot means no simulated frame is ever dropped
+		m_snapshots.wait_for_consumed();
+
+		if (!keep_running) {
+			break;
+		}
+
+		m_snapshots.publish();
+	}
+
+	// Wake the render thread up, it checks the running flag before rendering what it receives
+	atomic_store(&m_renderThreadRunning, 0);
+	m_snapshots.publish();
+	render_thread.join();
+}
+
+void FramePipeline::render_loop() {
+	while (true) {
+		m_snapshots.wait_for_published();
+		if (atomic_load(&m_renderThreadRunning) == 0) {
+			break;
+		}
+
+		m_snapshots.consume();
+
+		u64 render_start = get_current_time();
+		m_render(m_snapshots.read_slot());
+		record_render(render_start, get_current_time());
+
+		m_stats.frame_count++;
+	}
+}
+
+void FramePipeline::record_update(u64 start, u64 end) {
+	m_stats.update_time += Time(end - start).as<TimePrecision::Seconds>();
+	if (m_config.collect_timings) {
+		m_updateTimings.emplace_back(start, end);
+	}
+}
+
+void FramePipeline::record_render(u64 start, u64 end) {
+	m_stats.render_time += Time(end - start).as<TimePrecision::Seconds>();
+	if (m_config.collect_timings) {
+		m_renderTimings.emplace_back(start, end);
+	}
+}
+
+void FramePipeline::compute_overlap() {
+	// Both arrays are sorted and non overlapping within themselves since each is filled by a single thread
+	u64 overlap = 0;
+	for (u32 u = 0, r = 0; u < m_updateTimings.size() && r < m_renderTimings.size();) {
+		const TimeInterval& update = m_updateTimings[u];
+		const TimeInterval& render = m_renderTimings[r];
+
+		u64 start = toki::max(update.start, render.start);
+		u64 end	  = toki::min(update.end, render.end);
+		if (end > start) {
+			overlap += end - start;
+		}
+
+		if (update.end < render.end) {
+			u++;
+		} else {
+			r++;
+		}
+	}
+
+	m_stats.overlap_time = Time(overlap).as<TimePrecision::Seconds>();
+}
+
+}  // namespace toki
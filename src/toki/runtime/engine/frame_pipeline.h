@@ -0,0 +1,76 @@
+#pragma once
+
+#include <toki/core/core.h>
+#include <toki/core/platform/threads/triple_buffer.h>
+#include <toki/runtime/engine/frame_snapshot.h>
+
+namespace toki {
+
+struct FramePipelineConfig {
+	// Render frame N on a dedicated thread while update runs frame N + 1, otherwise
+	// update and render run one after another on the calling thread
+	b8 threaded = false;
+	// Keep per frame timestamps so overlap between update and render can be reported
+	b8 collect_timings = false;
+};
+
+// All times are in seconds
+struct FramePipelineStats {
+	u64 frame_count{};
+	f64 total_time{};
+	f64 update_time{};
+	f64 render_time{};
+	// Time in which update and render were running at the same time, requires collect_timings
+	f64 overlap_time{};
+};
+
+class FramePipeline {
+public:
+	using UpdateFunction = Function<b8(FrameSnapshot&)>;
+	using RenderFunction = Function<void(const FrameSnapshot&)>;
+
+	// Update fills in the snapshot for a frame and returns false to stop the pipeline,
+	// render consumes the snapshot
+	template <typename UpdateFn, typename RenderFn>
+	FramePipeline(const FramePipelineConfig& config, UpdateFn update, RenderFn render):
+		m_config(config),
+		m_update(update),
+		m_render(render) {}
+
+	DELETE_COPY(FramePipeline);
+	DELETE_MOVE(FramePipeline);
+
+	void run();
+
+	const FramePipelineStats& stats() const {
+		return m_stats;
+	}
+
+private:
+	struct TimeInterval {
+		u64 start;
+		u64 end;
+	};
+
+	void run_serial();
+	void run_threaded();
+	void render_loop();
+
+	void record_update(u64 start, u64 end);
+	void record_render(u64 start, u64 end);
+	void compute_overlap();
+
+private:
+	FramePipelineConfig m_config{};
+	UpdateFunction m_update;
+	RenderFunction m_render;
+
+	TripleBuffer<FrameSnapshot> m_snapshots;
+	i32 m_renderThreadRunning{};
+
+	FramePipelineStats m_stats{};
+	DynamicArray<TimeInterval> m_updateTimings;
+	DynamicArray<TimeInterval> m_renderTimings;
+};
+
+}  // namespace toki
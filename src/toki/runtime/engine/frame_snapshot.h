@@ -0,0 +1,65 @@
+#pragma once
+
+#include <toki/core/core.h>
+
+namespace toki {
+
+// Per frame state handed from the game thread to the render thread. Layers copy everything
+// their on_render needs into the snapshot in on_snapshot, so on_render never has to touch
+// state that on_update is already modifying for the next frame.
+class FrameSnapshot {
+	friend class Engine;
+	friend class FramePipeline;
+
+public:
+	static constexpr u32 MAX_LAYERS	 = 16;
+	static constexpr u64 DATA_SIZE	 = KB(64);
+	static constexpr u32 NO_DATA	 = U32_MAX;
+	static constexpr u64 DATA_ALIGN	 = 16;
+
+	// Reserves storage for the layer currently writing its snapshot, slots are reused between
+	// frames without running destructors so don't store anything that owns memory
+	template <typename T>
+		requires(alignof(T) <= DATA_ALIGN)
+	T* allocate() {
+		TK_ASSERT(m_currentLayer < MAX_LAYERS);
+		TK_ASSERT(m_layerOffsets[m_currentLayer] == NO_DATA, "Layer already allocated snapshot data this frame");
+
+		u64 offset = (m_used + DATA_ALIGN - 1) & ~(DATA_ALIGN - 1);
+		TK_ASSERT(offset + sizeof(T) <= DATA_SIZE, "Frame snapshot is out of space");
+
+		m_layerOffsets[m_currentLayer] = static_cast<u32>(offset);
+		m_used						   = offset + sizeof(T);
+		return construct_at<T>(&m_data[offset]);
+	}
+
+	template <typename T>
+	const T* get(u32 layer_index) const {
+		TK_ASSERT(layer_index < MAX_LAYERS);
+		if (m_layerOffsets[layer_index] == NO_DATA) {
+			return nullptr;
+		}
+		return reinterpret_cast<const T*>(&m_data[m_layerOffsets[layer_index]]);
+	}
+
+	void reset(u64 index) {
+		frame_index = index;
+		delta_time	= 0.0f;
+		m_used		= 0;
+		for (u32 i = 0; i < MAX_LAYERS; i++) {
+			m_layerOffsets[i] = NO_DATA;
+		}
+	}
+
+	u64 frame_index{};
+	f32 delta_time{};
+	Vector2u32 window_dimensions{};
+
+private:
+	u32 m_currentLayer{};
+	u32 m_layerOffsets[MAX_LAYERS]{};
+	u64 m_used{};
+	alignas(DATA_ALIGN) byte m_data[DATA_SIZE]{};
+};
+
+}  // namespace toki
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <toki/renderer/renderer.h>
+#include <toki/runtime/engine/frame_snapshot.h>
 
 namespace toki {
 
@@ -13,11 +14,28 @@ public:
 	virtual void on_attach() {}
 	virtual void on_detach() {}
 	virtual void on_update([[maybe_unused]] f32 delta_time) {}
+	// Called on the game thread right after on_update, store the state on_render reads
+	virtual void on_snapshot([[maybe_unused]] FrameSnapshot& snapshot) {}
+	// With EngineConfig::threaded_rendering this runs on the render thread, one frame behind
+	// on_update, so renderer calls belong here and layer state should be read from the snapshot
 	virtual void on_render() {}
 	virtual void on_event([[maybe_unused]] Event& event) {}
+	// A file in EngineConfig::asset_directory changed while hot reload is enabled. Called right
+	// before on_render on the same thread, so layers can rebuild the renderer resources made from it.
+	virtual void on_file_changed([[maybe_unused]] const Path& path) {}
 
 protected:
+	// Data this layer allocated in on_snapshot for the frame that is currently being rendered
+	template <typename T>
+	const T* snapshot_data() const {
+		return m_snapshot != nullptr ? m_snapshot->get<T>(m_index) : nullptr;
+	}
+
 	Engine* m_engine;
+
+private:
+	const FrameSnapshot* m_snapshot{};
+	u32 m_index{};
 };
 
 }  // namespace toki
@@ -22,6 +22,11 @@ const Matrix4& Camera::get_projection() const {
 	return m_projection;
 }
 
+const Matrix4& Camera::get_view_projection() {
+	recalculate_if_dirty();
+	return m_view_projection;
+}
+
 void Camera::set_position(const Vector3& position) {
 	m_position = position;
 	m_dirty	   = true;
@@ -62,6 +67,9 @@ void Camera::recalculate_if_dirty() {
 	direction.z		= sin(radians(m_rotation.y)) * cos(radians(m_rotation.x));
 	Vector3 forward = direction.normalize();
 	m_view			= look_at(m_position, m_position + forward, { 0.0f, 1.0f, 0.0f });
+
+	m_view_projection = m_projection * m_view;
+	m_dirty			  = false;
 }
 
 }  // namespace toki
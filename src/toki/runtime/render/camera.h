@@ -16,7 +16,8 @@ public:
 
 	const Matrix4& get_view();
 	const Matrix4& get_projection() const;
-	const Matrix4& get_view_projection() const;
+	// Projection times view, the matrix Frustum::from_matrix takes
+	const Matrix4& get_view_projection();
 
 	Vector3 forward() const;
 	Vector3 right() const;
@@ -27,6 +28,7 @@ public:
 private:
 	Matrix4 m_view{};
 	Matrix4 m_projection{};
+	Matrix4 m_view_projection{};
 	Vector3 m_position{};
 	Vector3 m_rotation{};
 	b8 m_dirty = true;
@@ -62,6 +62,19 @@ void FreeFlightCameraController::on_event(toki::Event& event) {
 	}
 }
 
+f32 FreeFlightCameraController::distance_to(const Aabb& bounds) const {
+	// Unknown bounds could be anywhere, treating them as close keeps the full detail
+	if (bounds.is_empty()) {
+		return 0.0f;
+	}
+
+	Vector3 closest(
+		toki::clamp(m_position.x, bounds.min.x, bounds.max.x),
+		toki::clamp(m_position.y, bounds.min.y, bounds.max.y),
+		toki::clamp(m_position.z, bounds.min.z, bounds.max.z));
+	return (closest - m_position).length();
+}
+
 const Vector3& FreeFlightCameraController::position() const {
 	return m_position;
 }
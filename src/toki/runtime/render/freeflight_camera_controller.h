@@ -12,6 +12,9 @@ public:
 	void on_event(toki::Event& event);
 
 	const Vector3& position() const;
+	// Distance from the camera to the closest point of bounds, 0 inside of them. What LOD selection
+	// goes by.
+	f32 distance_to(const Aabb& bounds) const;
 
 private:
 	Camera m_camera;
@@ -1,7 +1,35 @@
 #include <toki/runtime/render/geometry.h>
+#include <toki/runtime/resources/cooked_mesh.h>
 
 namespace toki {
 
+Geometry Geometry::from_cooked_mesh(const CookedMesh& mesh) {
+	TK_ASSERT(mesh.is_loaded());
+	TK_ASSERT(
+		mesh.header().vertex_format != CookedVertexFormat::QUANTIZED,
+		"Quantized cooked meshes need a pipeline with a matching vertex layout");
+
+	Geometry geometry{};
+	geometry.vertices		  = mesh.vertex_data();
+	geometry.vertex_data_size = static_cast<u32>(mesh.vertex_data_size());
+	geometry.indices		  = mesh.indices();
+	geometry.index_count	  = mesh.index_count();
+
+	const CookedMeshHeader& header = mesh.header();
+	geometry.bounds.min			   = Vector3(header.bounds_min[0], header.bounds_min[1], header.bounds_min[2]);
+	geometry.bounds.max			   = Vector3(header.bounds_max[0], header.bounds_max[1], header.bounds_max[2]);
+
+	geometry.lod_count = mesh.lod_count();
+	toki::memcpy(geometry.lods, mesh.lods(), mesh.lod_count() * sizeof(MeshLod));
+
+	if (header.vertex_format == CookedVertexFormat::PACKED) {
+		geometry.vertex_layout = vertex_layout_hash(PackedVertex::vertex_bindings, PackedVertex::vertex_attributes);
+	} else {
+		geometry.vertex_layout = vertex_layout_hash(Vertex::vertex_bindings, Vertex::vertex_attributes);
+	}
+	return geometry;
+}
+
 void Geometry::upload(toki::Renderer* renderer) {
 	{
 		BufferConfig buffer_config{};
@@ -15,11 +43,19 @@ void Geometry::upload(toki::Renderer* renderer) {
 	{
 		BufferConfig buffer_config{};
 		buffer_config.type = BufferType::INDEX;
-		buffer_config.size = indices.size() * sizeof(u32);
+		buffer_config.size = index_count * sizeof(u32);
 
 		index_buffer = renderer->create_buffer(buffer_config);
-		renderer->set_buffer_data(index_buffer, indices.data(), buffer_config.size);
+		renderer->set_buffer_data(index_buffer, indices, buffer_config.size);
 	}
+
+	if (owns_data) {
+		DefaultAllocator::free(const_cast<void*>(vertices));
+		DefaultAllocator::free(const_cast<u32*>(indices));
+		owns_data = false;
+	}
+	vertices = nullptr;
+	indices	 = nullptr;
 }
 
 void Geometry::free(toki::Renderer* renderer) {
@@ -27,10 +63,23 @@ void Geometry::free(toki::Renderer* renderer) {
 	renderer->destroy_handle(index_buffer);
 }
 
-void Geometry::draw(toki::Commands* cmd) {
+u32 Geometry::select_lod(f32 distance, f32 pixel_scale, f32 pixel_threshold) const {
+	return toki::select_lod(Span<MeshLod>(lods, lod_count), distance, pixel_scale, pixel_threshold);
+}
+
+void Geometry::draw(toki::Commands* cmd, u32 lod) {
+	TK_ASSERT(
+		vertex_layout == 0 || cmd->bound_vertex_layout() == vertex_layout,
+		"The bound shader reads another vertex layout than the geometry has");
 	cmd->bind_index_buffer(index_buffer);
 	cmd->bind_vertex_buffer(vertex_buffer);
-	cmd->draw_indexed(indices.size());
+	if (lod_count == 0) {
+		cmd->draw_indexed(index_count);
+		return;
+	}
+
+	TK_ASSERT(lod < lod_count);
+	cmd->draw_indexed(lods[lod].index_count, lods[lod].first_index);
 }
 
 }  // namespace toki
@@ -6,14 +6,37 @@
 
 namespace toki {
 
+class CookedMesh;
+
 struct Geometry {
-	void* vertices{};
+	const void* vertices{};
 	u32 vertex_data_size{};
-	toki::DynamicArray<u32> indices;
+	const u32* indices{};
+	u32 index_count{};
+	// Vertex and index data were allocated with DefaultAllocator and are freed once uploaded,
+	// otherwise they are borrowed and have to outlive the upload
+	b8 owns_data{};
+	// Bounds of the vertex positions in model space, empty when they are not known
+	Aabb bounds{};
+	// Ranges of the index data from the full mesh down, all of it is one LOD when lod_count is 0
+	MeshLod lods[MAX_MESH_LODS]{};
+	u32 lod_count{};
+	// vertex_layout_hash of the vertex data, draw asserts the bound shader reads the same layout.
+	// 0 skips the check.
+	u64 vertex_layout{};
+
+	// Points into the mapping of a cooked mesh so upload copies straight from the mapped pages
+	// into staging, the mesh has to stay loaded until upload returns. Packed meshes are drawn with
+	// a pipeline using PackedVertex::vertex_attributes.
+	static Geometry from_cooked_mesh(const CookedMesh& mesh);
 
 	void upload(toki::Renderer* renderer);
 	void free(toki::Renderer* renderer);
-	void draw(toki::Commands* cmd);
+	// The coarsest LOD that is off by at most pixel_threshold pixels at distance, pixel_scale
+	// comes from lod_pixel_scale
+	u32 select_lod(f32 distance, f32 pixel_scale, f32 pixel_threshold = 1.0f) const;
+
+	void draw(toki::Commands* cmd, u32 lod = 0);
 
 	BufferHandle vertex_buffer{};
 	BufferHandle index_buffer{};
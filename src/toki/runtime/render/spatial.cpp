@@ -0,0 +1,559 @@
+#include "toki/runtime/render/spatial.h"
+
+#include <toki/core/math/simd.h>
+
+namespace toki {
+
+// Subtrees per thread, more than one so threads that get mostly culled subtrees take more
+static constexpr u32 TASKS_PER_THREAD = 4;
+// Right children waiting to be visited, median splits keep the tree about log2 of the object
+// count deep so this is never close to full
+static constexpr u32 MAX_TRAVERSAL_DEPTH = 64;
+
+#if defined(TK_MATH_X86)
+struct PlaneLanes {
+	__m128 x, y, z, w;
+	__m128 abs_x, abs_y, abs_z;
+};
+#endif
+
+struct FrustumPlanes {
+	Frustum frustum;
+#if defined(TK_MATH_X86)
+	// The six planes padded with two that every box is inside of, as two groups for testing one
+	// box against four planes at a time
+	PlaneLanes grouped[2];
+	// Each plane in all lanes, for testing four boxes against one plane at a time
+	PlaneLanes single[Frustum::PLANE_COUNT];
+#endif
+};
+
+static FrustumPlanes make_frustum_planes(const Frustum& frustum) {
+	FrustumPlanes planes{};
+	planes.frustum = frustum;
+
+#if defined(TK_MATH_X86)
+	f32 x[8]{}, y[8]{}, z[8]{}, w[8]{};
+	for (u32 i = 0; i < 8; i++) {
+		if (i < Frustum::PLANE_COUNT) {
+			x[i] = frustum.planes[i].x;
+			y[i] = frustum.planes[i].y;
+			z[i] = frustum.planes[i].z;
+			w[i] = frustum.planes[i].w;
+		} else {
+			w[i] = 1.0f;
+		}
+	}
+
+	auto set_abs = [](PlaneLanes& lanes) {
+		__m128 sign_mask = _mm_set1_ps(-0.0f);
+		lanes.abs_x		 = _mm_andnot_ps(sign_mask, lanes.x);
+		lanes.abs_y		 = _mm_andnot_ps(sign_mask, lanes.y);
+		lanes.abs_z		 = _mm_andnot_ps(sign_mask, lanes.z);
+	};
+
+	for (u32 group = 0; group < 2; group++) {
+		PlaneLanes& lanes = planes.grouped[group];
+		lanes.x			  = _mm_loadu_ps(x + group * 4);
+		lanes.y			  = _mm_loadu_ps(y + group * 4);
+		lanes.z			  = _mm_loadu_ps(z + group * 4);
+		lanes.w			  = _mm_loadu_ps(w + group * 4);
+		set_abs(lanes);
+	}
+
+	for (u32 i = 0; i < Frustum::PLANE_COUNT; i++) {
+		PlaneLanes& lanes = planes.single[i];
+		lanes.x			  = _mm_set1_ps(x[i]);
+		lanes.y			  = _mm_set1_ps(y[i]);
+		lanes.z			  = _mm_set1_ps(z[i]);
+		lanes.w			  = _mm_set1_ps(w[i]);
+		set_abs(lanes);
+	}
+#endif
+
+	return planes;
+}
+
+#if defined(TK_MATH_X86)
+// Same test as Frustum::classify for each lane, accumulates the lanes where the box is behind
+// the plane and the ones where it crosses it
+static void test_lanes(
+	const PlaneLanes& plane,
+	__m128 center_x,
+	__m128 center_y,
+	__m128 center_z,
+	__m128 extent_x,
+	__m128 extent_y,
+	__m128 extent_z,
+	__m128& outside,
+	__m128& intersecting) {
+	__m128 distance = _mm_add_ps(
+		_mm_add_ps(_mm_mul_ps(plane.x, center_x), _mm_mul_ps(plane.y, center_y)),
+		_mm_add_ps(_mm_mul_ps(plane.z, center_z), plane.w));
+	__m128 radius = _mm_add_ps(
+		_mm_add_ps(_mm_mul_ps(plane.abs_x, extent_x), _mm_mul_ps(plane.abs_y, extent_y)),
+		_mm_mul_ps(plane.abs_z, extent_z));
+
+	outside		 = _mm_or_ps(outside, _mm_cmplt_ps(distance, _mm_sub_ps(_mm_setzero_ps(), radius)));
+	intersecting = _mm_or_ps(intersecting, _mm_cmplt_ps(distance, radius));
+}
+#endif
+
+static FrustumTest classify(const FrustumPlanes& planes, const Aabb& box) {
+#if defined(TK_MATH_X86)
+	Vector3 center = box.center();
+	Vector3 extent = box.extent();
+
+	__m128 outside		= _mm_setzero_ps();
+	__m128 intersecting = _mm_setzero_ps();
+	for (u32 group = 0; group < 2; group++) {
+		test_lanes(
+			planes.grouped[group],
+			_mm_set1_ps(center.x),
+			_mm_set1_ps(center.y),
+			_mm_set1_ps(center.z),
+			_mm_set1_ps(extent.x),
+			_mm_set1_ps(extent.y),
+			_mm_set1_ps(extent.z),
+			outside,
+			intersecting);
+	}
+
+	if (_mm_movemask_ps(outside) != 0) {
+		return FrustumTest::OUTSIDE;
+	}
+	return _mm_movemask_ps(intersecting) != 0 ? FrustumTest::INTERSECTING : FrustumTest::INSIDE;
+#else
+	return planes.frustum.classify(box);
+#endif
+}
+
+// Reorders objects so the one at nth has the nth smallest key, with smaller or equal keys before
+// it and larger or equal ones after it
+static void select_nth(u32* objects, u32 count, u32 nth, const f32* keys) {
+	i64 left  = 0;
+	i64 right = static_cast<i64>(count) - 1;
+	while (left < right) {
+		f32 pivot = keys[objects[left + (right - left) / 2]];
+		i64 i	  = left;
+		i64 j	  = right;
+		while (i <= j) {
+			while (keys[objects[i]] < pivot) {
+				i++;
+			}
+			while (keys[objects[j]] > pivot) {
+				j--;
+			}
+			if (i <= j) {
+				toki::swap(objects[i], objects[j]);
+				i++;
+				j--;
+			}
+		}
+
+		if (static_cast<i64>(nth) <= j) {
+			right = j;
+		} else if (static_cast<i64>(nth) >= i) {
+			left = i;
+		} else {
+			return;
+		}
+	}
+}
+
+static void signal(i32* value) {
+	atomic_fetch_add(value, 1);
+	atomic_notify_all(value);
+}
+
+Aabb compute_bounds(Span<Vertex> vertices) {
+	Aabb bounds{};
+	for (u64 i = 0; i < vertices.size(); i++) {
+		bounds.expand(vertices[i].position);
+	}
+	return bounds;
+}
+
+Aabb transform_bounds(const Aabb& bounds, const Matrix4& transform) {
+	if (bounds.is_empty()) {
+		return bounds;
+	}
+
+	Vector3 center = bounds.center();
+	Vector3 extent = bounds.extent();
+
+	auto transform_row = [&](u32 row, f32& center_out, f32& extent_out) {
+		center_out = transform[0 * 4 + row] * center.x + transform[1 * 4 + row] * center.y +
+					 transform[2 * 4 + row] * center.z + transform[3 * 4 + row];
+		extent_out = toki::abs(transform[0 * 4 + row]) * extent.x + toki::abs(transform[1 * 4 + row]) * extent.y +
+					 toki::abs(transform[2 * 4 + row]) * extent.z;
+	};
+
+	Vector3 new_center, new_extent;
+	transform_row(0, new_center.x, new_extent.x);
+	transform_row(1, new_center.y, new_extent.y);
+	transform_row(2, new_center.z, new_extent.z);
+	return Aabb{ new_center - new_extent, new_center + new_extent };
+}
+
+void Bvh::build(Span<Aabb> bounds) {
+	u32 count = static_cast<u32>(bounds.size());
+
+	m_nodes.clear();
+	m_nodes.reserve(count);
+	m_objects.resize(count);
+	m_slots.resize(count);
+	m_leaves.resize(count);
+	m_dirty = false;
+
+	DynamicArray<f32> centers[3];
+	for (u32 axis = 0; axis < 3; axis++) {
+		centers[axis].resize(count);
+		m_centers[axis].resize(count + 3);
+		m_extents[axis].resize(count + 3);
+	}
+
+	for (u32 i = 0; i < count; i++) {
+		TK_ASSERT(!bounds[i].is_empty(), "Objects in a hierarchy need bounds");
+		Vector3 center = bounds[i].center();
+		centers[0][i]  = center.x;
+		centers[1][i]  = center.y;
+		centers[2][i]  = center.z;
+		m_objects[i]   = i;
+	}
+
+	// Padding read by the last leaf, outside of the object count so never reported
+	for (u32 axis = 0; axis < 3; axis++) {
+		for (u32 i = count; i < count + 3; i++) {
+			m_centers[axis][i] = 0.0f;
+			m_extents[axis][i] = 0.0f;
+		}
+	}
+
+	if (count == 0) {
+		return;
+	}
+
+	const f32* const center_data[3] = { centers[0].data(), centers[1].data(), centers[2].data() };
+	build_node(bounds, center_data, 0, 0, count);
+}
+
+u32 Bvh::build_node(Span<Aabb> bounds, const f32* const centers[3], u32 parent, u32 first, u32 count) {
+	u32 index = static_cast<u32>(m_nodes.size());
+	m_nodes.push_back(Node{ Aabb{}, first, count, 0, parent, false });
+
+	if (count <= MAX_LEAF_OBJECTS) {
+		for (u32 slot = first; slot < first + count; slot++) {
+			u32 object		   = m_objects[slot];
+			Vector3 center	   = bounds[object].center();
+			Vector3 extent	   = bounds[object].extent();
+			m_slots[object]	   = slot;
+			m_leaves[object]   = index;
+			m_centers[0][slot] = center.x;
+			m_centers[1][slot] = center.y;
+			m_centers[2][slot] = center.z;
+			m_extents[0][slot] = extent.x;
+			m_extents[1][slot] = extent.y;
+			m_extents[2][slot] = extent.z;
+		}
+		m_nodes[index].bounds = leaf_bounds(m_nodes[index]);
+		return index;
+	}
+
+	// Median split along the axis the centers spread out the most on, keeps the tree balanced
+	// however the objects are placed
+	Aabb center_bounds{};
+	for (u32 slot = first; slot < first + count; slot++) {
+		u32 object = m_objects[slot];
+		center_bounds.expand(Vector3(centers[0][object], centers[1][object], centers[2][object]));
+	}
+	Vector3 size = center_bounds.max - center_bounds.min;
+	u32 axis	 = size.x >= size.y && size.x >= size.z ? 0 : (size.y >= size.z ? 1 : 2);
+	u32 half	 = count / 2;
+	select_nth(m_objects.data() + first, count, half, centers[axis]);
+
+	build_node(bounds, centers, index, first, half);
+	u32 right_child = build_node(bounds, centers, index, first + half, count - half);
+
+	Node& node		 = m_nodes[index];
+	node.right_child = right_child;
+	node.bounds		 = m_nodes[index + 1].bounds;
+	node.bounds.merge(m_nodes[right_child].bounds);
+	return index;
+}
+
+void Bvh::update(u32 object, const Aabb& bounds) {
+	TK_ASSERT(object < object_count());
+
+	TK_ASSERT(!bounds.is_empty(), "Objects in a hierarchy need bounds");
+
+	u32 slot		   = m_slots[object];
+	Vector3 center	   = bounds.center();
+	Vector3 extent	   = bounds.extent();
+	m_centers[0][slot] = center.x;
+	m_centers[1][slot] = center.y;
+	m_centers[2][slot] = center.z;
+	m_extents[0][slot] = extent.x;
+	m_extents[1][slot] = extent.y;
+	m_extents[2][slot] = extent.z;
+
+	// Stops at the first node that is already dirty, everything above it is as well
+	for (u32 index = m_leaves[object]; !m_nodes[index].dirty; index = m_nodes[index].parent) {
+		m_nodes[index].dirty = true;
+		if (index == 0) {
+			break;
+		}
+	}
+	m_dirty = true;
+}
+
+void Bvh::refit() {
+	if (!m_dirty) {
+		return;
+	}
+
+	// Children are stored after their parent, walking backwards finishes them first
+	for (u32 index = static_cast<u32>(m_nodes.size()); index-- > 0;) {
+		Node& node = m_nodes[index];
+		if (!node.dirty) {
+			continue;
+		}
+
+		if (node.right_child == 0) {
+			node.bounds = leaf_bounds(node);
+		} else {
+			node.bounds = m_nodes[index + 1].bounds;
+			node.bounds.merge(m_nodes[node.right_child].bounds);
+		}
+		node.dirty = false;
+	}
+	m_dirty = false;
+}
+
+void Bvh::cull(const Frustum& frustum, DynamicArray<u32>& visible_out) const {
+	TK_ASSERT(!m_dirty, "Refit the hierarchy after updating objects");
+	if (m_nodes.size() == 0) {
+		return;
+	}
+
+	cull_subtree(make_frustum_planes(frustum), 0, visible_out);
+}
+
+Aabb Bvh::leaf_bounds(const Node& node) const {
+	Aabb bounds{};
+	for (u32 slot = node.first_object; slot < node.first_object + node.object_count; slot++) {
+		Vector3 center(m_centers[0][slot], m_centers[1][slot], m_centers[2][slot]);
+		Vector3 extent(m_extents[0][slot], m_extents[1][slot], m_extents[2][slot]);
+		bounds.merge(Aabb{ center - extent, center + extent });
+	}
+	return bounds;
+}
+
+void Bvh::append_objects(const Node& node, DynamicArray<u32>& visible_out) const {
+	u64 size = visible_out.size();
+	if (size + node.object_count > visible_out.capacity()) {
+		visible_out.reserve(toki::max(visible_out.capacity() * 2, size + node.object_count));
+	}
+	visible_out.resize(size + node.object_count);
+	toki::memcpy(visible_out.data() + size, m_objects.data() + node.first_object, node.object_count * sizeof(u32));
+}
+
+void Bvh::cull_leaf(const FrustumPlanes& planes, const Node& node, DynamicArray<u32>& visible_out) const {
+	u32 end = node.first_object + node.object_count;
+
+#if defined(TK_MATH_X86)
+	// Leaves are at most four objects, one group of lanes
+	for (u32 slot = node.first_object; slot < end; slot += 4) {
+		__m128 center_x		= _mm_loadu_ps(m_centers[0].data() + slot);
+		__m128 center_y		= _mm_loadu_ps(m_centers[1].data() + slot);
+		__m128 center_z		= _mm_loadu_ps(m_centers[2].data() + slot);
+		__m128 extent_x		= _mm_loadu_ps(m_extents[0].data() + slot);
+		__m128 extent_y		= _mm_loadu_ps(m_extents[1].data() + slot);
+		__m128 extent_z		= _mm_loadu_ps(m_extents[2].data() + slot);
+		__m128 outside		= _mm_setzero_ps();
+		__m128 intersecting = _mm_setzero_ps();
+		for (u32 i = 0; i < Frustum::PLANE_COUNT; i++) {
+			test_lanes(
+				planes.single[i], center_x, center_y, center_z, extent_x, extent_y, extent_z, outside, intersecting);
+		}
+
+		u32 lane_count = toki::min(end - slot, 4u);
+		u32 visible	   = ~static_cast<u32>(_mm_movemask_ps(outside)) & ((1u << lane_count) - 1);
+		while (visible != 0) {
+			visible_out.push_back(m_objects[slot + static_cast<u32>(__builtin_ctz(visible))]);
+			visible &= visible - 1;
+		}
+	}
+#else
+	for (u32 slot = node.first_object; slot < end; slot++) {
+		Vector3 center(m_centers[0][slot], m_centers[1][slot], m_centers[2][slot]);
+		Vector3 extent(m_extents[0][slot], m_extents[1][slot], m_extents[2][slot]);
+		if (planes.frustum.intersects(Aabb{ center - extent, center + extent })) {
+			visible_out.push_back(m_objects[slot]);
+		}
+	}
+#endif
+}
+
+void Bvh::cull_subtree(const FrustumPlanes& planes, u32 root, DynamicArray<u32>& visible_out) const {
+	u32 stack[MAX_TRAVERSAL_DEPTH];
+	u32 stack_size = 0;
+	u32 index	   = root;
+	for (;;) {
+		const Node& node = m_nodes[index];
+		FrustumTest test = classify(planes, node.bounds);
+		if (test == FrustumTest::INSIDE) {
+			append_objects(node, visible_out);
+		} else if (test == FrustumTest::INTERSECTING) {
+			if (node.right_child == 0) {
+				cull_leaf(planes, node, visible_out);
+			} else {
+				TK_ASSERT(stack_size < MAX_TRAVERSAL_DEPTH);
+				stack[stack_size++] = node.right_child;
+				index++;
+				continue;
+			}
+		}
+
+		if (stack_size == 0) {
+			return;
+		}
+		index = stack[--stack_size];
+	}
+}
+
+Culler::Culler(const CullerConfig& config): m_config(config) {
+	atomic_store(&m_running, 1);
+
+	ThreadConfig thread_config{};
+	thread_config.name		 = "toki-culling";
+	thread_config.stack_size = KB(64);
+	for (u32 i = 0; i < m_config.worker_count; i++) {
+		m_workers.emplace_back(toki::make_unique<Thread>(thread_config, [this]() {
+			worker_loop();
+		}));
+	}
+}
+
+Culler::~Culler() {
+	atomic_store(&m_running, 0);
+	signal(&m_workSignal);
+	m_workers.clear();
+}
+
+void Culler::cull(const Bvh& bvh, const Frustum& frustum, DynamicArray<u32>& visible_out) {
+	visible_out.clear();
+	if (m_workers.size() == 0 || bvh.object_count() < m_config.parallel_threshold) {
+		bvh.cull(frustum, visible_out);
+		return;
+	}
+	TK_ASSERT(!bvh.m_dirty, "Refit the hierarchy after updating objects");
+
+	m_bvh	  = &bvh;
+	m_frustum = frustum;
+	split_tasks(make_frustum_planes(frustum));
+	while (m_taskResults.size() < m_tasks.size()) {
+		m_taskResults.emplace_back();
+	}
+
+	atomic_store(&m_nextTask, 0);
+	atomic_store(&m_busyWorkers, static_cast<i32>(m_workers.size()));
+	signal(&m_workSignal);
+	run_tasks();
+	for (i32 busy = atomic_load(&m_busyWorkers); busy != 0; busy = atomic_load(&m_busyWorkers)) {
+		atomic_wait(&m_busyWorkers, busy);
+	}
+
+	u64 total = 0;
+	for (u32 i = 0; i < m_tasks.size(); i++) {
+		total += m_taskResults[i].size();
+	}
+	visible_out.reserve(total);
+	for (u32 i = 0; i < m_tasks.size(); i++) {
+		const DynamicArray<u32>& results = m_taskResults[i];
+		u64 size						 = visible_out.size();
+		visible_out.resize(size + results.size());
+		toki::memcpy(visible_out.data() + size, results.data(), results.size() * sizeof(u32));
+	}
+}
+
+void Culler::split_tasks(const FrustumPlanes& planes) {
+	// Replaces intersecting nodes with their children one level at a time, which keeps the tasks
+	// in tree order. Culled nodes are dropped, leaves and nodes fully inside are tasks as they are.
+	u32 target = TASKS_PER_THREAD * (static_cast<u32>(m_workers.size()) + 1);
+	m_tasks.clear();
+	m_tasks.push_back(0);
+	while (m_tasks.size() < target) {
+		b8 changed = false;
+		m_scratch.clear();
+		for (u32 i = 0; i < m_tasks.size(); i++) {
+			const Bvh::Node& node = m_bvh->m_nodes[m_tasks[i]];
+			if (node.right_child == 0) {
+				m_scratch.push_back(m_tasks[i]);
+				continue;
+			}
+
+			FrustumTest test = classify(planes, node.bounds);
+			if (test == FrustumTest::INSIDE) {
+				m_scratch.push_back(m_tasks[i]);
+			} else if (test == FrustumTest::INTERSECTING) {
+				m_scratch.push_back(m_tasks[i] + 1);
+				m_scratch.push_back(node.right_child);
+				changed = true;
+			} else {
+				changed = true;
+			}
+		}
+
+		m_tasks.clear();
+		for (u32 i = 0; i < m_scratch.size(); i++) {
+			m_tasks.push_back(m_scratch[i]);
+		}
+		if (!changed) {
+			break;
+		}
+	}
+}
+
+void Culler::run_tasks() {
+	FrustumPlanes planes = make_frustum_planes(m_frustum);
+	i32 task_count		 = static_cast<i32>(m_tasks.size());
+	for (;;) {
+		i32 task = atomic_load(&m_nextTask);
+		if (task >= task_count) {
+			return;
+		}
+		if (!atomic_compare_exchange_strong(&m_nextTask, &task, task + 1)) {
+			continue;
+		}
+
+		DynamicArray<u32>& results = m_taskResults[static_cast<u32>(task)];
+		results.clear();
+		m_bvh->cull_subtree(planes, m_tasks[static_cast<u32>(task)], results);
+	}
+}
+
+void Culler::worker_loop() {
+	// Each signal is a cull the worker has to finish, cull waits for every worker before it
+	// returns so none can miss one
+	i32 handled_signal = 0;
+	for (;;) {
+		i32 signal_value = atomic_load(&m_workSignal);
+		if (signal_value == handled_signal) {
+			atomic_wait(&m_workSignal, signal_value);
+			continue;
+		}
+		handled_signal = signal_value;
+
+		if (atomic_load(&m_running) == 0) {
+			return;
+		}
+
+		run_tasks();
+		if (atomic_fetch_add(&m_busyWorkers, -1) == 1) {
+			atomic_notify_all(&m_busyWorkers);
+		}
+	}
+}
+
+}  // namespace toki
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <toki/core/core.h>
+#include <toki/runtime/render/types.h>
+
+namespace toki {
+
+// Bounds of the positions, for geometry built at runtime, cooked meshes store theirs
+Aabb compute_bounds(Span<Vertex> vertices);
+
+// Box around a transformed box, projects the extent onto each axis instead of transforming all
+// eight corners. Used to place the model space bounds of a Geometry in the world.
+Aabb transform_bounds(const Aabb& bounds, const Matrix4& transform);
+
+struct FrustumPlanes;
+
+// Bounding volume hierarchy over the world space boxes of scene objects. Moved objects update
+// their box and refit() grows or shrinks the nodes above them without changing the tree, it
+// stays correct but gets looser the further objects move from where they were at build time.
+class Bvh {
+public:
+	static constexpr u32 MAX_LEAF_OBJECTS = 4;
+
+	// Objects are the indices into bounds, none of the boxes can be empty
+	void build(Span<Aabb> bounds);
+	void update(u32 object, const Aabb& bounds);
+	// Recomputes the nodes above the objects updated since the last refit
+	void refit();
+
+	// Appends the objects whose boxes intersect the frustum, conservative like
+	// Frustum::intersects. Ordered by the tree, not by object index.
+	void cull(const Frustum& frustum, DynamicArray<u32>& visible_out) const;
+
+	u32 object_count() const {
+		return static_cast<u32>(m_objects.size());
+	}
+
+	u32 node_count() const {
+		return static_cast<u32>(m_nodes.size());
+	}
+
+private:
+	friend class Culler;
+
+	struct Node {
+		Aabb bounds;
+		// Objects below the node are m_objects[first_object, first_object + object_count)
+		u32 first_object;
+		u32 object_count;
+		// Nodes are stored depth first so the left child follows its parent, 0 for leaves
+		u32 right_child;
+		u32 parent;
+		b8 dirty;
+	};
+
+	u32 build_node(Span<Aabb> bounds, const f32* const centers[3], u32 parent, u32 first, u32 count);
+	Aabb leaf_bounds(const Node& node) const;
+	void append_objects(const Node& node, DynamicArray<u32>& visible_out) const;
+	void cull_leaf(const FrustumPlanes& planes, const Node& node, DynamicArray<u32>& visible_out) const;
+	void cull_subtree(const FrustumPlanes& planes, u32 root, DynamicArray<u32>& visible_out) const;
+
+	DynamicArray<Node> m_nodes;
+	// Object indices in leaf order
+	DynamicArray<u32> m_objects;
+	// Position in m_objects and the leaf of each object
+	DynamicArray<u32> m_slots;
+	DynamicArray<u32> m_leaves;
+	// Centers and extents of the object boxes in leaf order, an array per axis so leaves test
+	// four objects at once. Padded to a multiple of four.
+	DynamicArray<f32> m_centers[3];
+	DynamicArray<f32> m_extents[3];
+	b8 m_dirty{};
+};
+
+struct CullerConfig {
+	u32 worker_count = 3;
+	// Smaller hierarchies are culled on the calling thread, waking the workers costs more than
+	// they would save
+	u32 parallel_threshold = 16384;
+};
+
+// Culls large hierarchies on worker threads together with the calling thread. The top of the
+// tree is culled first and what is left of it is split into subtrees the threads claim one at a
+// time, the results are the same as Bvh::cull and in the same order.
+class Culler {
+public:
+	Culler(const CullerConfig& config = {});
+	~Culler();
+
+	DELETE_COPY(Culler)
+	DELETE_MOVE(Culler)
+
+	// Replaces the contents of visible_out
+	void cull(const Bvh& bvh, const Frustum& frustum, DynamicArray<u32>& visible_out);
+
+private:
+	void split_tasks(const FrustumPlanes& planes);
+	void run_tasks();
+	void worker_loop();
+
+	CullerConfig m_config{};
+
+	// Set by cull before the workers are signaled and only read while they run
+	const Bvh* m_bvh{};
+	Frustum m_frustum{};
+	// Subtree roots, each task writes to its own results so they can be joined in tree order
+	DynamicArray<u32> m_tasks;
+	DynamicArray<u32> m_scratch;
+	DynamicArray<DynamicArray<u32>> m_taskResults;
+
+	DynamicArray<UniquePtr<Thread>> m_workers;
+	i32 m_nextTask{};
+	i32 m_busyWorkers{};
+	i32 m_workSignal{};
+	i32 m_running{};
+};
+
+}  // namespace toki
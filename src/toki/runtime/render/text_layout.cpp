@@ -0,0 +1,104 @@
+#include "toki/runtime/render/text_layout.h"
+
+namespace toki {
+
+void layout_glyphs(GlyphSource& source, StringView text, f32 line_height, f32 wrap_width, TextLayout& layout_out) {
+	DynamicArray<PositionedGlyph>& glyphs = layout_out.glyphs;
+	glyphs.clear();
+
+	f32 pen_x	   = 0;
+	f32 baseline   = 0;
+	u32 line_count = 1;
+	u64 line_start = 0;
+	i32 previous   = -1;
+
+	// Glyphs from break_glyph on are the word after the last space of the line, they move to the
+	// next line together once the word does not fit
+	b8 has_break	= false;
+	u64 break_glyph = 0;
+	f32 break_x		= 0;
+
+	for (u64 offset = 0; offset < text.size();) {
+		u32 code_point = utf8_decode(text, offset);
+		if (code_point == '\n') {
+			baseline += line_height;
+			line_count++;
+			pen_x	   = 0;
+			line_start = glyphs.size();
+			previous   = -1;
+			has_break  = false;
+			continue;
+		}
+
+		LayoutGlyph glyph = source.glyph(code_point);
+		if (previous >= 0) {
+			pen_x += source.kerning(previous, glyph.glyph_index);
+		}
+		previous = glyph.glyph_index;
+
+		if (code_point == ' ') {
+			pen_x += glyph.xadvance;
+			has_break	= true;
+			break_glyph = glyphs.size();
+			break_x		= pen_x;
+			continue;
+		}
+
+		if (glyph.width > 0) {
+			f32 x0 = pen_x + glyph.xoffset;
+			f32 x1 = x0 + glyph.width;
+
+			if (wrap_width > 0 && x1 > wrap_width) {
+				b8 wrapped = false;
+				if (has_break && break_glyph > line_start) {
+					for (u64 i = break_glyph; i < glyphs.size(); i++) {
+						glyphs[i].x0 -= break_x;
+						glyphs[i].x1 -= break_x;
+						glyphs[i].y0 -= line_height;
+						glyphs[i].y1 -= line_height;
+					}
+					pen_x -= break_x;
+					x0 -= break_x;
+					x1 -= break_x;
+					line_start = break_glyph;
+					wrapped	   = true;
+				} else if (glyphs.size() > line_start) {
+					// No space to break at, the word is wider than the line
+					pen_x	   = 0;
+					x0		   = glyph.xoffset;
+					x1		   = x0 + glyph.width;
+					line_start = glyphs.size();
+					wrapped	   = true;
+				}
+
+				if (wrapped) {
+					baseline += line_height;
+					line_count++;
+					has_break = false;
+				}
+			}
+
+			PositionedGlyph positioned{};
+			positioned.x0 = x0;
+			positioned.x1 = x1;
+			positioned.y0 = -(baseline + glyph.yoffset);
+			positioned.y1 = positioned.y0 - glyph.height;
+			positioned.u0 = glyph.u0;
+			positioned.v0 = glyph.v0;
+			positioned.u1 = glyph.u1;
+			positioned.v1 = glyph.v1;
+			glyphs.push_back(positioned);
+		}
+
+		pen_x += glyph.xadvance;
+	}
+
+	layout_out.width = 0;
+	for (u64 i = 0; i < glyphs.size(); i++) {
+		layout_out.width = toki::max(layout_out.width, glyphs[i].x1);
+	}
+	layout_out.line_count = text.size() > 0 ? line_count : 0;
+	layout_out.height	  = layout_out.line_count * line_height;
+}
+
+}  // namespace toki
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <toki/core/core.h>
+
+namespace toki {
+
+struct TextLayoutConfig {
+	// Pixel height of the text
+	f32 size;
+	// Lines are wrapped at spaces to stay narrower than this, words wider than a whole line are
+	// wrapped between glyphs. Zero only breaks lines at newlines.
+	f32 wrap_width = 0;
+};
+
+// Glyph quad relative to the start of the baseline of the first line, y grows upwards
+struct PositionedGlyph {
+	f32 x0, y0, x1, y1;
+	f32 u0, v0, u1, v1;
+};
+
+// Text shaped once, drawing it again only offsets the quads. Stays valid as long as the font is
+// loaded since glyphs never move in the atlas.
+struct TextLayout {
+	DynamicArray<PositionedGlyph> glyphs;
+	f32 width{};
+	f32 height{};
+	u32 line_count{};
+};
+
+// Glyph metrics already scaled to the size of the layout, y grows downwards from the baseline
+struct LayoutGlyph {
+	// Passed back to GlyphSource::kerning
+	i32 glyph_index;
+	// Quad relative to the pen, zero width for glyphs without an outline like spaces
+	f32 xoffset, yoffset, width, height;
+	f32 xadvance;
+	f32 u0, v0, u1, v1;
+};
+
+// Where layout_glyphs gets glyphs from, the font system looks them up in a font
+class GlyphSource {
+public:
+	virtual ~GlyphSource() = default;
+
+	virtual LayoutGlyph glyph(u32 code_point) = 0;
+	// Pixels added between two glyphs, already scaled like the glyphs
+	virtual f32 kerning(i32 previous_glyph_index, i32 glyph_index) = 0;
+};
+
+// Positions the glyphs of UTF-8 text line by line. Words move to the next line once they reach
+// past wrap_width, words wider than a whole line are broken between glyphs.
+void layout_glyphs(GlyphSource& source, StringView text, f32 line_height, f32 wrap_width, TextLayout& layout_out);
+
+}  // namespace toki
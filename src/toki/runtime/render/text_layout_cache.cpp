@@ -0,0 +1,161 @@
+#include "toki/runtime/render/text_layout_cache.h"
+
+namespace toki {
+
+static constexpr u32 INITIAL_BUCKET_COUNT = 64;
+
+struct TextLayoutCacheEntry {
+	u64 key{};
+	// Tells apart layouts of the same text in different fonts
+	u64 font_id{};
+	TextLayoutConfig config{};
+	DynamicArray<char> text;
+	TextLayout layout;
+
+	TextLayoutCacheEntry* bucket_next{};
+	TextLayoutCacheEntry* lru_previous{};
+	TextLayoutCacheEntry* lru_next{};
+};
+
+static u64 layout_key(u64 font_id, StringView text, const TextLayoutConfig& config) {
+	u64 seed = toki::hash_fnv1a(reinterpret_cast<const char*>(&font_id), sizeof(font_id));
+	seed	 = toki::hash_fnv1a(reinterpret_cast<const char*>(&config.size), sizeof(config.size), seed);
+	seed	 = toki::hash_fnv1a(reinterpret_cast<const char*>(&config.wrap_width), sizeof(config.wrap_width), seed);
+	return toki::hash_bytes(text.data(), text.size(), seed);
+}
+
+static void destroy_entry(TextLayoutCacheEntry* entry) {
+	toki::destroy_at(entry);
+	DefaultAllocator::free_aligned(entry);
+}
+
+TextLayoutCache::TextLayoutCache(const TextLayoutCacheConfig& config):
+	m_config(config),
+	m_buckets(INITIAL_BUCKET_COUNT, nullptr) {}
+
+TextLayoutCache::~TextLayoutCache() {
+	clear();
+}
+
+TextLayout* TextLayoutCache::find(u64 font_id, StringView text, const TextLayoutConfig& config) {
+	TextLayoutCacheEntry* entry = find_entry(layout_key(font_id, text, config), font_id, text, config);
+	if (entry == nullptr) {
+		m_missCount++;
+		return nullptr;
+	}
+
+	m_hitCount++;
+	lru_remove(entry);
+	lru_push(entry);
+	return &entry->layout;
+}
+
+TextLayout& TextLayoutCache::insert(u64 font_id, StringView text, const TextLayoutConfig& config) {
+	TextLayoutCacheEntry* entry = toki::construct_at<TextLayoutCacheEntry>(
+		DefaultAllocator::allocate_aligned(sizeof(TextLayoutCacheEntry), alignof(TextLayoutCacheEntry)));
+	entry->key	   = layout_key(font_id, text, config);
+	entry->font_id = font_id;
+	entry->config  = config;
+	entry->text.resize(text.size());
+	toki::memcpy(entry->text.data(), text.data(), text.size());
+
+	insert_entry(entry);
+	lru_push(entry);
+	return entry->layout;
+}
+
+void TextLayoutCache::finish_insert() {
+	m_glyphCount += m_lruTail->layout.glyphs.size();
+
+	// The new entry is the most recently used one, so it is never evicted right away
+	evict_over_budget();
+}
+
+void TextLayoutCache::clear() {
+	while (m_lruHead != nullptr) {
+		remove(m_lruHead);
+	}
+}
+
+TextLayoutCacheEntry* TextLayoutCache::find_entry(
+	u64 key, u64 font_id, StringView text, const TextLayoutConfig& config) const {
+	TextLayoutCacheEntry* entry = m_buckets[key & (m_buckets.size() - 1)];
+	while (entry != nullptr) {
+		if (entry->key == key && entry->font_id == font_id && entry->config.size == config.size &&
+			entry->config.wrap_width == config.wrap_width && entry->text.size() == text.size() &&
+			toki::strncmp(entry->text.data(), text.data(), static_cast<u32>(text.size())) == 0) {
+			return entry;
+		}
+		entry = entry->bucket_next;
+	}
+	return nullptr;
+}
+
+void TextLayoutCache::insert_entry(TextLayoutCacheEntry* entry) {
+	if (m_entryCount >= m_buckets.size()) {
+		DynamicArray<TextLayoutCacheEntry*> buckets(m_buckets.size() * 2, nullptr);
+		for (u32 i = 0; i < m_buckets.size(); i++) {
+			TextLayoutCacheEntry* current = m_buckets[i];
+			while (current != nullptr) {
+				TextLayoutCacheEntry* next = current->bucket_next;
+				u64 bucket				   = current->key & (buckets.size() - 1);
+				current->bucket_next	   = buckets[bucket];
+				buckets[bucket]			   = current;
+				current					   = next;
+			}
+		}
+		m_buckets = toki::move(buckets);
+	}
+
+	u64 bucket		   = entry->key & (m_buckets.size() - 1);
+	entry->bucket_next = m_buckets[bucket];
+	m_buckets[bucket]  = entry;
+	m_entryCount++;
+}
+
+void TextLayoutCache::remove(TextLayoutCacheEntry* entry) {
+	TextLayoutCacheEntry** link = &m_buckets[entry->key & (m_buckets.size() - 1)];
+	while (*link != entry) {
+		link = &(*link)->bucket_next;
+	}
+	*link = entry->bucket_next;
+	m_entryCount--;
+
+	lru_remove(entry);
+	m_glyphCount -= entry->layout.glyphs.size();
+	destroy_entry(entry);
+}
+
+void TextLayoutCache::evict_over_budget() {
+	while (m_glyphCount > m_config.glyph_budget && m_lruHead != m_lruTail) {
+		remove(m_lruHead);
+	}
+}
+
+void TextLayoutCache::lru_push(TextLayoutCacheEntry* entry) {
+	entry->lru_previous = m_lruTail;
+	entry->lru_next		= nullptr;
+	if (m_lruTail != nullptr) {
+		m_lruTail->lru_next = entry;
+	} else {
+		m_lruHead = entry;
+	}
+	m_lruTail = entry;
+}
+
+void TextLayoutCache::lru_remove(TextLayoutCacheEntry* entry) {
+	if (entry->lru_previous != nullptr) {
+		entry->lru_previous->lru_next = entry->lru_next;
+	} else {
+		m_lruHead = entry->lru_next;
+	}
+	if (entry->lru_next != nullptr) {
+		entry->lru_next->lru_previous = entry->lru_previous;
+	} else {
+		m_lruTail = entry->lru_previous;
+	}
+	entry->lru_previous = nullptr;
+	entry->lru_next		= nullptr;
+}
+
+}  // namespace toki
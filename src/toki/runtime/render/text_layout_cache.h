@@ -0,0 +1,88 @@
+#pragma once
+
+#include <toki/core/core.h>
+#include <toki/runtime/render/text_layout.h>
+
+namespace toki {
+
+struct TextLayoutCacheConfig {
+	// Glyphs of every cached layout allowed before the least recently used layouts are dropped
+	u32 glyph_budget = 1 << 16;
+};
+
+struct TextLayoutCacheEntry;
+
+// Layouts of recently drawn text keyed by font, size, wrap width and the text itself. Text
+// drawn every frame is only shaped again once it changes.
+class TextLayoutCache {
+public:
+	TextLayoutCache(const TextLayoutCacheConfig& config = {});
+	~TextLayoutCache();
+
+	DELETE_COPY(TextLayoutCache)
+	DELETE_MOVE(TextLayoutCache)
+
+	// Returns the cached layout of the text or lays it out with layout(TextLayout& layout_out).
+	// font_id tells apart layouts of the same text in different fonts. The layout stays valid
+	// until the next call.
+	template <typename LayoutFunction>
+	const TextLayout& get(u64 font_id, StringView text, const TextLayoutConfig& config, LayoutFunction&& layout) {
+		TextLayout* cached = find(font_id, text, config);
+		if (cached != nullptr) {
+			return *cached;
+		}
+
+		TextLayout& layout_out = insert(font_id, text, config);
+		layout(layout_out);
+		finish_insert();
+		return layout_out;
+	}
+
+	void clear();
+
+	u32 entry_count() const {
+		return m_entryCount;
+	}
+
+	u64 glyph_count() const {
+		return m_glyphCount;
+	}
+
+	u64 hit_count() const {
+		return m_hitCount;
+	}
+
+	u64 miss_count() const {
+		return m_missCount;
+	}
+
+private:
+	// Counts a hit and marks the layout most recently used, or counts a miss and returns nullptr
+	TextLayout* find(u64 font_id, StringView text, const TextLayoutConfig& config);
+	// Adds an empty layout for the text, finish_insert accounts for its glyphs once it is filled
+	TextLayout& insert(u64 font_id, StringView text, const TextLayoutConfig& config);
+	void finish_insert();
+
+	TextLayoutCacheEntry* find_entry(u64 key, u64 font_id, StringView text, const TextLayoutConfig& config) const;
+	void insert_entry(TextLayoutCacheEntry* entry);
+	void remove(TextLayoutCacheEntry* entry);
+	void evict_over_budget();
+
+	void lru_push(TextLayoutCacheEntry* entry);
+	void lru_remove(TextLayoutCacheEntry* entry);
+
+	TextLayoutCacheConfig m_config{};
+
+	DynamicArray<TextLayoutCacheEntry*> m_buckets;
+	u32 m_entryCount{};
+	u64 m_glyphCount{};
+
+	// The head is the least recently used layout
+	TextLayoutCacheEntry* m_lruHead{};
+	TextLayoutCacheEntry* m_lruTail{};
+
+	u64 m_hitCount{};
+	u64 m_missCount{};
+};
+
+}  // namespace toki
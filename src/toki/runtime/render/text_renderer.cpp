@@ -0,0 +1,98 @@
+#include "toki/runtime/render/text_renderer.h"
+
+namespace toki {
+
+void TextRenderer::create(const TextRendererConfig& config) {
+	TK_ASSERT(config.max_glyphs > 0);
+
+	m_renderer	  = config.renderer;
+	m_fontSystem  = config.font_system;
+	m_fontName	  = config.font_name;
+	m_maxGlyphs	  = config.max_glyphs;
+	m_frame		  = MAX_FRAMES_IN_FLIGHT - 1;
+	m_glyphCount  = 0;
+	m_layoutCache = toki::make_unique<TextLayoutCache>(config.layout_cache_config);
+
+	{
+		BufferConfig buffer_config{};
+		buffer_config.type	= BufferType::VERTEX;
+		buffer_config.usage = BufferUsage::DYNAMIC;
+		buffer_config.size	= sizeof(FontVertex) * 4 * static_cast<u64>(m_maxGlyphs) * MAX_FRAMES_IN_FLIGHT;
+
+		m_vertexBuffer = m_renderer->create_buffer(buffer_config);
+		m_vertices	   = reinterpret_cast<FontVertex*>(m_renderer->get_mapped_buffer(m_vertexBuffer));
+	}
+
+	// Every quad has the same two triangles, so the indices are written once for the most quads
+	// a frame can hold and regions only differ in where the vertex buffer is bound
+	{
+		DynamicArray<u32> indices(static_cast<u64>(m_maxGlyphs) * 6);
+		for (u32 i = 0; i < m_maxGlyphs; i++) {
+			u32* quad = indices.data() + static_cast<u64>(i) * 6;
+			quad[0]	  = i * 4 + 0;
+			quad[1]	  = i * 4 + 1;
+			quad[2]	  = i * 4 + 2;
+			quad[3]	  = i * 4 + 2;
+			quad[4]	  = i * 4 + 1;
+			quad[5]	  = i * 4 + 3;
+		}
+
+		BufferConfig buffer_config{};
+		buffer_config.type = BufferType::INDEX;
+		buffer_config.size = indices.size() * sizeof(u32);
+
+		m_indexBuffer = m_renderer->create_buffer(buffer_config);
+		m_renderer->set_buffer_data(m_indexBuffer, indices.data(), static_cast<u32>(buffer_config.size));
+	}
+}
+
+void TextRenderer::destroy() {
+	m_renderer->destroy_handle(m_vertexBuffer);
+	m_renderer->destroy_handle(m_indexBuffer);
+	m_vertices = nullptr;
+	m_layoutCache.reset();
+}
+
+void TextRenderer::begin_frame() {
+	m_frame		 = (m_frame + 1) % MAX_FRAMES_IN_FLIGHT;
+	m_glyphCount = 0;
+	m_warnedFull = false;
+
+	// Looked up once per frame instead of once per text, fonts added since may have moved it
+	m_font = &m_fontSystem->get_mutable_font(m_fontName);
+}
+
+void TextRenderer::add_text(StringView text, Vector2 origin, f32 size, f32 wrap_width) {
+	TK_ASSERT(m_font != nullptr, "begin_frame has to be called before adding text");
+
+	TextLayoutConfig config{ size, wrap_width };
+	// The atlas is unique per font and stays put while fonts move around in the font map
+	u64 font_id				 = m_font->atlas_handle.m_value;
+	const TextLayout& layout = m_layoutCache->get(font_id, text, config, [&](TextLayout& layout_out) {
+		m_fontSystem->layout_text(*m_font, text, config, layout_out);
+	});
+
+	FontVertex* region = m_vertices + static_cast<u64>(m_frame) * m_maxGlyphs * 4;
+	m_glyphCount += FontSystem::write_quads(
+		layout, origin, region + static_cast<u64>(m_glyphCount) * 4, m_maxGlyphs - m_glyphCount);
+
+	if (m_glyphCount == m_maxGlyphs && !m_warnedFull) {
+		TK_LOG_WARN("Text batch is full at {} glyphs, further text this frame is not drawn", m_maxGlyphs);
+		m_warnedFull = true;
+	}
+
+	// Glyphs seen for the first time were only rasterized into the copy of the atlas
+	m_fontSystem->upload_atlas(*m_font);
+}
+
+void TextRenderer::draw(Commands* cmd) {
+	if (m_glyphCount == 0) {
+		return;
+	}
+
+	cmd->bind_index_buffer(m_indexBuffer);
+	cmd->bind_vertex_buffer(m_vertexBuffer, sizeof(FontVertex) * 4 * static_cast<u64>(m_maxGlyphs) * m_frame);
+	cmd->draw_indexed(m_glyphCount * 6);
+}
+
+}  // namespace toki
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <toki/core/core.h>
+#include <toki/renderer/commands.h>
+#include <toki/renderer/frontend/renderer_frontend.h>
+#include <toki/runtime/render/text_layout_cache.h>
+#include <toki/runtime/systems/font_system.h>
+
+namespace toki {
+
+struct TextRendererConfig {
+	Renderer* renderer;
+	FontSystem* font_system;
+	StringView font_name;
+	// Glyph quads per frame, text added past this is dropped
+	u32 max_glyphs = 65536;
+	TextLayoutCacheConfig layout_cache_config{};
+};
+
+// Batches the text of a frame into one draw. Quads are written straight into a dynamic vertex
+// buffer holding one region per frame in flight, all of them share a static index buffer. Text
+// drawn again is taken from a layout cache, so adding it only costs the vertex writes.
+class TextRenderer {
+public:
+	TextRenderer() = default;
+
+	DELETE_COPY(TextRenderer)
+
+	void create(const TextRendererConfig& config);
+	void destroy();
+
+	// Moves to the region of the next frame, the region was last drawn MAX_FRAMES_IN_FLIGHT
+	// frames ago
+	void begin_frame();
+
+	// Text is UTF-8, origin is the start of the baseline of its first line. Lines are wrapped to
+	// stay narrower than wrap_width unless it's zero.
+	void add_text(StringView text, Vector2 origin, f32 size, f32 wrap_width = 0);
+
+	// Draws every glyph added since begin_frame, the font shader and its uniforms have to be bound
+	void draw(Commands* cmd);
+
+	u32 glyph_count() const {
+		return m_glyphCount;
+	}
+
+	const TextLayoutCache& layout_cache() const {
+		return *m_layoutCache.get();
+	}
+
+private:
+	Renderer* m_renderer{};
+	FontSystem* m_fontSystem{};
+	StringView m_fontName;
+	Font* m_font{};
+	UniquePtr<TextLayoutCache> m_layoutCache;
+
+	BufferHandle m_vertexBuffer{};
+	BufferHandle m_indexBuffer{};
+	FontVertex* m_vertices{};
+
+	u32 m_maxGlyphs{};
+	u32 m_frame{};
+	u32 m_glyphCount{};
+	b8 m_warnedFull{};
+};
+
+}  // namespace toki
@@ -28,6 +28,34 @@ inline toki::Array<VertexAttributeDescription, 3> Vertex::vertex_attributes = {
 	VertexAttributeDescription{ 2, 0, VertexFormat::FLOAT2, offsetof(Vertex, uv) },
 };
 
+// Vertex at half the size, halves for position and uv and a packed normal. The hardware converts
+// every attribute to floats so it binds to the same shader inputs as Vertex. Halves keep about
+// three significant digits, enough for positions of meshes around the origin. Devices without
+// vertex buffer support for snorm 10:10:10:2 fail to create pipelines with these attributes, cook
+// FULL or QUANTIZED meshes for them.
+struct PackedVertex {
+	// w is 1
+	u16 position[4];
+	// snorm 10:10:10:2 with alpha 0, normalize in the shader
+	u32 normal;
+	u16 uv[2];
+
+	static toki::Array<VertexBindingDescription, 1> vertex_bindings;
+	static toki::Array<VertexAttributeDescription, 3> vertex_attributes;
+};
+
+static_assert(sizeof(PackedVertex) == 16);
+
+inline toki::Array<VertexBindingDescription, 1> PackedVertex::vertex_bindings = {
+	{ 0, sizeof(PackedVertex), VertexInputRate::VERTEX }
+};
+
+inline toki::Array<VertexAttributeDescription, 3> PackedVertex::vertex_attributes = {
+	VertexAttributeDescription{ 0, 0, VertexFormat::HALF4, offsetof(PackedVertex, position) },
+	VertexAttributeDescription{ 1, 0, VertexFormat::SNORM_10_10_10_2, offsetof(PackedVertex, normal) },
+	VertexAttributeDescription{ 2, 0, VertexFormat::HALF2, offsetof(PackedVertex, uv) },
+};
+
 struct FontVertex {
 	Vector3 position;
 	Vector2 uv;
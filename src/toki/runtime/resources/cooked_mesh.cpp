@@ -0,0 +1,434 @@
+#include <toki/runtime/resources/cooked_mesh.h>
+
+namespace toki {
+
+static constexpr u32 NO_LOCAL_INDEX = U32_MAX;
+
+// unorm16 relative to a range, positions to the mesh bounds and uvs to their range
+static u16 quantize_range(f32 value, f32 min_value, f32 max_value) {
+	f32 extent = max_value - min_value;
+	if (extent <= 0.0f) {
+		return 0;
+	}
+	return quantize_unorm16((value - min_value) / extent);
+}
+
+static f32 dequantize_range(u16 value, f32 min_value, f32 max_value) {
+	return min_value + dequantize_unorm(value, 65535) * (max_value - min_value);
+}
+
+static u32 vertex_stride(CookedVertexFormat format) {
+	switch (format) {
+		case CookedVertexFormat::FULL:
+			return sizeof(Vertex);
+		case CookedVertexFormat::QUANTIZED:
+			return sizeof(QuantizedVertex);
+		case CookedVertexFormat::PACKED:
+			return sizeof(PackedVertex);
+	}
+	return 0;
+}
+
+static DynamicArray<QuantizedVertex> quantize_vertices(const ObjData& data, const CookedMeshHeader& header) {
+	u64 count = data.vertex_data.size();
+	DynamicArray<Vector3> normals(count, Vector3{});
+	for (u64 i = 0; i < count; i++) {
+		normals[i] = data.vertex_data[i].normals;
+	}
+	DynamicArray<i16> encoded_normals(count * 2, 0);
+	encode_octahedral_many(normals, encoded_normals.data());
+
+	DynamicArray<QuantizedVertex> quantized(count, QuantizedVertex{});
+	for (u64 i = 0; i < count; i++) {
+		const Vertex& vertex = data.vertex_data[i];
+		const f32* position	 = reinterpret_cast<const f32*>(&vertex.position);
+		QuantizedVertex& out = quantized[i];
+
+		for (u32 axis = 0; axis < 3; axis++) {
+			out.position[axis] = quantize_range(position[axis], header.bounds_min[axis], header.bounds_max[axis]);
+		}
+		out.normal[0] = encoded_normals[i * 2];
+		out.normal[1] = encoded_normals[i * 2 + 1];
+		out.uv[0]	  = quantize_range(vertex.uv.x, header.uv_min[0], header.uv_max[0]);
+		out.uv[1]	  = quantize_range(vertex.uv.y, header.uv_min[1], header.uv_max[1]);
+	}
+	return quantized;
+}
+
+// Components are gathered into flat arrays first so the conversions run over whole arrays
+static DynamicArray<PackedVertex> pack_vertices(const ObjData& data) {
+	u64 count = data.vertex_data.size();
+	DynamicArray<f32> positions(count * 4, 1.0f);
+	DynamicArray<f32> uvs(count * 2, 0.0f);
+	DynamicArray<Vector3> normals(count, Vector3{});
+	for (u64 i = 0; i < count; i++) {
+		const Vertex& vertex = data.vertex_data[i];
+		positions[i * 4]	 = vertex.position.x;
+		positions[i * 4 + 1] = vertex.position.y;
+		positions[i * 4 + 2] = vertex.position.z;
+		uvs[i * 2]			 = vertex.uv.x;
+		uvs[i * 2 + 1]		 = vertex.uv.y;
+		normals[i]			 = vertex.normals;
+	}
+
+	DynamicArray<u16> position_halves(count * 4, 0);
+	DynamicArray<u16> uv_halves(count * 2, 0);
+	DynamicArray<u32> packed_normals(count, 0);
+	f32_to_f16_many(positions, position_halves.data());
+	f32_to_f16_many(uvs, uv_halves.data());
+	pack_normals_10_10_10_2(normals, packed_normals.data());
+
+	DynamicArray<PackedVertex> packed(count, PackedVertex{});
+	for (u64 i = 0; i < count; i++) {
+		toki::memcpy(packed[i].position, &position_halves[i * 4], sizeof(PackedVertex::position));
+		toki::memcpy(packed[i].uv, &uv_halves[i * 2], sizeof(PackedVertex::uv));
+		packed[i].normal = packed_normals[i];
+	}
+	return packed;
+}
+
+struct MeshletData {
+	DynamicArray<Meshlet> meshlets;
+	DynamicArray<u32> vertices;
+	DynamicArray<u8> triangles;
+};
+
+static void finish_meshlet(const ObjData& data, MeshletData& out, Meshlet& meshlet, DynamicArray<u32>& local_indices) {
+	if (meshlet.triangle_count == 0) {
+		return;
+	}
+
+	Vector3 min_position = data.vertex_data[out.vertices[meshlet.vertex_offset]].position;
+	Vector3 max_position = min_position;
+	for (u32 i = 0; i < meshlet.vertex_count; i++) {
+		const Vector3& position = data.vertex_data[out.vertices[meshlet.vertex_offset + i]].position;
+		min_position			= { toki::min(min_position.x, position.x),
+									toki::min(min_position.y, position.y),
+									toki::min(min_position.z, position.z) };
+		max_position			= { toki::max(max_position.x, position.x),
+									toki::max(max_position.y, position.y),
+									toki::max(max_position.z, position.z) };
+	}
+
+	Vector3 center	   = (min_position + max_position) * 0.5f;
+	f32 radius_squared = 0.0f;
+	for (u32 i = 0; i < meshlet.vertex_count; i++) {
+		u32 vertex_index			= out.vertices[meshlet.vertex_offset + i];
+		const Vector3& position		= data.vertex_data[vertex_index].position;
+		radius_squared				= toki::max(radius_squared, (position - center).length_squared());
+		local_indices[vertex_index] = NO_LOCAL_INDEX;
+	}
+
+	meshlet.center[0] = center.x;
+	meshlet.center[1] = center.y;
+	meshlet.center[2] = center.z;
+	meshlet.radius	  = static_cast<f32>(toki::sqrt(radius_squared));
+	out.meshlets.push_back(meshlet);
+
+	meshlet					= {};
+	meshlet.vertex_offset	= static_cast<u32>(out.vertices.size());
+	meshlet.triangle_offset = static_cast<u32>(out.triangles.size());
+}
+
+// Greedily fills meshlets in index buffer order, which keeps neighbouring triangles together for
+// meshes whose index buffer was already optimized for locality
+static MeshletData build_meshlets(const ObjData& data) {
+	MeshletData out{};
+	DynamicArray<u32> local_indices(data.vertex_data.size(), NO_LOCAL_INDEX);
+
+	Meshlet meshlet{};
+	for (u64 triangle = 0; triangle + 2 < data.index_data.size(); triangle += 3) {
+		const u32* corners = &data.index_data[triangle];
+
+		u32 new_vertex_count = 0;
+		for (u32 i = 0; i < 3; i++) {
+			new_vertex_count += local_indices[corners[i]] == NO_LOCAL_INDEX;
+		}
+		if (meshlet.vertex_count + new_vertex_count > MESHLET_MAX_VERTICES ||
+			meshlet.triangle_count + 1 > MESHLET_MAX_TRIANGLES) {
+			finish_meshlet(data, out, meshlet, local_indices);
+		}
+
+		for (u32 i = 0; i < 3; i++) {
+			if (local_indices[corners[i]] == NO_LOCAL_INDEX) {
+				local_indices[corners[i]] = meshlet.vertex_count++;
+				out.vertices.push_back(corners[i]);
+			}
+			out.triangles.push_back(static_cast<u8>(local_indices[corners[i]]));
+		}
+		meshlet.triangle_count++;
+	}
+	finish_meshlet(data, out, meshlet, local_indices);
+
+	return out;
+}
+
+static u64 align_offset(u64 offset) {
+	return (offset + COOKED_MESH_ALIGNMENT - 1) & ~(COOKED_MESH_ALIGNMENT - 1);
+}
+
+static void write_stream(BufferedWriter& writer, u64& position, const CookedMeshStream& stream, const void* data) {
+	static constexpr byte PADDING[COOKED_MESH_ALIGNMENT]{};
+	if (stream.size == 0) {
+		return;
+	}
+
+	TK_ASSERT(stream.offset >= position && stream.offset - position < COOKED_MESH_ALIGNMENT);
+	writer.write(PADDING, stream.offset - position);
+	writer.write(data, stream.size);
+	position = stream.offset + stream.size;
+}
+
+b8 cook_mesh(const ObjData& data, const MeshCookConfig& config, const Path& output_path) {
+	if (data.vertex_data.size() == 0 || data.index_data.size() == 0) {
+		TK_LOG_WARN("Refusing to cook an empty mesh into {}", output_path.c_str());
+		return false;
+	}
+
+	CookedMeshHeader header{};
+	header.magic		 = COOKED_MESH_MAGIC;
+	header.version		 = COOKED_MESH_VERSION;
+	header.vertex_format = config.vertex_format;
+	header.vertex_stride = vertex_stride(config.vertex_format);
+	header.vertex_count	 = static_cast<u32>(data.vertex_data.size());
+	header.index_count	 = static_cast<u32>(data.index_data.size());
+
+	const Vertex& first = data.vertex_data[0];
+	f32 bounds_min[3]	= { first.position.x, first.position.y, first.position.z };
+	f32 bounds_max[3]	= { first.position.x, first.position.y, first.position.z };
+	f32 uv_min[2]		= { first.uv.x, first.uv.y };
+	f32 uv_max[2]		= { first.uv.x, first.uv.y };
+	for (u64 i = 0; i < data.vertex_data.size(); i++) {
+		const Vertex& vertex = data.vertex_data[i];
+		const f32* position	 = reinterpret_cast<const f32*>(&vertex.position);
+		const f32* uv		 = reinterpret_cast<const f32*>(&vertex.uv);
+		for (u32 axis = 0; axis < 3; axis++) {
+			bounds_min[axis] = toki::min(bounds_min[axis], position[axis]);
+			bounds_max[axis] = toki::max(bounds_max[axis], position[axis]);
+		}
+		for (u32 axis = 0; axis < 2; axis++) {
+			uv_min[axis] = toki::min(uv_min[axis], uv[axis]);
+			uv_max[axis] = toki::max(uv_max[axis], uv[axis]);
+		}
+	}
+	toki::memcpy(header.bounds_min, bounds_min, sizeof(bounds_min));
+	toki::memcpy(header.bounds_max, bounds_max, sizeof(bounds_max));
+	toki::memcpy(header.uv_min, uv_min, sizeof(uv_min));
+	toki::memcpy(header.uv_max, uv_max, sizeof(uv_max));
+
+	DynamicArray<QuantizedVertex> quantized;
+	DynamicArray<PackedVertex> packed;
+	const void* vertex_stream = data.vertex_data.data();
+	switch (config.vertex_format) {
+		case CookedVertexFormat::FULL:
+			break;
+		case CookedVertexFormat::QUANTIZED:
+			quantized	  = quantize_vertices(data, header);
+			vertex_stream = quantized.data();
+			break;
+		case CookedVertexFormat::PACKED:
+			packed		  = pack_vertices(data);
+			vertex_stream = packed.data();
+			break;
+	}
+
+	// The LODs are simplified from the full mesh, which stays first in the index stream
+	DynamicArray<u32> lod_indices;
+	DynamicArray<MeshLod> lods;
+	Span<u32> indices = data.index_data;
+	if (config.lods.max_lod_count > 1) {
+		build_lod_chain(
+			data.index_data,
+			&data.vertex_data[0].position,
+			sizeof(Vertex),
+			header.vertex_count,
+			config.lods,
+			lod_indices,
+			lods);
+		indices			   = lod_indices;
+		header.index_count = static_cast<u32>(lod_indices.size());
+		header.lod_count   = static_cast<u32>(lods.size());
+	}
+
+	DynamicArray<byte> encoded_indices;
+	const void* index_stream = indices.data();
+	u64 index_stream_size	 = indices.size() * sizeof(u32);
+	if (config.compress_indices) {
+		encode_indices(indices, encoded_indices);
+		header.flags	 |= COOKED_MESH_FLAG_COMPRESSED_INDICES;
+		index_stream	  = encoded_indices.data();
+		index_stream_size = encoded_indices.size();
+	}
+
+	MeshletData meshlets{};
+	if (config.build_meshlets) {
+		meshlets			 = build_meshlets(data);
+		header.flags		|= COOKED_MESH_FLAG_MESHLETS;
+		header.meshlet_count = static_cast<u32>(meshlets.meshlets.size());
+	}
+
+	u64 offset		  = align_offset(sizeof(CookedMeshHeader));
+	auto place_stream = [&offset](CookedMeshStream& stream, u64 size) {
+		stream = { size > 0 ? offset : 0, size };
+		offset = align_offset(offset + size);
+	};
+	place_stream(header.vertices, static_cast<u64>(header.vertex_count) * header.vertex_stride);
+	place_stream(header.indices, index_stream_size);
+	place_stream(header.meshlets, meshlets.meshlets.size() * sizeof(Meshlet));
+	place_stream(header.meshlet_vertices, meshlets.vertices.size() * sizeof(u32));
+	place_stream(header.meshlet_triangles, meshlets.triangles.size() * sizeof(u8));
+	place_stream(header.lods, lods.size() * sizeof(MeshLod));
+
+	File file(output_path, FileMode::WRITE, FILE_FLAG_CREATE | FILE_FLAG_TRUNCATE);
+	if (!file.is_open()) {
+		TK_LOG_WARN("Could not create cooked mesh {}", output_path.c_str());
+		return false;
+	}
+	BufferedWriter writer(file);
+
+	u64 position = sizeof(CookedMeshHeader);
+	writer.write(&header, sizeof(header));
+	write_stream(writer, position, header.vertices, vertex_stream);
+	write_stream(writer, position, header.indices, index_stream);
+	write_stream(writer, position, header.meshlets, meshlets.meshlets.data());
+	write_stream(writer, position, header.meshlet_vertices, meshlets.vertices.data());
+	write_stream(writer, position, header.meshlet_triangles, meshlets.triangles.data());
+	write_stream(writer, position, header.lods, lods.data());
+
+	if (!writer.flush()) {
+		TK_LOG_WARN("Could not write cooked mesh {}", output_path.c_str());
+		return false;
+	}
+	return true;
+}
+
+static b8 stream_is_valid(const CookedMeshStream& stream, u64 expected_size, u64 file_size) {
+	if (stream.size != expected_size) {
+		return false;
+	}
+	if (stream.size == 0) {
+		return true;
+	}
+	return stream.offset % COOKED_MESH_ALIGNMENT == 0 && stream.offset <= file_size &&
+		   stream.size <= file_size - stream.offset;
+}
+
+b8 CookedMesh::load(const Path& path) {
+	unload();
+
+	// Read ahead is enabled since uploading the mesh touches every page in order
+	if (!m_file.open(path, FileAccessHint::SEQUENTIAL)) {
+		TK_LOG_WARN("Could not open cooked mesh {}", path.c_str());
+		return false;
+	}
+
+	if (m_file.size() < sizeof(CookedMeshHeader)) {
+		TK_LOG_WARN("Cooked mesh {} is truncated", path.c_str());
+		m_file.close();
+		return false;
+	}
+
+	const CookedMeshHeader* header = reinterpret_cast<const CookedMeshHeader*>(m_file.data());
+	if (header->magic != COOKED_MESH_MAGIC || header->version != COOKED_MESH_VERSION) {
+		TK_LOG_WARN("{} is not a cooked mesh of version {}", path.c_str(), COOKED_MESH_VERSION);
+		m_file.close();
+		return false;
+	}
+
+	// The size of compressed indices is only known once they are decoded
+	b8 compressed  = (header->flags & COOKED_MESH_FLAG_COMPRESSED_INDICES) != 0;
+	u64 index_size = compressed ? header->indices.size : static_cast<u64>(header->index_count) * sizeof(u32);
+
+	u64 expected_stride = vertex_stride(header->vertex_format);
+	u64 file_size	= m_file.size();
+	b8 has_meshlets = (header->flags & COOKED_MESH_FLAG_MESHLETS) != 0;
+	b8 valid		= expected_stride != 0 && header->vertex_stride == expected_stride &&
+			   stream_is_valid(header->vertices, static_cast<u64>(header->vertex_count) * expected_stride, file_size) &&
+			   stream_is_valid(header->indices, index_size, file_size) &&
+			   stream_is_valid(header->meshlets, static_cast<u64>(header->meshlet_count) * sizeof(Meshlet), file_size) &&
+			   (has_meshlets || header->meshlet_count == 0) &&
+			   stream_is_valid(header->meshlet_vertices, header->meshlet_vertices.size, file_size) &&
+			   stream_is_valid(header->meshlet_triangles, header->meshlet_triangles.size, file_size) &&
+			   header->lod_count <= MAX_MESH_LODS &&
+			   stream_is_valid(header->lods, static_cast<u64>(header->lod_count) * sizeof(MeshLod), file_size);
+	const MeshLod* lods = reinterpret_cast<const MeshLod*>(m_file.data() + header->lods.offset);
+	for (u32 i = 0; valid && i < header->lod_count; i++) {
+		valid = static_cast<u64>(lods[i].first_index) + lods[i].index_count <= header->index_count;
+	}
+	const Meshlet* meshlets	 = reinterpret_cast<const Meshlet*>(m_file.data() + header->meshlets.offset);
+	u64 meshlet_vertex_count = header->meshlet_vertices.size / sizeof(u32);
+	for (u32 i = 0; valid && i < header->meshlet_count; i++) {
+		valid = static_cast<u64>(meshlets[i].vertex_offset) + meshlets[i].vertex_count <= meshlet_vertex_count &&
+				static_cast<u64>(meshlets[i].triangle_offset) + static_cast<u64>(meshlets[i].triangle_count) * 3 <=
+					header->meshlet_triangles.size;
+	}
+	if (!valid) {
+		TK_LOG_WARN("Cooked mesh {} has an invalid layout", path.c_str());
+		m_file.close();
+		return false;
+	}
+
+	const u32* indices = reinterpret_cast<const u32*>(m_file.data() + header->indices.offset);
+	if (compressed) {
+		m_indices.resize(header->index_count);
+		auto decoded = decode_indices(
+			m_file.data() + header->indices.offset, header->indices.size, m_indices.data(), header->index_count);
+		valid	= decoded && decoded.value() == header->indices.size;
+		indices = m_indices.data();
+	}
+
+	// Checked once here so that drawing or decoding vertices never reads past the vertex stream
+	for (u32 i = 0; valid && i < header->index_count; i++) {
+		valid = indices[i] < header->vertex_count;
+	}
+	if (!valid) {
+		TK_LOG_WARN("Cooked mesh {} has corrupt indices", path.c_str());
+		m_indices.clear();
+		m_file.close();
+		return false;
+	}
+
+	m_header = header;
+	return true;
+}
+
+void CookedMesh::unload() {
+	m_header = nullptr;
+	m_indices.clear();
+	m_file.close();
+}
+
+Vertex CookedMesh::decode_vertex(u32 index) const {
+	TK_ASSERT(index < m_header->vertex_count);
+
+	if (m_header->vertex_format == CookedVertexFormat::FULL) {
+		return reinterpret_cast<const Vertex*>(vertex_data())[index];
+	}
+
+	if (m_header->vertex_format == CookedVertexFormat::PACKED) {
+		const PackedVertex& packed = reinterpret_cast<const PackedVertex*>(vertex_data())[index];
+		Vector3 normal			   = unpack_snorm_10_10_10_2(packed.normal).xyz();
+
+		Vertex vertex{};
+		vertex.position = { f16_to_f32(packed.position[0]),
+							f16_to_f32(packed.position[1]),
+							f16_to_f32(packed.position[2]) };
+		vertex.normals	= normal.length_squared() > 0.0f ? normal.normalize() : normal;
+		vertex.uv		= { f16_to_f32(packed.uv[0]), f16_to_f32(packed.uv[1]) };
+		return vertex;
+	}
+
+	const QuantizedVertex& quantized = reinterpret_cast<const QuantizedVertex*>(vertex_data())[index];
+	Vertex vertex{};
+	f32* position = reinterpret_cast<f32*>(&vertex.position);
+	for (u32 axis = 0; axis < 3; axis++) {
+		position[axis] =
+			dequantize_range(quantized.position[axis], m_header->bounds_min[axis], m_header->bounds_max[axis]);
+	}
+	vertex.normals = decode_octahedral(quantized.normal);
+	vertex.uv	   = { dequantize_range(quantized.uv[0], m_header->uv_min[0], m_header->uv_max[0]),
+					   dequantize_range(quantized.uv[1], m_header->uv_min[1], m_header->uv_max[1]) };
+	return vertex;
+}
+
+}  // namespace toki
@@ -0,0 +1,176 @@
+#pragma once
+
+#include <toki/core/core.h>
+#include <toki/runtime/render/types.h>
+#include <toki/runtime/resources/loaders/obj_loader.h>
+
+namespace toki {
+
+// Binary mesh format written by the mesh_cooker tool. The file is a CookedMeshHeader followed by
+// the streams it describes, every stream starts at a COOKED_MESH_ALIGNMENT aligned offset so it
+// can be used straight from a mapping. All values are little endian.
+
+static constexpr u32 COOKED_MESH_MAGIC	   = 0x48534D54;  // "TMSH"
+static constexpr u32 COOKED_MESH_VERSION   = 2;
+static constexpr u64 COOKED_MESH_ALIGNMENT = 64;
+
+static constexpr u32 MESHLET_MAX_VERTICES  = 64;
+static constexpr u32 MESHLET_MAX_TRIANGLES = 124;
+
+enum struct CookedVertexFormat : u32 {
+	// Vertex as used by the renderer
+	FULL,
+	// QuantizedVertex, has to be decoded before it matches Vertex
+	QUANTIZED,
+	// PackedVertex, read by the same shaders as Vertex
+	PACKED,
+};
+
+enum CookedMeshFlags : u32 {
+	COOKED_MESH_FLAG_MESHLETS			= 1 << 0,
+	// The index stream is encoded with encode_indices
+	COOKED_MESH_FLAG_COMPRESSED_INDICES = 1 << 1,
+};
+
+struct CookedMeshStream {
+	// Bytes from the start of the file
+	u64 offset;
+	u64 size;
+};
+
+struct CookedMeshHeader {
+	u32 magic;
+	u32 version;
+	u32 flags;
+	CookedVertexFormat vertex_format;
+	u32 vertex_stride;
+	u32 vertex_count;
+	// Indices of all LODs together
+	u32 index_count;
+	u32 meshlet_count;
+	// 0 when the file only has the full mesh
+	u32 lod_count;
+	u32 padding;
+
+	f32 bounds_min[3];
+	f32 bounds_max[3];
+	// Range quantized texture coordinates are relative to
+	f32 uv_min[2];
+	f32 uv_max[2];
+
+	CookedMeshStream vertices;
+	// u32 per index, or the encode_indices bytes with COOKED_MESH_FLAG_COMPRESSED_INDICES
+	CookedMeshStream indices;
+	CookedMeshStream meshlets;
+	// u32 per entry, indices into the vertex stream
+	CookedMeshStream meshlet_vertices;
+	// Three u8 per triangle, indices into the meshlet's vertices
+	CookedMeshStream meshlet_triangles;
+	// MeshLod per LOD, ranges of the index stream sharing the one vertex stream
+	CookedMeshStream lods;
+};
+
+struct QuantizedVertex {
+	// unorm16 relative to the mesh bounds
+	u16 position[3];
+	u16 padding;
+	// Octahedral encoded unit vector, snorm16
+	i16 normal[2];
+	// unorm16 relative to the mesh uv range
+	u16 uv[2];
+};
+
+static_assert(sizeof(QuantizedVertex) == 16);
+
+struct Meshlet {
+	u32 vertex_offset;
+	u32 triangle_offset;
+	u32 vertex_count;
+	u32 triangle_count;
+	// Bounding sphere for culling
+	f32 center[3];
+	f32 radius;
+};
+
+struct MeshCookConfig {
+	CookedVertexFormat vertex_format = CookedVertexFormat::FULL;
+	b8 build_meshlets				 = false;
+	// Worth it for meshes that went through optimize_mesh, their indices change by small steps
+	b8 compress_indices				 = false;
+	// Builds LODs when max_lod_count is above 1, meshlets only cover the full mesh
+	LodChainConfig lods				 = { .max_lod_count = 1 };
+};
+
+b8 cook_mesh(const ObjData& data, const MeshCookConfig& config, const Path& output_path);
+
+// Cooked mesh mapped read only, the accessors point straight into the mapping and are valid
+// until the mesh is unloaded. Compressed indices are decoded into memory owned by the mesh.
+class CookedMesh {
+public:
+	CookedMesh() = default;
+
+	// Validates the header and stream ranges, a file that fails validation is not kept open
+	b8 load(const Path& path);
+	void unload();
+
+	b8 is_loaded() const {
+		return m_header != nullptr;
+	}
+
+	const CookedMeshHeader& header() const {
+		return *m_header;
+	}
+
+	const void* vertex_data() const {
+		return stream_data(m_header->vertices);
+	}
+
+	u64 vertex_data_size() const {
+		return m_header->vertices.size;
+	}
+
+	const u32* indices() const {
+		if (m_indices.size() > 0) {
+			return m_indices.data();
+		}
+		return reinterpret_cast<const u32*>(stream_data(m_header->indices));
+	}
+
+	u32 index_count() const {
+		return m_header->index_count;
+	}
+
+	const MeshLod* lods() const {
+		return reinterpret_cast<const MeshLod*>(stream_data(m_header->lods));
+	}
+
+	u32 lod_count() const {
+		return m_header->lod_count;
+	}
+
+	const Meshlet* meshlets() const {
+		return reinterpret_cast<const Meshlet*>(stream_data(m_header->meshlets));
+	}
+
+	const u32* meshlet_vertices() const {
+		return reinterpret_cast<const u32*>(stream_data(m_header->meshlet_vertices));
+	}
+
+	const u8* meshlet_triangles() const {
+		return reinterpret_cast<const u8*>(stream_data(m_header->meshlet_triangles));
+	}
+
+	// Returns the vertex in the renderer layout whatever format it is stored in
+	Vertex decode_vertex(u32 index) const;
+
+private:
+	const void* stream_data(const CookedMeshStream& stream) const {
+		return stream.size > 0 ? m_file.data() + stream.offset : nullptr;
+	}
+
+	MappedFile m_file;
+	const CookedMeshHeader* m_header{};
+	DynamicArray<u32> m_indices;
+};
+
+}  // namespace toki
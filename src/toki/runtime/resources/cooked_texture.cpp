@@ -0,0 +1,117 @@
+#include <toki/runtime/resources/cooked_texture.h>
+#include <toki/runtime/resources/loaders/texture_loader.h>
+
+namespace toki {
+
+b8 cook_texture(const Path& input_path, const TextureCookConfig& config, const Path& output_path) {
+	TextureImportConfig import_config{};
+	import_config.generate_mips = config.generate_mips;
+	import_config.mip_config	= config.mip_config;
+
+	ResourceData texture = load_texture(input_path, import_config);
+	if (texture.data == nullptr) {
+		return false;
+	}
+
+	CookedTextureHeader header{};
+	header.magic	   = COOKED_TEXTURE_MAGIC;
+	header.version	   = COOKED_TEXTURE_VERSION;
+	header.format	   = config.format;
+	header.width	   = static_cast<u32>(texture.metadata.texture.width);
+	header.height	   = static_cast<u32>(texture.metadata.texture.height);
+	header.mip_levels  = static_cast<u32>(texture.metadata.texture.mip_levels);
+	header.data_offset = (sizeof(CookedTextureHeader) + COOKED_TEXTURE_ALIGNMENT - 1) & ~(COOKED_TEXTURE_ALIGNMENT - 1);
+	header.data_size   = compressed_chain_size(header.format, header.width, header.height, header.mip_levels);
+
+	DynamicArray<byte> blocks(header.data_size);
+	toki::compress_mip_chain(
+		header.format,
+		reinterpret_cast<const byte*>(texture.data),
+		header.width,
+		header.height,
+		header.mip_levels,
+		blocks.data());
+	unload_texture(texture);
+
+	File file(output_path, FileMode::WRITE, FILE_FLAG_CREATE | FILE_FLAG_TRUNCATE);
+	if (!file.is_open()) {
+		TK_LOG_WARN("Could not create cooked texture {}", output_path.c_str());
+		return false;
+	}
+
+	const byte padding[COOKED_TEXTURE_ALIGNMENT]{};
+	file.write(&header, sizeof(header));
+	file.write(padding, header.data_offset - sizeof(header));
+	file.write(blocks.data(), blocks.size());
+	return true;
+}
+
+ColorFormat to_color_format(BlockFormat format) {
+	switch (format) {
+		case BlockFormat::BC1:
+			return ColorFormat::BC1_RGBA;
+		case BlockFormat::BC3:
+			return ColorFormat::BC3_RGBA;
+		case BlockFormat::BC4:
+			return ColorFormat::BC4_R;
+		case BlockFormat::BC7:
+			return ColorFormat::BC7_RGBA;
+	}
+
+	TK_UNREACHABLE();
+}
+
+b8 CookedTexture::load(const Path& path) {
+	unload();
+
+	if (!m_file.open(path, FileAccessHint::SEQUENTIAL)) {
+		TK_LOG_WARN("Could not open cooked texture {}", path.c_str());
+		return false;
+	}
+
+	if (m_file.size() < sizeof(CookedTextureHeader)) {
+		TK_LOG_WARN("Cooked texture {} is truncated", path.c_str());
+		m_file.close();
+		return false;
+	}
+
+	const CookedTextureHeader* header = reinterpret_cast<const CookedTextureHeader*>(m_file.data());
+	if (header->magic != COOKED_TEXTURE_MAGIC || header->version != COOKED_TEXTURE_VERSION) {
+		TK_LOG_WARN("{} is not a cooked texture of version {}", path.c_str(), COOKED_TEXTURE_VERSION);
+		m_file.close();
+		return false;
+	}
+
+	b8 valid = header->format <= BlockFormat::BC7 && header->width > 0 && header->height > 0 &&
+			   header->mip_levels > 0 && header->mip_levels <= mip_level_count(header->width, header->height) &&
+			   header->data_offset % COOKED_TEXTURE_ALIGNMENT == 0 && header->data_offset <= m_file.size() &&
+			   header->data_size <= m_file.size() - header->data_offset &&
+			   header->data_size ==
+				   compressed_chain_size(header->format, header->width, header->height, header->mip_levels);
+	if (!valid) {
+		TK_LOG_WARN("Cooked texture {} has an invalid layout", path.c_str());
+		m_file.close();
+		return false;
+	}
+
+	m_header = header;
+	return true;
+}
+
+void CookedTexture::unload() {
+	m_header = nullptr;
+	m_file.close();
+}
+
+TextureConfig CookedTexture::texture_config() const {
+	TextureConfig config{};
+	config.flags	  = TextureFlags::SAMPLED | TextureFlags::WRITABLE;
+	config.width	  = m_header->width;
+	config.height	  = m_header->height;
+	config.channels	  = m_header->format == BlockFormat::BC4 ? 1 : 4;
+	config.format	  = to_color_format(m_header->format);
+	config.mip_levels = m_header->mip_levels;
+	return config;
+}
+
+}  // namespace toki
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <toki/core/core.h>
+#include <toki/renderer/frontend/renderer_types.h>
+
+namespace toki {
+
+// Block compressed texture written by the texture_cooker tool. The file is a CookedTextureHeader
+// followed by every level of the mip chain, compressed and packed one after the other the way
+// Renderer::begin_texture_upload lays them out. All values are little endian.
+
+static constexpr u32 COOKED_TEXTURE_MAGIC	  = 0x58455454;	 // "TTEX"
+static constexpr u32 COOKED_TEXTURE_VERSION	  = 1;
+static constexpr u64 COOKED_TEXTURE_ALIGNMENT = 64;
+
+struct CookedTextureHeader {
+	u32 magic;
+	u32 version;
+	BlockFormat format;
+	u32 width;
+	u32 height;
+	u32 mip_levels;
+	// Bytes from the start of the file
+	u64 data_offset;
+	u64 data_size;
+};
+
+struct TextureCookConfig {
+	BlockFormat format = BlockFormat::BC7;
+	b8 generate_mips   = true;
+	// Color is sRGB encoded, BC4 textures are usually masks and should turn this off
+	MipConfig mip_config{ MipFilter::BOX, true };
+};
+
+b8 cook_texture(const Path& input_path, const TextureCookConfig& config, const Path& output_path);
+
+ColorFormat to_color_format(BlockFormat format);
+
+// Cooked texture mapped read only, the level data can be copied straight into upload memory
+class CookedTexture {
+public:
+	CookedTexture() = default;
+
+	// Validates the header and the data size, a file that fails validation is not kept open
+	b8 load(const Path& path);
+	void unload();
+
+	b8 is_loaded() const {
+		return m_header != nullptr;
+	}
+
+	const CookedTextureHeader& header() const {
+		return *m_header;
+	}
+
+	// Config of a sampled texture that fits the data of the file
+	TextureConfig texture_config() const;
+
+	const void* data() const {
+		return m_file.data() + m_header->data_offset;
+	}
+
+	u64 data_size() const {
+		return m_header->data_size;
+	}
+
+private:
+	MappedFile m_file;
+	const CookedTextureHeader* m_header{};
+};
+
+}  // namespace toki
@@ -2,152 +2,495 @@
 
 namespace toki {
 
-ObjData load_obj(const Path& path) {
-	File file(path, FileMode::READ);
-	u32 vertex_count{};
-	u32 normal_count{};
-	u32 texture_coord_count{};
-	u32 face_count{};
-
-	u32 read_count{};
-	char buf[256]{};
-	do {
-		read_count		= file.read_line(buf, 256);
-		buf[read_count] = 0;
-
-		if (toki::starts_with(buf, "#")) {
-			continue;
-		}
-
-		if (toki::starts_with(buf, "v ")) {
-			vertex_count++;
-		} else if (toki::starts_with(buf, "vn ")) {
-			normal_count++;
-		} else if (toki::starts_with(buf, "vt ")) {
-			texture_coord_count++;
-		} else if (toki::starts_with(buf, "f ")) {
-			face_count++;
-		}
-	} while (read_count > 0);
-
-	DynamicArray<Vector3> vertices(vertex_count);
-	DynamicArray<Vector3> normals(normal_count);
-	DynamicArray<Vector2> texture_coords(texture_coord_count);
-	DynamicArray<Vertex> vertex_data;
-	vertex_data.reserve(face_count * 3);
-	DynamicArray<u32> index_data;
-	index_data.reserve(face_count * 3);
-	vertex_count = normal_count = texture_coord_count = face_count = 0;
-
-	file.seek(0, FileCursorStart::BEGIN);
-
-	auto handle_face = [&](const char* face_string) {
-		const char* temp = face_string;
-		enum {
-			VERTEX_INDEX,
-			TEXTURE_COORD_INDEX,
-			NORMAL_INDEX,
-		};
-		i32 indices[3]{};
-
-		for (; is_space(*temp); ++temp) {}
-
-		u32 slash_count = 0;
-		for (u32 n = 0; !is_space(*temp); ++temp) {
-			if (n == 3) {
-				break;
+static constexpr u32 NO_INDEX = U32_MAX;
+
+// Negative OBJ indices count back from the last element parsed so far. Inside a chunk that is
+// parsed in parallel only the local count is known, so such indices are stored as an offset from
+// the start of the chunk with this bit set and rebased once every chunk is parsed. The offset is
+// biased to stay positive so that an offset of -1 does not encode to NO_INDEX.
+static constexpr u32 CHUNK_RELATIVE_BIT = 1u << 31;
+static constexpr i64 CHUNK_OFFSET_BIAS	= CHUNK_RELATIVE_BIT / 2;
+
+namespace {
+
+struct Corner {
+	u32 position;
+	u32 uv;
+	u32 normal;
+};
+
+struct ObjChunk {
+	const char* begin{};
+	const char* end{};
+
+	DynamicArray<Vector3> positions;
+	DynamicArray<Vector3> normals;
+	DynamicArray<Vector2> uvs;
+	// Three per triangle
+	DynamicArray<Corner> corners;
+	// Triangle count of every face, faces are checked as a whole once indices are resolved
+	DynamicArray<u32> face_triangle_counts;
+	u32 invalid_face_count{};
+};
+
+// Maps (position, uv, normal) index triples to output vertices, open addressing with linear probing
+class VertexTable {
+public:
+	VertexTable(u64 expected_count) {
+		u64 capacity = 64;
+		while (capacity < expected_count * 2) {
+			capacity *= 2;
+		}
+		allocate(capacity);
+	}
+
+	// Returns the vertex the corner already maps to, or maps it to new_vertex
+	u32 find_or_insert(const Corner& corner, u32 new_vertex) {
+		if ((m_count + 1) * 2 > m_entries.size()) {
+			grow();
+		}
+
+		u64 mask = m_entries.size() - 1;
+		for (u64 index = hash(corner) & mask;; index = (index + 1) & mask) {
+			Entry& entry = m_entries[index];
+			if (entry.vertex == NO_INDEX) {
+				entry = { corner, new_vertex };
+				m_count++;
+				return new_vertex;
+			}
+			if (entry.corner.position == corner.position && entry.corner.uv == corner.uv &&
+				entry.corner.normal == corner.normal) {
+				return entry.vertex;
 			}
+		}
+	}
 
-			u32 read_byte_count = atoi<i32>(temp, indices[slash_count]);
-			++n;
-			temp += read_byte_count;
-			if (*temp == '/') {
-				++slash_count;
+private:
+	struct Entry {
+		Corner corner;
+		u32 vertex;
+	};
+
+	static u64 hash(const Corner& corner) {
+		u64 h = corner.position * 0x9E3779B97F4A7C15ull;
+		h ^= (h >> 29) + corner.uv * 0xBF58476D1CE4E5B9ull;
+		h ^= (h >> 31) + corner.normal * 0x94D049BB133111EBull;
+		return h ^ (h >> 32);
+	}
+
+	void allocate(u64 capacity) {
+		m_entries.resize(capacity);
+		for (u64 i = 0; i < capacity; i++) {
+			m_entries[i].vertex = NO_INDEX;
+		}
+	}
+
+	void grow() {
+		DynamicArray<Entry> old_entries = toki::move(m_entries);
+		allocate(old_entries.size() * 2);
+
+		u64 mask = m_entries.size() - 1;
+		for (u64 i = 0; i < old_entries.size(); i++) {
+			if (old_entries[i].vertex == NO_INDEX) {
+				continue;
 			}
+
+			u64 index = hash(old_entries[i].corner) & mask;
+			while (m_entries[index].vertex != NO_INDEX) {
+				index = (index + 1) & mask;
+			}
+			m_entries[index] = old_entries[i];
 		}
+	}
+
+	DynamicArray<Entry> m_entries;
+	u64 m_count{};
+};
+
+}  // namespace
+
+static constexpr f64 POWERS_OF_TEN[] = { 1e0,  1e1,  1e2,  1e3,	 1e4,  1e5,	 1e6,  1e7,	 1e8,  1e9,	 1e10, 1e11,
+										 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
 
-		Vertex temp_vertex{};
+static const char* skip_spaces(const char* ptr, const char* end) {
+	while (ptr < end && (*ptr == ' ' || *ptr == '\t')) {
+		++ptr;
+	}
+	return ptr;
+}
+
+// Accumulates up to 19 significant digits into an integer and applies the decimal exponent with a
+// single multiply or divide by an exact power of ten, which is accurate to well below f32 precision
+static const char* parse_float(const char* ptr, const char* end, f32& out_value) {
+	ptr = skip_spaces(ptr, end);
+
+	b8 negative = false;
+	if (ptr < end && (*ptr == '-' || *ptr == '+')) {
+		negative = *ptr == '-';
+		++ptr;
+	}
 
-		temp_vertex.position = vertices[indices[VERTEX_INDEX] - 1];
-		if (indices[NORMAL_INDEX] > 0) {
-			temp_vertex.normals = normals[indices[NORMAL_INDEX] - 1];
+	u64 mantissa = 0;
+	u32 digits	 = 0;
+	i32 exponent = 0;
+	for (; ptr < end && is_digit(*ptr); ++ptr) {
+		if (digits < 19) {
+			mantissa = mantissa * 10 + static_cast<u64>(*ptr - '0');
+			digits += mantissa != 0;
 		} else {
-			temp_vertex.normals = {};
+			exponent++;
 		}
-		if (indices[TEXTURE_COORD_INDEX] > 0) {
-			temp_vertex.uv = texture_coords[indices[TEXTURE_COORD_INDEX] - 1];
-		} else {
-			temp_vertex.uv = {};
+	}
+
+	if (ptr < end && *ptr == '.') {
+		for (++ptr; ptr < end && is_digit(*ptr); ++ptr) {
+			if (digits < 19) {
+				mantissa = mantissa * 10 + static_cast<u64>(*ptr - '0');
+				digits += mantissa != 0;
+				exponent--;
+			}
 		}
+	}
 
-		auto bootleg_hash = [&vertex_data](const Vertex& v) {
-			i32 hash = v.position.length() * 100000 + v.normals.length() * 10000 + v.uv.length() * 100000;
-			hash *= 97;
-			hash = hash % (vertex_data.capacity() * 103);
-			return hash;
-		};
+	if (ptr < end && (*ptr == 'e' || *ptr == 'E')) {
+		++ptr;
+		b8 negative_exponent = false;
+		if (ptr < end && (*ptr == '-' || *ptr == '+')) {
+			negative_exponent = *ptr == '-';
+			++ptr;
+		}
 
-		auto hash = bootleg_hash(temp_vertex);
+		i32 value = 0;
+		for (; ptr < end && is_digit(*ptr); ++ptr) {
+			value = toki::min(value * 10 + (*ptr - '0'), 1000);
+		}
+		exponent += negative_exponent ? -value : value;
+	}
 
-		// This is temporary until i make a map
-		for (u32 i = 0; i < vertex_data.size(); i++) {
-			Vertex& current	  = vertex_data[i];
-			auto current_hash = bootleg_hash(current);
-			if (current_hash == hash && temp_vertex == current) {
-				index_data.push_back(i);
-				goto ret;
-			}
+	f64 value = static_cast<f64>(mantissa);
+	while (exponent > 22) {
+		value *= 1e22;
+		exponent -= 22;
+	}
+	while (exponent < -22) {
+		value /= 1e22;
+		exponent += 22;
+	}
+	value = exponent < 0 ? value / POWERS_OF_TEN[-exponent] : value * POWERS_OF_TEN[exponent];
+
+	out_value = static_cast<f32>(negative ? -value : value);
+	return ptr;
+}
+
+static const char* parse_index(const char* ptr, const char* end, i64& out_value) {
+	b8 negative = false;
+	if (ptr < end && *ptr == '-') {
+		negative = true;
+		++ptr;
+	}
+
+	out_value = 0;
+	for (; ptr < end && is_digit(*ptr); ++ptr) {
+		out_value = out_value * 10 + (*ptr - '0');
+	}
+	out_value = negative ? -out_value : out_value;
+
+	return ptr;
+}
+
+// Converts a 1 based, possibly negative OBJ index to a 0 based one, 0 is never a valid index
+static u32 resolve_index(i64 index, u64 local_count, b8& valid) {
+	if (index > 0 && index < CHUNK_RELATIVE_BIT) {
+		return static_cast<u32>(index - 1);
+	}
+	// May point before the start of the chunk, rebasing checks the final index
+	i64 chunk_offset = static_cast<i64>(local_count) + index;
+	if (index < 0 && chunk_offset >= -CHUNK_OFFSET_BIAS && chunk_offset < CHUNK_OFFSET_BIAS - 1) {
+		return static_cast<u32>(chunk_offset + CHUNK_OFFSET_BIAS) | CHUNK_RELATIVE_BIT;
+	}
+
+	valid = false;
+	return NO_INDEX;
+}
+
+// Parses "v", "v/vt", "v//vn" or "v/vt/vn"
+static const char* parse_corner(
+	const char* ptr, const char* end, const ObjChunk& chunk, Corner& out_corner, b8& valid) {
+	out_corner = { NO_INDEX, NO_INDEX, NO_INDEX };
+
+	i64 index{};
+	ptr					= parse_index(ptr, end, index);
+	out_corner.position = resolve_index(index, chunk.positions.size(), valid);
+
+	if (ptr < end && *ptr == '/') {
+		++ptr;
+		if (ptr < end && *ptr != '/') {
+			ptr			  = parse_index(ptr, end, index);
+			out_corner.uv = resolve_index(index, chunk.uvs.size(), valid);
 		}
 
-		index_data.push_back(vertex_data.size());
-		vertex_data.push_back(temp_vertex);
-ret:
-		return temp - face_string + 1;
-	};
+		if (ptr < end && *ptr == '/') {
+			ptr				  = parse_index(ptr + 1, end, index);
+			out_corner.normal = resolve_index(index, chunk.normals.size(), valid);
+		}
+	}
 
-	char* temp{};
-	f64 value{};
-	do {
-		read_count		= file.read_line(buf, 256);
-		buf[read_count] = 0;
+	return ptr;
+}
+
+// Polygons are triangulated as a fan around their first corner
+static void parse_face(const char* ptr, const char* end, ObjChunk& chunk) {
+	Corner first{}, previous{}, current{};
+	u32 corner_count = 0;
+	b8 valid		 = true;
+	u64 first_corner = chunk.corners.size();
+
+	for (ptr = skip_spaces(ptr, end); ptr < end && valid; ptr = skip_spaces(ptr, end)) {
+		if (!is_digit(*ptr) && *ptr != '-') {
+			break;
+		}
+
+		ptr = parse_corner(ptr, end, chunk, current, valid);
+		if (corner_count >= 2) {
+			chunk.corners.push_back(first);
+			chunk.corners.push_back(previous);
+			chunk.corners.push_back(current);
+		} else if (corner_count == 0) {
+			first = current;
+		}
 
-		if (toki::starts_with(buf, "#")) {
-			continue;
+		previous = current;
+		corner_count++;
+	}
+
+	if (!valid || corner_count < 3) {
+		chunk.corners.resize(first_corner);
+		chunk.invalid_face_count++;
+		return;
+	}
+	chunk.face_triangle_counts.push_back(corner_count - 2);
+}
+
+static void parse_chunk(ObjChunk& chunk) {
+	const char* ptr = chunk.begin;
+	while (ptr < chunk.end) {
+		const char* line_end =
+			reinterpret_cast<const char*>(toki::memchr(ptr, '\n', static_cast<u64>(chunk.end - ptr)));
+		if (line_end == nullptr) {
+			line_end = chunk.end;
 		}
 
-		if (toki::starts_with(buf, "vn ")) {
-			temp			= buf + 2;
-			Vector3& normal = normals[normal_count++];
-			for (u32 i = 0; i < 3; i++) {
-				u32 converted_count = atof(temp, value);
-				temp += converted_count - 1;
-				reinterpret_cast<f32*>(&normal)[i] = value;
+		ptr = skip_spaces(ptr, line_end);
+		if (line_end - ptr >= 2) {
+			if (ptr[0] == 'v' && ptr[1] == ' ') {
+				chunk.positions.emplace_back();
+				Vector3& position = chunk.positions.last();
+				const char* temp  = ptr + 2;
+				for (u32 i = 0; i < 3; i++) {
+					temp = parse_float(temp, line_end, reinterpret_cast<f32*>(&position)[i]);
+				}
+			} else if (ptr[0] == 'v' && ptr[1] == 'n') {
+				chunk.normals.emplace_back();
+				Vector3& normal	 = chunk.normals.last();
+				const char* temp = ptr + 2;
+				for (u32 i = 0; i < 3; i++) {
+					temp = parse_float(temp, line_end, reinterpret_cast<f32*>(&normal)[i]);
+				}
+			} else if (ptr[0] == 'v' && ptr[1] == 't') {
+				chunk.uvs.emplace_back();
+				Vector2& uv		 = chunk.uvs.last();
+				const char* temp = ptr + 2;
+				for (u32 i = 0; i < 2; i++) {
+					temp = parse_float(temp, line_end, reinterpret_cast<f32*>(&uv)[i]);
+				}
+			} else if (ptr[0] == 'f' && (ptr[1] == ' ' || ptr[1] == '\t')) {
+				parse_face(ptr + 2, line_end, chunk);
 			}
-		} else if (toki::starts_with(buf, "v ")) {
-			temp			= buf + 1;
-			Vector3& vertex = vertices[vertex_count++];
-			for (u32 i = 0; i < 3; i++) {
-				u32 converted_count = atof(temp, value);
-				temp += converted_count - 1;
-				reinterpret_cast<f32*>(&vertex)[i] = value;
+		}
+
+		ptr = line_end + 1;
+	}
+}
+
+template <typename T>
+static void append(DynamicArray<T>& dst, const DynamicArray<T>& src) {
+	u64 offset = dst.size();
+	dst.resize(offset + src.size());
+	toki::memcpy(dst.data() + offset, src.data(), src.size() * sizeof(T));
+}
+
+ObjData load_obj(const Path& path, const ObjLoadConfig& config) {
+	MappedFile file(path, FileAccessHint::SEQUENTIAL);
+	if (!file.is_open()) {
+		TK_LOG_WARN("Could not open OBJ file {}", path.c_str());
+		return {};
+	}
+
+	const char* data = reinterpret_cast<const char*>(file.data());
+	const char* end	 = data + file.size();
+
+	u32 chunk_count = 1;
+	if (config.thread_count > 1 && file.size() >= config.parallel_threshold) {
+		chunk_count = config.thread_count;
+	}
+
+	// Chunk boundaries are moved forward to the start of the next line
+	DynamicArray<ObjChunk> chunks;
+	chunks.reserve(chunk_count);
+	for (u32 i = 0; i < chunk_count; i++) {
+		chunks.emplace_back();
+		ObjChunk& chunk = chunks.last();
+		chunk.begin		= i == 0 ? data : chunks[i - 1].end;
+		chunk.end		= i == chunk_count - 1 ? end : data + file.size() / chunk_count * (i + 1);
+		if (chunk.end < chunk.begin) {
+			chunk.end = chunk.begin;
+		} else if (chunk.end < end) {
+			const void* newline = toki::memchr(chunk.end, '\n', static_cast<u64>(end - chunk.end));
+			chunk.end			= newline != nullptr ? reinterpret_cast<const char*>(newline) + 1 : end;
+		}
+	}
+
+	{
+		ThreadConfig thread_config{};
+		thread_config.name = "toki-obj-parse";
+
+		DynamicArray<UniquePtr<Thread>> threads;
+		for (u32 i = 1; i < chunk_count; i++) {
+			ObjChunk* chunk = &chunks[i];
+			threads.emplace_back(toki::make_unique<Thread>(thread_config, [chunk]() {
+				parse_chunk(*chunk);
+			}));
+		}
+
+		parse_chunk(chunks[0]);
+
+		// Joins the workers
+		threads.clear();
+	}
+
+	// Single chunk files are indexed in place, otherwise the attribute arrays are concatenated
+	DynamicArray<Vector3> merged_positions;
+	DynamicArray<Vector3> merged_normals;
+	DynamicArray<Vector2> merged_uvs;
+	DynamicArray<Vector3>* positions = &chunks[0].positions;
+	DynamicArray<Vector3>* normals	 = &chunks[0].normals;
+	DynamicArray<Vector2>* uvs		 = &chunks[0].uvs;
+	u64 corner_count				 = 0;
+	u32 invalid_face_count			 = 0;
+	for (u32 i = 0; i < chunk_count; i++) {
+		corner_count += chunks[i].corners.size();
+		invalid_face_count += chunks[i].invalid_face_count;
+	}
+
+	if (chunk_count > 1) {
+		for (u32 i = 0; i < chunk_count; i++) {
+			append(merged_positions, chunks[i].positions);
+			append(merged_normals, chunks[i].normals);
+			append(merged_uvs, chunks[i].uvs);
+		}
+		positions = &merged_positions;
+		normals	  = &merged_normals;
+		uvs		  = &merged_uvs;
+	}
+
+	ObjData result{};
+	result.index_data.reserve(corner_count);
+	result.vertex_data.reserve(corner_count / 4 + 1);
+	VertexTable table(corner_count / 4 + 1);
+
+	// Turns a chunk index into an index into the merged arrays, false when it is out of range
+	auto rebase = [](u32& index, u64 base, u64 count) -> b8 {
+		if (index == NO_INDEX) {
+			return true;
+		}
+		i64 absolute = index;
+		if ((index & CHUNK_RELATIVE_BIT) != 0) {
+			absolute = static_cast<i64>(base) + (index & ~CHUNK_RELATIVE_BIT) - CHUNK_OFFSET_BIAS;
+		}
+		index = static_cast<u32>(absolute);
+		return absolute >= 0 && absolute < static_cast<i64>(count);
+	};
+
+	u64 position_base = 0, normal_base = 0, uv_base = 0;
+	DynamicArray<Corner> face_corners;
+	for (u32 chunk_index = 0; chunk_index < chunk_count; chunk_index++) {
+		const ObjChunk& chunk = chunks[chunk_index];
+
+		u64 next_corner = 0;
+		for (u64 face = 0; face < chunk.face_triangle_counts.size(); face++) {
+			u64 first_corner = next_corner;
+			next_corner += static_cast<u64>(chunk.face_triangle_counts[face]) * 3;
+
+			// One corner out of range drops the whole face, not just the triangles using it
+			b8 valid = true;
+			face_corners.clear();
+			for (u64 i = first_corner; i < next_corner && valid; i++) {
+				Corner corner = chunk.corners[i];
+				valid		  = rebase(corner.position, position_base, positions->size()) &&
+						rebase(corner.uv, uv_base, uvs->size()) && rebase(corner.normal, normal_base, normals->size());
+				face_corners.push_back(corner);
 			}
-		} else if (toki::starts_with(buf, "vt ")) {
-			temp				   = buf + 2;
-			Vector2& texture_coord = texture_coords[texture_coord_count++];
-			for (u32 i = 0; i < 2; i++) {
-				u32 converted_count = atof(temp, value);
-				temp += converted_count - 1;
-				reinterpret_cast<f32*>(&texture_coord)[i] = value;
+
+			if (!valid) {
+				invalid_face_count++;
+				continue;
 			}
-		} else if (toki::starts_with(buf, "f ")) {
-			temp = buf + 1;
-			for (u32 i = 0; i < 3; i++) {
-				temp += handle_face(temp) - 1;
+
+			for (u64 i = 0; i < face_corners.size(); i++) {
+				const Corner& corner = face_corners[i];
+				u32 new_vertex		 = static_cast<u32>(result.vertex_data.size());
+				u32 vertex			 = table.find_or_insert(corner, new_vertex);
+				if (vertex == new_vertex) {
+					result.vertex_data.emplace_back();
+					Vertex& output	= result.vertex_data.last();
+					output.position = (*positions)[corner.position];
+					output.normals	= corner.normal != NO_INDEX ? (*normals)[corner.normal] : Vector3{};
+					output.uv		= corner.uv != NO_INDEX ? (*uvs)[corner.uv] : Vector2{};
+				}
+				result.index_data.push_back(vertex);
 			}
 		}
-	} while (read_count > 0);
 
-	return { toki::move(vertex_data), toki::move(index_data) };
+		position_base += chunk.positions.size();
+		normal_base += chunk.normals.size();
+		uv_base += chunk.uvs.size();
+	}
+
+	if (invalid_face_count > 0) {
+		TK_LOG_WARN("Skipped {} invalid faces in {}", invalid_face_count, path.c_str());
+	}
+
+	// DynamicArray does not destroy its elements, release the per chunk arrays explicitly
+	chunks.clear();
+
+	if (config.optimize) {
+		optimize_mesh(result);
+	}
+
+	return result;
+}
+
+MeshOptimizationStatistics optimize_mesh(ObjData& data) {
+	u32 vertex_count = static_cast<u32>(data.vertex_data.size());
+	MeshOptimizationStatistics statistics{};
+	statistics.cache_before = analyze_vertex_cache(data.index_data, vertex_count);
+	statistics.fetch_before = analyze_vertex_fetch(data.index_data, vertex_count, sizeof(Vertex));
+	if (data.index_data.size() == 0) {
+		return statistics;
+	}
+
+	DynamicArray<u32> reordered(data.index_data.size());
+	optimize_vertex_cache(data.index_data, vertex_count, reordered.data());
+	optimize_overdraw(
+		reordered, &data.vertex_data[0].position, sizeof(Vertex), vertex_count, data.index_data.data());
+
+	vertex_count = optimize_vertex_fetch(
+		data.index_data.data(), data.index_data.size(), data.vertex_data.data(), vertex_count, sizeof(Vertex));
+	data.vertex_data.shrink_to_size(vertex_count);
+
+	statistics.cache_after = analyze_vertex_cache(data.index_data, vertex_count);
+	statistics.fetch_after = analyze_vertex_fetch(data.index_data, vertex_count, sizeof(Vertex));
+	return statistics;
 }
 
 }  // namespace toki
@@ -11,6 +11,29 @@ struct ObjData {
 	DynamicArray<u32> index_data;
 };
 
-ObjData load_obj(const Path& path);
+struct ObjLoadConfig {
+	// Files of at least parallel_threshold bytes are split into this many chunks that are parsed
+	// on separate threads, vertex deduplication still runs on the calling thread afterwards
+	u32 thread_count	   = 1;
+	u64 parallel_threshold = MB(16);
+
+	// Runs optimize_mesh on the result
+	b8 optimize = false;
+};
+
+struct MeshOptimizationStatistics {
+	VertexCacheStatistics cache_before;
+	VertexCacheStatistics cache_after;
+	VertexFetchStatistics fetch_before;
+	VertexFetchStatistics fetch_after;
+};
+
+// Reorders the triangles for the post transform cache and overdraw and then the vertices for
+// fetch locality, unused vertices are dropped. Rendering the result looks the same.
+MeshOptimizationStatistics optimize_mesh(ObjData& data);
+
+// Supports positions, normals and texture coordinates, negative (relative) indices and
+// polygonal faces, which are triangulated as a fan. Other statements are ignored.
+ObjData load_obj(const Path& path, const ObjLoadConfig& config = {});
 
 }  // namespace toki
@@ -10,6 +10,11 @@ ResourceData load_text(const Path& path) {
 	ResourceData resource_data{};
 
 	File file(path, FileMode::READ, FileFlags::FILE_FLAG_OPEN_EXISTING);
+	if (!file.is_open()) {
+		TK_LOG_WARN("Could not open text file {}", path.c_str());
+		return resource_data;
+	}
+
 	file.seek(0, FileCursorStart::END);
 	resource_data.size = file.tell();
 	file.seek(0, FileCursorStart::BEGIN);
@@ -2,31 +2,147 @@
 
 #include <toki/runtime/allocators.h>
 
+// Files are mapped and decoded from memory, stb doesn't need to read them itself
+#define STBI_NO_STDIO
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
 
 namespace toki {
 
-ResourceData load_texture(const Path& path) {
-	ResourceData resource_data{};
+static constexpr u32 TEXTURE_CHANNELS = 4;
+
+static TextureInfo make_texture_info(u32 width, u32 height, const TextureImportConfig& config) {
+	TextureInfo info{};
+	info.width		= width;
+	info.height		= height;
+	info.mip_levels = config.generate_mips ? mip_level_count(width, height) : 1;
+	info.size		= mip_chain_size(width, height, info.mip_levels);
+	return info;
+}
 
-	void* pixels = stbi_load(
-		path.c_str(),
-		&resource_data.metadata.texture.width,
-		&resource_data.metadata.texture.height,
-		&resource_data.metadata.texture.channels,
-		STBI_rgb_alpha);
+// stb always decodes into memory it allocates itself, the pixels are copied out of it exactly once
+static stbi_uc* decode_texture(const Path& path, i32& width_out, i32& height_out) {
+	MappedFile file(path, FileAccessHint::SEQUENTIAL);
+	if (!file.is_open()) {
+		TK_LOG_WARN("Could not open texture {}", path.c_str());
+		return nullptr;
+	}
 
-	resource_data.metadata.texture.channels = 4;
+	i32 channels	= 0;
+	stbi_uc* pixels = stbi_load_from_memory(
+		file.data(), static_cast<i32>(file.size()), &width_out, &height_out, &channels, STBI_rgb_alpha);
+	if (pixels == nullptr) {
+		TK_LOG_WARN("Could not load texture {}: {}", path.c_str(), stbi_failure_reason());
+	}
 
-	resource_data.size = resource_data.metadata.texture.width * resource_data.metadata.texture.height *
-						 resource_data.metadata.texture.channels;
-	resource_data.data = ResourceAllocator::allocate(resource_data.size);
+	return pixels;
+}
 
-	toki::memcpy(resource_data.data, pixels, resource_data.size);
+Optional<TextureInfo> read_texture_info(const Path& path, const TextureImportConfig& config) {
+	MappedFile file(path, FileAccessHint::SEQUENTIAL);
+	if (!file.is_open()) {
+		TK_LOG_WARN("Could not open texture {}", path.c_str());
+		return {};
+	}
+
+	i32 width	 = 0;
+	i32 height	 = 0;
+	i32 channels = 0;
+	if (!stbi_info_from_memory(file.data(), static_cast<i32>(file.size()), &width, &height, &channels)) {
+		TK_LOG_WARN("Could not read texture info {}: {}", path.c_str(), stbi_failure_reason());
+		return {};
+	}
+
+	return make_texture_info(static_cast<u32>(width), static_cast<u32>(height), config);
+}
+
+b8 import_texture(const Path& path, const TextureInfo& info, void* destination, const TextureImportConfig& config) {
+	i32 width		= 0;
+	i32 height		= 0;
+	stbi_uc* pixels = decode_texture(path, width, height);
+	if (pixels == nullptr) {
+		return false;
+	}
+
+	if (static_cast<u32>(width) != info.width || static_cast<u32>(height) != info.height) {
+		TK_LOG_WARN("Texture {} changed after its info was read", path.c_str());
+		stbi_image_free(pixels);
+		return false;
+	}
+
+	byte* output   = reinterpret_cast<byte*>(destination);
+	u64 level_size = static_cast<u64>(info.width) * info.height * TEXTURE_CHANNELS;
+	toki::memcpy(output, pixels, level_size);
+
+	// Smaller levels are filtered from the previous one, they are generated in regular memory
+	// first since upload memory is usually write combined and very slow to read back
+	if (info.mip_levels > 1) {
+		byte* levels = reinterpret_cast<byte*>(DefaultAllocator::allocate(info.size - level_size));
+		toki::generate_mip_chain(pixels, info.width, info.height, info.mip_levels, levels, config.mip_config);
+		toki::memcpy(output + level_size, levels, info.size - level_size);
+		DefaultAllocator::free(levels);
+	}
 
 	stbi_image_free(pixels);
+	return true;
+}
+
+void import_textures(TextureImportJob* jobs, u64 job_count, u32 thread_count, const TextureImportConfig& config) {
+	TK_ASSERT(thread_count > 0);
 
+	// Jobs are claimed one at a time, image sizes vary too much to split them up front
+	i32 next_job = 0;
+
+	auto work = [&]() {
+		while (true) {
+			i32 job = atomic_load(&next_job);
+			while (job < static_cast<i32>(job_count) && !atomic_compare_exchange_weak(&next_job, &job, job + 1)) {}
+			if (job >= static_cast<i32>(job_count)) {
+				return;
+			}
+
+			TextureImportJob& current = jobs[job];
+			current.imported		  = import_texture(current.path, current.info, current.destination, config);
+		}
+	};
+
+	ThreadConfig thread_config{};
+	thread_config.name		 = "toki-texture-import";
+	thread_config.stack_size = KB(512);
+
+	DynamicArray<UniquePtr<Thread>> threads;
+	for (u32 i = 1; i < thread_count; i++) {
+		threads.emplace_back(toki::make_unique<Thread>(thread_config, work));
+	}
+	work();
+	threads.clear();
+}
+
+ResourceData load_texture(const Path& path, const TextureImportConfig& config) {
+	i32 width		= 0;
+	i32 height		= 0;
+	stbi_uc* pixels = decode_texture(path, width, height);
+	if (pixels == nullptr) {
+		return {};
+	}
+
+	TextureInfo info = make_texture_info(static_cast<u32>(width), static_cast<u32>(height), config);
+
+	ResourceData resource_data{};
+	resource_data.metadata.texture.width	  = width;
+	resource_data.metadata.texture.height	  = height;
+	resource_data.metadata.texture.channels	  = TEXTURE_CHANNELS;
+	resource_data.metadata.texture.mip_levels = static_cast<i32>(info.mip_levels);
+	resource_data.size						  = info.size;
+	resource_data.data						  = ResourceAllocator::allocate(info.size);
+
+	// Resource memory is readable, levels can be generated in place
+	byte* output   = reinterpret_cast<byte*>(resource_data.data);
+	u64 level_size = static_cast<u64>(info.width) * info.height * TEXTURE_CHANNELS;
+	toki::memcpy(output, pixels, level_size);
+	toki::generate_mip_chain(pixels, info.width, info.height, info.mip_levels, output + level_size, config.mip_config);
+
+	stbi_image_free(pixels);
 	return resource_data;
 }
 
@@ -1,11 +1,46 @@
 #pragma once
 
-#include <toki/core/utils/path.h>
+#include <toki/core/core.h>
 #include <toki/runtime/resources/resources.h>
 
 namespace toki {
 
-ResourceData load_texture(const Path& path);
+struct TextureImportConfig {
+	// Adds the full mip chain after level 0
+	b8 generate_mips = false;
+	// Textures are created with an sRGB format, so color is filtered in linear space by default
+	MipConfig mip_config{ MipFilter::BOX, true };
+};
+
+// Layout of an imported texture, always RGBA8
+struct TextureInfo {
+	u32 width;
+	u32 height;
+	u32 mip_levels;
+	// Bytes of every level packed one after the other, see generate_mip_chain
+	u64 size;
+};
+
+// Only parses the image header
+Optional<TextureInfo> read_texture_info(const Path& path, const TextureImportConfig& config = {});
+
+// Decodes the image and its mip chain into destination, which has to hold info.size bytes. The
+// destination is only written, so it can be upload memory from Renderer::begin_texture_upload.
+// Safe to call from multiple threads.
+b8 import_texture(
+	const Path& path, const TextureInfo& info, void* destination, const TextureImportConfig& config = {});
+
+struct TextureImportJob {
+	Path path;
+	TextureInfo info;
+	void* destination;
+	b8 imported;
+};
+
+// Runs import_texture for every job on thread_count threads, the calling thread included
+void import_textures(TextureImportJob* jobs, u64 job_count, u32 thread_count, const TextureImportConfig& config = {});
+
+ResourceData load_texture(const Path& path, const TextureImportConfig& config = {});
 void unload_texture(ResourceData& resource_data);
 
 }  // namespace toki
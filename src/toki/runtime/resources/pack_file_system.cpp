@@ -0,0 +1,252 @@
+#include "toki/runtime/resources/pack_file_system.h"
+
+namespace toki {
+
+static constexpr byte PADDING[PACK_ALIGNMENT]{};
+
+static u64 align_to_pack(u64 offset) {
+	return (offset + PACK_ALIGNMENT - 1) & ~(PACK_ALIGNMENT - 1);
+}
+
+b8 write_pack(const Path& output_path, Span<StringView> input_paths, const PackWriteConfig& config) {
+	File file(output_path, FileMode::WRITE, FILE_FLAG_CREATE | FILE_FLAG_TRUNCATE);
+	if (!file.is_open()) {
+		TK_LOG_WARN("Could not create pack file {}", output_path.c_str());
+		return false;
+	}
+
+	PackHeader header{};
+	header.magic   = PACK_MAGIC;
+	header.version = PACK_VERSION;
+
+	DynamicArray<PackEntry> entries;
+	DynamicArray<char> names;
+	DynamicArray<byte> compressed;
+
+	{
+		BufferedWriter writer(file, MB(1));
+
+		// Header is written last once the table of contents position is known
+		writer.write(PADDING, PACK_ALIGNMENT);
+		u64 position = PACK_ALIGNMENT;
+
+		for (u64 i = 0; i < input_paths.size(); i++) {
+			StringView name = input_paths[i];
+			u64 path_hash	= toki::hash_fnv1a(name);
+
+			b8 duplicate = false;
+			for (u64 j = 0; j < entries.size() && !duplicate; j++) {
+				const PackEntry& other = entries[j];
+				duplicate			   = other.path_hash == path_hash && other.name_size == name.size() &&
+						   toki::strncmp(names.data() + other.name_offset, name.data(), name.size()) == 0;
+			}
+			if (duplicate) {
+				TK_LOG_WARN("Skipping duplicate pack entry {}", name);
+				continue;
+			}
+
+			MappedFile input(Path(name), FileAccessHint::SEQUENTIAL);
+			if (!input.is_open()) {
+				TK_LOG_WARN("Could not open {} for packing", name);
+				return false;
+			}
+
+			PackEntry entry{};
+			entry.path_hash	  = path_hash;
+			entry.offset	  = position;
+			entry.stored_size = input.size();
+			entry.size		  = input.size();
+			entry.checksum	  = toki::hash_bytes(input.data(), input.size());
+			entry.name_offset = static_cast<u32>(names.size());
+			entry.name_size	  = static_cast<u32>(name.size());
+			entry.compression = PackCompression::NONE;
+
+			const void* stored = input.data();
+			if (config.compress && input.size() > 0) {
+				compressed.resize(lz4_compress_bound(input.size()));
+				u64 compressed_size = toki::lz4_compress(input.data(), input.size(), compressed.data(), compressed.size());
+				if (compressed_size > 0 && compressed_size <= input.size() - input.size() / 8) {
+					stored			  = compressed.data();
+					entry.stored_size = compressed_size;
+					entry.compression = PackCompression::LZ4;
+				}
+			}
+
+			writer.write(stored, entry.stored_size);
+			u64 end = position + entry.stored_size;
+			writer.write(PADDING, align_to_pack(end) - end);
+			position = align_to_pack(end);
+
+			for (u64 c = 0; c < name.size(); c++) {
+				names.push_back(name[c]);
+			}
+			entries.push_back(entry);
+		}
+
+		toki::sort(entries.data(), entries.size(), [](const PackEntry& lhs, const PackEntry& rhs) {
+			return lhs.path_hash < rhs.path_hash;
+		});
+
+		header.entry_count	= static_cast<u32>(entries.size());
+		header.toc_offset	= position;
+		header.names_offset = position + entries.size() * sizeof(PackEntry);
+		header.names_size	= names.size();
+		writer.write(entries.data(), entries.size() * sizeof(PackEntry));
+		writer.write(names.data(), names.size());
+		if (!writer.flush()) {
+			TK_LOG_WARN("Could not write pack file {}", output_path.c_str());
+			return false;
+		}
+	}
+
+	file.seek(0, FileCursorStart::BEGIN);
+	if (file.write(&header, sizeof(header)) != sizeof(header)) {
+		TK_LOG_WARN("Could not write pack file {}", output_path.c_str());
+		return false;
+	}
+	return true;
+}
+
+PackFileSystem::~PackFileSystem() {
+	close();
+}
+
+static b8 range_is_valid(u64 offset, u64 size, u64 file_size) {
+	return offset <= file_size && size <= file_size - offset;
+}
+
+b8 PackFileSystem::open(const Path& path) {
+	close();
+
+	if (!m_file.open(path)) {
+		TK_LOG_WARN("Could not open pack file {}", path.c_str());
+		return false;
+	}
+
+	u64 file_size			 = m_file.size();
+	const PackHeader* header = reinterpret_cast<const PackHeader*>(m_file.data());
+	b8 valid				 = file_size >= sizeof(PackHeader) && header->magic == PACK_MAGIC &&
+			   header->version == PACK_VERSION && header->toc_offset % alignof(PackEntry) == 0 &&
+			   range_is_valid(header->toc_offset, static_cast<u64>(header->entry_count) * sizeof(PackEntry), file_size) &&
+			   range_is_valid(header->names_offset, header->names_size, file_size);
+
+	const PackEntry* entries = valid ? reinterpret_cast<const PackEntry*>(m_file.data() + header->toc_offset) : nullptr;
+	for (u32 i = 0; valid && i < header->entry_count; i++) {
+		const PackEntry& entry = entries[i];
+		valid = entry.offset % PACK_ALIGNMENT == 0 && range_is_valid(entry.offset, entry.stored_size, file_size) &&
+				range_is_valid(entry.name_offset, entry.name_size, header->names_size) &&
+				(i == 0 || entries[i - 1].path_hash <= entry.path_hash);
+
+		switch (entry.compression) {
+			case PackCompression::NONE:
+				valid = valid && entry.stored_size == entry.size;
+				break;
+			case PackCompression::LZ4:
+				break;
+			default:
+				valid = false;
+				break;
+		}
+	}
+
+	if (!valid) {
+		TK_LOG_WARN("{} is not a valid pack file of version {}", path.c_str(), PACK_VERSION);
+		m_file.close();
+		return false;
+	}
+
+	m_header  = header;
+	m_entries = entries;
+	m_names	  = reinterpret_cast<const char*>(m_file.data() + header->names_offset);
+	m_decompressed.resize(header->entry_count);
+	for (u32 i = 0; i < header->entry_count; i++) {
+		m_decompressed[i] = nullptr;
+	}
+
+	return true;
+}
+
+void PackFileSystem::close() {
+	for (u64 i = 0; i < m_decompressed.size(); i++) {
+		if (m_decompressed[i] != nullptr) {
+			DefaultAllocator::free(m_decompressed[i]);
+		}
+	}
+	m_decompressed.clear();
+
+	m_header  = nullptr;
+	m_entries = nullptr;
+	m_names	  = nullptr;
+	m_file.close();
+}
+
+const PackEntry* PackFileSystem::find(StringView path) const {
+	TK_ASSERT(is_open());
+
+	u64 path_hash = toki::hash_fnv1a(path);
+	u64 low		  = 0;
+	u64 high	  = m_header->entry_count;
+	while (low < high) {
+		u64 middle = low + (high - low) / 2;
+		if (m_entries[middle].path_hash < path_hash) {
+			low = middle + 1;
+		} else {
+			high = middle;
+		}
+	}
+
+	for (; low < m_header->entry_count && m_entries[low].path_hash == path_hash; low++) {
+		const PackEntry& entry = m_entries[low];
+		if (entry.name_size == path.size() && toki::strncmp(m_names + entry.name_offset, path.data(), path.size()) == 0) {
+			return &entry;
+		}
+	}
+
+	return nullptr;
+}
+
+Optional<StringView> PackFileSystem::read(StringView path) {
+	const PackEntry* entry = find(path);
+	if (entry == nullptr) {
+		return {};
+	}
+	return read_entry(*entry);
+}
+
+b8 PackFileSystem::verify(StringView path) {
+	const PackEntry* entry = find(path);
+	if (entry == nullptr) {
+		return false;
+	}
+
+	Optional<StringView> contents = read_entry(*entry);
+	return contents.has_value() &&
+		   toki::hash_bytes(contents.value().data(), contents.value().size()) == entry->checksum;
+}
+
+Optional<StringView> PackFileSystem::read_entry(const PackEntry& entry) {
+	const char* stored = reinterpret_cast<const char*>(m_file.data() + entry.offset);
+	if (entry.compression == PackCompression::NONE) {
+		return StringView(stored, entry.size);
+	}
+
+	u64 index = static_cast<u64>(&entry - m_entries);
+
+	ScopedLock lock(m_mutex);
+	if (m_decompressed[index] == nullptr) {
+		byte* buffer = reinterpret_cast<byte*>(DefaultAllocator::allocate(toki::max<u64>(entry.size, 1)));
+		auto result	 = toki::lz4_decompress(stored, entry.stored_size, buffer, entry.size);
+
+		// Decompressing touches every byte anyway, checking the contents costs little on top
+		if (!result || result.value() != entry.size || toki::hash_bytes(buffer, entry.size) != entry.checksum) {
+			TK_LOG_WARN("Pack entry {} is corrupt", entry_name(entry));
+			DefaultAllocator::free(buffer);
+			return {};
+		}
+		m_decompressed[index] = buffer;
+	}
+
+	return StringView(reinterpret_cast<const char*>(m_decompressed[index]), entry.size);
+}
+
+}  // namespace toki
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <toki/core/core.h>
+
+namespace toki {
+
+// Archive written by the asset_packer tool. The file starts with a PackHeader, entry data
+// follows at PACK_ALIGNMENT aligned offsets and the table of contents with the entry names is
+// stored at the end. All values are little endian.
+
+static constexpr u32 PACK_MAGIC		= 0x4B415054;  // "TPAK"
+static constexpr u32 PACK_VERSION	= 1;
+static constexpr u64 PACK_ALIGNMENT = KB(4);
+
+enum struct PackCompression : u32 {
+	NONE,
+	// LZ4 block, see lz4_compress
+	LZ4,
+};
+
+struct PackHeader {
+	u32 magic;
+	u32 version;
+	u32 entry_count;
+	u32 padding;
+	// PackEntry array sorted by path_hash
+	u64 toc_offset;
+	u64 names_offset;
+	u64 names_size;
+};
+
+struct PackEntry {
+	// hash_fnv1a of the name
+	u64 path_hash;
+	u64 offset;
+	// Bytes in the archive, equal to size for uncompressed entries
+	u64 stored_size;
+	u64 size;
+	// hash_bytes of the uncompressed contents
+	u64 checksum;
+	u32 name_offset;
+	u32 name_size;
+	PackCompression compression;
+	u32 padding;
+};
+
+struct PackWriteConfig {
+	// Entries are only stored compressed when that saves at least an eighth of their size
+	b8 compress = false;
+};
+
+// Entry names are the paths as given, lookups use the same relative paths as loose files
+b8 write_pack(const Path& output_path, Span<StringView> input_paths, const PackWriteConfig& config = {});
+
+// Serves the entries of a mapped pack file. Uncompressed entries are returned as views into the
+// mapping, compressed ones are decompressed on first read and kept until the pack is closed.
+class PackFileSystem {
+public:
+	PackFileSystem() = default;
+	~PackFileSystem();
+
+	DELETE_COPY(PackFileSystem)
+	DELETE_MOVE(PackFileSystem)
+
+	// Validates the header and the table of contents, a pack that fails validation is not kept open
+	b8 open(const Path& path);
+	void close();
+
+	b8 is_open() const {
+		return m_header != nullptr;
+	}
+
+	u32 entry_count() const {
+		return m_header->entry_count;
+	}
+
+	const PackEntry* find(StringView path) const;
+
+	b8 contains(StringView path) const {
+		return find(path) != nullptr;
+	}
+
+	StringView entry_name(const PackEntry& entry) const {
+		return StringView(m_names + entry.name_offset, entry.name_size);
+	}
+
+	// Empty when the entry doesn't exist or can't be decompressed, safe to call from multiple threads
+	Optional<StringView> read(StringView path);
+
+	// Hashes the contents and compares them with the stored checksum
+	b8 verify(StringView path);
+
+private:
+	Optional<StringView> read_entry(const PackEntry& entry);
+
+	MappedFile m_file;
+	const PackHeader* m_header{};
+	const PackEntry* m_entries{};
+	const char* m_names{};
+
+	// Guards m_decompressed
+	Mutex m_mutex;
+	// One per entry, null until a compressed entry is first read
+	DynamicArray<byte*> m_decompressed;
+};
+
+}  // namespace toki
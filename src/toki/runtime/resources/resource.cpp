@@ -16,37 +16,43 @@ Resource::~Resource() {
 	}
 }
 
-void Resource::load_as(const Path& path, ResourceType type) {
+ResourceData load_resource_data(const Path& path, ResourceType type) {
 	switch (type) {
 		case ResourceType::BINARY:
 			break;
 		case ResourceType::TEXT:
-			m_data.resource_data = load_text(path);
-			break;
+			return load_text(path);
 		case toki::ResourceType::NONE:
 			break;
 		case ResourceType::TEXTURE:
-			m_data.resource_data = load_texture(path);
-			break;
+			return load_texture(path);
 	}
 
-	m_data.type = type;
+	return {};
 }
 
-void Resource::unload() {
-	switch (m_data.type) {
+void unload_resource_data(ResourceData& resource_data, ResourceType type) {
+	switch (type) {
 		case ResourceType::BINARY:
 			break;
 		case ResourceType::TEXT:
-			unload_text(m_data.resource_data);
+			unload_text(resource_data);
 			break;
 		case toki::ResourceType::NONE:
 			break;
 		case ResourceType::TEXTURE:
-			unload_texture(m_data.resource_data);
+			unload_texture(resource_data);
 			break;
 	}
+}
 
+void Resource::load_as(const Path& path, ResourceType type) {
+	m_data.resource_data = load_resource_data(path, type);
+	m_data.type			 = type;
+}
+
+void Resource::unload() {
+	unload_resource_data(m_data.resource_data, m_data.type);
 	m_data.type = ResourceType::NONE;
 }
 
@@ -6,6 +6,10 @@
 
 namespace toki {
 
+// Runs the loader for the resource type, the returned data is empty when loading failed
+ResourceData load_resource_data(const Path& path, ResourceType type);
+void unload_resource_data(ResourceData& resource_data, ResourceType type);
+
 class Resource {
 public:
 	Resource() = default;
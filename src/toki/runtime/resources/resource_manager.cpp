@@ -0,0 +1,467 @@
+#include "toki/runtime/resources/resource_manager.h"
+
+namespace toki {
+
+static constexpr u32 INITIAL_BUCKET_COUNT = 64;
+
+struct ResourceEntry {
+	u64 key{};
+	Path path{};
+	ResourceType type{};
+
+	ResourceData data{};
+	u64 content_hash{};
+	// ResourceState, written under the manager mutex but read by handles without it
+	i32 state{};
+	u32 reference_count{};
+
+	ResourceEntry* bucket_next{};
+	ResourceEntry* lru_previous{};
+	ResourceEntry* lru_next{};
+	b8 in_lru{};
+	// Invalidated while referenced, no longer in the hash map and destroyed on the last release
+	b8 detached{};
+};
+
+static u64 resource_key(const Path& path, ResourceType type) {
+	return toki::hash_fnv1a(path.c_str(), toki::strlen(path.c_str()), FNV1A_OFFSET_BASIS + static_cast<u64>(type));
+}
+
+static b8 paths_equal(const Path& lhs, const Path& rhs) {
+	u64 size = toki::strlen(lhs.c_str());
+	return size == toki::strlen(rhs.c_str()) && toki::strncmp(lhs.c_str(), rhs.c_str(), size) == 0;
+}
+
+static void signal(i32* value) {
+	atomic_fetch_add(value, 1);
+	atomic_notify_all(value);
+}
+
+ResourceHandle::~ResourceHandle() {
+	reset();
+}
+
+ResourceHandle::ResourceHandle(const ResourceHandle& other): m_manager(other.m_manager), m_entry(other.m_entry) {
+	if (m_entry != nullptr) {
+		m_manager->add_reference(m_entry);
+	}
+}
+
+ResourceHandle& ResourceHandle::operator=(const ResourceHandle& other) {
+	if (&other == this) {
+		return *this;
+	}
+
+	reset();
+	m_manager = other.m_manager;
+	m_entry	  = other.m_entry;
+	if (m_entry != nullptr) {
+		m_manager->add_reference(m_entry);
+	}
+	return *this;
+}
+
+ResourceHandle::ResourceHandle(ResourceHandle&& other): m_manager(other.m_manager), m_entry(other.m_entry) {
+	other.m_manager = nullptr;
+	other.m_entry	= nullptr;
+}
+
+ResourceHandle& ResourceHandle::operator=(ResourceHandle&& other) {
+	if (&other == this) {
+		return *this;
+	}
+
+	reset();
+	m_manager		= other.m_manager;
+	m_entry			= other.m_entry;
+	other.m_manager = nullptr;
+	other.m_entry	= nullptr;
+	return *this;
+}
+
+ResourceState ResourceHandle::state() const {
+	TK_ASSERT(valid());
+	return static_cast<ResourceState>(atomic_load(&m_entry->state));
+}
+
+b8 ResourceHandle::wait() const {
+	TK_ASSERT(valid());
+	while (true) {
+		i32 state = atomic_load(&m_entry->state);
+		if (state == static_cast<i32>(ResourceState::READY)) {
+			return true;
+		}
+		if (state == static_cast<i32>(ResourceState::FAILED)) {
+			return false;
+		}
+		atomic_wait(&m_entry->state, state);
+	}
+}
+
+void ResourceHandle::reset() {
+	if (m_entry != nullptr) {
+		m_manager->release(m_entry);
+	}
+	m_manager = nullptr;
+	m_entry	  = nullptr;
+}
+
+const void* ResourceHandle::data() const {
+	TK_ASSERT(is_ready());
+	return m_entry->data.data;
+}
+
+u64 ResourceHandle::size() const {
+	TK_ASSERT(is_ready());
+	return m_entry->data.size;
+}
+
+const ResourceMetadata& ResourceHandle::metadata() const {
+	TK_ASSERT(is_ready());
+	return m_entry->data.metadata;
+}
+
+u64 ResourceHandle::content_hash() const {
+	TK_ASSERT(is_ready());
+	return m_entry->content_hash;
+}
+
+ResourceManager::ResourceManager(const ResourceManagerConfig& config):
+	m_config(config),
+	m_buckets(INITIAL_BUCKET_COUNT, nullptr) {
+	// Synchronous loads wait on entries that are queued, something has to pick those up
+	TK_ASSERT(m_config.worker_count > 0);
+
+	atomic_store(&m_running, 1);
+
+	ThreadConfig thread_config{};
+	thread_config.name		 = "toki-resources";
+	thread_config.stack_size = KB(256);
+	for (u32 i = 0; i < m_config.worker_count; i++) {
+		m_workers.emplace_back(toki::make_unique<Thread>(thread_config, [this]() {
+			worker_loop();
+		}));
+	}
+}
+
+ResourceManager::~ResourceManager() {
+	atomic_store(&m_running, 0);
+	signal(&m_workSignal);
+	m_workers.clear();
+
+	// Requests the workers never got to, the ones invalidated meanwhile are no longer in the buckets
+	for (u64 i = m_queueHead; i < m_queue.size(); i++) {
+		if (m_queue[i]->detached) {
+			destroy(m_queue[i]);
+		}
+	}
+	m_queue.clear();
+
+	for (u32 i = 0; i < m_buckets.size(); i++) {
+		ResourceEntry* entry = m_buckets[i];
+		while (entry != nullptr) {
+			ResourceEntry* next = entry->bucket_next;
+			if (entry->reference_count > 0) {
+				TK_LOG_WARN("Resource {} is still referenced while its manager is destroyed", entry->path.c_str());
+			}
+			destroy(entry);
+			entry = next;
+		}
+	}
+}
+
+ResourceHandle ResourceManager::load_async(const Path& path, ResourceType type) {
+	b8 created			 = false;
+	ResourceEntry* entry = acquire(path, type, created);
+
+	if (created) {
+		{
+			ScopedLock lock(m_mutex);
+			m_queue.push_back(entry);
+		}
+		signal(&m_workSignal);
+	}
+
+	return ResourceHandle(this, entry);
+}
+
+ResourceHandle ResourceManager::load(const Path& path, ResourceType type) {
+	b8 created			 = false;
+	ResourceEntry* entry = acquire(path, type, created);
+	ResourceHandle handle(this, entry);
+
+	if (created) {
+		atomic_store(&entry->state, static_cast<i32>(ResourceState::LOADING));
+		finish_load(entry);
+	} else {
+		handle.wait();
+	}
+
+	return handle;
+}
+
+u32 ResourceManager::invalidate(const Path& path) {
+	ScopedLock lock(m_mutex);
+
+	// The path is hashed together with the type, so every bucket has to be checked
+	u32 invalidated_count = 0;
+	for (u32 i = 0; i < m_buckets.size(); i++) {
+		ResourceEntry* entry = m_buckets[i];
+		while (entry != nullptr) {
+			ResourceEntry* next = entry->bucket_next;
+			if (paths_equal(entry->path, path)) {
+				remove(entry);
+				if (entry->in_lru) {
+					lru_remove(entry);
+					destroy(entry);
+				} else {
+					entry->detached = true;
+				}
+				invalidated_count++;
+			}
+			entry = next;
+		}
+	}
+
+	return invalidated_count;
+}
+
+void ResourceManager::set_cache_budget(u64 budget) {
+	ScopedLock lock(m_mutex);
+	m_config.cache_budget = budget;
+	evict_over_budget();
+}
+
+u64 ResourceManager::resident_size() const {
+	ScopedLock lock(m_mutex);
+	return m_residentSize;
+}
+
+u32 ResourceManager::entry_count() const {
+	ScopedLock lock(m_mutex);
+	return m_entryCount;
+}
+
+// New entries are returned in the QUEUED state, the caller either loads them itself or queues them
+ResourceEntry* ResourceManager::acquire(const Path& path, ResourceType type, b8& created_out) {
+	u64 key = resource_key(path, type);
+
+	ScopedLock lock(m_mutex);
+	ResourceEntry* entry = find(key, path, type);
+	// Failed loads are only cached while handles to them exist, a new request tries again
+	if (entry != nullptr && atomic_load(&entry->state) == static_cast<i32>(ResourceState::FAILED)) {
+		remove(entry);
+		entry->detached = true;
+		entry			= nullptr;
+	}
+	if (entry != nullptr) {
+		if (entry->in_lru) {
+			lru_remove(entry);
+		}
+		entry->reference_count++;
+		created_out = false;
+		return entry;
+	}
+
+	entry = toki::construct_at<ResourceEntry>(
+		DefaultAllocator::allocate_aligned(sizeof(ResourceEntry), alignof(ResourceEntry)));
+	entry->key			   = key;
+	entry->path			   = path;
+	entry->type			   = type;
+	entry->reference_count = 1;
+	atomic_store(&entry->state, static_cast<i32>(ResourceState::QUEUED));
+
+	insert(entry);
+	created_out = true;
+	return entry;
+}
+
+void ResourceManager::add_reference(ResourceEntry* entry) {
+	ScopedLock lock(m_mutex);
+	entry->reference_count++;
+}
+
+void ResourceManager::release(ResourceEntry* entry) {
+	ScopedLock lock(m_mutex);
+	TK_ASSERT(entry->reference_count > 0);
+	if (--entry->reference_count > 0) {
+		return;
+	}
+
+	if (entry->detached) {
+		// Loads still in flight are destroyed by finish_load
+		ResourceState state = static_cast<ResourceState>(atomic_load(&entry->state));
+		if (state == ResourceState::READY || state == ResourceState::FAILED) {
+			destroy(entry);
+		}
+		return;
+	}
+
+	switch (static_cast<ResourceState>(atomic_load(&entry->state))) {
+		case ResourceState::READY:
+			lru_push(entry);
+			evict_over_budget();
+			break;
+		case ResourceState::FAILED:
+			// Not cached so the next request tries again
+			remove(entry);
+			destroy(entry);
+			break;
+		case ResourceState::QUEUED:
+		case ResourceState::LOADING:
+			// Finished loads with no references are cached by finish_load
+			break;
+	}
+}
+
+void ResourceManager::finish_load(ResourceEntry* entry) {
+	ResourceData data = load_resource_data(entry->path, entry->type);
+	b8 loaded		  = data.data != nullptr;
+	u64 content_hash  = loaded ? toki::hash_bytes(data.data, data.size) : 0;
+
+	ScopedLock lock(m_mutex);
+	entry->data			= data;
+	entry->content_hash = content_hash;
+	if (loaded) {
+		m_residentSize += data.size;
+	}
+	atomic_store(&entry->state, static_cast<i32>(loaded ? ResourceState::READY : ResourceState::FAILED));
+
+	if (entry->reference_count > 0) {
+		atomic_notify_all(&entry->state);
+	} else if (entry->detached) {
+		destroy(entry);
+	} else if (loaded) {
+		lru_push(entry);
+		evict_over_budget();
+	} else {
+		remove(entry);
+		destroy(entry);
+	}
+}
+
+void ResourceManager::evict_over_budget() {
+	while (m_residentSize > m_config.cache_budget && m_lruHead != nullptr) {
+		ResourceEntry* entry = m_lruHead;
+		lru_remove(entry);
+		remove(entry);
+		destroy(entry);
+	}
+}
+
+ResourceEntry* ResourceManager::find(u64 key, const Path& path, ResourceType type) const {
+	ResourceEntry* entry = m_buckets[key & (m_buckets.size() - 1)];
+	while (entry != nullptr) {
+		if (entry->key == key && entry->type == type && paths_equal(entry->path, path)) {
+			return entry;
+		}
+		entry = entry->bucket_next;
+	}
+	return nullptr;
+}
+
+void ResourceManager::insert(ResourceEntry* entry) {
+	if (m_entryCount >= m_buckets.size()) {
+		DynamicArray<ResourceEntry*> buckets(m_buckets.size() * 2, nullptr);
+		for (u32 i = 0; i < m_buckets.size(); i++) {
+			ResourceEntry* current = m_buckets[i];
+			while (current != nullptr) {
+				ResourceEntry* next	 = current->bucket_next;
+				u64 bucket			 = current->key & (buckets.size() - 1);
+				current->bucket_next = buckets[bucket];
+				buckets[bucket]		 = current;
+				current				 = next;
+			}
+		}
+		m_buckets = toki::move(buckets);
+	}
+
+	u64 bucket		   = entry->key & (m_buckets.size() - 1);
+	entry->bucket_next = m_buckets[bucket];
+	m_buckets[bucket]  = entry;
+	m_entryCount++;
+}
+
+void ResourceManager::remove(ResourceEntry* entry) {
+	ResourceEntry** link = &m_buckets[entry->key & (m_buckets.size() - 1)];
+	while (*link != entry) {
+		TK_ASSERT(*link != nullptr);
+		link = &(*link)->bucket_next;
+	}
+	*link = entry->bucket_next;
+	m_entryCount--;
+}
+
+void ResourceManager::destroy(ResourceEntry* entry) {
+	if (atomic_load(&entry->state) == static_cast<i32>(ResourceState::READY)) {
+		m_residentSize -= entry->data.size;
+		unload_resource_data(entry->data, entry->type);
+	}
+	toki::destroy_at(entry);
+	DefaultAllocator::free_aligned(entry);
+}
+
+void ResourceManager::lru_push(ResourceEntry* entry) {
+	TK_ASSERT(!entry->in_lru);
+	entry->lru_previous = m_lruTail;
+	entry->lru_next		= nullptr;
+	if (m_lruTail != nullptr) {
+		m_lruTail->lru_next = entry;
+	} else {
+		m_lruHead = entry;
+	}
+	m_lruTail	  = entry;
+	entry->in_lru = true;
+}
+
+void ResourceManager::lru_remove(ResourceEntry* entry) {
+	TK_ASSERT(entry->in_lru);
+	if (entry->lru_previous != nullptr) {
+		entry->lru_previous->lru_next = entry->lru_next;
+	} else {
+		m_lruHead = entry->lru_next;
+	}
+	if (entry->lru_next != nullptr) {
+		entry->lru_next->lru_previous = entry->lru_previous;
+	} else {
+		m_lruTail = entry->lru_previous;
+	}
+	entry->lru_previous = nullptr;
+	entry->lru_next		= nullptr;
+	entry->in_lru		= false;
+}
+
+ResourceEntry* ResourceManager::take_queued() {
+	ScopedLock lock(m_mutex);
+	if (m_queueHead == m_queue.size()) {
+		return nullptr;
+	}
+
+	ResourceEntry* entry = m_queue[m_queueHead++];
+	if (m_queueHead == m_queue.size()) {
+		m_queue.clear();
+		m_queueHead = 0;
+	}
+	atomic_store(&entry->state, static_cast<i32>(ResourceState::LOADING));
+	return entry;
+}
+
+void ResourceManager::worker_loop() {
+	for (;;) {
+		// Read before checking m_running so a shutdown signalled in between can't be missed
+		i32 signal_value = atomic_load(&m_workSignal);
+		if (atomic_load(&m_running) == 0) {
+			return;
+		}
+
+		ResourceEntry* entry = take_queued();
+		if (entry == nullptr) {
+			atomic_wait(&m_workSignal, signal_value);
+			continue;
+		}
+
+		finish_load(entry);
+	}
+}
+
+}  // namespace toki
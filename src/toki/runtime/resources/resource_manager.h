@@ -0,0 +1,135 @@
+#pragma once
+
+#include <toki/core/core.h>
+#include <toki/runtime/resources/resource.h>
+
+namespace toki {
+
+struct ResourceManagerConfig {
+	// Resident bytes allowed before released resources are unloaded, least recently used first.
+	// Resources that still have handles count towards it but are never unloaded.
+	u64 cache_budget = MB(256);
+	u32 worker_count = 2;
+};
+
+enum struct ResourceState : i32 {
+	QUEUED,
+	LOADING,
+	READY,
+	FAILED,
+};
+
+class ResourceManager;
+struct ResourceEntry;
+
+// Shared reference to a resource owned by a ResourceManager, the resource stays loaded as long
+// as a handle to it exists. Handles have to be released before the manager is destroyed.
+class ResourceHandle {
+public:
+	ResourceHandle() = default;
+	~ResourceHandle();
+
+	ResourceHandle(const ResourceHandle& other);
+	ResourceHandle& operator=(const ResourceHandle& other);
+	ResourceHandle(ResourceHandle&& other);
+	ResourceHandle& operator=(ResourceHandle&& other);
+
+	b8 valid() const {
+		return m_entry != nullptr;
+	}
+
+	ResourceState state() const;
+
+	b8 is_ready() const {
+		return state() == ResourceState::READY;
+	}
+
+	// Blocks until loading finished, returns false if it failed
+	b8 wait() const;
+
+	void reset();
+
+	// Only valid once the resource is ready
+	const void* data() const;
+	u64 size() const;
+	const ResourceMetadata& metadata() const;
+	// Hash of the loaded bytes, stays the same when a resource is reloaded with the same contents
+	u64 content_hash() const;
+
+private:
+	friend class ResourceManager;
+
+	ResourceHandle(ResourceManager* manager, ResourceEntry* entry): m_manager(manager), m_entry(entry) {}
+
+	ResourceManager* m_manager{};
+	ResourceEntry* m_entry{};
+};
+
+// Cache of loaded resources keyed by the hash of their path and type. Each resource is loaded
+// once no matter how many handles to it are requested, also while it is still in flight.
+class ResourceManager {
+public:
+	ResourceManager(const ResourceManagerConfig& config = {});
+	~ResourceManager();
+
+	DELETE_COPY(ResourceManager)
+	DELETE_MOVE(ResourceManager)
+
+	// Returns right away, the handle becomes ready once a worker loaded the resource
+	ResourceHandle load_async(const Path& path, ResourceType type);
+	// Loads on the calling thread unless the resource is already cached or in flight, in which
+	// case it waits for it
+	ResourceHandle load(const Path& path, ResourceType type);
+
+	// Drops the cached copies of a file that changed on disk, returns how many were dropped. Handles
+	// that are still held keep the old data, the next load of the path reads the file again.
+	u32 invalidate(const Path& path);
+
+	void set_cache_budget(u64 budget);
+
+	// Bytes of every loaded resource, referenced or only cached
+	u64 resident_size() const;
+	u32 entry_count() const;
+
+private:
+	friend class ResourceHandle;
+
+	ResourceEntry* acquire(const Path& path, ResourceType type, b8& created_out);
+	void add_reference(ResourceEntry* entry);
+	void release(ResourceEntry* entry);
+
+	void finish_load(ResourceEntry* entry);
+	void evict_over_budget();
+
+	ResourceEntry* find(u64 key, const Path& path, ResourceType type) const;
+	void insert(ResourceEntry* entry);
+	void remove(ResourceEntry* entry);
+	void destroy(ResourceEntry* entry);
+
+	void lru_push(ResourceEntry* entry);
+	void lru_remove(ResourceEntry* entry);
+
+	ResourceEntry* take_queued();
+	void worker_loop();
+
+	ResourceManagerConfig m_config{};
+
+	// Guards everything below except the workers, loading itself runs without holding it
+	mutable Mutex m_mutex;
+	DynamicArray<ResourceEntry*> m_buckets;
+	u32 m_entryCount{};
+	u64 m_residentSize{};
+
+	// Released resources, the head is the least recently used one
+	ResourceEntry* m_lruHead{};
+	ResourceEntry* m_lruTail{};
+
+	DynamicArray<ResourceEntry*> m_queue;
+	u64 m_queueHead{};
+
+	DynamicArray<UniquePtr<Thread>> m_workers;
+	i32 m_workSignal{};
+	i32 m_running{};
+};
+
+}  // namespace toki
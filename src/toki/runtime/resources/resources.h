@@ -14,6 +14,8 @@ enum class ResourceType {
 union ResourceMetadata {
 	struct {
 		i32 width, height, channels;
+		// Levels are stored one after the other starting with level 0
+		i32 mip_levels;
 	} texture;
 	struct {
 	} model;
@@ -0,0 +1,22 @@
+#include <toki/runtime/resources/text_resource.h>
+
+namespace toki {
+
+b8 TextResource::load(const Path& path) {
+	unload();
+
+	if (!m_file.open(path)) {
+		TK_LOG_WARN("Could not open text file {}", path.c_str());
+		return false;
+	}
+
+	m_index.reset(m_file.as_string());
+	return true;
+}
+
+void TextResource::unload() {
+	m_index.reset({});
+	m_file.close();
+}
+
+}  // namespace toki
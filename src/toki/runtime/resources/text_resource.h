@@ -0,0 +1,47 @@
+#pragma once
+
+#include <toki/core/core.h>
+
+namespace toki {
+
+// Text file mapped read only instead of read into a buffer like load_text does. Opening costs no
+// reads, the kernel loads pages as lines are accessed and the line index is built as far as the
+// lines that were asked for.
+class TextResource {
+public:
+	TextResource() = default;
+
+	b8 load(const Path& path);
+	void unload();
+
+	b8 is_loaded() const {
+		return m_file.is_open();
+	}
+
+	StringView text() const {
+		return m_file.as_string();
+	}
+
+	u64 line_count() {
+		return m_index.line_count();
+	}
+
+	b8 has_line(u64 index) {
+		return m_index.has_line(index);
+	}
+
+	StringView line(u64 index) {
+		return m_index.line(index);
+	}
+
+	// Front to back without building the index
+	LineRange lines() const {
+		return LineRange{ text() };
+	}
+
+private:
+	MappedFile m_file;
+	LineIndex m_index;
+};
+
+}  // namespace toki
@@ -8,14 +8,23 @@
 #include <toki/runtime/engine/layer.h>
 
 // Resources
+#include <toki/runtime/resources/cooked_mesh.h>
+#include <toki/runtime/resources/cooked_texture.h>
 #include <toki/runtime/resources/loaders/obj_loader.h>
 #include <toki/runtime/resources/loaders/text_loader.h>
+#include <toki/runtime/resources/loaders/texture_loader.h>
+#include <toki/runtime/resources/pack_file_system.h>
 #include <toki/runtime/resources/resource.h>
+#include <toki/runtime/resources/resource_manager.h>
 #include <toki/runtime/resources/resources.h>
+#include <toki/runtime/resources/text_resource.h>
 
 // Rendering
 #include <toki/runtime/render/camera.h>
 #include <toki/runtime/render/freeflight_camera_controller.h>
+#include <toki/runtime/render/spatial.h>
+#include <toki/runtime/render/text_layout_cache.h>
+#include <toki/runtime/render/text_renderer.h>
 
 // Systems
 #include <toki/runtime/systems/font_system.h>
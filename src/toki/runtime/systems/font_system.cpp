@@ -5,10 +5,10 @@
 #define STBTT_ifloor(x)	   toki::floor(x)
 #define STBTT_iceil(x)	   toki::ceil(x)
 #define STBTT_sqrt(x)	   toki::sqrt(x)
-#define STBTT_pow(x, y)	   toki::pow(x, y)
+#define STBTT_pow(x, y)	   toki::pow(static_cast<toki::f32>(x), static_cast<toki::f32>(y))
 #define STBTT_fmod(x, y)   toki::mod<toki::f32>(x, y)
-#define STBTT_cos(x)	   toki::cos(x)
-#define STBTT_acos(x)	   toki::acos(x)
+#define STBTT_cos(x)	   toki::cos(static_cast<toki::f32>(x))
+#define STBTT_acos(x)	   toki::acos(static_cast<toki::f32>(x))
 #define STBTT_fabs(x)	   toki::abs<toki::f32>(x)
 #define STBTT_assert(x)	   toki::assert(x)
 #define STBTT_strlen(x)	   toki::strlen(x)
@@ -26,69 +26,187 @@ POP_WARNING;
 
 namespace toki {
 
+// Texel value of the outline, distances inside the glyph are stored above it
+static constexpr u8 SDF_ON_EDGE_VALUE = 128;
+
+// Packed glyphs are kept a texel apart so filtering never reads a neighbour
+static constexpr u32 GLYPH_SPACING = 1;
+
+static constexpr u32 INITIAL_GLYPH_SLOTS = 256;
+
+static u32 glyph_slot(u32 code_point, u32 slot_count) {
+	return (code_point * 2654435761u) & (slot_count - 1);
+}
+
+static const Glyph* find_glyph(const Font& font, u32 code_point) {
+	u32 slot_count = static_cast<u32>(font.glyph_slots.size());
+	for (u32 slot = glyph_slot(code_point, slot_count);; slot = (slot + 1) & (slot_count - 1)) {
+		u32 index = font.glyph_slots[slot];
+		if (index == 0) {
+			return nullptr;
+		}
+		if (font.glyphs[index - 1].code_point == code_point) {
+			return &font.glyphs[index - 1];
+		}
+	}
+}
+
+static void insert_glyph_slot(DynamicArray<u32>& slots, u32 code_point, u32 index) {
+	u32 slot_count = static_cast<u32>(slots.size());
+	u32 slot	   = glyph_slot(code_point, slot_count);
+	while (slots[slot] != 0) {
+		slot = (slot + 1) & (slot_count - 1);
+	}
+	slots[slot] = index + 1;
+}
+
+static void add_glyph(Font& font, const Glyph& glyph) {
+	// Kept at most half full so probing stays short
+	if ((font.glyphs.size() + 1) * 2 > font.glyph_slots.size()) {
+		DynamicArray<u32> slots(font.glyph_slots.size() * 2, 0);
+		for (u32 i = 0; i < font.glyphs.size(); i++) {
+			insert_glyph_slot(slots, font.glyphs[i].code_point, i);
+		}
+		font.glyph_slots = toki::move(slots);
+	}
+
+	insert_glyph_slot(font.glyph_slots, glyph.code_point, static_cast<u32>(font.glyphs.size()));
+	font.glyphs.push_back(glyph);
+}
+
+static void mark_dirty(Font& font, const TextureRegion& region) {
+	// Glyphs rasterized one after the other usually land next to each other on the same shelf
+	if (font.dirty_regions.size() > 0) {
+		TextureRegion& last = font.dirty_regions.last();
+		if (last.y == region.y && last.x + last.width == region.x) {
+			last.width += region.width;
+			last.height = toki::max(last.height, region.height);
+			return;
+		}
+	}
+	font.dirty_regions.push_back(region);
+}
+
+static const Glyph& rasterize_glyph(Font& font, u32 code_point) {
+	Glyph glyph{};
+	glyph.code_point = code_point;
+
+	// Code points missing from the font are drawn with its missing glyph box
+	i32 glyph_index	  = stbtt_FindGlyphIndex(font.info, static_cast<i32>(code_point));
+	glyph.glyph_index = glyph_index;
+
+	i32 advance = 0;
+	i32 left_side_bearing;
+	stbtt_GetGlyphHMetrics(font.info, glyph_index, &advance, &left_side_bearing);
+	glyph.xadvance = advance * font.scale;
+
+	i32 width  = 0;
+	i32 height = 0;
+	i32 xoffset;
+	i32 yoffset;
+	u8* sdf = stbtt_GetGlyphSDF(
+		font.info,
+		font.scale,
+		glyph_index,
+		static_cast<i32>(font.sdf_padding),
+		SDF_ON_EDGE_VALUE,
+		static_cast<f32>(SDF_ON_EDGE_VALUE) / static_cast<f32>(font.sdf_padding),
+		&width,
+		&height,
+		&xoffset,
+		&yoffset);
+
+	Vector2u32 position{};
+	if (sdf == nullptr) {
+		// Nothing to draw, only the advance is used
+	} else if (!font.packer.pack(width + GLYPH_SPACING, height + GLYPH_SPACING, position)) {
+		TK_LOG_WARN("Font atlas is full, code point {} is not drawn", code_point);
+	} else {
+		for (i32 row = 0; row < height; row++) {
+			toki::memcpy(
+				font.atlas_pixels.data() + (position.y + row) * font.atlas_size.x + position.x,
+				sdf + row * width,
+				width);
+		}
+		// The spacing is part of the region so glyphs next to each other merge into one copy
+		mark_dirty(
+			font,
+			TextureRegion{ position.x, position.y, static_cast<u32>(width) + GLYPH_SPACING, static_cast<u32>(height) });
+
+		glyph.x0	  = static_cast<u16>(position.x);
+		glyph.y0	  = static_cast<u16>(position.y);
+		glyph.x1	  = static_cast<u16>(position.x + width);
+		glyph.y1	  = static_cast<u16>(position.y + height);
+		glyph.xoffset = static_cast<f32>(xoffset);
+		glyph.yoffset = static_cast<f32>(yoffset);
+	}
+
+	if (sdf != nullptr) {
+		stbtt_FreeSDF(sdf, nullptr);
+	}
+
+	// Glyphs that did not fit are cached as well so the atlas is not searched again every frame
+	add_glyph(font, glyph);
+	return font.glyphs.last();
+}
+
+FontSystem::~FontSystem() {
+	for (u64 i = 0; i < m_fontInfos.size(); i++) {
+		DefaultAllocator::free_aligned(m_fontInfos[i]);
+	}
+}
+
 void FontSystem::load_font(toki::StringView name, const LoadFontConfig& config) {
-	u32 first_char = 32;
-	u32 char_count = 96;
+	TK_ASSERT(config.sdf_padding > 0);
 
 	Font font{};
+	font.renderer	 = config.renderer;
+	font.atlas_size	 = config.atlas_size;
+	font.size		 = config.size;
+	font.sdf_padding = config.sdf_padding;
 
 	File file(config.path);
 	file.seek(0, FileCursorStart::END);
 	u32 file_byte_count = file.tell();
-	DynamicArray<u8> ttf_bytes(file_byte_count);
+	font.ttf_bytes		= DynamicArray<u8>(file_byte_count);
 	file.seek(0, FileCursorStart::BEGIN);
-	file.read(ttf_bytes.data(), file_byte_count);
-
-	using PixelType = u8;
-	u32 pixel_count = config.atlas_size.x * config.atlas_size.y;
-	DynamicArray<PixelType> initial_pixels(pixel_count, 255);
-
-	DynamicArray<Glyph> glyphs(char_count);
-
-	i32 result = stbtt_BakeFontBitmap(
-		ttf_bytes.data(),
-		0,
-		config.size,
-		reinterpret_cast<u8*>(initial_pixels.data()),
-		static_cast<i32>(config.atlas_size.x),
-		static_cast<i32>(config.atlas_size.y),
-		first_char,
-		char_count,
-		reinterpret_cast<stbtt_bakedchar*>(glyphs.data()));
-	TK_ASSERT(result > 0);
-
-	union Temp {
-		u8 values[4];
-		u32 v;
-	};
-	DynamicArray<Temp> pixels(pixel_count);
-	for (u32 i = 0; i < pixel_count; i++) {
-		pixels[i].values[0] = 100;
-		pixels[i].values[1] = 220;
-		pixels[i].values[2] = 200;
-		pixels[i].values[3] = initial_pixels[i];
-	}
-
-	font.glyph_data.reset(char_count);
-
-	for (u32 i = 0; i < glyphs.size(); i++) {
-		font.glyph_data.emplace(i + first_char, glyphs[i]);
-	}
-
+	file.read(font.ttf_bytes.data(), file_byte_count);
+
+	font.info = construct_at<stbtt_fontinfo>(
+		DefaultAllocator::allocate_aligned(sizeof(stbtt_fontinfo), alignof(stbtt_fontinfo)));
+	m_fontInfos.push_back(font.info);
+	i32 font_offset = stbtt_GetFontOffsetForIndex(font.ttf_bytes.data(), 0);
+	i32 result		= stbtt_InitFont(font.info, font.ttf_bytes.data(), font_offset);
+	TK_ASSERT(result != 0, "Could not parse font file");
+
+	i32 ascent;
+	i32 descent;
+	i32 line_gap;
+	stbtt_GetFontVMetrics(font.info, &ascent, &descent, &line_gap);
+	font.scale		 = stbtt_ScaleForPixelHeight(font.info, config.size);
+	font.line_height = (ascent - descent + line_gap) * font.scale;
+
+	font.atlas_pixels = DynamicArray<u8>(config.atlas_size.x * config.atlas_size.y, 0);
+	font.packer.reset(config.atlas_size.x, config.atlas_size.y);
+	font.glyph_slots = DynamicArray<u32>(INITIAL_GLYPH_SLOTS, 0);
+
+	// Single channel so glyphs can be written into any sub rectangle, block compressed data could
+	// only be updated in whole blocks
 	TextureConfig texture_config{};
-	texture_config.channels = 2;
+	texture_config.channels = 1;
 	texture_config.format	= ColorFormat::R8;
 	texture_config.width	= config.atlas_size.x;
 	texture_config.height	= config.atlas_size.y;
-	texture_config.flags	= SAMPLED | COLOR_ATTACHMENT | WRITABLE;
+	texture_config.flags	= SAMPLED | WRITABLE;
 
 	font.atlas_handle = config.renderer->create_texture(texture_config);
 
-	config.renderer->set_texture_data(font.atlas_handle, initial_pixels.data(), pixels.size() * sizeof(char));
+	// Glyphs are uploaded as regions later, those updates expect the texture to hold data
+	config.renderer->set_texture_data(font.atlas_handle, font.atlas_pixels.data(), font.atlas_pixels.size());
 
 	TK_LOG_INFO("Creating [Font] \"{}\"", name);
 
-	m_fontMap.emplace(name, toki::move(font.atlas_handle), toki::move(font.glyph_data));
+	m_fontMap.emplace(name, toki::move(font));
 }
 
 ConstWrapper<Font> FontSystem::get_font(toki::StringView name) {
@@ -96,59 +214,112 @@ ConstWrapper<Font> FontSystem::get_font(toki::StringView name) {
 	return m_fontMap.at(name);
 }
 
-toki::Geometry FontSystem::generate_geometry(toki::StringView name, toki::StringView text) {
+Font& FontSystem::get_mutable_font(toki::StringView name) {
+	TK_ASSERT(m_fontMap.contains(name));
+	return m_fontMap.at(name);
+}
+
+toki::Geometry FontSystem::generate_geometry(toki::StringView name, toki::StringView text, f32 size) {
 	TK_ASSERT(m_fontMap.contains(name));
-	const Font& font = m_fontMap.at(name);
+	Font& font = m_fontMap.at(name);
 
-	u32 vertex_data_size = sizeof(FontVertex) * 4 * text.size();
-	FontVertex* vertices = reinterpret_cast<FontVertex*>(DefaultAllocator::allocate(vertex_data_size));
+	TextLayout layout;
+	layout_text(font, text, TextLayoutConfig{ size }, layout);
+	upload_atlas(font);
 
-	toki::DynamicArray<u32> indices;
-	indices.reserve(text.size() * 6);
+	u32 quad_count		 = static_cast<u32>(layout.glyphs.size());
+	u32 vertex_data_size = sizeof(FontVertex) * 4 * quad_count;
+	FontVertex* vertices = reinterpret_cast<FontVertex*>(DefaultAllocator::allocate(vertex_data_size));
+	write_quads(layout, Vector2{ 0, 0 }, vertices, quad_count);
+
+	u32* indices	= reinterpret_cast<u32*>(DefaultAllocator::allocate(sizeof(u32) * 6 * quad_count));
+	u32 index_count = 0;
+	for (u32 i = 0; i < quad_count; i++) {
+		indices[index_count++] = i * 4 + 0;
+		indices[index_count++] = i * 4 + 1;
+		indices[index_count++] = i * 4 + 2;
+		indices[index_count++] = i * 4 + 2;
+		indices[index_count++] = i * 4 + 1;
+		indices[index_count++] = i * 4 + 3;
+	}
 
-	f32 cursor_x = 0;
-	f32 cursor_y = 0;
-	u32 index	 = 0;
-	FontVertex v;
+	Aabb bounds{};
+	for (u32 i = 0; i < quad_count * 4; i++) {
+		bounds.expand(vertices[i].position);
+	}
 
-	constexpr const f32 atlas_width	 = 512;
-	constexpr const f32 atlas_height = 512;
+	return { vertices, vertex_data_size, indices, index_count, true, bounds };
+}
 
-	for (u32 i = 0; i < text.size(); i++) {
-		if (text[i] == ' ') {
-			cursor_x += 10;
-			continue;
-		}
+// Glyphs of a font scaled to the layout size, rasterized on first use
+class FontGlyphSource final : public GlyphSource {
+public:
+	FontGlyphSource(Font& font, f32 size): m_font(font), m_scale(size / font.size) {}
+
+	virtual LayoutGlyph glyph(u32 code_point) override {
+		const Glyph* cached = find_glyph(m_font, code_point);
+		const Glyph& glyph	= cached != nullptr ? *cached : rasterize_glyph(m_font, code_point);
+
+		const f32 atlas_width  = static_cast<f32>(m_font.atlas_size.x);
+		const f32 atlas_height = static_cast<f32>(m_font.atlas_size.y);
+
+		LayoutGlyph scaled{};
+		scaled.glyph_index = glyph.glyph_index;
+		scaled.xoffset	   = glyph.xoffset * m_scale;
+		scaled.yoffset	   = glyph.yoffset * m_scale;
+		scaled.width	   = (glyph.x1 - glyph.x0) * m_scale;
+		scaled.height	   = (glyph.y1 - glyph.y0) * m_scale;
+		scaled.xadvance	   = glyph.xadvance * m_scale;
+		scaled.u0		   = glyph.x0 / atlas_width;
+		scaled.v0		   = glyph.y0 / atlas_height;
+		scaled.u1		   = glyph.x1 / atlas_width;
+		scaled.v1		   = glyph.y1 / atlas_height;
+		return scaled;
+	}
 
-		Glyph& glyph = font.glyph_data.at(text[i]);
+	// Covers both the kern table and GPOS pair adjustments
+	virtual f32 kerning(i32 previous_glyph_index, i32 glyph_index) override {
+		return stbtt_GetGlyphKernAdvance(m_font.info, previous_glyph_index, glyph_index) * m_font.scale * m_scale;
+	}
 
-		f32 u0 = glyph.x0 / atlas_width;
-		f32 v0 = (glyph.y0 / atlas_height);
-		f32 u1 = glyph.x1 / atlas_width;
-		f32 v1 = (glyph.y1 / atlas_height);
+private:
+	Font& m_font;
+	f32 m_scale;
+};
 
-		f32 x0 = cursor_x + glyph.xoffset;
-		f32 y0 = -(cursor_y + glyph.yoffset);
-		f32 x1 = x0 + (glyph.x1 - glyph.x0);
-		f32 y1 = -(y0 - (glyph.y1 - glyph.y0));
+void FontSystem::layout_text(
+	Font& font, toki::StringView text, const TextLayoutConfig& config, TextLayout& layout_out) {
+	FontGlyphSource source(font, config.size);
+	layout_glyphs(source, text, font.line_height * config.size / font.size, config.wrap_width, layout_out);
+}
 
-		vertices[index + 0] = { Vector3{ x0, y0, 0 }, Vector2{ u0, v0 } };
-		vertices[index + 1] = { Vector3{ x1, y0, 0 }, Vector2{ u1, v0 } };
-		vertices[index + 2] = { Vector3{ x0, y1, 0 }, Vector2{ u0, v1 } };
-		vertices[index + 3] = { Vector3{ x1, y1, 0 }, Vector2{ u1, v1 } };
+u32 FontSystem::write_quads(const TextLayout& layout, Vector2 origin, FontVertex* vertices_out, u32 max_quads) {
+	u32 quad_count				 = toki::min(static_cast<u32>(layout.glyphs.size()), max_quads);
+	const PositionedGlyph* glyph = layout.glyphs.data();
+	FontVertex* out				 = vertices_out;
+
+	for (u32 i = 0; i < quad_count; i++, glyph++, out += 4) {
+		f32 x0 = origin.x + glyph->x0;
+		f32 y0 = origin.y + glyph->y0;
+		f32 x1 = origin.x + glyph->x1;
+		f32 y1 = origin.y + glyph->y1;
+
+		out[0] = { Vector3{ x0, y0, 0 }, Vector2{ glyph->u0, glyph->v0 } };
+		out[1] = { Vector3{ x1, y0, 0 }, Vector2{ glyph->u1, glyph->v0 } };
+		out[2] = { Vector3{ x0, y1, 0 }, Vector2{ glyph->u0, glyph->v1 } };
+		out[3] = { Vector3{ x1, y1, 0 }, Vector2{ glyph->u1, glyph->v1 } };
+	}
 
-		indices.push_back(index + 0);
-		indices.push_back(index + 1);
-		indices.push_back(index + 2);
-		indices.push_back(index + 2);
-		indices.push_back(index + 1);
-		indices.push_back(index + 3);
+	return quad_count;
+}
 
-		cursor_x += glyph.xadvance;
-		index += 4;
+void FontSystem::upload_atlas(Font& font) {
+	if (font.dirty_regions.size() == 0) {
+		return;
 	}
 
-	return { vertices, vertex_data_size, toki::move(indices) };
+	font.renderer->update_texture_regions(font.atlas_handle, font.atlas_pixels.data(), font.dirty_regions);
+	font.dirty_regions.clear();
 }
 
 }  // namespace toki
@@ -2,36 +2,91 @@
 
 #include <toki/renderer/renderer.h>
 #include <toki/runtime/render/geometry.h>
+#include <toki/runtime/render/text_layout.h>
 #include <toki/runtime/render/types.h>
 
+struct stbtt_fontinfo;
+
 namespace toki {
 
 struct Glyph {
+	u32 code_point;
+	// Index into the glyphs of the font file, kerning is looked up by it
+	i32 glyph_index;
+	// Texels of the distance field in the atlas, empty for glyphs without an outline like spaces
 	u16 x0, y0, x1, y1;
+	// Pixels at the rasterized size of the font, y grows downwards from the baseline
 	f32 xoffset, yoffset, xadvance;
 };
 
+// Glyphs are rasterized as signed distance fields the first time they are used and packed into
+// the atlas, which is shared by text of every size. The outline is at the texel value 0.5.
 struct Font {
 	TextureHandle atlas_handle;
-	HashMap<u32, Glyph> glyph_data;
+	Vector2u32 atlas_size;
+	Renderer* renderer;
+
+	DynamicArray<u8> ttf_bytes;
+	stbtt_fontinfo* info;
+	// Scale from font units to pixels at the rasterized size
+	f32 scale;
+	f32 size;
+	f32 line_height;
+	u32 sdf_padding;
+
+	// Copy of the atlas, regions changed since the last upload are tracked so only they get copied
+	DynamicArray<u8> atlas_pixels;
+	DynamicArray<TextureRegion> dirty_regions;
+	ShelfPacker packer;
+
+	DynamicArray<Glyph> glyphs;
+	// Open addressing table of indices into glyphs plus one, zero marks an empty slot
+	DynamicArray<u32> glyph_slots;
 };
 
 struct LoadFontConfig {
 	Renderer* renderer;
 	StringView path;
 	Vector2u32 atlas_size;
+	// Pixel height glyphs are rasterized at, larger sizes stay sharp up to a few times this
 	f32 size;
+	// Pixels of distance stored around each glyph outline
+	u32 sdf_padding = 6;
 };
 
 class FontSystem {
 public:
+	FontSystem() = default;
+	~FontSystem();
+
+	DELETE_COPY(FontSystem)
+	DELETE_MOVE(FontSystem)
+
 	void load_font(toki::StringView name, const LoadFontConfig& config);
 	ConstWrapper<Font> get_font(toki::StringView name);
+	// Drawing text adds glyphs to the font, so writing quads needs it mutable
+	Font& get_mutable_font(toki::StringView name);
+
+	// Text is UTF-8 and laid out at a height of size pixels, glyphs not in the atlas yet are
+	// rasterized and uploaded before returning
+	toki::Geometry generate_geometry(toki::StringView name, toki::StringView text, f32 size);
+
+	// Positions the glyphs of UTF-8 text with kerning applied and lines wrapped. Glyphs
+	// rasterized for the text are only in the atlas once upload_atlas was called.
+	void layout_text(Font& font, toki::StringView text, const TextLayoutConfig& config, TextLayout& layout_out);
+
+	// Writes four vertices per glyph of the layout, origin is the start of the baseline of the
+	// first line. Stops after max_quads quads and returns how many were written. Vertices are
+	// written once and in order, so they can go straight into mapped memory.
+	static u32 write_quads(const TextLayout& layout, Vector2 origin, FontVertex* vertices_out, u32 max_quads);
 
-	toki::Geometry generate_geometry(toki::StringView name, toki::StringView text);
+	// Copies glyphs rasterized since the last call into the atlas texture
+	void upload_atlas(Font& font);
 
 private:
 	toki::HashMap<toki::StringView, Font> m_fontMap{ 16 };
+	// Font::info of every loaded font, the map does not destroy its values so they are freed from here
+	DynamicArray<stbtt_fontinfo*> m_fontInfos;
 };
 
 }  // namespace toki
@@ -8,6 +8,10 @@ layout(location = 0) out vec4 out_color;
 layout(set = 0, binding = 1) uniform sampler2D tex_sampler;
 
 void main() {
-    float alpha = texture(tex_sampler, in_uv).r;
-    out_color = vec4(vec3(1.0, 1.0, 1.0) * (1-alpha), alpha);
+    // Signed distance field with the outline at 0.5, the edge is smoothed over about one pixel
+    // on screen whatever size the text is drawn at
+    float distance = texture(tex_sampler, in_uv).r;
+    float width = fwidth(distance);
+    float alpha = smoothstep(0.5 - width, 0.5 + width, distance);
+    out_color = vec4(in_color, alpha);
 }
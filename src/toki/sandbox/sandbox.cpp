@@ -7,6 +7,7 @@
 
 toki::i32 toki::toki_entrypoint([[maybe_unused]] toki::Span<char*> _) {
 	toki::EngineConfig runtime_config{};
+	runtime_config.hot_reload = true;
 	toki::Engine engine(runtime_config);
 
 	engine.attach_layer(toki::make_unique<TestFontLayer>());
@@ -2,6 +2,8 @@
 
 using namespace toki;
 
+static constexpr const char* FONT_NAME = "Test font";
+
 struct Uniform {
 	toki::Matrix4 model;
 	toki::Matrix4 view;
@@ -19,7 +21,7 @@ void TestFontLayer::on_attach() {
 void TestFontLayer::on_detach() {
 	toki::Renderer* renderer = m_engine->renderer();
 
-	m_fontGeometry.free(renderer);
+	m_textRenderer.destroy();
 
 	renderer->destroy_handle(m_sampler);
 	renderer->destroy_handle(m_fontShader);
@@ -42,6 +44,9 @@ void TestFontLayer::on_update(toki::f32 delta_time) {
 }
 
 void TestFontLayer::on_render() {
+	m_textRenderer.begin_frame();
+	m_textRenderer.add_text("This is a test", { 0, 0 }, 50);
+
 	m_engine->renderer()->submit([this](toki::Commands* cmd) {
 		DynamicArray<RenderTarget> render_targets;
 		render_targets.emplace_back(TextureHandle{}, RenderTargetLoadOp::LOAD, RenderTargetStoreOp::STORE);
@@ -54,7 +59,7 @@ void TestFontLayer::on_render() {
 		cmd->begin_pass(begin_pass_config);
 		cmd->bind_shader(m_fontShader);
 		cmd->bind_uniforms(m_fontShaderLayout);
-		m_fontGeometry.draw(cmd);
+		m_textRenderer.draw(cmd);
 		cmd->end_pass();
 	});
 }
@@ -71,19 +76,23 @@ void TestFontLayer::create_font_resources() {
 	toki::Window* window	 = m_engine->window();
 
 	toki::LoadFontConfig load_font_config{};
-	load_font_config.size		= 50;
+	load_font_config.size		= 32;
 	load_font_config.atlas_size = { 512, 512 };
 	load_font_config.path		= "assets/fonts/RobotoMono-Regular.ttf";
 	load_font_config.renderer	= renderer;
 
-	const toki::String font_name = "Test font";
-	m_engine->system_manager()->font_system().load_font(font_name, load_font_config);
+	m_engine->system_manager()->font_system().load_font(FONT_NAME, load_font_config);
 
 	toki::FontSystem& font_system = m_engine->system_manager()->font_system();
 
-	m_font		   = font_system.get_font(font_name);
-	m_fontGeometry = font_system.generate_geometry(font_name, "This is a test");
-	m_fontGeometry.upload(renderer);
+	m_font = font_system.get_font(FONT_NAME);
+
+	TextRendererConfig text_renderer_config{};
+	text_renderer_config.renderer	 = renderer;
+	text_renderer_config.font_system = &font_system;
+	// The font and the text renderer keep the name, so it can't point into a temporary string
+	text_renderer_config.font_name = FONT_NAME;
+	m_textRenderer.create(text_renderer_config);
 
 	const Vector2u32 window_dimensions = window->get_dimensions();
 	m_projection2D					   = toki::ortho(0, window_dimensions.x, window_dimensions.y, 0, 0.0001, 100.0);
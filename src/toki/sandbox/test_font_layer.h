@@ -22,7 +22,7 @@ private:
 	toki::BufferHandle m_fontUniformBuffer;
 	toki::SamplerHandle m_sampler;
 	toki::ConstWrapper<toki::Font> m_font;
-	toki::Geometry m_fontGeometry;
+	toki::TextRenderer m_textRenderer;
 
 	toki::Matrix4 m_view2D;
 	toki::Matrix4 m_projection2D;
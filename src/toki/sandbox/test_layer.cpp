@@ -2,6 +2,13 @@
 
 using namespace toki;
 
+static constexpr const char* TEXTURE_PATH = "assets/textures/pepe.jpg";
+
+static b8 is_path(const Path& path, const char* expected) {
+	u64 size = toki::strlen(expected);
+	return toki::strlen(path.c_str()) == size && toki::strncmp(path.c_str(), expected, size) == 0;
+}
+
 struct Uniform {
 	toki::Matrix4 model;
 	toki::Matrix4 view;
@@ -65,7 +72,7 @@ void TestLayer::on_render() {
 		cmd->bind_index_buffer(m_indexBuffer);
 		cmd->bind_vertex_buffer(m_vertexBuffer);
 		cmd->bind_uniforms(m_shaderLayout);
-		cmd->draw_indexed(m_vertexCount);
+		cmd->draw_indexed(m_lods[m_lod].index_count, m_lods[m_lod].first_index);
 
 		cmd->bind_shader(m_gridShader);
 		cmd->draw_indexed(6);
@@ -88,6 +95,12 @@ void TestLayer::on_update(toki::f32 delta_time) {
 
 	Matrix4 model = Matrix4().rotate(Vector3(0.0f, 1.0f, 0.0f), -m_color * TWO_PI).scale(m_imageScale * -0.2);
 
+	// LOD errors are in model units and grow with the scale of the model
+	f32 distance	= m_cameraController.distance_to(transform_bounds(m_modelBounds, model));
+	f32 model_scale = toki::abs(m_imageScale * 0.2f);
+	f32 pixel_scale = lod_pixel_scale(m_cameraController.camera().get_projection(), m_viewportHeight) * model_scale;
+	m_lod			= select_lod(m_lods, distance, pixel_scale);
+
 	Uniform uniform{ model,
 					 m_cameraController.camera().get_view(),
 					 m_cameraController.camera().get_projection(),
@@ -122,6 +135,7 @@ void TestLayer::on_event([[maybe_unused]] toki::Event& event) {
 		// m_camera.set_projection(ortho(half_width, -half_width, -half_height, half_height, 0.01, 100.0));
 		m_cameraController.camera().set_projection(
 			perspective(toki::radians(90.0), data.dimensions.x / static_cast<f32>(data.dimensions.y), 0.01, 100000.0));
+		m_viewportHeight = static_cast<f32>(data.dimensions.y);
 
 		create_depth_buffer();
 	}
@@ -131,6 +145,16 @@ void TestLayer::on_event([[maybe_unused]] toki::Event& event) {
 	}
 }
 
+void TestLayer::on_file_changed(const Path& path) {
+	if (is_path(path, "assets/shaders/test.glsl.vert") || is_path(path, "assets/shaders/test.glsl.frag")) {
+		load_shader();
+	} else if (is_path(path, "assets/shaders/grid.glsl.vert") || is_path(path, "assets/shaders/grid.glsl.frag")) {
+		load_grid_shader();
+	} else if (is_path(path, TEXTURE_PATH)) {
+		load_texture();
+	}
+}
+
 void TestLayer::create_shader() {
 	toki::Renderer* renderer = m_engine->renderer();
 
@@ -153,6 +177,13 @@ void TestLayer::create_shader() {
 		m_shaderLayout = renderer->create_shader_layout(shader_layout_config);
 	}
 
+	load_shader();
+}
+
+// Creates the shader the first time and rebuilds its pipeline when the sources changed
+void TestLayer::load_shader() {
+	toki::Renderer* renderer = m_engine->renderer();
+
 	ColorFormat color_formats[1]{ ColorFormat::RGBA8 };
 
 	ResourceData vertex_shader	 = load_text("assets/shaders/test.glsl.vert");
@@ -175,14 +206,35 @@ void TestLayer::create_shader() {
 		StringView(static_cast<char*>(vertex_shader.data), vertex_shader.size);
 	shader_config.sources[ShaderStageFlags::SHADER_STAGE_FRAGMENT] =
 		StringView(static_cast<char*>(fragment_shader.data), fragment_shader.size);
-	m_shader = renderer->create_shader(shader_config);
+
+	if (!m_shader.valid()) {
+		m_shader = renderer->create_shader(shader_config);
+	} else if (!renderer->reload_shader(m_shader, shader_config)) {
+		TK_LOG_WARN("Keeping the previous test shader");
+	}
+
+	unload_text(vertex_shader);
+	unload_text(fragment_shader);
 }
 
 void TestLayer::create_model() {
 	toki::Renderer* renderer = m_engine->renderer();
 
-	auto model_data = toki::load_obj("assets/models/rabbit.obj");
-	m_vertexCount	= model_data.index_data.size();
+	ObjLoadConfig load_config{};
+	load_config.optimize = true;
+	auto model_data		 = toki::load_obj("assets/models/rabbit.obj", load_config);
+	m_modelBounds		 = compute_bounds(model_data.vertex_data);
+
+	LodChainConfig lod_config{};
+	DynamicArray<u32> lod_indices;
+	build_lod_chain(
+		model_data.index_data,
+		&model_data.vertex_data[0].position,
+		sizeof(Vertex),
+		static_cast<u32>(model_data.vertex_data.size()),
+		lod_config,
+		lod_indices,
+		m_lods);
 
 	BufferConfig vertex_buffer_config{};
 	vertex_buffer_config.size = model_data.vertex_data.size() * sizeof(Vertex);
@@ -191,10 +243,10 @@ void TestLayer::create_model() {
 	renderer->set_buffer_data(m_vertexBuffer, model_data.vertex_data.data(), vertex_buffer_config.size);
 
 	BufferConfig index_buffer_config{};
-	index_buffer_config.size = model_data.index_data.size() * sizeof(u32);
+	index_buffer_config.size = lod_indices.size() * sizeof(u32);
 	index_buffer_config.type = BufferType::INDEX;
 	m_indexBuffer			 = renderer->create_buffer(index_buffer_config);
-	renderer->set_buffer_data(m_indexBuffer, model_data.index_data.data(), index_buffer_config.size);
+	renderer->set_buffer_data(m_indexBuffer, lod_indices.data(), index_buffer_config.size);
 }
 
 void TestLayer::setup_uniforms(
@@ -228,9 +280,38 @@ void TestLayer::setup_uniforms(
 void TestLayer::setup_textures() {
 	toki::Renderer* m_renderer = m_engine->renderer();
 
+	load_texture();
+
 	{
-		Resource texture_resource("assets/textures/pepe.jpg", ResourceType::TEXTURE);
-		auto& metadata = texture_resource.metadata().texture;
+		SamplerConfig sampler_config{};
+		sampler_config.use_normalized_coords = true;
+		sampler_config.mag_filter			 = SamplerFilter::LINEAR;
+		sampler_config.min_filter			 = SamplerFilter::LINEAR;
+		m_sampler							 = m_renderer->create_sampler(sampler_config);
+	}
+
+	create_depth_buffer();
+}
+
+// Uploads into the existing texture if the size stayed the same, so only that image is touched
+void TestLayer::load_texture() {
+	toki::Renderer* renderer = m_engine->renderer();
+
+	Resource texture_resource(TEXTURE_PATH, ResourceType::TEXTURE);
+	if (texture_resource.data() == nullptr) {
+		return;
+	}
+
+	auto& metadata = texture_resource.metadata().texture;
+	Vector2u32 dimensions(static_cast<u32>(metadata.width), static_cast<u32>(metadata.height));
+
+	b8 recreate = !m_texture.valid() || dimensions.x != m_textureDimensions.x || dimensions.y != m_textureDimensions.y;
+	if (recreate) {
+		if (m_texture.valid()) {
+			// Frames in flight still sample the old image through the descriptor rewritten below
+			renderer->wait_idle();
+			renderer->destroy_handle(m_texture);
+		}
 
 		TextureConfig texture_config{};
 		texture_config.flags	= TextureFlags::SAMPLED | TextureFlags::WRITABLE;
@@ -238,20 +319,16 @@ void TestLayer::setup_textures() {
 		texture_config.height	= metadata.height;
 		texture_config.channels = metadata.channels;
 		texture_config.format	= ColorFormat::RGBA8;
-		m_texture				= m_renderer->create_texture(texture_config);
-
-		m_renderer->set_texture_data(m_texture, texture_resource.data(), texture_resource.size());
+		m_texture				= renderer->create_texture(texture_config);
+		m_textureDimensions		= dimensions;
 	}
 
-	{
-		SamplerConfig sampler_config{};
-		sampler_config.use_normalized_coords = true;
-		sampler_config.mag_filter			 = SamplerFilter::LINEAR;
-		sampler_config.min_filter			 = SamplerFilter::LINEAR;
-		m_sampler							 = m_renderer->create_sampler(sampler_config);
-	}
+	renderer->set_texture_data(m_texture, texture_resource.data(), texture_resource.size());
 
-	create_depth_buffer();
+	// The descriptor still points at the old texture until it is written again
+	if (recreate && m_uniformBuffer.valid()) {
+		setup_uniforms(m_shaderLayout, m_texture, m_uniformBuffer);
+	}
 }
 
 void TestLayer::create_depth_buffer() {
@@ -273,6 +350,12 @@ void TestLayer::create_depth_buffer() {
 }
 
 void TestLayer::create_grid_resources() {
+	load_grid_shader();
+}
+
+void TestLayer::load_grid_shader() {
+	toki::Renderer* renderer = m_engine->renderer();
+
 	ColorFormat color_formats[1]{ ColorFormat::RGBA8 };
 
 	ResourceData vertex_shader	 = load_text("assets/shaders/grid.glsl.vert");
@@ -294,5 +377,13 @@ void TestLayer::create_grid_resources() {
 		StringView(static_cast<char*>(vertex_shader.data), vertex_shader.size);
 	shader_config.sources[ShaderStageFlags::SHADER_STAGE_FRAGMENT] =
 		StringView(static_cast<char*>(fragment_shader.data), fragment_shader.size);
-	m_gridShader = m_engine->renderer()->create_shader(shader_config);
+
+	if (!m_gridShader.valid()) {
+		m_gridShader = renderer->create_shader(shader_config);
+	} else if (!renderer->reload_shader(m_gridShader, shader_config)) {
+		TK_LOG_WARN("Keeping the previous grid shader");
+	}
+
+	unload_text(vertex_shader);
+	unload_text(fragment_shader);
 }
@@ -11,10 +11,14 @@ public:
 	virtual void on_update(toki::f32 delta_time) override;
 	virtual void on_render() override;
 	virtual void on_event( toki::Event& event) override;
+	virtual void on_file_changed(const toki::Path& path) override;
 
 	void create_shader();
+	void load_shader();
+	void load_grid_shader();
 	void create_model();
 	void setup_textures();
+	void load_texture();
 	void create_depth_buffer();
 	void setup_uniforms(
 		const toki::ShaderLayoutHandle layout,
@@ -29,17 +33,22 @@ private:
 	toki::BufferHandle m_indexBuffer;
 	toki::BufferHandle m_uniformBuffer;
 	toki::TextureHandle m_texture;
+	toki::Vector2u32 m_textureDimensions;
 	toki::TextureHandle m_depthBuffer;
 	toki::SamplerHandle m_sampler;
 
 	toki::ShaderHandle m_gridShader;
 
-	toki::u32 m_vertexCount = 0;
-	toki::f32 m_imageScale	= 1.0;
-	toki::f32 m_offset		= 1;
-	toki::f32 m_color		= 0.5;
+	toki::f32 m_imageScale = 1.0;
+	toki::f32 m_offset	   = 1;
+	toki::f32 m_color	   = 0.5;
 
 	toki::f32 m_textRotation = 0.0f;
 
+	toki::DynamicArray<toki::MeshLod> m_lods;
+	toki::Aabb m_modelBounds;
+	toki::u32 m_lod			   = 0;
+	toki::f32 m_viewportHeight = 800.0f;
+
 	toki::FreeFlightCameraController m_cameraController;
 };
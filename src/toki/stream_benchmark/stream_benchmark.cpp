@@ -0,0 +1,105 @@
+#include <toki/core/core.h>
+#include <toki/runtime/runtime.h>
+
+// Compares line reading through File::read_line, which does one read syscall per byte, with
+// BufferedReader::next_line on a generated text file shaped like an OBJ vertex list.
+//
+// usage: stream_benchmark [size_mb] [path]
+
+using namespace toki;
+
+static void generate_file(StringView path, u64 size) {
+	File file(path, FileMode::WRITE, FILE_FLAG_CREATE | FILE_FLAG_TRUNCATE);
+	BufferedWriter writer(file);
+
+	char line[64]{};
+	u64 written = 0;
+	for (u64 i = 0; written < size; i++) {
+		u32 length	   = 0;
+		line[length++] = 'v';
+		for (u32 axis = 0; axis < 3; axis++) {
+			u64 value	   = (i * 7919 + axis * 104729) % 1000000;
+			line[length++] = ' ';
+			line[length++] = '0';
+			line[length++] = '.';
+			for (u64 divisor = 100000; divisor > 0; divisor /= 10) {
+				line[length++] = static_cast<char>('0' + value / divisor % 10);
+			}
+		}
+		line[length++] = '\n';
+
+		writer.write(line, length);
+		written += length;
+	}
+}
+
+struct ReadResult {
+	u64 line_count;
+	u64 byte_count;
+	f64 seconds;
+};
+
+static ReadResult read_with_read_line(StringView path) {
+	File file(path, FileMode::READ);
+	ReadResult result{};
+
+	u64 start = get_current_time();
+	char line[256]{};
+	u64 length{};
+	while ((length = file.read_line(line, sizeof(line))) > 0) {
+		result.line_count++;
+		result.byte_count += length;
+	}
+	result.seconds = static_cast<f64>(get_current_time() - start) / 1e9;
+
+	return result;
+}
+
+static ReadResult read_with_buffered_reader(StringView path) {
+	File file(path, FileMode::READ);
+	ReadResult result{};
+
+	u64 start = get_current_time();
+	BufferedReader reader(file);
+	for (Optional<StringView> line = reader.next_line(); line.has_value(); line = reader.next_line()) {
+		result.line_count++;
+		result.byte_count += line.value().size();
+	}
+	result.seconds = static_cast<f64>(get_current_time() - start) / 1e9;
+
+	return result;
+}
+
+static void report(StringView name, const ReadResult& result, u64 file_size) {
+	f64 megabytes = static_cast<f64>(file_size) / static_cast<f64>(MB(1));
+
+	toki::println("{}:", name);
+	toki::println("  lines          {}", result.line_count);
+	toki::println("  line bytes     {}", result.byte_count);
+	toki::println("  time           {} s", result.seconds);
+	toki::println("  throughput     {} MB/s", megabytes / result.seconds);
+}
+
+toki::i32 toki::toki_entrypoint(toki::Span<char*> args) {
+	u64 size_mb		 = 100;
+	const char* path = "stream_benchmark.txt";
+
+	if (args.size() > 1) {
+		toki::atoi(args[1], size_mb);
+	}
+	if (args.size() > 2) {
+		path = args[2];
+	}
+
+	toki::println("Generating {} MB of text in {}", size_mb, path);
+	generate_file(path, MB(size_mb));
+
+	ReadResult buffered	 = read_with_buffered_reader(path);
+	ReadResult read_line = read_with_read_line(path);
+
+	report("File::read_line", read_line, MB(size_mb));
+	report("BufferedReader::next_line", buffered, MB(size_mb));
+	toki::println("speedup          {}x", read_line.seconds / buffered.seconds);
+
+	return 0;
+}
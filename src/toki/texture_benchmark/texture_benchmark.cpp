@@ -0,0 +1,109 @@
+#include <toki/core/core.h>
+#include <toki/runtime/runtime.h>
+
+// Times loading a batch of PNG/JPG files into upload memory. The old path decodes into a texture
+// resource and copies it into the upload memory the way set_texture_data does, the import path
+// decodes straight into the upload memory, first on one thread and then on one thread per
+// physical core. A plain allocation stands in for the renderer's staging buffer.
+//
+// usage: texture_benchmark [--mips box|kaiser] <images...>
+
+using namespace toki;
+
+static b8 is_option(StringView arg, StringView option) {
+	return arg.size() == option.size() && arg == option;
+}
+
+static f64 measure_resource_path(DynamicArray<TextureImportJob>& jobs, const TextureImportConfig& config) {
+	u64 start = get_current_time();
+	for (u64 i = 0; i < jobs.size(); i++) {
+		ResourceData texture = load_texture(jobs[i].path, config);
+		jobs[i].imported	 = texture.data != nullptr && texture.size == jobs[i].info.size;
+		if (jobs[i].imported) {
+			toki::memcpy(jobs[i].destination, texture.data, texture.size);
+			unload_texture(texture);
+		}
+	}
+	return static_cast<f64>(get_current_time() - start) / 1e6;
+}
+
+static f64 measure_import_path(
+	DynamicArray<TextureImportJob>& jobs, u32 thread_count, const TextureImportConfig& config) {
+	u64 start = get_current_time();
+	toki::import_textures(jobs.data(), jobs.size(), thread_count, config);
+	return static_cast<f64>(get_current_time() - start) / 1e6;
+}
+
+static u64 checksum(const DynamicArray<TextureImportJob>& jobs) {
+	u64 hash = 0;
+	for (u64 i = 0; i < jobs.size(); i++) {
+		TK_ASSERT(jobs[i].imported);
+		hash ^= toki::hash_bytes(jobs[i].destination, jobs[i].info.size, i);
+	}
+	return hash;
+}
+
+toki::i32 toki::toki_entrypoint(toki::Span<char*> args) {
+	TextureImportConfig config{};
+	DynamicArray<StringView> paths;
+	for (u64 i = 1; i < args.size(); i++) {
+		if (is_option(args[i], "--mips") && i + 1 < args.size()) {
+			config.generate_mips	 = true;
+			config.mip_config.filter = is_option(args[++i], "kaiser") ? MipFilter::KAISER : MipFilter::BOX;
+		} else {
+			paths.push_back(args[i]);
+		}
+	}
+
+	if (paths.size() == 0) {
+		toki::println("usage: texture_benchmark [--mips box|kaiser] <images...>");
+		return 1;
+	}
+
+	// Headers are read up front so every texture gets its upload memory before decoding starts,
+	// the same order the import path would use with the renderer
+	DynamicArray<TextureImportJob> jobs;
+	u64 total_size = 0;
+	u64 info_start = get_current_time();
+	for (u64 i = 0; i < paths.size(); i++) {
+		Optional<TextureInfo> info = read_texture_info(paths[i], config);
+		if (!info.has_value()) {
+			continue;
+		}
+
+		jobs.emplace_back();
+		jobs.last().path = paths[i];
+		jobs.last().info = info.value();
+		total_size += info.value().size;
+	}
+	f64 info_ms = static_cast<f64>(get_current_time() - info_start) / 1e6;
+
+	byte* upload_memory = reinterpret_cast<byte*>(DefaultAllocator::allocate(toki::max<u64>(total_size, 1)));
+	u64 offset			= 0;
+	for (u64 i = 0; i < jobs.size(); i++) {
+		jobs[i].destination = upload_memory + offset;
+		offset += jobs[i].info.size;
+	}
+
+	CpuTopology topology = query_cpu_topology();
+	u32 thread_count	 = toki::max(static_cast<u32>(topology.physical_cores.size()), 1u);
+
+	f64 resource_ms = measure_resource_path(jobs, config);
+	u64 reference	= checksum(jobs);
+
+	f64 import_ms = measure_import_path(jobs, 1, config);
+	TK_ASSERT(checksum(jobs) == reference);
+
+	f64 threaded_ms = measure_import_path(jobs, thread_count, config);
+	TK_ASSERT(checksum(jobs) == reference);
+
+	toki::println("{} textures, {} MB of upload data", jobs.size(), total_size / MB(1));
+	toki::println("  read headers             {} ms", info_ms);
+	toki::println("  resource + copy          {} ms", resource_ms);
+	toki::println("  import                   {} ms", import_ms);
+	toki::println("  import, {} threads       {} ms", thread_count, threaded_ms);
+
+	DefaultAllocator::free(upload_memory);
+	jobs.clear();
+	return 0;
+}
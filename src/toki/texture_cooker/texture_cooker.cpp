@@ -0,0 +1,73 @@
+#include <toki/core/core.h>
+#include <toki/runtime/runtime.h>
+
+// Converts a PNG/JPG image into a block compressed cooked texture with its mip chain.
+//
+// usage: texture_cooker <input> <output> [--format bc1|bc3|bc4|bc7] [--no-mips] [--linear]
+
+using namespace toki;
+
+static b8 is_option(StringView arg, StringView option) {
+	return arg.size() == option.size() && arg == option;
+}
+
+static Optional<BlockFormat> parse_format(StringView name) {
+	if (is_option(name, "bc1")) {
+		return BlockFormat::BC1;
+	}
+	if (is_option(name, "bc3")) {
+		return BlockFormat::BC3;
+	}
+	if (is_option(name, "bc4")) {
+		return BlockFormat::BC4;
+	}
+	if (is_option(name, "bc7")) {
+		return BlockFormat::BC7;
+	}
+	return {};
+}
+
+toki::i32 toki::toki_entrypoint(toki::Span<char*> args) {
+	if (args.size() < 3) {
+		toki::println("usage: texture_cooker <input> <output> [--format bc1|bc3|bc4|bc7] [--no-mips] [--linear]");
+		return 1;
+	}
+
+	TextureCookConfig config{};
+	for (u64 i = 3; i < args.size(); i++) {
+		if (is_option(args[i], "--format") && i + 1 < args.size()) {
+			Optional<BlockFormat> format = parse_format(args[++i]);
+			if (!format.has_value()) {
+				toki::println("Unknown format {}", args[i]);
+				return 1;
+			}
+			config.format = format.value();
+		} else if (is_option(args[i], "--no-mips")) {
+			config.generate_mips = false;
+		} else if (is_option(args[i], "--linear")) {
+			config.mip_config.srgb = false;
+		} else {
+			toki::println("Unknown option {}", args[i]);
+			return 1;
+		}
+	}
+
+	u64 start = get_current_time();
+	if (!cook_texture(args[1], config, args[2])) {
+		return 1;
+	}
+	f64 cook_ms = static_cast<f64>(get_current_time() - start) / 1e6;
+
+	CookedTexture texture;
+	if (!texture.load(args[2])) {
+		return 1;
+	}
+
+	const CookedTextureHeader& header = texture.header();
+	u64 uncompressed_size			  = mip_chain_size(header.width, header.height, header.mip_levels);
+	toki::println("Cooked {} into {} in {} ms", args[1], args[2], cook_ms);
+	toki::println("  size         {}x{}", header.width, header.height);
+	toki::println("  mip levels   {}", header.mip_levels);
+	toki::println("  data         {} bytes, {} as RGBA8", header.data_size, uncompressed_size);
+	return 0;
+}
@@ -0,0 +1,179 @@
+#include "testing.h"
+//
+
+#include <errno.h>
+#include <toki/core/core.h>
+#include <toki/core/platform/syscalls.h>
+
+using namespace toki;
+
+static constexpr const char* TEST_FILE_PATH = "test_async_io.tmp";
+static constexpr u32 BLOCK_SIZE				= 4096;
+static constexpr u32 BLOCK_COUNT			= 8;
+
+struct Results {
+	i64 results[BLOCK_COUNT];
+	u32 completed;
+};
+
+static void record_completion(const AsyncIoCompletion& completion) {
+	Results* results					   = reinterpret_cast<Results*>(completion.user_data);
+	results->results[results->completed++] = completion.result;
+}
+
+static b8 all_completed(const Results& results, i64 expected) {
+	for (u32 i = 0; i < results.completed; i++) {
+		if (results.results[i] != expected) {
+			return false;
+		}
+	}
+	return results.completed == BLOCK_COUNT;
+}
+
+// Writes every block in one batch and reads them back in reverse order
+static b8 write_and_read_back(const AsyncIoConfig& config) {
+	NativeHandle handle =
+		toki::open(TEST_FILE_PATH, FileMode::RDWR, FILE_FLAG_CREATE | FILE_FLAG_TRUNCATE).value_or({});
+	if (!handle.valid()) {
+		return false;
+	}
+
+	DynamicArray<byte> written(BLOCK_SIZE * BLOCK_COUNT);
+	DynamicArray<byte> read_back(BLOCK_SIZE * BLOCK_COUNT, 0);
+	for (u32 i = 0; i < written.size(); i++) {
+		written[i] = static_cast<byte>(i * 7 + i / BLOCK_SIZE);
+	}
+
+	b8 passed = true;
+	{
+		AsyncIo io(config);
+		Results results{};
+		AsyncIoRequest request{};
+		request.handle	  = handle;
+		request.size	  = BLOCK_SIZE;
+		request.callback  = record_completion;
+		request.user_data = &results;
+
+		request.operation = AsyncIoOperation::WRITE;
+		for (u32 i = 0; i < BLOCK_COUNT; i++) {
+			request.buffer = written.data() + i * BLOCK_SIZE;
+			request.offset = i * BLOCK_SIZE;
+			io.queue(request);
+		}
+		io.wait_all();
+		passed = passed && io.in_flight() == 0 && all_completed(results, BLOCK_SIZE);
+
+		results			  = {};
+		request.operation = AsyncIoOperation::READ;
+		for (u32 i = BLOCK_COUNT; i > 0; i--) {
+			request.buffer = read_back.data() + (i - 1) * BLOCK_SIZE;
+			request.offset = (i - 1) * BLOCK_SIZE;
+			io.queue(request);
+		}
+		io.wait_all();
+		passed = passed && all_completed(results, BLOCK_SIZE);
+	}
+	toki::close(handle);
+
+	for (u32 i = 0; i < written.size(); i++) {
+		passed = passed && read_back[i] == written[i];
+	}
+	return passed;
+}
+
+// Reading past the end is a short transfer, which breaks a linked chain and cancels the rest
+static b8 short_read_cancels_chain(const AsyncIoConfig& config) {
+	NativeHandle handle =
+		toki::open(TEST_FILE_PATH, FileMode::RDWR, FILE_FLAG_CREATE | FILE_FLAG_TRUNCATE).value_or({});
+	if (!handle.valid()) {
+		return false;
+	}
+
+	byte data[BLOCK_SIZE]{};
+	b8 passed = toki::write(handle, data, 100).value_or(0) == 100;
+	{
+		AsyncIo io(config);
+		Results results{};
+		AsyncIoRequest request{};
+		request.handle	  = handle;
+		request.buffer	  = data;
+		request.size	  = BLOCK_SIZE;
+		request.callback  = record_completion;
+		request.user_data = &results;
+		for (u32 i = 0; i < 3; i++) {
+			request.link_next = i < 2;
+			io.queue(request);
+		}
+		io.wait_all();
+		passed = passed && results.completed == 3 && results.results[0] == 100 &&
+				 results.results[1] == -ECANCELED && results.results[2] == -ECANCELED;
+	}
+	toki::close(handle);
+	return passed;
+}
+
+static void store_result(const AsyncIoCompletion& completion) {
+	*reinterpret_cast<i64*>(completion.user_data) = completion.result;
+}
+
+// More chains than the queue holds, making room for the next request must not submit half a chain
+static b8 chains_survive_full_queue(const AsyncIoConfig& config) {
+	constexpr u32 CHAIN_COUNT  = 12;
+	constexpr u32 CHAIN_LENGTH = 3;
+
+	NativeHandle handle =
+		toki::open(TEST_FILE_PATH, FileMode::RDWR, FILE_FLAG_CREATE | FILE_FLAG_TRUNCATE).value_or({});
+	if (!handle.valid()) {
+		return false;
+	}
+
+	byte data[BLOCK_SIZE]{};
+	i64 results[CHAIN_COUNT * CHAIN_LENGTH]{};
+	b8 passed = toki::write(handle, data, 100).value_or(0) == 100;
+	{
+		AsyncIo io(config);
+		AsyncIoRequest request{};
+		request.handle	 = handle;
+		request.buffer	 = data;
+		request.size	 = BLOCK_SIZE;
+		request.callback = store_result;
+		for (u32 i = 0; i < CHAIN_COUNT * CHAIN_LENGTH; i++) {
+			request.link_next = i % CHAIN_LENGTH != CHAIN_LENGTH - 1;
+			request.user_data = &results[i];
+			io.queue(request);
+		}
+		io.wait_all();
+	}
+	toki::close(handle);
+
+	// Every chain starts with a short read, the rest of it is cancelled
+	for (u32 i = 0; i < CHAIN_COUNT * CHAIN_LENGTH; i++) {
+		passed = passed && results[i] == (i % CHAIN_LENGTH == 0 ? 100 : -ECANCELED);
+	}
+	return passed;
+}
+
+TK_TEST(AsyncIo, default_backend) {
+	// io_uring where the kernel allows it, the thread pool otherwise
+	TK_TEST_ASSERT(write_and_read_back({}));
+	TK_TEST_ASSERT(short_read_cancels_chain({}));
+	TK_TEST_ASSERT(chains_survive_full_queue({ .queue_depth = 4 }));
+	return true;
+}
+
+TK_TEST(AsyncIo, thread_pool) {
+	AsyncIoConfig config{ .fallback_thread_count = 3, .force_fallback = true };
+	TK_TEST_ASSERT(write_and_read_back(config));
+	TK_TEST_ASSERT(short_read_cancels_chain(config));
+	TK_TEST_ASSERT(chains_survive_full_queue({ .queue_depth = 4, .fallback_thread_count = 3, .force_fallback = true }));
+	return true;
+}
+
+TK_TEST(AsyncIo, thread_pool_shutdown) {
+	// Idle workers have to wake up for the shutdown however it lines up with their wait, a lost
+	// wakeup hangs in the destructor
+	for (u32 i = 0; i < 200; i++) {
+		AsyncIo io({ .fallback_thread_count = 4, .force_fallback = true });
+	}
+	return true;
+}
@@ -0,0 +1,157 @@
+#include "testing.h"
+//
+
+#include <toki/core/core.h>
+
+using namespace toki;
+
+// Sizes around the 8 wide step so both the vector loop and the scalar tail are covered
+static constexpr u64 BATCH_SIZES[] = { 0, 1, 7, 8, 9, 37 };
+
+static Vector3 test_vector(u64 index) {
+	f32 i = static_cast<f32>(index);
+	return Vector3(i * 0.5f - 3.0f, 2.0f - i * 0.25f, i * i * 0.125f);
+}
+
+static Matrix4 test_matrix() {
+	return Matrix4(Vector3{ 1, -2, 3 }).rotate(Vector3{ 1, 1, 0 }, 0.6f).scale(Vector3{ 1, 2, 3 });
+}
+
+static b8 nearly_equal(const Vector3& lhs, const Vector3& rhs) {
+	return toki::abs(lhs.x - rhs.x) <= 1e-4f && toki::abs(lhs.y - rhs.y) <= 1e-4f &&
+		   toki::abs(lhs.z - rhs.z) <= 1e-4f;
+}
+
+static b8 nearly_equal(const Matrix4& lhs, const Matrix4& rhs) {
+	for (u32 i = 0; i < 16; i++) {
+		if (toki::abs(lhs[i] - rhs[i]) > 1e-4f) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static b8 same_bounds(const Aabb& lhs, const Aabb& rhs) {
+	return lhs.min.x == rhs.min.x && lhs.min.y == rhs.min.y && lhs.min.z == rhs.min.z && lhs.max.x == rhs.max.x &&
+		   lhs.max.y == rhs.max.y && lhs.max.z == rhs.max.z;
+}
+
+TK_TEST(Batch, transform_points) {
+	Matrix4 matrix = test_matrix();
+
+	for (u64 count : BATCH_SIZES) {
+		DynamicArray<Vector3> points(count + 1, Vector3{});
+		DynamicArray<Vector3> transformed(count + 1, Vector3{ 42.0f });
+		for (u64 i = 0; i < count; i++) {
+			points[i] = test_vector(i);
+		}
+
+		transform_points(Span<Vector3>(points.data(), count), matrix, transformed.data());
+		for (u64 i = 0; i < count; i++) {
+			TK_TEST_ASSERT(nearly_equal(transformed[i], matrix.transform_point(points[i])));
+		}
+		// Nothing is written past the end
+		TK_TEST_ASSERT(transformed[count].x == 42.0f);
+
+		transform_directions(Span<Vector3>(points.data(), count), matrix, transformed.data());
+		for (u64 i = 0; i < count; i++) {
+			TK_TEST_ASSERT(nearly_equal(transformed[i], matrix.transform_direction(points[i])));
+		}
+	}
+
+	return true;
+}
+
+TK_TEST(Batch, transform_points_soa) {
+	Matrix4 matrix = test_matrix();
+
+	for (u64 count : BATCH_SIZES) {
+		DynamicArray<f32> x(count + 1, 0.0f), y(count + 1, 0.0f), z(count + 1, 0.0f);
+		for (u64 i = 0; i < count; i++) {
+			Vector3 v = test_vector(i);
+			x[i]	  = v.x;
+			y[i]	  = v.y;
+			z[i]	  = v.z;
+		}
+
+		// In place
+		Vector3Soa points{ x.data(), y.data(), z.data(), count };
+		transform_points(points, matrix, points);
+		for (u64 i = 0; i < count; i++) {
+			TK_TEST_ASSERT(nearly_equal(Vector3(x[i], y[i], z[i]), matrix.transform_point(test_vector(i))));
+		}
+	}
+
+	return true;
+}
+
+TK_TEST(Batch, multiply_matrices) {
+	DynamicArray<Matrix4> lhs(9, Matrix4{});
+	DynamicArray<Matrix4> rhs(9, Matrix4{});
+	DynamicArray<Matrix4> products(9, Matrix4{});
+	for (u32 i = 0; i < lhs.size(); i++) {
+		lhs[i] = Matrix4(test_vector(i)).rotate(Vector3{ 0, 0, 1 }, static_cast<f32>(i));
+		rhs[i] = Matrix4(test_vector(i + 3)).scale(static_cast<f32>(i + 1));
+	}
+
+	multiply_matrices(lhs, rhs, products.data());
+	for (u32 i = 0; i < lhs.size(); i++) {
+		TK_TEST_ASSERT(nearly_equal(products[i], lhs[i] * rhs[i]));
+	}
+
+	multiply_matrices(lhs[2], rhs, products.data());
+	for (u32 i = 0; i < lhs.size(); i++) {
+		TK_TEST_ASSERT(nearly_equal(products[i], lhs[2] * rhs[i]));
+	}
+
+	return true;
+}
+
+TK_TEST(Batch, normalize_many) {
+	for (u64 count : BATCH_SIZES) {
+		DynamicArray<Vector3> vectors(count + 1, Vector3{});
+		for (u64 i = 0; i < count; i++) {
+			vectors[i] = test_vector(i);
+		}
+		if (count > 3) {
+			vectors[3] = Vector3{};
+		}
+
+		normalize_many(Span<Vector3>(vectors.data(), count), vectors.data());
+		for (u64 i = 0; i < count; i++) {
+			if (i == 3) {
+				TK_TEST_ASSERT(vectors[i].x == 0.0f && vectors[i].y == 0.0f && vectors[i].z == 0.0f);
+			} else {
+				TK_TEST_ASSERT(nearly_equal(vectors[i], test_vector(i).normalize()));
+			}
+		}
+	}
+
+	return true;
+}
+
+TK_TEST(Batch, compute_aabb) {
+	TK_TEST_ASSERT(compute_aabb(Span<Vector3>()).is_empty());
+
+	for (u64 count : BATCH_SIZES) {
+		if (count == 0) {
+			continue;
+		}
+
+		DynamicArray<Vector3> points(count, Vector3{});
+		DynamicArray<f32> x(count, 0.0f), y(count, 0.0f), z(count, 0.0f);
+		Aabb expected;
+		for (u64 i = 0; i < count; i++) {
+			points[i] = test_vector(i);
+			x[i]	  = points[i].x;
+			y[i]	  = points[i].y;
+			z[i]	  = points[i].z;
+			expected.expand(points[i]);
+		}
+
+		TK_TEST_ASSERT(same_bounds(compute_aabb(points), expected));
+		TK_TEST_ASSERT(same_bounds(compute_aabb(Vector3Soa{ x.data(), y.data(), z.data(), count }), expected));
+	}
+
+	return true;
+}
@@ -0,0 +1,109 @@
+#include "testing.h"
+//
+
+#include <toki/core/core.h>
+
+using namespace toki;
+
+// Every channel follows the same diagonal ramp, so the colors of a block lie on a line the
+// encoders can represent
+static void fill_gradient(DynamicArray<byte>& pixels, u32 width, u32 height) {
+	for (u32 y = 0; y < height; y++) {
+		for (u32 x = 0; x < width; x++) {
+			u32 ramp	= (x + y) * 255 / (width + height - 2);
+			byte* pixel = pixels.data() + (static_cast<u64>(y) * width + x) * 4;
+			pixel[0]	= static_cast<byte>(ramp);
+			pixel[1]	= static_cast<byte>(255 - ramp);
+			pixel[2]	= static_cast<byte>(64 + ramp / 2);
+			pixel[3]	= static_cast<byte>(255 - ramp * 200 / 255);
+		}
+	}
+}
+
+static i32 max_difference(const DynamicArray<byte>& a, const DynamicArray<byte>& b, u32 channels) {
+	i32 difference = 0;
+	for (u64 i = 0; i < a.size(); i++) {
+		if (i % 4 < channels) {
+			difference = toki::max(difference, toki::abs(static_cast<i32>(a[i]) - static_cast<i32>(b[i])));
+		}
+	}
+	return difference;
+}
+
+TK_TEST(BlockCompression, sizes) {
+	TK_TEST_ASSERT(toki::compressed_level_size(BlockFormat::BC1, 4, 4) == 8);
+	TK_TEST_ASSERT(toki::compressed_level_size(BlockFormat::BC7, 5, 4) == 32);
+	TK_TEST_ASSERT(toki::compressed_level_size(BlockFormat::BC4, 1, 1) == 8);
+
+	// 8x8, 4x4, 2x2 and 1x1 each take at least one block
+	TK_TEST_ASSERT(toki::compressed_chain_size(BlockFormat::BC3, 8, 8, 4) == 16 * (4 + 1 + 1 + 1));
+
+	return true;
+}
+
+TK_TEST(BlockCompression, flat_color_round_trips) {
+	const byte color[] = { 200, 90, 17, 128 };
+	DynamicArray<byte> pixels(8 * 8 * 4);
+	for (u64 i = 0; i < pixels.size(); i++) {
+		pixels[i] = color[i % 4];
+	}
+
+	BlockFormat formats[] = { BlockFormat::BC1, BlockFormat::BC3, BlockFormat::BC4, BlockFormat::BC7 };
+	for (BlockFormat format : formats) {
+		DynamicArray<byte> blocks(toki::compressed_level_size(format, 8, 8));
+		DynamicArray<byte> decoded(pixels.size());
+		toki::compress_blocks(format, pixels.data(), 8, 8, 4, blocks.data());
+		toki::decompress_blocks(format, blocks.data(), 8, 8, decoded.data());
+
+		// 565 endpoints can't hit every color exactly, BC1 is also always opaque
+		u32 channels = format == BlockFormat::BC4 ? 1 : format == BlockFormat::BC1 ? 3 : 4;
+		i32 limit	 = format == BlockFormat::BC1 || format == BlockFormat::BC3 ? 4 : 1;
+		TK_TEST_ASSERT(max_difference(pixels, decoded, channels) <= limit);
+	}
+
+	return true;
+}
+
+TK_TEST(BlockCompression, gradient_error_is_bounded) {
+	// Not a multiple of the block size, so the edge blocks are padded
+	constexpr u32 WIDTH	 = 30;
+	constexpr u32 HEIGHT = 18;
+
+	DynamicArray<byte> pixels(WIDTH * HEIGHT * 4);
+	fill_gradient(pixels, WIDTH, HEIGHT);
+
+	DynamicArray<byte> blocks(toki::compressed_level_size(BlockFormat::BC7, WIDTH, HEIGHT));
+	DynamicArray<byte> decoded(pixels.size());
+
+	toki::compress_blocks(BlockFormat::BC7, pixels.data(), WIDTH, HEIGHT, 4, blocks.data());
+	toki::decompress_blocks(BlockFormat::BC7, blocks.data(), WIDTH, HEIGHT, decoded.data());
+	TK_TEST_ASSERT(max_difference(pixels, decoded, 4) <= 2);
+
+	toki::compress_blocks(BlockFormat::BC3, pixels.data(), WIDTH, HEIGHT, 4, blocks.data());
+	toki::decompress_blocks(BlockFormat::BC3, blocks.data(), WIDTH, HEIGHT, decoded.data());
+	TK_TEST_ASSERT(max_difference(pixels, decoded, 4) <= 8);
+
+	return true;
+}
+
+TK_TEST(BlockCompression, bc4_reads_single_channel_images) {
+	constexpr u32 SIZE = 8;
+
+	DynamicArray<byte> pixels(SIZE * SIZE);
+	for (u32 i = 0; i < SIZE * SIZE; i++) {
+		pixels[i] = static_cast<byte>(i * 4);
+	}
+
+	DynamicArray<byte> blocks(toki::compressed_level_size(BlockFormat::BC4, SIZE, SIZE));
+	DynamicArray<byte> decoded(SIZE * SIZE * 4);
+	toki::compress_blocks(BlockFormat::BC4, pixels.data(), SIZE, SIZE, 1, blocks.data());
+	toki::decompress_blocks(BlockFormat::BC4, blocks.data(), SIZE, SIZE, decoded.data());
+
+	// A block spans at most 108 values, 8 levels keep every pixel within half a step
+	for (u32 i = 0; i < SIZE * SIZE; i++) {
+		TK_TEST_ASSERT(toki::abs(static_cast<i32>(decoded[i * 4]) - pixels[i]) <= 8);
+		TK_TEST_ASSERT(decoded[i * 4 + 3] == 255);
+	}
+
+	return true;
+}
@@ -0,0 +1,117 @@
+#include "testing.h"
+//
+
+#include <toki/core/core.h>
+
+using namespace toki;
+
+static constexpr const char* TEST_FILE_PATH = "test_buffered_stream.tmp";
+
+static b8 line_equals(const Optional<StringView>& line, const char* expected) {
+	return line.has_value() && line.value().size() == toki::strlen(expected) &&
+		   toki::strncmp(line.value().data(), expected, line.value().size()) == 0;
+}
+
+TK_TEST(BufferedStream, memchr_finds_first_match) {
+	char data[100]{};
+	for (u32 i = 0; i < CARRAY_SIZE(data); i++) {
+		data[i] = 'a';
+	}
+
+	TK_TEST_ASSERT(toki::memchr(data, '\n', CARRAY_SIZE(data)) == nullptr);
+
+	// Cover the scalar tail as well as the 16 and 32 byte loops
+	for (u32 i = 0; i < CARRAY_SIZE(data); i += 7) {
+		data[i] = '\n';
+		TK_TEST_ASSERT(toki::memchr(data, '\n', CARRAY_SIZE(data)) == &data[i]);
+		TK_TEST_ASSERT(toki::memchr(data, '\n', i) == nullptr);
+		data[i] = 'a';
+	}
+
+	return true;
+}
+
+TK_TEST(BufferedStream, lines_round_trip) {
+	char long_line[300]{};
+	for (u32 i = 0; i < CARRAY_SIZE(long_line) - 1; i++) {
+		long_line[i] = static_cast<char>('a' + i % 26);
+	}
+
+	{
+		File file(StringView(TEST_FILE_PATH), FileMode::WRITE, FILE_FLAG_CREATE | FILE_FLAG_TRUNCATE);
+		BufferedWriter writer(file, 32);
+		writer.write_line("first");
+		writer.write_line("");
+		writer.write("windows\r\n");
+		writer.write_line(long_line);
+		writer.write("last");
+	}
+
+	File file(StringView(TEST_FILE_PATH), FileMode::READ);
+	// Smaller than the long line, the reader has to grow its buffer
+	BufferedReader reader(file, 16);
+
+	Optional<StringView> line = reader.next_line();
+	TK_TEST_ASSERT(line_equals(line, "first"));
+	line = reader.next_line();
+	TK_TEST_ASSERT(line_equals(line, ""));
+	line = reader.next_line();
+	TK_TEST_ASSERT(line_equals(line, "windows"));
+	line = reader.next_line();
+	TK_TEST_ASSERT(line_equals(line, long_line));
+	line = reader.next_line();
+	TK_TEST_ASSERT(line_equals(line, "last"));
+	TK_TEST_ASSERT(!reader.next_line().has_value());
+	TK_TEST_ASSERT(reader.at_end());
+
+	return true;
+}
+
+TK_TEST(BufferedStream, peek_skip_read) {
+	{
+		File file(StringView(TEST_FILE_PATH), FileMode::WRITE, FILE_FLAG_CREATE | FILE_FLAG_TRUNCATE);
+		BufferedWriter writer(file, 8);
+		writer.write("0123456789abcdefghijklmnopqrstuvwxyz");
+	}
+
+	File file(StringView(TEST_FILE_PATH), FileMode::READ);
+	BufferedReader reader(file, 8);
+
+	TK_TEST_ASSERT(reader.peek().value() == '0');
+	TK_TEST_ASSERT(reader.peek().value() == '0');
+	TK_TEST_ASSERT(reader.skip(10) == 10);
+	TK_TEST_ASSERT(reader.peek().value() == 'a');
+
+	char out[20]{};
+	TK_TEST_ASSERT(reader.read(out, 20) == 20);
+	TK_TEST_ASSERT(toki::strncmp(out, "abcdefghijklmnopqrst", 20) == 0);
+
+	TK_TEST_ASSERT(reader.skip(100) == 6);
+	TK_TEST_ASSERT(!reader.peek().has_value());
+
+	return true;
+}
+
+TK_TEST(BufferedStream, writer_reports_failed_writes) {
+	{
+		File file(StringView(TEST_FILE_PATH), FileMode::WRITE, FILE_FLAG_CREATE | FILE_FLAG_TRUNCATE);
+		BufferedWriter writer(file, 8);
+		writer.write("small");
+		writer.write("larger than the buffer");
+		TK_TEST_ASSERT(writer.flush());
+	}
+
+	// A file opened for reading takes no bytes, buffered and direct writes both fail
+	File file(StringView(TEST_FILE_PATH), FileMode::READ);
+	BufferedWriter buffered(file, 64);
+	buffered.write("small");
+	TK_TEST_ASSERT(!buffered.flush());
+	buffered.write("more");
+	TK_TEST_ASSERT(!buffered.flush());
+
+	BufferedWriter direct(file, 8);
+	direct.write("larger than the buffer");
+	TK_TEST_ASSERT(!direct.flush());
+
+	return true;
+}
@@ -0,0 +1,154 @@
+#include "testing.h"
+//
+
+#include <toki/core/core.h>
+#include <toki/runtime/resources/cooked_mesh.h>
+
+using namespace toki;
+
+static constexpr const char* TEST_FILE_PATH = "test_cooked_mesh.tmp";
+static constexpr u32 GRID_SIZE				= 8;
+
+// Flat grid of GRID_SIZE x GRID_SIZE quads with normals and texture coordinates
+static ObjData make_grid() {
+	ObjData data{};
+	for (u32 y = 0; y <= GRID_SIZE; y++) {
+		for (u32 x = 0; x <= GRID_SIZE; x++) {
+			Vertex vertex{};
+			vertex.position = { static_cast<f32>(x), static_cast<f32>(y), 0.5f };
+			vertex.normals	= { 0.0f, 0.0f, 1.0f };
+			vertex.uv		= { x / static_cast<f32>(GRID_SIZE), y / static_cast<f32>(GRID_SIZE) };
+			data.vertex_data.push_back(vertex);
+		}
+	}
+	for (u32 y = 0; y < GRID_SIZE; y++) {
+		for (u32 x = 0; x < GRID_SIZE; x++) {
+			u32 corner = y * (GRID_SIZE + 1) + x;
+			u32 above  = corner + GRID_SIZE + 1;
+			u32 quad[]{ corner, corner + 1, above + 1, corner, above + 1, above };
+			for (u32 i = 0; i < CARRAY_SIZE(quad); i++) {
+				data.index_data.push_back(quad[i]);
+			}
+		}
+	}
+	return data;
+}
+
+// Cooks the grid, loads it back and compares every index and vertex within tolerance
+static b8 round_trip(const MeshCookConfig& config, f32 tolerance) {
+	ObjData data = make_grid();
+	if (!cook_mesh(data, config, TEST_FILE_PATH)) {
+		return false;
+	}
+
+	CookedMesh mesh;
+	if (!mesh.load(TEST_FILE_PATH)) {
+		return false;
+	}
+
+	b8 passed = mesh.header().vertex_count == data.vertex_data.size() &&
+				mesh.index_count() == data.index_data.size() &&
+				((mesh.header().flags & COOKED_MESH_FLAG_MESHLETS) != 0) == config.build_meshlets;
+	for (u32 i = 0; passed && i < mesh.index_count(); i++) {
+		passed = mesh.indices()[i] == data.index_data[i];
+	}
+	for (u32 i = 0; passed && i < mesh.header().vertex_count; i++) {
+		Vertex expected = data.vertex_data[i];
+		Vertex decoded	= mesh.decode_vertex(i);
+		passed			= (decoded.position - expected.position).length() <= tolerance &&
+				 (decoded.normals - expected.normals).length() <= tolerance &&
+				 toki::abs(decoded.uv.x - expected.uv.x) <= tolerance &&
+				 toki::abs(decoded.uv.y - expected.uv.y) <= tolerance;
+	}
+	return passed;
+}
+
+TK_TEST(CookedMesh, round_trips_every_format) {
+	TK_TEST_ASSERT(round_trip({}, 0.0f));
+	TK_TEST_ASSERT(round_trip({ .vertex_format = CookedVertexFormat::QUANTIZED, .compress_indices = true }, 1e-3f));
+	TK_TEST_ASSERT(round_trip({ .vertex_format = CookedVertexFormat::PACKED, .build_meshlets = true }, 1e-2f));
+	return true;
+}
+
+TK_TEST(CookedMesh, rejects_out_of_range_indices) {
+	ObjData data = make_grid();
+	TK_TEST_ASSERT(cook_mesh(data, {}, TEST_FILE_PATH));
+
+	u64 index_offset = 0;
+	{
+		CookedMesh mesh;
+		TK_TEST_ASSERT(mesh.load(TEST_FILE_PATH));
+		index_offset = mesh.header().indices.offset;
+	}
+
+	// Points the last index one past the last vertex, the layout itself stays valid
+	{
+		File file(StringView(TEST_FILE_PATH), FileMode::RDWR);
+		u32 index = static_cast<u32>(data.vertex_data.size());
+		file.seek(static_cast<i64>(index_offset + (data.index_data.size() - 1) * sizeof(u32)), FileCursorStart::BEGIN);
+		TK_TEST_ASSERT(file.write(&index, sizeof(index)) == sizeof(index));
+	}
+
+	CookedMesh mesh;
+	TK_TEST_ASSERT(!mesh.load(TEST_FILE_PATH));
+	TK_TEST_ASSERT(!mesh.is_loaded());
+
+	// Compressed indices are checked after decoding, out of range ones encode just as well
+	data.index_data[3] = static_cast<u32>(data.vertex_data.size()) + 5;
+	TK_TEST_ASSERT(cook_mesh(data, { .compress_indices = true }, TEST_FILE_PATH));
+	TK_TEST_ASSERT(!mesh.load(TEST_FILE_PATH));
+	return true;
+}
+
+static void write_u32(u64 offset, u32 value) {
+	File file(StringView(TEST_FILE_PATH), FileMode::RDWR);
+	file.seek(static_cast<i64>(offset), FileCursorStart::BEGIN);
+	file.write(&value, sizeof(value));
+}
+
+TK_TEST(CookedMesh, rejects_out_of_range_meshlets) {
+	MeshCookConfig config{ .vertex_format = CookedVertexFormat::PACKED, .build_meshlets = true };
+	TK_TEST_ASSERT(cook_mesh(make_grid(), config, TEST_FILE_PATH));
+
+	Meshlet last{};
+	u64 last_offset			= 0;
+	u64 vertex_stream_end	= 0;
+	u64 triangle_stream_end = 0;
+	{
+		CookedMesh mesh;
+		TK_TEST_ASSERT(mesh.load(TEST_FILE_PATH));
+		TK_TEST_ASSERT(mesh.header().meshlet_count > 0);
+		last				= mesh.meshlets()[mesh.header().meshlet_count - 1];
+		last_offset			= mesh.header().meshlets.offset + (mesh.header().meshlet_count - 1) * sizeof(Meshlet);
+		vertex_stream_end	= mesh.header().meshlet_vertices.size / sizeof(u32);
+		triangle_stream_end = mesh.header().meshlet_triangles.size;
+	}
+
+	// The last meshlet reaching exactly to the end of both streams is still fine, one more is not
+	CookedMesh mesh;
+	u32 vertex_count = static_cast<u32>(vertex_stream_end - last.vertex_offset);
+	write_u32(last_offset + offsetof(Meshlet, vertex_count), vertex_count);
+	TK_TEST_ASSERT(mesh.load(TEST_FILE_PATH));
+	mesh.unload();
+	write_u32(last_offset + offsetof(Meshlet, vertex_count), vertex_count + 1);
+	TK_TEST_ASSERT(!mesh.load(TEST_FILE_PATH));
+	write_u32(last_offset + offsetof(Meshlet, vertex_count), last.vertex_count);
+
+	u32 triangle_count = static_cast<u32>((triangle_stream_end - last.triangle_offset) / 3);
+	write_u32(last_offset + offsetof(Meshlet, triangle_count), triangle_count);
+	TK_TEST_ASSERT(mesh.load(TEST_FILE_PATH));
+	mesh.unload();
+	write_u32(last_offset + offsetof(Meshlet, triangle_count), triangle_count + 1);
+	TK_TEST_ASSERT(!mesh.load(TEST_FILE_PATH));
+
+	// Offsets far enough out to wrap around in 32 bits
+	write_u32(last_offset + offsetof(Meshlet, triangle_count), last.triangle_count);
+	write_u32(last_offset + offsetof(Meshlet, vertex_offset), 0xffffffffu);
+	TK_TEST_ASSERT(!mesh.load(TEST_FILE_PATH));
+	return true;
+}
+
+TK_TEST(CookedMesh, reports_unwritable_output) {
+	TK_TEST_ASSERT(!cook_mesh(make_grid(), {}, "missing_directory/test_cooked_mesh.tmp"));
+	return true;
+}
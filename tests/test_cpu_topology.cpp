@@ -0,0 +1,60 @@
+#include "testing.h"
+//
+
+#include <toki/core/core.h>
+
+using namespace toki;
+
+static u32 count_set(const CpuMask& mask) {
+	u32 count = 0;
+	for (u32 i = 0; i < MAX_CPU_COUNT; i++) {
+		count += mask[i] ? 1 : 0;
+	}
+	return count;
+}
+
+TK_TEST(CpuTopology, parse_cpu_list) {
+	CpuMask mask = parse_cpu_list("0-3,8,10-11\n");
+	TK_TEST_ASSERT(count_set(mask) == 7);
+	TK_TEST_ASSERT(mask[0] && mask[3] && mask[8] && mask[10] && mask[11]);
+	TK_TEST_ASSERT(!mask[4] && !mask[9] && !mask[12]);
+
+	TK_TEST_ASSERT(count_set(parse_cpu_list("")) == 0);
+	TK_TEST_ASSERT(count_set(parse_cpu_list("5")) == 1);
+
+	// Ranges reaching past the mask are cut off instead of writing out of bounds
+	mask = parse_cpu_list("250-300,1000");
+	TK_TEST_ASSERT(count_set(mask) == MAX_CPU_COUNT - 250);
+	TK_TEST_ASSERT(mask[MAX_CPU_COUNT - 1]);
+
+	return true;
+}
+
+TK_TEST(CpuTopology, query_is_consistent) {
+	CpuTopology topology = query_cpu_topology();
+	TK_TEST_ASSERT(topology.logical_cpus.size() > 0);
+	TK_TEST_ASSERT(topology.physical_cores.size() > 0);
+	TK_TEST_ASSERT(topology.physical_cores.size() <= topology.logical_cpus.size());
+	TK_TEST_ASSERT(topology.package_count > 0 && topology.numa_node_count > 0);
+
+	// Every logical CPU belongs to exactly one physical core and one NUMA node
+	u32 core_cpus = 0;
+	for (u32 i = 0; i < topology.physical_cores.size(); i++) {
+		CpuMask mask = topology.physical_core_mask(i);
+		TK_TEST_ASSERT(mask[topology.physical_cores[i]]);
+		core_cpus += count_set(mask);
+	}
+	TK_TEST_ASSERT(core_cpus == topology.logical_cpus.size());
+
+	u32 node_cpus = 0;
+	for (u32 i = 0; i < topology.numa_node_count; i++) {
+		node_cpus += count_set(topology.numa_node_mask(i));
+	}
+	TK_TEST_ASSERT(node_cpus == topology.logical_cpus.size());
+
+	for (u32 i = 0; i < topology.logical_cpus.size(); i++) {
+		TK_TEST_ASSERT(topology.logical_cpus[i].package < topology.package_count);
+	}
+
+	return true;
+}
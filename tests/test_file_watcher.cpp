@@ -0,0 +1,108 @@
+#include "testing.h"
+//
+
+#include <stdio.h>
+#include <toki/core/core.h>
+#include <toki/core/platform/file_watcher.h>
+
+using namespace toki;
+
+static constexpr const char* TEST_DIRECTORY		= "test_file_watcher";
+static constexpr const char* TEST_FILE_PATH		= "test_file_watcher/a.tmp";
+static constexpr const char* RENAMED_PATH		= "test_file_watcher/b.tmp";
+static constexpr const char* SUBDIRECTORY		= "test_file_watcher/old";
+static constexpr const char* SUBDIRECTORY_FILE	= "test_file_watcher/old/c.tmp";
+static constexpr const char* NEW_DIRECTORY		= "test_file_watcher/new";
+static constexpr const char* NEW_DIRECTORY_FILE = "test_file_watcher/new/d.tmp";
+
+static void write_text(const char* path, const char* text) {
+	File file(StringView(path), FileMode::WRITE, FILE_FLAG_CREATE | FILE_FLAG_TRUNCATE);
+	file.write(text, toki::strlen(text));
+}
+
+// Files first, directories once they are empty. Also cleans up after an earlier run that failed.
+static void remove_test_directory() {
+	const char* paths[]{
+		TEST_FILE_PATH, RENAMED_PATH, SUBDIRECTORY_FILE, NEW_DIRECTORY_FILE, SUBDIRECTORY, NEW_DIRECTORY, TEST_DIRECTORY
+	};
+	for (u32 i = 0; i < CARRAY_SIZE(paths); i++) {
+		::remove(paths[i]);
+	}
+}
+
+static b8 contains(const DynamicArray<Path>& paths, const char* expected) {
+	u64 size = toki::strlen(expected);
+	for (u64 i = 0; i < paths.size(); i++) {
+		if (toki::strlen(paths[i].c_str()) == size && toki::strncmp(paths[i].c_str(), expected, size) == 0) {
+			return true;
+		}
+	}
+	return false;
+}
+
+TK_TEST(FileWatcher, debounces_changes) {
+	remove_test_directory();
+	TK_TEST_ASSERT(!toki::create_directory(TEST_DIRECTORY).has_value());
+
+	DynamicArray<Path> changed;
+	{
+		FileWatcher watcher({ .debounce_ms = 50 });
+		TK_TEST_ASSERT(watcher.watch_directory(TEST_DIRECTORY, false));
+
+		// Saved three times in a row and once through a temporary file moved into place
+		write_text(TEST_FILE_PATH, "first");
+		write_text(TEST_FILE_PATH, "second");
+		write_text(TEST_FILE_PATH, "third");
+		write_text("test_file_watcher.tmp", "renamed");
+		TK_TEST_ASSERT(::rename("test_file_watcher.tmp", RENAMED_PATH) == 0);
+
+		// Nothing settled yet
+		TK_TEST_ASSERT(watcher.poll(changed) == 0);
+
+		toki::sleep(100);
+		TK_TEST_ASSERT(watcher.poll(changed) == 2);
+		TK_TEST_ASSERT(changed.size() == 2);
+		TK_TEST_ASSERT(contains(changed, TEST_FILE_PATH));
+		TK_TEST_ASSERT(contains(changed, RENAMED_PATH));
+
+		// Reported changes are not reported again
+		toki::sleep(60);
+		TK_TEST_ASSERT(watcher.poll(changed) == 0);
+	}
+
+	remove_test_directory();
+	return true;
+}
+
+TK_TEST(FileWatcher, watches_subdirectories) {
+	remove_test_directory();
+	TK_TEST_ASSERT(!toki::create_directory(TEST_DIRECTORY).has_value());
+	TK_TEST_ASSERT(!toki::create_directory(SUBDIRECTORY).has_value());
+
+	DynamicArray<Path> changed;
+	DynamicArray<Path> created;
+	{
+		FileWatcher recursive({ .debounce_ms = 0 });
+		FileWatcher flat({ .debounce_ms = 0 });
+		TK_TEST_ASSERT(recursive.watch_directory(TEST_DIRECTORY, true));
+		TK_TEST_ASSERT(flat.watch_directory(TEST_DIRECTORY, false));
+
+		// Existing subdirectories are watched right away
+		write_text(SUBDIRECTORY_FILE, "old");
+		TK_TEST_ASSERT(recursive.poll(changed) == 1);
+		TK_TEST_ASSERT(contains(changed, SUBDIRECTORY_FILE));
+		TK_TEST_ASSERT(flat.poll(changed) == 0);
+
+		// New ones once the poll saw them being created, files written before that are missed
+		TK_TEST_ASSERT(!toki::create_directory(NEW_DIRECTORY).has_value());
+		TK_TEST_ASSERT(recursive.poll(created) == 0);
+		TK_TEST_ASSERT(flat.poll(created) == 0);
+		write_text(NEW_DIRECTORY_FILE, "new");
+		TK_TEST_ASSERT(recursive.poll(created) == 1);
+		TK_TEST_ASSERT(contains(created, NEW_DIRECTORY_FILE));
+		TK_TEST_ASSERT(flat.poll(created) == 0);
+	}
+
+	remove_test_directory();
+	return true;
+}
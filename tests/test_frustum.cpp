@@ -0,0 +1,97 @@
+#include "testing.h"
+//
+
+#include <toki/core/core.h>
+
+using namespace toki;
+
+// Camera at the origin looking down -z with a 90 degree field of view, near 1 and far 100
+static Frustum test_frustum() {
+	Matrix4 view = look_at(Vector3(0.0f), Vector3(0.0f, 0.0f, -1.0f), Vector3(0.0f, 1.0f, 0.0f));
+	return Frustum::from_matrix(perspective(static_cast<f32>(PI / 2.0), 1.0f, 1.0f, 100.0f) * view);
+}
+
+static Aabb box_at(const Vector3& center, f32 extent) {
+	return Aabb{ center - Vector3(extent), center + Vector3(extent) };
+}
+
+TK_TEST(Frustum, planes_are_normalized) {
+	Frustum frustum = test_frustum();
+	for (u32 i = 0; i < Frustum::PLANE_COUNT; i++) {
+		TK_TEST_ASSERT(toki::abs(frustum.planes[i].xyz().length() - 1.0f) <= 1e-5f);
+	}
+
+	// Distances are in world units
+	TK_TEST_ASSERT(toki::abs(frustum.distance(Frustum::PLANE_NEAR, Vector3(0.0f, 0.0f, -3.0f)) - 2.0f) <= 1e-4f);
+	TK_TEST_ASSERT(toki::abs(frustum.distance(Frustum::PLANE_FAR, Vector3(0.0f, 0.0f, -60.0f)) - 40.0f) <= 1e-2f);
+	return true;
+}
+
+TK_TEST(Frustum, contains) {
+	Frustum frustum = test_frustum();
+	TK_TEST_ASSERT(frustum.contains(Vector3(0.0f, 0.0f, -10.0f)));
+	TK_TEST_ASSERT(frustum.contains(Vector3(9.0f, -9.0f, -10.0f)));
+	TK_TEST_ASSERT(!frustum.contains(Vector3(11.0f, 0.0f, -10.0f)));
+	TK_TEST_ASSERT(!frustum.contains(Vector3(0.0f, 0.0f, 10.0f)));
+	TK_TEST_ASSERT(!frustum.contains(Vector3(0.0f, 0.0f, -0.5f)));
+	TK_TEST_ASSERT(!frustum.contains(Vector3(0.0f, 0.0f, -101.0f)));
+	return true;
+}
+
+TK_TEST(Frustum, spheres) {
+	Frustum frustum = test_frustum();
+	TK_TEST_ASSERT(frustum.intersects(BoundingSphere{ Vector3(0.0f, 0.0f, -50.0f), 1.0f }));
+	// Center outside but the sphere reaches over the right plane
+	TK_TEST_ASSERT(frustum.intersects(BoundingSphere{ Vector3(12.0f, 0.0f, -10.0f), 2.0f }));
+	TK_TEST_ASSERT(!frustum.intersects(BoundingSphere{ Vector3(14.0f, 0.0f, -10.0f), 2.0f }));
+	TK_TEST_ASSERT(!frustum.intersects(BoundingSphere{ Vector3(0.0f, 0.0f, 5.0f), 2.0f }));
+
+	BoundingSphere sphere = BoundingSphere::from_aabb(box_at(Vector3(1.0f, 2.0f, 3.0f), 1.0f));
+	TK_TEST_ASSERT(sphere.center == Vector3(1.0f, 2.0f, 3.0f));
+	TK_TEST_ASSERT(toki::abs(sphere.radius - static_cast<f32>(toki::sqrt(3.0))) <= 1e-6f);
+	return true;
+}
+
+TK_TEST(Frustum, classify_boxes) {
+	Frustum frustum = test_frustum();
+	TK_TEST_ASSERT(frustum.classify(box_at(Vector3(0.0f, 0.0f, -50.0f), 1.0f)) == FrustumTest::INSIDE);
+	TK_TEST_ASSERT(frustum.classify(box_at(Vector3(10.0f, 0.0f, -10.0f), 1.0f)) == FrustumTest::INTERSECTING);
+	TK_TEST_ASSERT(frustum.classify(box_at(Vector3(0.0f, 0.0f, -100.0f), 1.0f)) == FrustumTest::INTERSECTING);
+	TK_TEST_ASSERT(frustum.classify(box_at(Vector3(0.0f, 0.0f, 10.0f), 1.0f)) == FrustumTest::OUTSIDE);
+	TK_TEST_ASSERT(frustum.classify(box_at(Vector3(-20.0f, 0.0f, -10.0f), 1.0f)) == FrustumTest::OUTSIDE);
+	TK_TEST_ASSERT(frustum.classify(box_at(Vector3(0.0f, 30.0f, -10.0f), 1.0f)) == FrustumTest::OUTSIDE);
+	// Around the camera, crosses the near plane
+	TK_TEST_ASSERT(frustum.classify(box_at(Vector3(0.0f), 2.0f)) == FrustumTest::INTERSECTING);
+	TK_TEST_ASSERT(!frustum.intersects(Aabb{}));
+	return true;
+}
+
+TK_TEST(Frustum, matches_clip_space) {
+	// Points the view projection puts inside the clip volume are the ones the planes contain
+	Matrix4 view			= look_at(Vector3(3.0f, 2.0f, 5.0f), Vector3(0.0f), Vector3(0.0f, 1.0f, 0.0f));
+	Matrix4 view_projection = perspective(1.2f, 1.5f, 0.5f, 40.0f) * view;
+	Frustum frustum			= Frustum::from_matrix(view_projection);
+
+	for (i32 x = -10; x <= 10; x++) {
+		for (i32 y = -10; y <= 10; y++) {
+			for (i32 z = -10; z <= 10; z++) {
+				Vector3 point(static_cast<f32>(x) * 1.3f, static_cast<f32>(y) * 0.9f, static_cast<f32>(z) * 1.7f);
+
+				// Points right on a plane can go either way with rounding
+				b8 on_plane = false;
+				for (u32 i = 0; i < Frustum::PLANE_COUNT; i++) {
+					on_plane = on_plane || toki::abs(frustum.distance(i, point)) <= 1e-3f;
+				}
+				if (on_plane) {
+					continue;
+				}
+
+				Vector4 clip = view_projection * Vector4(point, 1.0f);
+				b8 inside	 = clip.w > 0.0f && toki::abs(clip.x) <= clip.w && toki::abs(clip.y) <= clip.w;
+				inside		 = inside && clip.z >= 0.0f && clip.z <= clip.w;
+				TK_TEST_ASSERT(frustum.contains(point) == inside);
+			}
+		}
+	}
+	return true;
+}
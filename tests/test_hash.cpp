@@ -0,0 +1,36 @@
+#include "testing.h"
+//
+
+#include <toki/core/core.h>
+
+using namespace toki;
+
+TK_TEST(Hash, fnv1a_matches_reference_values) {
+	static_assert(toki::hash_fnv1a("", 0) == 0xCBF29CE484222325);
+
+	TK_TEST_ASSERT(toki::hash_fnv1a("a", 1) == 0xAF63DC4C8601EC8C);
+	TK_TEST_ASSERT(toki::hash_fnv1a(StringView("foobar")) == 0x85944171F73967E8);
+
+	return true;
+}
+
+TK_TEST(Hash, hash_bytes_covers_every_byte) {
+	byte data[37]{};
+	for (u32 i = 0; i < CARRAY_SIZE(data); i++) {
+		data[i] = static_cast<byte>(i * 13);
+	}
+
+	// Changing any byte, including the ones in the partial last word, changes the hash
+	u64 reference = toki::hash_bytes(data, CARRAY_SIZE(data));
+	for (u32 i = 0; i < CARRAY_SIZE(data); i++) {
+		data[i] ^= 1;
+		TK_TEST_ASSERT(toki::hash_bytes(data, CARRAY_SIZE(data)) != reference);
+		data[i] ^= 1;
+	}
+
+	TK_TEST_ASSERT(toki::hash_bytes(data, CARRAY_SIZE(data)) == reference);
+	TK_TEST_ASSERT(toki::hash_bytes(data, CARRAY_SIZE(data), 1) != reference);
+	TK_TEST_ASSERT(toki::hash_bytes(data, CARRAY_SIZE(data) - 1) != reference);
+
+	return true;
+}
@@ -0,0 +1,78 @@
+#include "testing.h"
+//
+
+#include <toki/core/core.h>
+
+using namespace toki;
+
+TK_TEST(Image, mip_chain_layout) {
+	TK_TEST_ASSERT(toki::mip_level_count(1, 1) == 1);
+	TK_TEST_ASSERT(toki::mip_level_count(256, 1) == 9);
+	TK_TEST_ASSERT(toki::mip_level_count(5, 3) == 3);
+
+	TK_TEST_ASSERT(toki::mip_level_offset(4, 4, 2) == 64 + 16);
+	TK_TEST_ASSERT(toki::mip_chain_size(4, 4, 3) == 64 + 16 + 4);
+	TK_TEST_ASSERT(toki::mip_chain_size(4, 1, 3) == 16 + 8 + 4);
+
+	return true;
+}
+
+TK_TEST(Image, box_filter_matches_rounded_average) {
+	// Wide enough for the vectorized path, odd so the last column is dropped
+	constexpr u32 WIDTH	 = 37;
+	constexpr u32 HEIGHT = 9;
+
+	DynamicArray<byte> source(WIDTH * HEIGHT * 4);
+	u64 state = 7;
+	for (u64 i = 0; i < source.size(); i++) {
+		state	  = state * 6364136223846793005 + 1442695040888963407;
+		source[i] = static_cast<byte>(state >> 56);
+	}
+
+	DynamicArray<byte> level(mip_dimension(WIDTH, 1) * mip_dimension(HEIGHT, 1) * 4);
+	toki::downsample_rgba8(source.data(), WIDTH, HEIGHT, level.data());
+
+	for (u32 y = 0; y < HEIGHT / 2; y++) {
+		for (u32 x = 0; x < WIDTH / 2; x++) {
+			for (u32 c = 0; c < 4; c++) {
+				u32 sum = source[((2 * y) * WIDTH + 2 * x) * 4 + c] + source[((2 * y) * WIDTH + 2 * x + 1) * 4 + c] +
+						  source[((2 * y + 1) * WIDTH + 2 * x) * 4 + c] +
+						  source[((2 * y + 1) * WIDTH + 2 * x + 1) * 4 + c];
+				TK_TEST_ASSERT(level[(y * (WIDTH / 2) + x) * 4 + c] == (sum + 2) / 4);
+			}
+		}
+	}
+
+	return true;
+}
+
+TK_TEST(Image, filters_keep_flat_color) {
+	constexpr u32 SIZE = 16;
+	const byte color[] = { 200, 90, 17, 128 };
+
+	MipConfig configs[] = {
+		{ MipFilter::BOX, false },
+		{ MipFilter::BOX, true },
+		{ MipFilter::KAISER, false },
+		{ MipFilter::KAISER, true },
+	};
+
+	for (const MipConfig& config : configs) {
+		u32 level_count = toki::mip_level_count(SIZE, SIZE / 2);
+		DynamicArray<byte> chain(toki::mip_chain_size(SIZE, SIZE / 2, level_count));
+		for (u64 i = 0; i < SIZE * SIZE / 2 * 4; i++) {
+			chain[i] = color[i % 4];
+		}
+
+		byte* levels = chain.data() + SIZE * SIZE / 2 * 4;
+		toki::generate_mip_chain(chain.data(), SIZE, SIZE / 2, level_count, levels, config);
+
+		// Kernels are normalized, the sRGB round trip may be off by one
+		for (u64 i = 0; i < chain.size(); i++) {
+			i32 difference = static_cast<i32>(chain[i]) - color[i % 4];
+			TK_TEST_ASSERT(difference >= -1 && difference <= 1);
+		}
+	}
+
+	return true;
+}
@@ -0,0 +1,67 @@
+#include "testing.h"
+//
+
+#include <toki/core/core.h>
+
+using namespace toki;
+
+static b8 equals(StringView view, const char* expected) {
+	u64 size = toki::strlen(expected);
+	return view.size() == size && toki::strncmp(view.data(), expected, static_cast<u32>(size)) == 0;
+}
+
+TK_TEST(LineIndex, splits_lines_and_drops_carriage_returns) {
+	StringView text("first\r\nsecond\n\nlast");
+	LineIndex index(text);
+
+	TK_TEST_ASSERT(index.line_count() == 4);
+	TK_TEST_ASSERT(equals(index.line(0), "first"));
+	TK_TEST_ASSERT(equals(index.line(1), "second"));
+	TK_TEST_ASSERT(equals(index.line(2), ""));
+	TK_TEST_ASSERT(equals(index.line(3), "last"));
+
+	// A newline at the end does not add an empty line
+	LineIndex trailing(StringView("a\nb\n"));
+	TK_TEST_ASSERT(trailing.line_count() == 2);
+	TK_TEST_ASSERT(equals(trailing.line(1), "b"));
+
+	LineIndex empty(StringView(""));
+	TK_TEST_ASSERT(empty.line_count() == 0);
+	TK_TEST_ASSERT(!empty.has_line(0));
+
+	return true;
+}
+
+TK_TEST(LineIndex, indexes_only_as_far_as_needed) {
+	// Longer than one indexing step, lines of varying length cross the SIMD chunks
+	DynamicArray<char> text;
+	u64 line_count = 0;
+	while (text.size() < MB(1)) {
+		u64 length = line_count % 37;
+		for (u64 i = 0; i < length; i++) {
+			text.push_back(static_cast<char>('a' + (line_count + i) % 26));
+		}
+		text.push_back('\n');
+		line_count++;
+	}
+
+	LineIndex index(StringView(text.data(), text.size()));
+	TK_TEST_ASSERT(index.has_line(10));
+	TK_TEST_ASSERT(index.line(10).size() == 10);
+	TK_TEST_ASSERT(!index.is_complete());
+	TK_TEST_ASSERT(index.scanned_size() < text.size() / 4);
+
+	TK_TEST_ASSERT(index.line_count() == line_count);
+	TK_TEST_ASSERT(index.is_complete());
+
+	u64 line_number = 0;
+	for (StringView line : LineRange{ StringView(text.data(), text.size()) }) {
+		TK_TEST_ASSERT(line.size() == line_number % 37);
+		TK_TEST_ASSERT(line.size() == index.line(line_number).size());
+		TK_TEST_ASSERT(line.size() == 0 || line.data()[0] == static_cast<char>('a' + line_number % 26));
+		line_number++;
+	}
+	TK_TEST_ASSERT(line_number == line_count);
+
+	return true;
+}
@@ -0,0 +1,71 @@
+#include "testing.h"
+//
+
+#include <toki/core/core.h>
+
+using namespace toki;
+
+static constexpr u64 TEST_DATA_SIZE = 10000;
+
+static b8 round_trips(const byte* data, u64 size) {
+	DynamicArray<byte> compressed(lz4_compress_bound(size));
+	u64 compressed_size = toki::lz4_compress(data, size, compressed.data(), compressed.size());
+	if (compressed_size == 0) {
+		return false;
+	}
+
+	DynamicArray<byte> decompressed(size + 1);
+	auto result = toki::lz4_decompress(compressed.data(), compressed_size, decompressed.data(), decompressed.size());
+	if (!result || result.value() != size) {
+		return false;
+	}
+
+	for (u64 i = 0; i < size; i++) {
+		if (decompressed[i] != data[i]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+TK_TEST(Lz4, round_trips_repetitive_and_random_data) {
+	DynamicArray<byte> data(TEST_DATA_SIZE);
+	for (u64 i = 0; i < data.size(); i++) {
+		data[i] = static_cast<byte>("abcabcabd"[i % 9]);
+	}
+	TK_TEST_ASSERT(round_trips(data.data(), data.size()));
+
+	DynamicArray<byte> compressed(lz4_compress_bound(data.size()));
+	TK_TEST_ASSERT(toki::lz4_compress(data.data(), data.size(), compressed.data(), compressed.size()) < data.size() / 10);
+
+	u64 state = 12345;
+	for (u64 i = 0; i < data.size(); i++) {
+		state	= state * 6364136223846793005 + 1442695040888963407;
+		data[i] = static_cast<byte>(state >> 56);
+	}
+	TK_TEST_ASSERT(round_trips(data.data(), data.size()));
+
+	// Shorter than the minimum size a match can appear in
+	for (u64 size = 0; size < 20; size++) {
+		TK_TEST_ASSERT(round_trips(data.data(), size));
+	}
+
+	return true;
+}
+
+TK_TEST(Lz4, rejects_corrupt_input) {
+	DynamicArray<byte> data(TEST_DATA_SIZE, 7);
+	DynamicArray<byte> compressed(lz4_compress_bound(data.size()));
+	u64 compressed_size = toki::lz4_compress(data.data(), data.size(), compressed.data(), compressed.size());
+
+	// Too small destination
+	TK_TEST_ASSERT(!toki::lz4_decompress(compressed.data(), compressed_size, data.data(), data.size() - 1));
+	// Truncated block
+	TK_TEST_ASSERT(!toki::lz4_decompress(compressed.data(), compressed_size - 1, data.data(), data.size()));
+
+	// Offset pointing before the start of the output
+	byte bad_offset[] = { 0x10, 'a', 0x10, 0x00, 0x00 };
+	TK_TEST_ASSERT(!toki::lz4_decompress(bad_offset, CARRAY_SIZE(bad_offset), data.data(), data.size()));
+
+	return true;
+}
@@ -45,3 +45,71 @@ TK_TEST(Matrix4, multiply) {
 
 	return true;
 }
+
+static constexpr Matrix4 sequence_matrix() {
+	Matrix4 matrix;
+	for (u32 i = 0; i < 16; i++) {
+		matrix[i] = static_cast<f32>(i + 1);
+	}
+	return matrix;
+}
+
+static b8 nearly_equal(const Matrix4& lhs, const Matrix4& rhs) {
+	for (u32 i = 0; i < 16; i++) {
+		if (toki::abs(lhs[i] - rhs[i]) > 1e-5f) {
+			return false;
+		}
+	}
+	return true;
+}
+
+TK_TEST(Matrix4, multiply_matches_compile_time) {
+	constexpr Matrix4 lhs	   = sequence_matrix();
+	constexpr Matrix4 rhs	   = Matrix4(Vector3{ 1, 2, 3 }).scale(0.5f);
+	constexpr Matrix4 expected = lhs * rhs;
+
+	Matrix4 runtime_lhs = lhs;
+	TK_TEST_ASSERT(nearly_equal(runtime_lhs * rhs, expected));
+
+	return true;
+}
+
+TK_TEST(Matrix4, transpose) {
+	Matrix4 matrix	   = sequence_matrix();
+	Matrix4 transposed = matrix.transpose();
+
+	for (u32 col = 0; col < 4; col++) {
+		for (u32 row = 0; row < 4; row++) {
+			TK_TEST_ASSERT(transposed[row * 4 + col] == matrix[col * 4 + row]);
+		}
+	}
+	TK_TEST_ASSERT(transposed.transpose() == matrix);
+
+	return true;
+}
+
+TK_TEST(Matrix4, inverse) {
+	Matrix4 matrix = Matrix4(Vector3{ 1, 2, 3 }).rotate(Vector3{ 0, 1, 1 }, 0.7f).scale(Vector3{ 1, 2, 3 });
+	TK_TEST_ASSERT(nearly_equal(matrix * matrix.inverse(), Matrix4{}));
+	TK_TEST_ASSERT(nearly_equal(matrix.inverse() * matrix, Matrix4{}));
+
+	// Singular matrices give the identity
+	TK_TEST_ASSERT(Matrix4(1.0f).inverse() == Matrix4{});
+
+	return true;
+}
+
+TK_TEST(Matrix4, transform_point) {
+	Matrix4 matrix = Matrix4(Vector3{ 1, 2, 3 }).scale(2.0f);
+
+	Vector3 point = matrix.transform_point(Vector3{ 1, 1, 1 });
+	TK_TEST_ASSERT(point.x == 3.0f && point.y == 4.0f && point.z == 5.0f);
+
+	Vector3 direction = matrix.transform_direction(Vector3{ 1, 1, 1 });
+	TK_TEST_ASSERT(direction.x == 2.0f && direction.y == 2.0f && direction.z == 2.0f);
+
+	Vector4 vector = matrix * Vector4(1, 1, 1, 0.5f);
+	TK_TEST_ASSERT(vector.x == 2.5f && vector.y == 3.0f && vector.z == 3.5f && vector.w == 0.5f);
+
+	return true;
+}
@@ -0,0 +1,154 @@
+#include "testing.h"
+//
+
+#include <toki/core/core.h>
+
+using namespace toki;
+
+static constexpr u32 GRID_SIZE = 32;
+
+// Grid of GRID_SIZE by GRID_SIZE quads with its triangles in a scrambled order, the worst case
+// for the vertex cache
+static void shuffled_grid(DynamicArray<Vector3>& positions, DynamicArray<u32>& indices) {
+	for (u32 y = 0; y <= GRID_SIZE; y++) {
+		for (u32 x = 0; x <= GRID_SIZE; x++) {
+			positions.push_back(Vector3(static_cast<f32>(x), static_cast<f32>(y), 0.0f));
+		}
+	}
+
+	u32 quad_count = GRID_SIZE * GRID_SIZE;
+	for (u32 i = 0; i < quad_count; i++) {
+		// 7 and quad_count are coprime, every quad comes up once
+		u32 quad   = (i * 7 + 3) % quad_count;
+		u32 corner = (quad / GRID_SIZE) * (GRID_SIZE + 1) + quad % GRID_SIZE;
+		u32 quad_indices[6]{
+			corner, corner + 1, corner + GRID_SIZE + 2, corner, corner + GRID_SIZE + 2, corner + GRID_SIZE + 1
+		};
+		for (u32 j = 0; j < 6; j++) {
+			indices.push_back(quad_indices[j]);
+		}
+	}
+}
+
+// Rotates every triangle so it starts with its smallest index and sorts them, equal for index
+// buffers with the same triangles and windings in any order
+static DynamicArray<u64> canonical_triangles(const u32* indices, u64 index_count) {
+	DynamicArray<u64> triangles;
+	for (u64 i = 0; i < index_count; i += 3) {
+		u32 a = indices[i], b = indices[i + 1], c = indices[i + 2];
+		while (a > b || a > c) {
+			u32 first = a;
+			a		  = b;
+			b		  = c;
+			c		  = first;
+		}
+		triangles.push_back((static_cast<u64>(a) << 42) | (static_cast<u64>(b) << 21) | c);
+	}
+	toki::sort(triangles.data(), triangles.size());
+	return triangles;
+}
+
+static b8 same_triangles(const DynamicArray<u32>& lhs, const DynamicArray<u32>& rhs) {
+	DynamicArray<u64> lhs_triangles = canonical_triangles(lhs.data(), lhs.size());
+	DynamicArray<u64> rhs_triangles = canonical_triangles(rhs.data(), rhs.size());
+	if (lhs_triangles.size() != rhs_triangles.size()) {
+		return false;
+	}
+	for (u64 i = 0; i < lhs_triangles.size(); i++) {
+		if (lhs_triangles[i] != rhs_triangles[i]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+TK_TEST(MeshOptimizer, vertex_cache) {
+	DynamicArray<Vector3> positions;
+	DynamicArray<u32> indices;
+	shuffled_grid(positions, indices);
+	u32 vertex_count = static_cast<u32>(positions.size());
+
+	DynamicArray<u32> optimized(indices.size());
+	optimize_vertex_cache(indices, vertex_count, optimized.data());
+	TK_TEST_ASSERT(same_triangles(indices, optimized));
+
+	VertexCacheStatistics before = analyze_vertex_cache(indices, vertex_count);
+	VertexCacheStatistics after	 = analyze_vertex_cache(optimized, vertex_count);
+	TK_TEST_ASSERT(before.acmr > 1.5f);
+	// A regular grid can't go below 0.5 and Tipsify gets within about 0.2 of that
+	TK_TEST_ASSERT(after.acmr < 0.75f);
+	TK_TEST_ASSERT(after.atvr < 1.5f);
+	return true;
+}
+
+TK_TEST(MeshOptimizer, overdraw) {
+	DynamicArray<Vector3> positions;
+	DynamicArray<u32> indices;
+	shuffled_grid(positions, indices);
+	u32 vertex_count = static_cast<u32>(positions.size());
+
+	DynamicArray<u32> cache_optimized(indices.size());
+	DynamicArray<u32> optimized(indices.size());
+	optimize_vertex_cache(indices, vertex_count, cache_optimized.data());
+	optimize_overdraw(cache_optimized, positions.data(), sizeof(Vector3), vertex_count, optimized.data());
+	TK_TEST_ASSERT(same_triangles(indices, optimized));
+
+	// Clusters start with a cold cache, the threshold bounds what that costs
+	f32 cache_acmr = analyze_vertex_cache(cache_optimized, vertex_count).acmr;
+	TK_TEST_ASSERT(analyze_vertex_cache(optimized, vertex_count).acmr <= cache_acmr * 1.05f + 0.01f);
+	return true;
+}
+
+TK_TEST(MeshOptimizer, vertex_fetch) {
+	DynamicArray<Vector3> positions;
+	DynamicArray<u32> indices;
+	shuffled_grid(positions, indices);
+	u32 vertex_count = static_cast<u32>(positions.size());
+	// An unused vertex is dropped
+	positions.push_back(Vector3(-1.0f));
+
+	DynamicArray<Vector3> original_positions(Span<Vector3>{ positions });
+	DynamicArray<u32> remapped(indices.size());
+	optimize_vertex_cache(indices, vertex_count, remapped.data());
+	toki::memcpy(indices.data(), remapped.data(), indices.size() * sizeof(u32));
+
+	u32 new_count = optimize_vertex_fetch(
+		remapped.data(), remapped.size(), positions.data(), vertex_count + 1, sizeof(Vector3));
+	TK_TEST_ASSERT(new_count == vertex_count);
+
+	u32 next_new_vertex = 0;
+	for (u64 i = 0; i < indices.size(); i++) {
+		TK_TEST_ASSERT(positions[remapped[i]] == original_positions[indices[i]]);
+		// Vertices are numbered in the order they are first used
+		TK_TEST_ASSERT(remapped[i] <= next_new_vertex);
+		if (remapped[i] == next_new_vertex) {
+			next_new_vertex++;
+		}
+	}
+
+	VertexFetchStatistics fetch = analyze_vertex_fetch(remapped, new_count, sizeof(Vector3));
+	TK_TEST_ASSERT(fetch.overfetch >= 1.0f && fetch.overfetch < 1.5f);
+	return true;
+}
+
+TK_TEST(MeshOptimizer, index_encoding) {
+	u32 indices[]{ 0, 1, 2, 2, 1, 3, 1000000, 7, U32_MAX, 0, U32_MAX - 5, 3 };
+
+	DynamicArray<byte> encoded;
+	encode_indices(indices, encoded);
+
+	u32 decoded[CARRAY_SIZE(indices)]{};
+	auto result = decode_indices(encoded.data(), encoded.size(), decoded, CARRAY_SIZE(indices));
+	TK_TEST_ASSERT(result && result.value() == encoded.size());
+	for (u32 i = 0; i < CARRAY_SIZE(indices); i++) {
+		TK_TEST_ASSERT(decoded[i] == indices[i]);
+	}
+
+	// Truncated input and a value longer than 32 bits fail instead of reading on
+	TK_TEST_ASSERT(!decode_indices(encoded.data(), encoded.size() - 1, decoded, CARRAY_SIZE(indices)));
+	byte overlong[]{ 0xFF, 0xFF, 0xFF, 0xFF, 0x7F };
+	TK_TEST_ASSERT(!decode_indices(overlong, CARRAY_SIZE(overlong), decoded, 1));
+	byte endless[]{ 0x80, 0x80, 0x80, 0x80, 0x80, 0x01 };
+	TK_TEST_ASSERT(!decode_indices(endless, CARRAY_SIZE(endless), decoded, 1));
+	return true;
+}
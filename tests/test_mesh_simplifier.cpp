@@ -0,0 +1,154 @@
+#include "testing.h"
+//
+
+#include <toki/core/core.h>
+
+using namespace toki;
+
+static constexpr u32 GRID_SIZE = 16;
+
+// Grid of GRID_SIZE by GRID_SIZE quads on the xy plane, height gives each vertex its z
+static void grid(DynamicArray<Vector3>& positions, DynamicArray<u32>& indices, f32 (*height)(f32 x, f32 y)) {
+	for (u32 y = 0; y <= GRID_SIZE; y++) {
+		for (u32 x = 0; x <= GRID_SIZE; x++) {
+			f32 fx = static_cast<f32>(x), fy = static_cast<f32>(y);
+			positions.push_back(Vector3(fx, fy, height(fx, fy)));
+		}
+	}
+
+	for (u32 y = 0; y < GRID_SIZE; y++) {
+		for (u32 x = 0; x < GRID_SIZE; x++) {
+			u32 corner = y * (GRID_SIZE + 1) + x;
+			u32 quad_indices[6]{
+				corner, corner + 1, corner + GRID_SIZE + 2, corner, corner + GRID_SIZE + 2, corner + GRID_SIZE + 1
+			};
+			for (u32 j = 0; j < 6; j++) {
+				indices.push_back(quad_indices[j]);
+			}
+		}
+	}
+}
+
+static f32 flat(f32, f32) {
+	return 0.0f;
+}
+
+static f32 bumpy(f32 x, f32 y) {
+	return toki::sin(x * 0.7f) * toki::cos(y * 0.5f) * 2.0f;
+}
+
+TK_TEST(MeshSimplifier, flat_grid) {
+	DynamicArray<Vector3> positions;
+	DynamicArray<u32> indices;
+	grid(positions, indices, flat);
+	u32 vertex_count = static_cast<u32>(positions.size());
+
+	DynamicArray<u32> simplified(indices.size());
+	f32 error		= -1.0f;
+	u64 index_count = simplify_mesh(
+		indices,
+		positions.data(),
+		sizeof(Vector3),
+		vertex_count,
+		{ .target_index_count = indices.size() / 8 },
+		simplified.data(),
+		&error);
+	TK_TEST_ASSERT(index_count > 0 && index_count <= indices.size() / 8);
+	TK_TEST_ASSERT(index_count % 3 == 0);
+	TK_TEST_ASSERT(error >= 0.0f && error < 0.001f);
+
+	// Borders only collapse along themselves, so the corners stay and the triangles still cover
+	// the whole grid with the same winding
+	b8 corners[4]{};
+	f32 area = 0.0f;
+	for (u64 i = 0; i < index_count; i += 3) {
+		const Vector3& a = positions[simplified[i]];
+		const Vector3& b = positions[simplified[i + 1]];
+		const Vector3& c = positions[simplified[i + 2]];
+		f32 doubled_area = (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+		TK_TEST_ASSERT(doubled_area > 0.0f);
+		area += doubled_area * 0.5f;
+
+		for (u32 j = 0; j < 3; j++) {
+			u32 index = simplified[i + j];
+			u32 x = index % (GRID_SIZE + 1), y = index / (GRID_SIZE + 1);
+			if ((x == 0 || x == GRID_SIZE) && (y == 0 || y == GRID_SIZE)) {
+				corners[(x == 0 ? 0 : 1) + (y == 0 ? 0 : 2)] = true;
+			}
+		}
+	}
+	TK_TEST_ASSERT(corners[0] && corners[1] && corners[2] && corners[3]);
+	TK_TEST_ASSERT(toki::abs(area - static_cast<f32>(GRID_SIZE * GRID_SIZE)) < 0.01f);
+	return true;
+}
+
+TK_TEST(MeshSimplifier, max_error) {
+	DynamicArray<Vector3> positions;
+	DynamicArray<u32> indices;
+	grid(positions, indices, bumpy);
+	u32 vertex_count = static_cast<u32>(positions.size());
+
+	// Reaching a single triangle would flatten the bumps, the error limit stops it first
+	DynamicArray<u32> simplified(indices.size());
+	f32 error		= -1.0f;
+	u64 index_count = simplify_mesh(
+		indices,
+		positions.data(),
+		sizeof(Vector3),
+		vertex_count,
+		{ .target_index_count = 3, .max_error = 0.1f },
+		simplified.data(),
+		&error);
+	TK_TEST_ASSERT(index_count > 3 && index_count < indices.size());
+	TK_TEST_ASSERT(error > 0.0f && error <= 0.1f);
+	return true;
+}
+
+TK_TEST(MeshSimplifier, lod_chain) {
+	DynamicArray<Vector3> positions;
+	DynamicArray<u32> indices;
+	grid(positions, indices, bumpy);
+	u32 vertex_count = static_cast<u32>(positions.size());
+
+	DynamicArray<u32> lod_indices;
+	DynamicArray<MeshLod> lods;
+	build_lod_chain(
+		indices, positions.data(), sizeof(Vector3), vertex_count, { .max_lod_count = 4 }, lod_indices, lods);
+	TK_TEST_ASSERT(lods.size() == 4);
+
+	// LOD 0 is the input, the rest follow it back to back and get coarser
+	TK_TEST_ASSERT(lods[0].first_index == 0 && lods[0].index_count == indices.size() && lods[0].error == 0.0f);
+	for (u64 i = 0; i < indices.size(); i++) {
+		TK_TEST_ASSERT(lod_indices[i] == indices[i]);
+	}
+	for (u64 i = 1; i < lods.size(); i++) {
+		TK_TEST_ASSERT(lods[i].first_index == lods[i - 1].first_index + lods[i - 1].index_count);
+		TK_TEST_ASSERT(lods[i].index_count <= lods[i - 1].index_count / 2);
+		TK_TEST_ASSERT(lods[i].error >= lods[i - 1].error);
+	}
+	TK_TEST_ASSERT(lods.last().first_index + lods.last().index_count == lod_indices.size());
+	for (u64 i = 0; i < lod_indices.size(); i++) {
+		TK_TEST_ASSERT(lod_indices[i] < vertex_count);
+	}
+	return true;
+}
+
+TK_TEST(MeshSimplifier, select_lod) {
+	MeshLod lods[]{
+		{ .first_index = 0, .index_count = 300, .error = 0.0f },
+		{ .first_index = 300, .index_count = 150, .error = 0.01f },
+		{ .first_index = 450, .index_count = 75, .error = 0.1f },
+	};
+
+	// 90 degree vertical field of view, one unit at distance 1 covers half the viewport
+	Matrix4 projection = perspective(toki::radians(90.0), 1.0, 0.1, 100.0);
+	f32 pixel_scale	   = lod_pixel_scale(projection, 800.0f);
+	TK_TEST_ASSERT(toki::abs(pixel_scale - 400.0f) < 0.5f);
+
+	// An error of 0.01 covers 4 pixels at distance 1, 1 pixel at 4 and 0.4 pixels at 10
+	TK_TEST_ASSERT(select_lod(lods, 1.0f, pixel_scale) == 0);
+	TK_TEST_ASSERT(select_lod(lods, 10.0f, pixel_scale) == 1);
+	TK_TEST_ASSERT(select_lod(lods, 100.0f, pixel_scale) == 2);
+	TK_TEST_ASSERT(select_lod(lods, 10.0f, pixel_scale, 8.0f) == 2);
+	return true;
+}
@@ -0,0 +1,162 @@
+#include "testing.h"
+//
+
+#include <toki/core/core.h>
+#include <toki/runtime/resources/loaders/obj_loader.h>
+
+using namespace toki;
+
+static constexpr const char* TEST_FILE_PATH = "test_obj_loader.tmp";
+
+static ObjData load_text(const char* text, const ObjLoadConfig& config = {}) {
+	{
+		File file(StringView(TEST_FILE_PATH), FileMode::WRITE, FILE_FLAG_CREATE | FILE_FLAG_TRUNCATE);
+		file.write(text, toki::strlen(text));
+	}
+	return load_obj(TEST_FILE_PATH, config);
+}
+
+static b8 near(f32 value, f32 expected) {
+	return toki::abs(value - expected) <= toki::abs(expected) * 1e-6f + 1e-7f;
+}
+
+TK_TEST(ObjLoader, attributes_and_deduplication) {
+	// A quad as two triangles, the two shared corners become one vertex each
+	ObjData data = load_text(
+		"# comment\n"
+		"o quad\n"
+		"v 0 0 0\n"
+		"v 1 0 0\n"
+		"v 1 1 0\n"
+		"v 0 1 0\n"
+		"vt 0 0\n"
+		"vt 1 1\n"
+		"vn 0 0 1\n"
+		"s off\n"
+		"f 1/1/1 2/1/1 3/2/1\n"
+		"f 1/1/1 3/2/1 4/2/1\r\n");
+
+	TK_TEST_ASSERT(data.index_data.size() == 6);
+	TK_TEST_ASSERT(data.vertex_data.size() == 4);
+	TK_TEST_ASSERT(data.index_data[3] == data.index_data[0]);
+	TK_TEST_ASSERT(data.index_data[4] == data.index_data[2]);
+
+	const Vertex& corner = data.vertex_data[data.index_data[2]];
+	TK_TEST_ASSERT(corner.position == Vector3(1.0f, 1.0f, 0.0f));
+	TK_TEST_ASSERT(corner.uv == Vector2(1.0f, 1.0f));
+	TK_TEST_ASSERT(corner.normals == Vector3(0.0f, 0.0f, 1.0f));
+
+	// The same position with another texture coordinate is a separate vertex
+	data = load_text("v 0 0 0\nv 1 0 0\nv 0 1 0\nvt 0 0\nvt 1 0\nf 1/1 2/1 3/1\nf 1/2 3/1 2/1\n");
+	TK_TEST_ASSERT(data.vertex_data.size() == 4);
+	return true;
+}
+
+TK_TEST(ObjLoader, parses_floats) {
+	ObjData data = load_text(
+		"v 1.5 -2.25 +3\n"
+		"v .5 -.125 1e3\n"
+		"v 2.5E-2 -1.e1 0.000001\n"
+		"f 1 2 3\n");
+
+	TK_TEST_ASSERT(data.vertex_data.size() == 3);
+	Vector3 a = data.vertex_data[0].position;
+	Vector3 b = data.vertex_data[1].position;
+	Vector3 c = data.vertex_data[2].position;
+	TK_TEST_ASSERT(near(a.x, 1.5f) && near(a.y, -2.25f) && near(a.z, 3.0f));
+	TK_TEST_ASSERT(near(b.x, 0.5f) && near(b.y, -0.125f) && near(b.z, 1000.0f));
+	TK_TEST_ASSERT(near(c.x, 0.025f) && near(c.y, -10.0f) && near(c.z, 0.000001f));
+	return true;
+}
+
+TK_TEST(ObjLoader, negative_indices) {
+	// Relative indices count back from the last element read before the face
+	ObjData data = load_text(
+		"v 0 0 0\n"
+		"v 1 0 0\n"
+		"v 0 1 0\n"
+		"f -3 -2 -1\n"
+		"v 5 5 5\n"
+		"f -4 -1 -2\n");
+
+	TK_TEST_ASSERT(data.index_data.size() == 6);
+	TK_TEST_ASSERT(data.vertex_data[data.index_data[0]].position == Vector3(0.0f, 0.0f, 0.0f));
+	TK_TEST_ASSERT(data.vertex_data[data.index_data[2]].position == Vector3(0.0f, 1.0f, 0.0f));
+	TK_TEST_ASSERT(data.vertex_data[data.index_data[3]].position == Vector3(0.0f, 0.0f, 0.0f));
+	TK_TEST_ASSERT(data.vertex_data[data.index_data[4]].position == Vector3(5.0f, 5.0f, 5.0f));
+	TK_TEST_ASSERT(data.vertex_data[data.index_data[5]].position == Vector3(0.0f, 1.0f, 0.0f));
+	return true;
+}
+
+TK_TEST(ObjLoader, fan_triangulation) {
+	ObjData data = load_text("v 0 0 0\nv 1 0 0\nv 2 1 0\nv 1 2 0\nv 0 1 0\nf 1 2 3 4 5\n");
+
+	// Fan around the first corner, every triangle keeps the winding of the polygon
+	u32 expected[]{ 0, 1, 2, 0, 2, 3, 0, 3, 4 };
+	TK_TEST_ASSERT(data.index_data.size() == CARRAY_SIZE(expected));
+	for (u32 i = 0; i < CARRAY_SIZE(expected); i++) {
+		TK_TEST_ASSERT(data.index_data[i] == expected[i]);
+	}
+	return true;
+}
+
+TK_TEST(ObjLoader, invalid_faces_are_skipped) {
+	ObjData data = load_text(
+		"v 0 0 0\n"
+		"v 1 0 0\n"
+		"v 0 1 0\n"
+		"v 1 1 0\n"
+		// Too few corners
+		"f 1 2\n"
+		// Out of range corners drop the whole polygon, also the triangles before them
+		"f 1 2 3 9\n"
+		"f 1 2 -7\n"
+		"f 0 1 2\n"
+		"f 2 4 3\n");
+
+	TK_TEST_ASSERT(data.index_data.size() == 3);
+	TK_TEST_ASSERT(data.vertex_data.size() == 3);
+	TK_TEST_ASSERT(data.vertex_data[data.index_data[1]].position == Vector3(1.0f, 1.0f, 0.0f));
+	return true;
+}
+
+TK_TEST(ObjLoader, parallel_chunks_match_single_thread) {
+	// Rows of quads written with negative indices so faces refer to vertices of earlier chunks
+	constexpr u32 ROW_COUNT = 200;
+	DynamicArray<char> text;
+	auto append = [&](const char* str) {
+		for (const char* it = str; *it != '\0'; it++) {
+			text.push_back(*it);
+		}
+	};
+
+	char number[16]{};
+	for (u32 row = 0; row <= ROW_COUNT; row++) {
+		for (u32 x = 0; x < 2; x++) {
+			append("v ");
+			number[toki::itoa(number, x)] = '\0';
+			append(number);
+			append(" ");
+			number[toki::itoa(number, row)] = '\0';
+			append(number);
+			append(" 0\n");
+		}
+		if (row > 0) {
+			append("f -4 -3 -1 -2\n");
+		}
+	}
+	text.push_back('\0');
+
+	ObjData single = load_text(text.data());
+	ObjData parallel =
+		load_text(text.data(), ObjLoadConfig{ .thread_count = 4, .parallel_threshold = 0, .optimize = false });
+
+	TK_TEST_ASSERT(single.index_data.size() == ROW_COUNT * 6);
+	TK_TEST_ASSERT(parallel.index_data.size() == single.index_data.size());
+	TK_TEST_ASSERT(parallel.vertex_data.size() == single.vertex_data.size());
+	for (u64 i = 0; i < single.index_data.size(); i++) {
+		TK_TEST_ASSERT(parallel.vertex_data[parallel.index_data[i]].position ==
+					   single.vertex_data[single.index_data[i]].position);
+	}
+	return true;
+}
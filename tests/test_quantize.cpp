@@ -0,0 +1,150 @@
+#include "testing.h"
+//
+
+#include <toki/core/core.h>
+
+using namespace toki;
+
+// Sizes around the 8 wide step so both the vector loop and the scalar tail are covered
+static constexpr u64 BATCH_SIZES[] = { 0, 1, 7, 8, 9, 37 };
+
+static b8 is_f16_nan(u16 value) {
+	return (value & 0x7C00u) == 0x7C00u && (value & 0x03FFu) != 0;
+}
+
+static Vector3 test_normal(u64 index) {
+	f32 i = static_cast<f32>(index);
+	return Vector3(toki::sin(i * 1.3f), toki::cos(i * 0.7f), toki::sin(i * 2.9f) - 0.3f).normalize();
+}
+
+TK_TEST(Quantize, f16_round_trip) {
+	// Every half that is not NaN converts to a float and back to itself
+	for (u32 i = 0; i < 0x10000; i++) {
+		u16 half = static_cast<u16>(i);
+		if (is_f16_nan(half)) {
+			TK_TEST_ASSERT(is_f16_nan(f32_to_f16(f16_to_f32(half))));
+			continue;
+		}
+		TK_TEST_ASSERT(f32_to_f16(f16_to_f32(half)) == half);
+	}
+	return true;
+}
+
+TK_TEST(Quantize, f16_rounding) {
+	TK_TEST_ASSERT(f32_to_f16(1.0f) == 0x3C00);
+	TK_TEST_ASSERT(f32_to_f16(-2.0f) == 0xC000);
+	TK_TEST_ASSERT(f32_to_f16(65504.0f) == 0x7BFF);
+	TK_TEST_ASSERT(f32_to_f16(65520.0f) == 0x7C00);
+	TK_TEST_ASSERT(f32_to_f16(1e10f) == 0x7C00);
+	TK_TEST_ASSERT(f32_to_f16(-1e10f) == 0xFC00);
+	TK_TEST_ASSERT(f32_to_f16(1e-10f) == 0x0000);
+	TK_TEST_ASSERT(f32_to_f16(-0.0f) == 0x8000);
+
+	// Halfway between two halves goes to the even one
+	TK_TEST_ASSERT(f32_to_f16(1.0f + 1.0f / 2048.0f) == 0x3C00);
+	TK_TEST_ASSERT(f32_to_f16(1.0f + 3.0f / 2048.0f) == 0x3C02);
+	TK_TEST_ASSERT(f32_to_f16(1.0f + 1.0f / 2048.0f + 1.0f / 65536.0f) == 0x3C01);
+
+	// Smallest subnormal and the largest subnormal
+	TK_TEST_ASSERT(f32_to_f16(5.9604645e-8f) == 0x0001);
+	TK_TEST_ASSERT(f32_to_f16(6.0975552e-5f) == 0x03FF);
+	TK_TEST_ASSERT(f16_to_f32(0x0001) == 5.9604645e-8f);
+	TK_TEST_ASSERT(f16_to_f32(0x7C00) == __builtin_inff());
+
+	static_assert(f32_to_f16(0.5f) == 0x3800);
+	static_assert(f16_to_f32(0x3800) == 0.5f);
+	return true;
+}
+
+TK_TEST(Quantize, f16_many_matches_scalar) {
+	for (u64 count : BATCH_SIZES) {
+		DynamicArray<f32> values(count + 1, 0.0f);
+		DynamicArray<u16> halves(count + 1, 0);
+		DynamicArray<f32> floats(count + 1, 0.0f);
+		for (u64 i = 0; i < count; i++) {
+			// Normal, subnormal, overflowing and negative values
+			f32 scale = i % 4 == 0 ? 1e-6f : (i % 4 == 1 ? 1.0f : (i % 4 == 2 ? 1e5f : -300.0f));
+			values[i] = (static_cast<f32>(i) + 0.37f) * scale;
+		}
+
+		f32_to_f16_many(Span<f32>(values.data(), count), halves.data());
+		for (u64 i = 0; i < count; i++) {
+			TK_TEST_ASSERT(halves[i] == f32_to_f16(values[i]));
+		}
+
+		f16_to_f32_many(Span<u16>(halves.data(), count), floats.data());
+		for (u64 i = 0; i < count; i++) {
+			TK_TEST_ASSERT(floats[i] == f16_to_f32(halves[i]));
+		}
+	}
+	return true;
+}
+
+TK_TEST(Quantize, normalized) {
+	TK_TEST_ASSERT(quantize_snorm16(1.0f) == 32767);
+	TK_TEST_ASSERT(quantize_snorm16(-1.0f) == -32767);
+	TK_TEST_ASSERT(quantize_snorm16(2.0f) == 32767);
+	TK_TEST_ASSERT(quantize_snorm8(-0.5f) == -64);
+	TK_TEST_ASSERT(quantize_unorm8(0.5f) == 128);
+	TK_TEST_ASSERT(quantize_unorm16(-1.0f) == 0);
+	TK_TEST_ASSERT(dequantize_snorm(-128, 127) == -1.0f);
+
+	Vector4 value(0.25f, -0.75f, 1.0f, 1.0f);
+	Vector4 snorm = unpack_snorm_10_10_10_2(pack_snorm_10_10_10_2(value));
+	Vector4 unorm = unpack_unorm_10_10_10_2(pack_unorm_10_10_10_2(Vector4(0.25f, 0.75f, 0.0f, 1.0f)));
+	TK_TEST_ASSERT(toki::abs(snorm.x - 0.25f) <= 1.0f / 1022.0f);
+	TK_TEST_ASSERT(toki::abs(snorm.y + 0.75f) <= 1.0f / 1022.0f);
+	TK_TEST_ASSERT(snorm.z == 1.0f && snorm.w == 1.0f);
+	TK_TEST_ASSERT(toki::abs(unorm.x - 0.25f) <= 1.0f / 2046.0f);
+	TK_TEST_ASSERT(toki::abs(unorm.y - 0.75f) <= 1.0f / 2046.0f);
+	TK_TEST_ASSERT(unorm.z == 0.0f && unorm.w == 1.0f);
+	TK_TEST_ASSERT(unpack_snorm_10_10_10_2(pack_snorm_10_10_10_2(Vector4(-1.0f))) == Vector4(-1.0f));
+	return true;
+}
+
+TK_TEST(Quantize, octahedral) {
+	Vector3 axes[] = { { 1, 0, 0 }, { 0, -1, 0 }, { 0, 0, 1 }, { 0, 0, -1 } };
+	for (const Vector3& axis : axes) {
+		i16 encoded[2];
+		encode_octahedral(axis, encoded);
+		TK_TEST_ASSERT(decode_octahedral(encoded) == axis);
+	}
+
+	for (u64 i = 0; i < 1000; i++) {
+		Vector3 normal = test_normal(i);
+		i16 encoded[2];
+		encode_octahedral(normal, encoded);
+		TK_TEST_ASSERT((decode_octahedral(encoded) - normal).length() <= 1e-4f);
+	}
+	return true;
+}
+
+TK_TEST(Quantize, normals_many_match_scalar) {
+	for (u64 count : BATCH_SIZES) {
+		DynamicArray<Vector3> normals(count + 1, Vector3{});
+		DynamicArray<i16> encoded(count * 2 + 1, 0);
+		DynamicArray<u32> packed(count + 1, 0);
+		for (u64 i = 0; i < count; i++) {
+			normals[i] = test_normal(i);
+		}
+		if (count > 1) {
+			normals[1] = Vector3{};
+		}
+
+		encode_octahedral_many(Span<Vector3>(normals.data(), count), encoded.data());
+		pack_normals_10_10_10_2(Span<Vector3>(normals.data(), count), packed.data());
+		for (u64 i = 0; i < count; i++) {
+			i16 expected[2];
+			encode_octahedral(normals[i], expected);
+			// Contracted multiply adds in the scalar version can move a value by one step
+			TK_TEST_ASSERT(toki::abs(encoded[i * 2] - expected[0]) <= 1);
+			TK_TEST_ASSERT(toki::abs(encoded[i * 2 + 1] - expected[1]) <= 1);
+
+			Vector4 unpacked = unpack_snorm_10_10_10_2(packed[i]);
+			Vector4 reference(normals[i], 0.0f);
+			TK_TEST_ASSERT((unpacked - reference).length() <= 3e-3f);
+			TK_TEST_ASSERT(unpacked.w == 0.0f);
+		}
+	}
+	return true;
+}
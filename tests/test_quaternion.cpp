@@ -0,0 +1,138 @@
+#include "testing.h"
+//
+
+#include <toki/core/core.h>
+
+using namespace toki;
+
+// Sizes around the 8 wide step so both the vector loop and the scalar tail are covered
+static constexpr u64 BATCH_SIZES[] = { 0, 1, 7, 8, 9, 37 };
+
+static b8 nearly_equal(const Vector3& lhs, const Vector3& rhs) {
+	return toki::abs(lhs.x - rhs.x) <= 1e-4f && toki::abs(lhs.y - rhs.y) <= 1e-4f &&
+		   toki::abs(lhs.z - rhs.z) <= 1e-4f;
+}
+
+static b8 nearly_equal(const Matrix4& lhs, const Matrix4& rhs) {
+	for (u32 i = 0; i < 16; i++) {
+		if (toki::abs(lhs[i] - rhs[i]) > 1e-4f) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// q and -q are the same rotation
+static b8 same_rotation(const Quaternion& lhs, const Quaternion& rhs) {
+	return toki::abs(toki::abs(lhs.dot(rhs)) - 1.0f) <= 1e-4f;
+}
+
+static Quaternion test_rotation(u64 index) {
+	f32 i = static_cast<f32>(index);
+	return Quaternion::from_axis_angle(Vector3{ 1.0f + i, 2.0f - i * 0.5f, 0.5f }, 0.3f + i * 0.7f);
+}
+
+TK_TEST(Quaternion, from_axis_angle_matches_matrix) {
+	Vector3 axis{ 1, 2, -1 };
+	Quaternion rotation = Quaternion::from_axis_angle(axis, 0.8f);
+	TK_TEST_ASSERT(nearly_equal(rotation.to_matrix(), Matrix4().rotate(axis, 0.8f)));
+	TK_TEST_ASSERT(toki::abs(rotation.length() - 1.0f) <= 1e-5f);
+
+	Vector3 v{ 3, -1, 2 };
+	TK_TEST_ASSERT(nearly_equal(rotation.rotate(v), rotation.to_matrix().transform_direction(v)));
+
+	return true;
+}
+
+TK_TEST(Quaternion, multiply_matches_matrix_product) {
+	Quaternion a = test_rotation(1);
+	Quaternion b = test_rotation(2);
+
+	TK_TEST_ASSERT(nearly_equal((a * b).to_matrix(), a.to_matrix() * b.to_matrix()));
+
+	// Runtime SIMD and compile time scalar paths agree
+	constexpr Quaternion lhs(0.1f, 0.2f, 0.3f, 0.9f);
+	constexpr Quaternion rhs(-0.4f, 0.5f, 0.1f, 0.7f);
+	constexpr Quaternion product = lhs * rhs;
+	Quaternion runtime			 = lhs;
+	runtime *= rhs;
+	TK_TEST_ASSERT(toki::abs(runtime.x - product.x) <= 1e-6f && toki::abs(runtime.y - product.y) <= 1e-6f);
+	TK_TEST_ASSERT(toki::abs(runtime.z - product.z) <= 1e-6f && toki::abs(runtime.w - product.w) <= 1e-6f);
+
+	TK_TEST_ASSERT(same_rotation(a * a.conjugate(), Quaternion()));
+
+	return true;
+}
+
+TK_TEST(Quaternion, from_matrix_round_trip) {
+	// Rotations by up to 180 degrees hit every branch of from_matrix
+	for (u64 i = 0; i < 16; i++) {
+		Quaternion rotation = test_rotation(i);
+		TK_TEST_ASSERT(same_rotation(Quaternion::from_matrix(rotation.to_matrix()), rotation));
+	}
+	TK_TEST_ASSERT(same_rotation(
+		Quaternion::from_matrix(Matrix4().rotate(Vector3{ 0, 1, 0 }, static_cast<f32>(toki::PI))),
+		Quaternion::from_axis_angle(Vector3{ 0, 1, 0 }, static_cast<f32>(toki::PI))));
+
+	return true;
+}
+
+TK_TEST(Quaternion, interpolation) {
+	Vector3 axis{ 0, 0, 1 };
+	Quaternion from = Quaternion::from_axis_angle(axis, 0.2f);
+	Quaternion to	= Quaternion::from_axis_angle(axis, 1.4f);
+
+	TK_TEST_ASSERT(same_rotation(slerp(from, to, 0.0f), from));
+	TK_TEST_ASSERT(same_rotation(slerp(from, to, 1.0f), to));
+	TK_TEST_ASSERT(same_rotation(slerp(from, to, 0.5f), Quaternion::from_axis_angle(axis, 0.8f)));
+	TK_TEST_ASSERT(same_rotation(slerp(from, to, 0.25f), Quaternion::from_axis_angle(axis, 0.5f)));
+
+	TK_TEST_ASSERT(same_rotation(nlerp(from, to, 0.0f), from));
+	TK_TEST_ASSERT(same_rotation(nlerp(from, to, 1.0f), to));
+	TK_TEST_ASSERT(same_rotation(nlerp(from, to, 0.5f), Quaternion::from_axis_angle(axis, 0.8f)));
+
+	// The negated end is the same rotation, the shorter path is still taken
+	Quaternion negated(-to.x, -to.y, -to.z, -to.w);
+	TK_TEST_ASSERT(same_rotation(slerp(from, negated, 0.5f), Quaternion::from_axis_angle(axis, 0.8f)));
+
+	return true;
+}
+
+TK_TEST(Quaternion, compose_trs) {
+	Vector3 translation{ 1, -2, 3 };
+	Vector3 scale{ 2, 0.5f, 3 };
+	Quaternion rotation = test_rotation(3);
+
+	Matrix4 scale_matrix;
+	scale_matrix[0]	 = scale.x;
+	scale_matrix[5]	 = scale.y;
+	scale_matrix[10] = scale.z;
+	Matrix4 expected = Matrix4(translation) * rotation.to_matrix() * scale_matrix;
+	TK_TEST_ASSERT(nearly_equal(compose_trs(translation, rotation, scale), expected));
+
+	for (u64 count : BATCH_SIZES) {
+		DynamicArray<Vector3> translations(count + 1, Vector3{});
+		DynamicArray<Quaternion> rotations(count + 1, Quaternion{});
+		DynamicArray<Vector3> scales(count + 1, Vector3{});
+		DynamicArray<Matrix4> matrices(count + 1, Matrix4(42.0f));
+		for (u64 i = 0; i < count; i++) {
+			f32 f			= static_cast<f32>(i);
+			translations[i] = Vector3{ f, -f * 0.5f, 2.0f };
+			rotations[i]	= test_rotation(i);
+			scales[i]		= Vector3{ 1.0f + f * 0.1f, 2.0f, 0.5f + f };
+		}
+
+		compose_trs(
+			Span<Vector3>(translations.data(), count),
+			Span<Quaternion>(rotations.data(), count),
+			Span<Vector3>(scales.data(), count),
+			matrices.data());
+		for (u64 i = 0; i < count; i++) {
+			TK_TEST_ASSERT(nearly_equal(matrices[i], compose_trs(translations[i], rotations[i], scales[i])));
+		}
+		// Nothing is written past the end
+		TK_TEST_ASSERT(matrices[count][0] == 42.0f);
+	}
+
+	return true;
+}
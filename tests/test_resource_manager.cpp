@@ -0,0 +1,111 @@
+#include "testing.h"
+//
+
+#include <stdio.h>
+#include <toki/core/core.h>
+#include <toki/core/platform/file_watcher.h>
+#include <toki/runtime/resources/resource_manager.h>
+
+using namespace toki;
+
+static constexpr const char* TEST_DIRECTORY = "test_resource_manager";
+static constexpr const char* TEST_FILE_PATH = "test_resource_manager/text.tmp";
+
+static void write_text(const char* path, const char* text) {
+	File file(StringView(path), FileMode::WRITE, FILE_FLAG_CREATE | FILE_FLAG_TRUNCATE);
+	file.write(text, toki::strlen(text));
+}
+
+static b8 has_text(const ResourceHandle& handle, const char* text) {
+	u64 size = toki::strlen(text);
+	return handle.is_ready() && handle.size() == size &&
+		   toki::strncmp(reinterpret_cast<const char*>(handle.data()), text, size) == 0;
+}
+
+TK_TEST(ResourceManager, invalidate_detaches_referenced_entries) {
+	const char* path = "test_resource_manager.tmp";
+	write_text(path, "old contents");
+
+	ResourceManager manager({ .worker_count = 1 });
+	ResourceHandle old_handle = manager.load(path, ResourceType::TEXT);
+	TK_TEST_ASSERT(has_text(old_handle, "old contents"));
+	TK_TEST_ASSERT(manager.entry_count() == 1);
+
+	// The held handle keeps the old data, the entry leaves the cache
+	write_text(path, "new");
+	TK_TEST_ASSERT(manager.invalidate(path) == 1);
+	TK_TEST_ASSERT(manager.entry_count() == 0);
+	TK_TEST_ASSERT(has_text(old_handle, "old contents"));
+
+	ResourceHandle new_handle = manager.load(path, ResourceType::TEXT);
+	TK_TEST_ASSERT(has_text(new_handle, "new"));
+	TK_TEST_ASSERT(new_handle.content_hash() != old_handle.content_hash());
+	TK_TEST_ASSERT(manager.entry_count() == 1);
+	TK_TEST_ASSERT(manager.resident_size() == toki::strlen("old contents") + toki::strlen("new"));
+
+	// The detached entry goes away with its last handle
+	old_handle.reset();
+	TK_TEST_ASSERT(manager.resident_size() == toki::strlen("new"));
+
+	// Released entries are only cached, invalidating destroys them right away
+	new_handle.reset();
+	TK_TEST_ASSERT(manager.entry_count() == 1);
+	TK_TEST_ASSERT(manager.invalidate(path) == 1);
+	TK_TEST_ASSERT(manager.entry_count() == 0);
+	TK_TEST_ASSERT(manager.resident_size() == 0);
+	TK_TEST_ASSERT(manager.invalidate(path) == 0);
+	return true;
+}
+
+TK_TEST(ResourceManager, retries_failed_loads) {
+	const char* path = "test_resource_manager.tmp";
+	::remove(path);
+
+	ResourceManager manager({ .worker_count = 1 });
+	ResourceHandle failed = manager.load(path, ResourceType::TEXT);
+	TK_TEST_ASSERT(failed.state() == ResourceState::FAILED);
+
+	// The failed entry is still referenced, the next load reads the file again anyway
+	write_text(path, "written later");
+	ResourceHandle loaded = manager.load(path, ResourceType::TEXT);
+	TK_TEST_ASSERT(has_text(loaded, "written later"));
+	TK_TEST_ASSERT(failed.state() == ResourceState::FAILED);
+	TK_TEST_ASSERT(manager.entry_count() == 1);
+
+	failed.reset();
+	TK_TEST_ASSERT(manager.entry_count() == 1);
+	TK_TEST_ASSERT(has_text(manager.load(path, ResourceType::TEXT), "written later"));
+	return true;
+}
+
+TK_TEST(ResourceManager, reloads_watched_files) {
+	::remove(TEST_FILE_PATH);
+	::remove(TEST_DIRECTORY);
+	TK_TEST_ASSERT(!toki::create_directory(TEST_DIRECTORY).has_value());
+	write_text(TEST_FILE_PATH, "first");
+
+	DynamicArray<Path> changed;
+	{
+		ResourceManager manager({ .worker_count = 1 });
+		FileWatcher watcher({ .debounce_ms = 0 });
+		TK_TEST_ASSERT(watcher.watch_directory(TEST_DIRECTORY));
+
+		ResourceHandle handle = manager.load(TEST_FILE_PATH, ResourceType::TEXT);
+		TK_TEST_ASSERT(has_text(handle, "first"));
+
+		// Saved through a temporary file, the way most editors do it
+		write_text("test_resource_manager.tmp", "second");
+		TK_TEST_ASSERT(::rename("test_resource_manager.tmp", TEST_FILE_PATH) == 0);
+		TK_TEST_ASSERT(watcher.poll(changed) == 1);
+		TK_TEST_ASSERT(manager.invalidate(changed[0]) == 1);
+
+		TK_TEST_ASSERT(has_text(handle, "first"));
+		handle = manager.load(TEST_FILE_PATH, ResourceType::TEXT);
+		TK_TEST_ASSERT(has_text(handle, "second"));
+		TK_TEST_ASSERT(manager.entry_count() == 1);
+	}
+
+	::remove(TEST_FILE_PATH);
+	::remove(TEST_DIRECTORY);
+	return true;
+}
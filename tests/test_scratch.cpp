@@ -0,0 +1,111 @@
+#include "testing.h"
+//
+
+#include <toki/core/core.h>
+
+using namespace toki;
+
+TK_TEST(ScratchArena, scope_restores_marker) {
+	ScratchArena* arena = get_scratch();
+	u64 marker			= arena->get_marker();
+
+	{
+		ScratchScope scope;
+		TK_TEST_ASSERT(scope.arena() == arena);
+
+		u32* values = scope.allocate_array<u32>(1024);
+		for (u32 i = 0; i < 1024; i++) {
+			values[i] = i;
+		}
+		TK_TEST_ASSERT(arena->get_marker() > marker);
+	}
+
+	TK_TEST_ASSERT(arena->get_marker() == marker);
+
+	return true;
+}
+
+TK_TEST(ScratchArena, get_scratch_avoids_conflicts) {
+	ScratchArena* first	 = get_scratch();
+	ScratchArena* second = get_scratch(first);
+	TK_TEST_ASSERT(first != second);
+
+	ScratchScope scope(second);
+	TK_TEST_ASSERT(scope.arena() == first);
+
+	return true;
+}
+
+TK_TEST(ScratchArena, allocations_are_aligned) {
+	ScratchScope scope;
+
+	scope.allocate(1);
+	void* ptr = scope.arena()->allocate_aligned(64, 64);
+	TK_TEST_ASSERT(reinterpret_cast<u64ptr>(ptr) % 64 == 0);
+
+	return true;
+}
+
+TK_TEST(ScratchArena, dynamic_array_grows_in_place) {
+	ScratchScope scope;
+
+	ScratchDynamicArray<u64> values;
+	for (u64 i = 0; i < 100000; i++) {
+		values.push_back(i);
+	}
+
+	for (u64 i = 0; i < 100000; i++) {
+		TK_TEST_ASSERT(values[i] == i);
+	}
+
+	return true;
+}
+
+TK_TEST(ScratchArena, interleaved_arrays_keep_their_values) {
+	ScratchScope scope;
+
+	// Growing one array moves the other off the end of the arena, so both take turns being copied
+	ScratchDynamicArray<u32> first;
+	ScratchDynamicArray<u32> second;
+	for (u32 i = 0; i < 10000; i++) {
+		first.push_back(i);
+		second.push_back(i * 3);
+	}
+
+	for (u32 i = 0; i < 10000; i++) {
+		TK_TEST_ASSERT(first[i] == i);
+		TK_TEST_ASSERT(second[i] == i * 3);
+	}
+
+	return true;
+}
+
+TK_TEST(ScratchArena, array_grows_in_its_own_arena) {
+	ScratchScope outer;
+	ScratchArena* outer_arena = outer.arena();
+	ScratchDynamicArray<u64> values;
+	values.push_back(0);
+
+	{
+		// Allocations of the inner scope go to the other arena and are gone after it ends, the
+		// array has to keep growing where it started
+		ScratchScope inner(outer_arena);
+		TK_TEST_ASSERT(inner.arena() != outer_arena);
+		u64 inner_marker = inner.arena()->get_marker();
+
+		for (u64 i = 1; i < 10000; i++) {
+			values.push_back(i);
+		}
+		TK_TEST_ASSERT(inner.arena()->get_marker() == inner_marker);
+	}
+
+	ScratchDynamicArray<u64> other;
+	for (u64 i = 0; i < 10000; i++) {
+		other.push_back(U64_MAX);
+	}
+	for (u64 i = 0; i < 10000; i++) {
+		TK_TEST_ASSERT(values[i] == i);
+	}
+
+	return true;
+}
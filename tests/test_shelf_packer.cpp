@@ -0,0 +1,59 @@
+#include "testing.h"
+//
+
+#include <toki/core/core.h>
+
+using namespace toki;
+
+struct PackedRect {
+	Vector2u32 position;
+	u32 width;
+	u32 height;
+};
+
+static b8 overlaps(const PackedRect& a, const PackedRect& b) {
+	return a.position.x < b.position.x + b.width && b.position.x < a.position.x + a.width &&
+		   a.position.y < b.position.y + b.height && b.position.y < a.position.y + a.height;
+}
+
+TK_TEST(ShelfPacker, packs_without_overlap_until_full) {
+	ShelfPacker packer(128, 128);
+	DynamicArray<PackedRect> packed;
+
+	// Glyph like sizes, a few heights repeating in varying order
+	u32 sizes[][2] = { { 12, 20 }, { 9, 14 }, { 15, 21 }, { 7, 7 }, { 13, 19 }, { 11, 15 } };
+	for (u32 i = 0;; i++) {
+		u32 width  = sizes[i % 6][0];
+		u32 height = sizes[i % 6][1];
+
+		Vector2u32 position{};
+		if (!packer.pack(width, height, position)) {
+			break;
+		}
+
+		TK_TEST_ASSERT(position.x + width <= 128 && position.y + height <= 128);
+		PackedRect rect{ position, width, height };
+		for (u32 j = 0; j < packed.size(); j++) {
+			TK_TEST_ASSERT(!overlaps(rect, packed[j]));
+		}
+		packed.push_back(rect);
+	}
+
+	// The area should be mostly covered before packing fails
+	u64 covered = 0;
+	for (u32 i = 0; i < packed.size(); i++) {
+		covered += packed[i].width * packed[i].height;
+	}
+	TK_TEST_ASSERT(covered > 128 * 128 * 6 / 10);
+	TK_TEST_ASSERT(packer.used_height() <= 128);
+
+	Vector2u32 position{};
+	TK_TEST_ASSERT(!packer.pack(129, 1, position));
+
+	packer.reset(64, 64);
+	TK_TEST_ASSERT(packer.pack(64, 64, position));
+	TK_TEST_ASSERT(position.x == 0 && position.y == 0);
+	TK_TEST_ASSERT(!packer.pack(1, 1, position));
+
+	return true;
+}
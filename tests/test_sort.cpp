@@ -0,0 +1,39 @@
+#include "testing.h"
+//
+
+#include <toki/core/core.h>
+
+using namespace toki;
+
+TK_TEST(Sort, sorts_random_and_degenerate_input) {
+	DynamicArray<u32> values(1000);
+
+	u64 state = 42;
+	for (u32 i = 0; i < values.size(); i++) {
+		state	  = state * 6364136223846793005 + 1442695040888963407;
+		values[i] = static_cast<u32>(state >> 40) % 100;
+	}
+	toki::sort(values.data(), values.size());
+	for (u32 i = 1; i < values.size(); i++) {
+		TK_TEST_ASSERT(values[i - 1] <= values[i]);
+	}
+
+	// Already sorted, reversed and all equal input are the usual quicksort worst cases
+	for (u32 i = 0; i < values.size(); i++) {
+		values[i] = i;
+	}
+	toki::sort(values.data(), values.size(), [](u32 lhs, u32 rhs) {
+		return lhs > rhs;
+	});
+	for (u32 i = 0; i < values.size(); i++) {
+		TK_TEST_ASSERT(values[i] == values.size() - 1 - i);
+	}
+
+	for (u32 i = 0; i < values.size(); i++) {
+		values[i] = 7;
+	}
+	toki::sort(values.data(), values.size());
+	TK_TEST_ASSERT(values[0] == 7 && values.last() == 7);
+
+	return true;
+}
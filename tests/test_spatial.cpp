@@ -0,0 +1,196 @@
+#include "testing.h"
+//
+
+#include <toki/core/core.h>
+#include <toki/runtime/render/spatial.h>
+
+using namespace toki;
+
+// xorshift32, the same boxes every run
+static f32 next_f32(u32& state, f32 min_value, f32 max_value) {
+	state ^= state << 13;
+	state ^= state >> 17;
+	state ^= state << 5;
+	return min_value + (max_value - min_value) * static_cast<f32>(state >> 8) / static_cast<f32>(1 << 24);
+}
+
+static Aabb random_box(u32& state) {
+	Vector3 center(next_f32(state, -80.0f, 80.0f), next_f32(state, -80.0f, 80.0f), next_f32(state, -150.0f, 20.0f));
+	Vector3 extent(next_f32(state, 0.1f, 3.0f), next_f32(state, 0.1f, 3.0f), next_f32(state, 0.1f, 3.0f));
+	return Aabb{ center - extent, center + extent };
+}
+
+static DynamicArray<Aabb> random_boxes(u32 count, u32 seed) {
+	DynamicArray<Aabb> boxes;
+	for (u32 i = 0; i < count; i++) {
+		boxes.push_back(random_box(seed));
+	}
+	return boxes;
+}
+
+static Frustum frustum_from(const Vector3& eye, const Vector3& target, f32 fov, f32 far) {
+	Matrix4 view = look_at(eye, target, Vector3(0.0f, 1.0f, 0.0f));
+	return Frustum::from_matrix(perspective(fov, 1.5f, 0.5f, far) * view);
+}
+
+static constexpr u32 FRUSTUM_COUNT = 4;
+
+// Looking into the boxes, past all of them from far away, at a corner and away from them
+static Frustum test_frustum(u32 index) {
+	switch (index) {
+		case 0:
+			return frustum_from(Vector3(0.0f), Vector3(0.0f, 0.0f, -1.0f), 1.4f, 100.0f);
+		case 1:
+			return frustum_from(Vector3(0.0f, 0.0f, 400.0f), Vector3(0.0f), 1.0f, 1000.0f);
+		case 2:
+			return frustum_from(Vector3(-30.0f, 10.0f, -20.0f), Vector3(50.0f, -20.0f, -120.0f), 0.6f, 60.0f);
+		default:
+			return frustum_from(Vector3(0.0f, 0.0f, 30.0f), Vector3(0.0f, 0.0f, 100.0f), 1.0f, 100.0f);
+	}
+}
+
+// Every object Frustum::intersects accepts is in visible exactly once and nothing else is
+static b8 matches_brute_force(const Frustum& frustum, Span<Aabb> boxes, const DynamicArray<u32>& visible) {
+	DynamicArray<u32> seen;
+	for (u64 i = 0; i < boxes.size(); i++) {
+		seen.push_back(0);
+	}
+	for (u64 i = 0; i < visible.size(); i++) {
+		if (visible[i] >= boxes.size() || seen[visible[i]]++ != 0) {
+			return false;
+		}
+	}
+	for (u64 i = 0; i < boxes.size(); i++) {
+		if ((seen[i] != 0) != frustum.intersects(boxes[i])) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// Median splits give every object count exactly one tree shape
+static u32 median_split_node_count(u32 count) {
+	if (count <= Bvh::MAX_LEAF_OBJECTS) {
+		return 1;
+	}
+	return 1 + median_split_node_count(count / 2) + median_split_node_count(count - count / 2);
+}
+
+TK_TEST(Bvh, cull_matches_brute_force) {
+	u32 counts[]{ 0, 1, 3, 4, 5, 17, 1000 };
+	for (u32 c = 0; c < CARRAY_SIZE(counts); c++) {
+		DynamicArray<Aabb> boxes = random_boxes(counts[c], 7 + c);
+		Bvh bvh;
+		bvh.build(boxes);
+		TK_TEST_ASSERT(bvh.object_count() == counts[c]);
+		TK_TEST_ASSERT(bvh.node_count() == (counts[c] == 0 ? 0 : median_split_node_count(counts[c])));
+
+		for (u32 f = 0; f < FRUSTUM_COUNT; f++) {
+			DynamicArray<u32> visible;
+			bvh.cull(test_frustum(f), visible);
+			TK_TEST_ASSERT(matches_brute_force(test_frustum(f), boxes, visible));
+		}
+	}
+	return true;
+}
+
+TK_TEST(Bvh, cull_sees_everything_or_nothing) {
+	DynamicArray<Aabb> boxes = random_boxes(300, 3);
+	Bvh bvh;
+	bvh.build(boxes);
+
+	// Whole tree inside, the root alone decides
+	DynamicArray<u32> visible;
+	bvh.cull(test_frustum(1), visible);
+	TK_TEST_ASSERT(visible.size() == boxes.size());
+
+	visible.clear();
+	bvh.cull(test_frustum(3), visible);
+	TK_TEST_ASSERT(visible.size() == 0);
+	return true;
+}
+
+TK_TEST(Bvh, update_and_refit) {
+	DynamicArray<Aabb> boxes = random_boxes(500, 11);
+	Bvh bvh;
+	bvh.build(boxes);
+
+	// Moves objects across the whole scene so their leaves and every node above have to grow
+	u32 state = 99;
+	for (u32 round = 0; round < 3; round++) {
+		for (u32 i = round; i < boxes.size(); i += 3 + round) {
+			boxes[i] = random_box(state);
+			bvh.update(i, boxes[i]);
+		}
+		// One object far away from everything, its leaf reaches into the frustums and out again
+		boxes[round] = Aabb{ Vector3(500.0f), Vector3(501.0f) };
+		bvh.update(round, boxes[round]);
+		bvh.refit();
+
+		for (u32 f = 0; f < FRUSTUM_COUNT; f++) {
+			DynamicArray<u32> visible;
+			bvh.cull(test_frustum(f), visible);
+			TK_TEST_ASSERT(matches_brute_force(test_frustum(f), boxes, visible));
+		}
+	}
+
+	// Refitting without updates keeps the results
+	DynamicArray<u32> before, after;
+	bvh.cull(test_frustum(0), before);
+	bvh.refit();
+	bvh.cull(test_frustum(0), after);
+	TK_TEST_ASSERT(before.size() == after.size());
+	for (u64 i = 0; i < before.size(); i++) {
+		TK_TEST_ASSERT(before[i] == after[i]);
+	}
+	return true;
+}
+
+TK_TEST(Spatial, transform_bounds) {
+	Aabb box{ Vector3(-1.0f, 2.0f, 0.5f), Vector3(3.0f, 2.5f, 4.0f) };
+	Matrix4 transform =
+		Matrix4().translate(Vector3(5.0f, -2.0f, 1.0f)).rotate(Vector3(1.0f, 2.0f, 0.5f), 0.7f).scale(2.0f);
+
+	// Tight box around the eight transformed corners
+	Aabb expected{};
+	for (u32 corner = 0; corner < 8; corner++) {
+		Vector3 point((corner & 1) ? box.max.x : box.min.x,
+					  (corner & 2) ? box.max.y : box.min.y,
+					  (corner & 4) ? box.max.z : box.min.z);
+		expected.expand(transform.transform_point(point));
+	}
+
+	Aabb result = transform_bounds(box, transform);
+	TK_TEST_ASSERT((result.min - expected.min).length() <= 1e-4f);
+	TK_TEST_ASSERT((result.max - expected.max).length() <= 1e-4f);
+	TK_TEST_ASSERT(transform_bounds(Aabb{}, transform).is_empty());
+	return true;
+}
+
+TK_TEST(Culler, matches_bvh_order) {
+	DynamicArray<Aabb> boxes = random_boxes(5000, 5);
+	Bvh bvh;
+	bvh.build(boxes);
+
+	// No threshold so the workers split every cull with the calling thread
+	Culler culler({ .worker_count = 3, .parallel_threshold = 0 });
+	u32 state = 17;
+	for (u32 round = 0; round < 4; round++) {
+		for (u32 f = 0; f < FRUSTUM_COUNT; f++) {
+			DynamicArray<u32> expected, visible;
+			bvh.cull(test_frustum(f), expected);
+			culler.cull(bvh, test_frustum(f), visible);
+
+			TK_TEST_ASSERT(visible.size() == expected.size());
+			for (u64 i = 0; i < expected.size(); i++) {
+				TK_TEST_ASSERT(visible[i] == expected[i]);
+			}
+		}
+
+		for (u32 i = round; i < boxes.size(); i += 7) {
+			bvh.update(i, random_box(state));
+		}
+		bvh.refit();
+	}
+	return true;
+}
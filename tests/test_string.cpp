@@ -41,3 +41,59 @@ TK_TEST(BasicString, multiple_sized_strings) {
 	TempAllocator::allocator = nullptr;
 	return true;
 }
+
+TK_TEST(BasicString, copy_and_move_keep_contents) {
+	const char* texts[] = { "short", "a string that does not fit into the inline buffer" };
+
+	for (const char* text : texts) {
+		toki::String<> original = text;
+
+		toki::String<> copied = original;
+		TK_TEST_ASSERT(copied.size() == toki::strlen(text));
+		TK_TEST_ASSERT(toki::strncmp(copied.data(), text, copied.size() + 1) == 0);
+
+		toki::String<> assigned;
+		assigned = original;
+		TK_TEST_ASSERT(toki::strncmp(assigned.data(), text, assigned.size() + 1) == 0);
+
+		toki::String<> moved = toki::move(copied);
+		TK_TEST_ASSERT(moved.size() == toki::strlen(text));
+		TK_TEST_ASSERT(toki::strncmp(moved.data(), text, moved.size() + 1) == 0);
+	}
+
+	return true;
+}
+
+TK_TEST(BasicString, format_uses_string_view_size) {
+	const char* text = "name.asset and the rest";
+
+	toki::String<> formatted = toki::format("[{}]", toki::StringView(text, 10));
+	TK_TEST_ASSERT(formatted.size() == 12);
+	TK_TEST_ASSERT(toki::strncmp(formatted.data(), "[name.asset]", 13) == 0);
+
+	return true;
+}
+
+TK_TEST(Utf8, decodes_code_points_and_replaces_invalid_bytes) {
+	// a, e with acute, euro sign, musical g clef
+	StringView text("a\xC3\xA9\xE2\x82\xAC\xF0\x9D\x84\x9E");
+	u32 expected[] = { 'a', 0xE9, 0x20AC, 0x1D11E };
+
+	u64 offset = 0;
+	for (u32 code_point : expected) {
+		TK_TEST_ASSERT(utf8_decode(text, offset) == code_point);
+	}
+	TK_TEST_ASSERT(offset == text.size());
+
+	// Stray continuation byte, overlong slash, encoded surrogate and a truncated sequence
+	StringView invalid("\x80" "\xC0\xAF" "\xED\xA0\x80" "\xE2\x82");
+	offset	  = 0;
+	u32 count = 0;
+	while (offset < invalid.size()) {
+		TK_TEST_ASSERT(utf8_decode(invalid, offset) == UTF8_REPLACEMENT_CHARACTER);
+		count++;
+	}
+	TK_TEST_ASSERT(count == 5);
+
+	return true;
+}
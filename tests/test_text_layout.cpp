@@ -0,0 +1,188 @@
+#include "testing.h"
+//
+
+#include <toki/core/core.h>
+#include <toki/runtime/render/text_layout.h>
+#include <toki/runtime/render/text_layout_cache.h>
+
+using namespace toki;
+
+static constexpr f32 LINE_HEIGHT = 20.0f;
+
+// Every glyph is 8 pixels wide and advances 10, spaces have no quad
+class MonospaceGlyphs final : public GlyphSource {
+public:
+	virtual LayoutGlyph glyph(u32 code_point) override {
+		LayoutGlyph glyph{};
+		glyph.glyph_index = static_cast<i32>(code_point);
+		glyph.xoffset	  = 1.0f;
+		glyph.yoffset	  = -12.0f;
+		glyph.width		  = code_point == ' ' ? 0.0f : 8.0f;
+		glyph.height	  = code_point == ' ' ? 0.0f : 12.0f;
+		glyph.xadvance	  = 10.0f;
+		return glyph;
+	}
+
+	// Pulls the pair "AV" together like a kern table would
+	virtual f32 kerning(i32 previous_glyph_index, i32 glyph_index) override {
+		return previous_glyph_index == 'A' && glyph_index == 'V' ? -2.0f : 0.0f;
+	}
+};
+
+static TextLayout layout(StringView text, f32 wrap_width) {
+	MonospaceGlyphs glyphs;
+	TextLayout layout_out;
+	layout_glyphs(glyphs, text, LINE_HEIGHT, wrap_width, layout_out);
+	return layout_out;
+}
+
+// Line of a glyph counted from 0, the glyph sits on the baseline of its line
+static u32 line_of(const PositionedGlyph& glyph) {
+	return static_cast<u32>((12.0f - glyph.y0) / LINE_HEIGHT + 0.5f);
+}
+
+TK_TEST(TextLayout, single_line_with_kerning) {
+	TextLayout result = layout("AVA", 0);
+	TK_TEST_ASSERT(result.glyphs.size() == 3);
+	TK_TEST_ASSERT(result.line_count == 1);
+	TK_TEST_ASSERT(result.height == LINE_HEIGHT);
+
+	TK_TEST_ASSERT(result.glyphs[0].x0 == 1.0f && result.glyphs[0].x1 == 9.0f);
+	TK_TEST_ASSERT(result.glyphs[1].x0 == 9.0f);
+	TK_TEST_ASSERT(result.glyphs[2].x0 == 19.0f);
+	TK_TEST_ASSERT(result.width == 27.0f);
+	TK_TEST_ASSERT(result.glyphs[0].y0 == 12.0f && result.glyphs[0].y1 == 0.0f);
+
+	TK_TEST_ASSERT(layout("", 0).line_count == 0);
+	return true;
+}
+
+TK_TEST(TextLayout, newlines) {
+	TextLayout result = layout("ab\n\ncd", 0);
+	TK_TEST_ASSERT(result.glyphs.size() == 4);
+	TK_TEST_ASSERT(result.line_count == 3);
+	TK_TEST_ASSERT(result.height == 3 * LINE_HEIGHT);
+	TK_TEST_ASSERT(line_of(result.glyphs[1]) == 0);
+	TK_TEST_ASSERT(line_of(result.glyphs[2]) == 2);
+	TK_TEST_ASSERT(result.glyphs[2].x0 == 1.0f);
+	return true;
+}
+
+TK_TEST(TextLayout, wraps_whole_words) {
+	// "aaa bbb ccc" would be 109 pixels wide, the third word moves down as a whole
+	TextLayout result = layout("aaa bbb ccc ddd", 80.0f);
+	TK_TEST_ASSERT(result.glyphs.size() == 12);
+	TK_TEST_ASSERT(result.line_count == 2);
+	for (u32 i = 0; i < 6; i++) {
+		TK_TEST_ASSERT(line_of(result.glyphs[i]) == 0);
+		TK_TEST_ASSERT(line_of(result.glyphs[6 + i]) == 1);
+	}
+	// The word starts at the left edge of its new line, the space before it is dropped
+	TK_TEST_ASSERT(result.glyphs[6].x0 == 1.0f);
+	TK_TEST_ASSERT(result.glyphs[9].x0 == 41.0f);
+	TK_TEST_ASSERT(result.width == 69.0f);
+	return true;
+}
+
+TK_TEST(TextLayout, breaks_words_wider_than_a_line) {
+	TextLayout result = layout("abcdefgh", 35.0f);
+	TK_TEST_ASSERT(result.glyphs.size() == 8);
+	TK_TEST_ASSERT(result.line_count == 3);
+	for (u32 i = 0; i < result.glyphs.size(); i++) {
+		TK_TEST_ASSERT(line_of(result.glyphs[i]) == i / 3);
+		TK_TEST_ASSERT(result.glyphs[i].x1 <= 35.0f);
+	}
+	return true;
+}
+
+// Fills in one glyph per character so the glyph count of a layout is the length of its text
+static void fake_layout(StringView text, TextLayout& layout_out) {
+	layout_out.glyphs.clear();
+	for (u64 i = 0; i < text.size(); i++) {
+		layout_out.glyphs.push_back({});
+	}
+	layout_out.line_count = 1;
+}
+
+TK_TEST(TextLayoutCache, hits_and_keys) {
+	TextLayoutCache cache;
+	u32 layouts_made = 0;
+	auto get		 = [&](u64 font_id, StringView text, TextLayoutConfig config) -> const TextLayout& {
+		return cache.get(font_id, text, config, [&](TextLayout& layout_out) {
+			layouts_made++;
+			fake_layout(text, layout_out);
+		});
+	};
+
+	get(1, "hello", { 16.0f });
+	get(1, "hello", { 16.0f });
+	TK_TEST_ASSERT(layouts_made == 1);
+	TK_TEST_ASSERT(cache.hit_count() == 1 && cache.miss_count() == 1);
+
+	// Font, size, wrap width and text are all part of the key
+	get(2, "hello", { 16.0f });
+	get(1, "hello", { 17.0f });
+	get(1, "hello", { 16.0f, 100.0f });
+	get(1, "hellO", { 16.0f });
+	get(1, "hell", { 16.0f });
+	TK_TEST_ASSERT(layouts_made == 6);
+	TK_TEST_ASSERT(cache.entry_count() == 6);
+	TK_TEST_ASSERT(cache.glyph_count() == 5 * 5 + 4);
+
+	const TextLayout& hit = get(1, "hell", { 16.0f });
+	TK_TEST_ASSERT(layouts_made == 6 && hit.glyphs.size() == 4);
+
+	cache.clear();
+	TK_TEST_ASSERT(cache.entry_count() == 0 && cache.glyph_count() == 0);
+	return true;
+}
+
+TK_TEST(TextLayoutCache, evicts_least_recently_used) {
+	TextLayoutCache cache({ .glyph_budget = 30 });
+	u32 layouts_made = 0;
+	auto get		 = [&](StringView text) {
+		cache.get(0, text, { 16.0f }, [&](TextLayout& layout_out) {
+			layouts_made++;
+			fake_layout(text, layout_out);
+		});
+	};
+
+	get("aaaaaaaaaa");
+	get("bbbbbbbbbb");
+	get("cccccccccc");
+	// Using the oldest layout again makes the second one the least recently used
+	get("aaaaaaaaaa");
+	TK_TEST_ASSERT(layouts_made == 3);
+
+	get("dddddddddd");
+	TK_TEST_ASSERT(cache.entry_count() == 3);
+	TK_TEST_ASSERT(cache.glyph_count() <= 30);
+
+	get("aaaaaaaaaa");
+	get("cccccccccc");
+	TK_TEST_ASSERT(layouts_made == 4);
+	get("bbbbbbbbbb");
+	TK_TEST_ASSERT(layouts_made == 5);
+
+	// A layout over the whole budget is still kept while it is the most recent one
+	get("a long text that does not fit the budget");
+	TK_TEST_ASSERT(cache.entry_count() == 1);
+	return true;
+}
+
+TK_TEST(TextLayoutCache, many_entries) {
+	TextLayoutCache cache;
+	char text[8]{};
+	for (u32 round = 0; round < 2; round++) {
+		for (u32 i = 0; i < 1000; i++) {
+			u64 length = toki::itoa(text, i);
+			cache.get(0, StringView(text, length), { 16.0f }, [&](TextLayout& layout_out) {
+				fake_layout(StringView(text, length), layout_out);
+			});
+		}
+	}
+	// The table grows past its initial buckets and every second lookup is a hit
+	TK_TEST_ASSERT(cache.entry_count() == 1000);
+	TK_TEST_ASSERT(cache.hit_count() == 1000 && cache.miss_count() == 1000);
+	return true;
+}
@@ -0,0 +1,219 @@
+#include "testing.h"
+//
+
+#include <toki/core/core.h>
+
+using namespace toki;
+
+// Sizes around the 8 wide step so both the vector loop and the scalar tail are covered
+static constexpr u64 BATCH_SIZES[] = { 0, 1, 7, 8, 9, 37 };
+
+// Distance in representable floats, the reference is computed in f64 by the compiler builtins and
+// rounded once so it is the correctly rounded result in almost every case
+static u32 ulp_distance(f32 value, f64 reference) {
+	i32 a = __builtin_bit_cast(i32, value);
+	i32 b = __builtin_bit_cast(i32, static_cast<f32>(reference));
+	a	  = a < 0 ? static_cast<i32>(0x80000000u - static_cast<u32>(a)) : a;
+	b	  = b < 0 ? static_cast<i32>(0x80000000u - static_cast<u32>(b)) : b;
+	return static_cast<u32>(a > b ? static_cast<i64>(a) - b : static_cast<i64>(b) - a);
+}
+
+static b8 is_nan(f32 value) {
+	return value != value;
+}
+
+static f32 sweep(f32 from, f32 to, u32 index, u32 count) {
+	return from + (to - from) * static_cast<f32>(index) / static_cast<f32>(count - 1);
+}
+
+TK_TEST(Transcendental, sin_cos_precise) {
+	for (u32 i = 0; i < 20000; i++) {
+		f32 x = sweep(-4.0f, 4.0f, i, 20000);
+		TK_TEST_ASSERT(ulp_distance(toki::sin(x), __builtin_sin(x)) <= 2);
+		TK_TEST_ASSERT(ulp_distance(toki::cos(x), __builtin_cos(x)) <= 2);
+	}
+
+	// Further out the reduction error shows up as absolute error instead of relative
+	for (u32 i = 0; i < 20000; i++) {
+		f32 x = sweep(-8192.0f, 8192.0f, i, 20000);
+		TK_TEST_ASSERT(toki::abs(toki::sin(x) - __builtin_sin(x)) <= 2e-7);
+		TK_TEST_ASSERT(toki::abs(toki::cos(x) - __builtin_cos(x)) <= 2e-7);
+	}
+
+	return true;
+}
+
+TK_TEST(Transcendental, sin_cos_fast) {
+	for (u32 i = 0; i < 20000; i++) {
+		f32 x = sweep(-100.0f, 100.0f, i, 20000);
+		TK_TEST_ASSERT(toki::abs(toki::sin<Accuracy::Fast>(x) - __builtin_sin(x)) <= 1e-4);
+		TK_TEST_ASSERT(toki::abs(toki::cos<Accuracy::Fast>(x) - __builtin_cos(x)) <= 1e-4);
+	}
+	return true;
+}
+
+TK_TEST(Transcendental, tan) {
+	for (u32 i = 0; i < 20000; i++) {
+		f32 x = sweep(-1.5f, 1.5f, i, 20000);
+		TK_TEST_ASSERT(ulp_distance(toki::tan(x), __builtin_tan(x)) <= 3);
+		f64 reference = __builtin_tan(x);
+		TK_TEST_ASSERT(toki::abs(toki::tan<Accuracy::Fast>(x) - reference) <= 1e-3 * toki::abs(reference) + 1e-5);
+	}
+	return true;
+}
+
+TK_TEST(Transcendental, atan_atan2) {
+	for (u32 i = 0; i < 20000; i++) {
+		f32 x = sweep(-50.0f, 50.0f, i, 20000);
+		TK_TEST_ASSERT(ulp_distance(toki::atan(x), __builtin_atan(x)) <= 3);
+		TK_TEST_ASSERT(toki::abs(toki::atan<Accuracy::Fast>(x) - __builtin_atan(x)) <= 1e-4);
+	}
+
+	for (u32 i = 0; i < 200; i++) {
+		for (u32 j = 0; j < 200; j++) {
+			f32 y = sweep(-3.0f, 3.0f, i, 200);
+			f32 x = sweep(-3.0f, 3.0f, j, 200);
+			TK_TEST_ASSERT(ulp_distance(toki::atan2(y, x), __builtin_atan2(y, x)) <= 3);
+			TK_TEST_ASSERT(toki::abs(toki::atan2<Accuracy::Fast>(y, x) - __builtin_atan2(y, x)) <= 1e-4);
+		}
+	}
+
+	TK_TEST_ASSERT(toki::atan2(0.0f, -1.0f) == static_cast<f32>(__builtin_atan2(0.0, -1.0)));
+	TK_TEST_ASSERT(toki::atan2(1.0f, 0.0f) == static_cast<f32>(__builtin_atan2(1.0, 0.0)));
+	TK_TEST_ASSERT(toki::atan2(0.0f, 0.0f) == 0.0f);
+
+	return true;
+}
+
+TK_TEST(Transcendental, acos) {
+	for (u32 i = 0; i < 20000; i++) {
+		f32 x = sweep(-1.0f, 1.0f, i, 20000);
+		TK_TEST_ASSERT(ulp_distance(toki::acos(x), __builtin_acos(x)) <= 2);
+		TK_TEST_ASSERT(toki::abs(toki::acos<Accuracy::Fast>(x) - __builtin_acos(x)) <= 1e-4);
+	}
+	TK_TEST_ASSERT(is_nan(toki::acos(1.5f)));
+	return true;
+}
+
+TK_TEST(Transcendental, exp_log) {
+	for (u32 i = 0; i < 20000; i++) {
+		f32 x		  = sweep(-87.0f, 88.0f, i, 20000);
+		f64 reference = __builtin_exp(x);
+		TK_TEST_ASSERT(ulp_distance(toki::exp(x), reference) <= 2);
+		TK_TEST_ASSERT(toki::abs(toki::exp<Accuracy::Fast>(x) - reference) <= 1e-5 * reference);
+	}
+
+	for (u32 i = 0; i < 20000; i++) {
+		f32 x = sweep(1e-3f, 1000.0f, i, 20000);
+		TK_TEST_ASSERT(ulp_distance(toki::log(x), __builtin_log(x)) <= 2);
+		TK_TEST_ASSERT(toki::abs(toki::log<Accuracy::Fast>(x) - __builtin_log(x)) <= 1e-4);
+	}
+
+	TK_TEST_ASSERT(toki::exp(-200.0f) == 0.0f);
+	TK_TEST_ASSERT(toki::exp(200.0f) == detail::F32_INFINITY);
+	TK_TEST_ASSERT(toki::log(0.0f) == -detail::F32_INFINITY);
+	TK_TEST_ASSERT(toki::log(detail::F32_INFINITY) == detail::F32_INFINITY);
+	TK_TEST_ASSERT(is_nan(toki::log(-1.0f)));
+
+	return true;
+}
+
+TK_TEST(Transcendental, pow) {
+	for (u32 i = 0; i < 200; i++) {
+		for (u32 j = 0; j < 200; j++) {
+			f32 x		  = sweep(0.01f, 20.0f, i, 200);
+			f32 y		  = sweep(-3.0f, 3.0f, j, 200);
+			f64 reference = __builtin_pow(x, y);
+			TK_TEST_ASSERT(ulp_distance(toki::pow(x, y), reference) <= 2);
+			TK_TEST_ASSERT(toki::abs(toki::pow<Accuracy::Fast>(x, y) - reference) <= 1e-4 * reference);
+		}
+	}
+
+	// Large products of y and log(x), a rounded product alone would be off by several ulp here
+	for (u32 i = 0; i < 200; i++) {
+		for (u32 j = 0; j < 200; j++) {
+			f32 x		  = sweep(1.01f, 2.0f, i, 200);
+			f32 y		  = sweep(-85.0f, 85.0f, j, 200) / static_cast<f32>(__builtin_log(x));
+			f64 reference = __builtin_pow(x, y);
+			TK_TEST_ASSERT(ulp_distance(toki::pow(x, y), reference) <= 2);
+		}
+	}
+
+	// Cube roots, the case stb_truetype uses it for
+	for (u32 i = 0; i < 1000; i++) {
+		f32 x = sweep(0.0f, 8.0f, i, 1000);
+		TK_TEST_ASSERT(ulp_distance(toki::pow(x, 1.0f / 3.0f), __builtin_pow(x, 1.0f / 3.0f)) <= 4);
+	}
+
+	TK_TEST_ASSERT(toki::pow(-2.0f, 3.0f) == -8.0f);
+	TK_TEST_ASSERT(toki::pow(-2.0f, 2.0f) == 4.0f);
+	TK_TEST_ASSERT(is_nan(toki::pow(-2.0f, 0.5f)));
+	TK_TEST_ASSERT(toki::pow(0.0f, 2.0f) == 0.0f);
+	TK_TEST_ASSERT(toki::pow(detail::F32_NAN, 0.0f) == 1.0f);
+	TK_TEST_ASSERT(toki::pow(1.0f, detail::F32_NAN) == 1.0f);
+
+	return true;
+}
+
+TK_TEST(Transcendental, special_values) {
+	TK_TEST_ASSERT(is_nan(toki::sin(detail::F32_INFINITY)));
+	TK_TEST_ASSERT(is_nan(toki::cos(detail::F32_NAN)));
+	TK_TEST_ASSERT(is_nan(toki::exp(detail::F32_NAN)));
+	TK_TEST_ASSERT(toki::sin(0.0f) == 0.0f);
+	TK_TEST_ASSERT(toki::cos(0.0f) == 1.0f);
+	TK_TEST_ASSERT(toki::exp(0.0f) == 1.0f);
+	TK_TEST_ASSERT(toki::log(1.0f) == 0.0f);
+	return true;
+}
+
+TK_TEST(Transcendental, constexpr_evaluation) {
+	static_assert(toki::abs(toki::sin(0.5f) - 0.47942554f) <= 1e-7f);
+	static_assert(toki::abs(toki::exp(1.0f) - 2.7182817f) <= 1e-6f);
+	static_assert(toki::log(1.0f) == 0.0f);
+	static_assert(toki::pow(2.0f, 10.0f) == 1024.0f);
+	return true;
+}
+
+TK_TEST(Transcendental, many_matches_scalar) {
+	for (u64 count : BATCH_SIZES) {
+		DynamicArray<f32> x(count + 1);
+		DynamicArray<f32> y(count + 1);
+		DynamicArray<f32> result(count + 1);
+		for (u64 i = 0; i < count; i++) {
+			x[i] = 0.25f + static_cast<f32>(i) * 0.7f;
+			y[i] = -1.5f + static_cast<f32>(i) * 0.1f;
+		}
+		Span<f32> xs(x.data(), count);
+		Span<f32> ys(y.data(), count);
+
+		sin_many(xs, result.data());
+		for (u64 i = 0; i < count; i++) {
+			TK_TEST_ASSERT(ulp_distance(result[i], toki::sin(x[i])) <= 1);
+		}
+		cos_many<Accuracy::Fast>(xs, result.data());
+		for (u64 i = 0; i < count; i++) {
+			TK_TEST_ASSERT(ulp_distance(result[i], toki::cos<Accuracy::Fast>(x[i])) <= 1);
+		}
+		tan_many(xs, result.data());
+		for (u64 i = 0; i < count; i++) {
+			TK_TEST_ASSERT(ulp_distance(result[i], toki::tan(x[i])) <= 1);
+		}
+		atan2_many(ys, xs, result.data());
+		for (u64 i = 0; i < count; i++) {
+			TK_TEST_ASSERT(ulp_distance(result[i], toki::atan2(y[i], x[i])) <= 1);
+		}
+		exp_many(ys, result.data());
+		for (u64 i = 0; i < count; i++) {
+			TK_TEST_ASSERT(ulp_distance(result[i], toki::exp(y[i])) <= 1);
+		}
+		log_many<Accuracy::Fast>(xs, result.data());
+		for (u64 i = 0; i < count; i++) {
+			TK_TEST_ASSERT(ulp_distance(result[i], toki::log<Accuracy::Fast>(x[i])) <= 1);
+		}
+		pow_many(xs, ys, result.data());
+		for (u64 i = 0; i < count; i++) {
+			TK_TEST_ASSERT(ulp_distance(result[i], toki::pow(x[i], y[i])) <= 1);
+		}
+	}
+	return true;
+}
@@ -0,0 +1,40 @@
+#include "testing.h"
+//
+
+#include <toki/core/core.h>
+
+using namespace toki;
+
+TK_TEST(Vector4, arithmetic) {
+	Vector4 vec1(1, 2, 3, 4);
+	Vector4 vec2(2, 3, 4, 5);
+
+	TK_TEST_ASSERT(vec1 + vec2 == Vector4(3, 5, 7, 9));
+	TK_TEST_ASSERT(vec1 - vec2 == Vector4(-1));
+	TK_TEST_ASSERT(vec1 * vec2 == Vector4(2, 6, 12, 20));
+	TK_TEST_ASSERT(vec1 * 2.0f == Vector4(2, 4, 6, 8));
+	TK_TEST_ASSERT(vec1.dot(vec2) == 40.0f);
+
+	return true;
+}
+
+TK_TEST(Vector4, aligned) {
+	static_assert(alignof(Vector4) == 16);
+	static_assert(sizeof(Vector4) == 16);
+
+	DynamicArray<Vector4> vectors(3, Vector4(1.0f));
+	for (u32 i = 0; i < vectors.size(); i++) {
+		TK_TEST_ASSERT(reinterpret_cast<u64ptr>(&vectors[i]) % 16 == 0);
+	}
+
+	return true;
+}
+
+TK_TEST(Vector4, from_vector3) {
+	Vector4 point(Vector3(1, 2, 3), 1.0f);
+	TK_TEST_ASSERT(point.w == 1.0f);
+	TK_TEST_ASSERT(point.xyz().x == 1.0f && point.xyz().y == 2.0f && point.xyz().z == 3.0f);
+	TK_TEST_ASSERT(Vector4(3, 0, 4, 0).length() == 5.0f);
+
+	return true;
+}